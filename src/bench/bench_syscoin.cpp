@@ -11,6 +11,7 @@
 #include <memory>
 // SYSCOIN
 #include <bls/bls.h>
+#include <ethereum/sha3.h>
 void InitBLSTests();
 void CleanupBLSTests();
 void CleanupBLSDkgTests();
@@ -46,6 +47,7 @@ int main(int argc, char** argv)
     SetupBenchArgs(argsman);
     SHA256AutoDetect();
     // SYSCOIN
+    dev::sha3AutoDetect();
     BLSInit();
     InitBLSTests();
     std::string error;
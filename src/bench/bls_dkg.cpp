@@ -5,6 +5,9 @@
 #include <bench/bench.h>
 #include <random.h>
 #include <bls/bls_worker.h>
+#include <llmq/quorums.h>
+#include <streams.h>
+#include <version.h>
 
 extern CBLSWorker blsWorker;
 
@@ -107,6 +110,50 @@ struct DKG
             memberIdx = (memberIdx + 1) % members.size();
         });
     }
+
+    // Time from a restart to the first signature share of a member, without a stored quorum vvec and skShare...
+    void Bench_RebuildQuorumData(benchmark::Bench& bench)
+    {
+        ReceiveVvecs();
+        ReceiveShares(0);
+        const uint256 msgHash = GetRandHash();
+
+        bench.run([&] {
+            auto vvec = blsWorker.BuildQuorumVerificationVector(receivedVvecs);
+            auto skShare = blsWorker.AggregateSecretKeys(receivedSkShares);
+            assert(vvec != nullptr && skShare.IsValid());
+            assert(skShare.Sign(msgHash).IsValid());
+        });
+    }
+
+    // ...and with them stored in a CQuorumDataRecord
+    void Bench_LoadQuorumData(benchmark::Bench& bench)
+    {
+        ReceiveVvecs();
+        ReceiveShares(0);
+        const uint256 msgHash = GetRandHash();
+
+        CBLSSecretKey operatorKey;
+        operatorKey.MakeNewKey();
+        llmq::CQuorumDataRecord record;
+        record.quorumVvec = *quorumVvec;
+        bool ok = record.SetSkShare(operatorKey.GetPublicKey(), blsWorker.AggregateSecretKeys(receivedSkShares));
+        assert(ok);
+        CDataStream ds(SER_DISK, PROTOCOL_VERSION);
+        ds << record;
+
+        bench.run([&] {
+            CDataStream ds2(ds);
+            llmq::CQuorumDataRecord record2;
+            ds2 >> record2;
+            // same checks as CQuorum::ReadContributions
+            assert(record2.skShare.IsValid());
+            CBLSSecretKey skShare;
+            bool ok = record2.skShare.Decrypt(0, operatorKey, skShare, PROTOCOL_VERSION);
+            assert(ok && record2.quorumVvec.size() == quorumVvec->size());
+            assert(skShare.Sign(msgHash).IsValid());
+        });
+    }
 };
 
 std::shared_ptr<DKG> dkg10;
@@ -177,3 +224,28 @@ BENCH_VerifyContributionShares(parallel, 400, 5, true, false)
 BENCH_VerifyContributionShares(parallel_aggregated, 10, 5, true, true)
 BENCH_VerifyContributionShares(parallel_aggregated, 100, 5, true, true)
 BENCH_VerifyContributionShares(parallel_aggregated, 400, 5, true, true)*/
+
+///////////////////////////////
+
+
+
+#define BENCH_RestoreQuorumData(quorumSize) \
+    static void BLSDKG_RebuildQuorumData_##quorumSize(benchmark::Bench& bench) \
+    { \
+        if (dkg##quorumSize == nullptr) { \
+            dkg##quorumSize = std::make_shared<DKG>(quorumSize); \
+        } \
+        dkg##quorumSize->Bench_RebuildQuorumData(bench); \
+    } \
+    static void BLSDKG_LoadQuorumData_##quorumSize(benchmark::Bench& bench) \
+    { \
+        if (dkg##quorumSize == nullptr) { \
+            dkg##quorumSize = std::make_shared<DKG>(quorumSize); \
+        } \
+        dkg##quorumSize->Bench_LoadQuorumData(bench); \
+    } \
+    BENCHMARK(BLSDKG_RebuildQuorumData_##quorumSize) \
+    BENCHMARK(BLSDKG_LoadQuorumData_##quorumSize)
+
+BENCH_RestoreQuorumData(10)
+BENCH_RestoreQuorumData(100)
@@ -0,0 +1,159 @@
+// Copyright (c) 2021 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+
+#include <chain.h>
+#include <clientversion.h>
+#include <evo/deterministicmns.h>
+#include <evo/evodb.h>
+#include <random.h>
+#include <streams.h>
+#include <test/util/setup_common.h>
+#include <uint256.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+static CDeterministicMNList BuildMNList(size_t nCount)
+{
+    FastRandomContext rng(true);
+    CDeterministicMNList mnList(uint256(), 1, 0);
+    for (size_t i = 0; i < nCount; i++) {
+        auto dmn = std::make_shared<CDeterministicMN>(i);
+        dmn->proTxHash = rng.rand256();
+        dmn->collateralOutpoint = COutPoint(rng.rand256(), 0);
+        auto dmnState = std::make_shared<CDeterministicMNState>();
+        dmnState->nRegisteredHeight = 1;
+        dmnState->nLastPaidHeight = rng.randrange(nCount);
+        dmnState->keyIDOwner = CKeyID(uint160(rng.randbytes(20)));
+        dmnState->UpdateConfirmedHash(dmn->proTxHash, rng.rand256());
+        dmn->pdmnState = dmnState;
+        mnList.AddMN(dmn);
+    }
+    return mnList;
+}
+
+// Lists and diffs of the following blocks, which only pay the next masternode like most blocks do
+static void BuildPaymentChain(const CDeterministicMNList& mnList, int nBlocks, std::vector<CDeterministicMNList>& lists, std::vector<CDeterministicMNListDiff>& diffs)
+{
+    lists.emplace_back(mnList);
+    for (int i = 0; i < nBlocks; i++) {
+        const CDeterministicMNList prevList = lists.back();
+        CDeterministicMNList newList = prevList;
+        auto payee = prevList.GetMNPayee();
+        auto newState = std::make_shared<CDeterministicMNState>(*payee->pdmnState);
+        // above all the random heights the masternodes were paid at
+        newState->nLastPaidHeight = prevList.GetAllMNsCount() + i;
+        newList.UpdateMN(payee->proTxHash, newState);
+        CDeterministicMNListDiff diff;
+        prevList.BuildDiff(newList, diff);
+        lists.emplace_back(std::move(newList));
+        diffs.emplace_back(std::move(diff));
+    }
+}
+
+static void CalculateQuorum_5000(benchmark::Bench& bench)
+{
+    const CDeterministicMNList mnList = BuildMNList(5000);
+    FastRandomContext rng(true);
+    std::vector<CDeterministicMNCPtr> members;
+    bench.batch(mnList.GetAllMNsCount()).unit("mn").run([&] {
+        mnList.CalculateQuorum(400, rng.rand256(), members);
+        assert(members.size() == 400);
+    });
+}
+
+static void GetProjectedMNPayees_5000(benchmark::Bench& bench)
+{
+    const CDeterministicMNList mnList = BuildMNList(5000);
+    std::vector<CDeterministicMNCPtr> payees;
+    bench.batch(mnList.GetAllMNsCount()).unit("mn").run([&] {
+        mnList.GetProjectedMNPayees(20, payees);
+        assert(payees.size() == 20);
+    });
+}
+
+static void GetMNPayee_5000(benchmark::Bench& bench)
+{
+    std::vector<CDeterministicMNList> lists;
+    std::vector<CDeterministicMNListDiff> diffs;
+    BuildPaymentChain(BuildMNList(5000), 576, lists, diffs);
+    bench.batch(lists.size()).unit("block").run([&] {
+        for (const auto& mnList : lists) {
+            assert(mnList.GetMNPayee() != nullptr);
+        }
+    });
+}
+
+static void PayeeSchedule_5000(benchmark::Bench& bench)
+{
+    const auto testing_setup = MakeNoLogFileContext<const TestingSetup>();
+    std::vector<CDeterministicMNList> lists;
+    std::vector<CDeterministicMNListDiff> diffs;
+    BuildPaymentChain(BuildMNList(5000), 576, lists, diffs);
+    // the chain is stored like connected blocks store it, a snapshot of the first list and the diffs of the others
+    FastRandomContext rng(true);
+    std::vector<uint256> blockHashes;
+    std::vector<CBlockIndex> blockIndexes(lists.size());
+    for (size_t i = 0; i < lists.size(); i++) {
+        blockHashes.emplace_back(rng.rand256());
+    }
+    for (size_t i = 0; i < lists.size(); i++) {
+        blockIndexes[i].phashBlock = &blockHashes[i];
+        blockIndexes[i].nHeight = i + 1;
+        blockIndexes[i].pprev = i > 0 ? &blockIndexes[i - 1] : nullptr;
+        if (i == 0) {
+            lists[0].SetBlockHash(blockHashes[0]);
+            evoDb->Write(std::make_pair(std::string("dmn_S"), blockHashes[0]), lists[0]);
+        } else {
+            evoDb->Write(std::make_pair(std::string("dmn_D"), blockHashes[i]), diffs[i - 1]);
+        }
+    }
+    // same payees as GetMNPayee_5000, each block becomes the tip before its payee is asked for like a template would,
+    // so the list lookup replays a single diff and the schedule is moved forward by it
+    bench.minEpochIterations(100).batch(lists.size()).unit("block").run([&] {
+        for (const auto& blockIndex : blockIndexes) {
+            deterministicMNManager->UpdatedBlockTip(&blockIndex);
+            assert(deterministicMNManager->GetMNPayee(&blockIndex) != nullptr);
+        }
+    });
+}
+
+static void ForEachMN_5000(benchmark::Bench& bench)
+{
+    const CDeterministicMNList mnList = BuildMNList(5000);
+    int64_t nSum{0};
+    bench.batch(mnList.GetAllMNsCount()).unit("mn").run([&] {
+        mnList.ForEachMN(true, [&](const CDeterministicMNCPtr& dmn) {
+            nSum += dmn->pdmnState->nLastPaidHeight;
+        });
+    });
+    ankerl::nanobench::doNotOptimizeAway(nSum);
+}
+
+static void InternMNs_5000(benchmark::Bench& bench)
+{
+    const CDeterministicMNList mnList = BuildMNList(5000);
+    CDataStream ss(SER_DISK, CLIENT_VERSION);
+    ss << mnList;
+    // a list read from disk holds a copy of every masternode until they are shared with the list in memory
+    CDeterministicMNList diskList;
+    CDataStream(ss) >> diskList;
+    const size_t nCopyUsage = diskList.DynamicMemoryUsage();
+    bench.batch(mnList.GetAllMNsCount()).unit("mn").run([&] {
+        CDeterministicMNList internedList;
+        CDataStream(ss) >> internedList;
+        assert(internedList.InternMNs(mnList) == mnList.GetAllMNsCount());
+        assert(internedList.DynamicMemoryUsage() < nCopyUsage);
+    });
+}
+
+BENCHMARK(CalculateQuorum_5000);
+BENCHMARK(GetProjectedMNPayees_5000);
+BENCHMARK(GetMNPayee_5000);
+BENCHMARK(PayeeSchedule_5000);
+BENCHMARK(ForEachMN_5000);
+BENCHMARK(InternMNs_5000);
@@ -0,0 +1,65 @@
+// Copyright (c) 2021 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <ethereum/sha3.h>
+
+#include <vector>
+
+/* Number of bytes to hash per iteration */
+static const uint64_t BUFFER_SIZE = 1000*1000;
+/* A full branch node of a Merkle-Patricia trie is 532 bytes */
+static const size_t TRIE_NODE_SIZE = 532;
+static const size_t NUM_TRIE_NODES = 64;
+
+static void Keccak256_1M(benchmark::Bench& bench)
+{
+    std::vector<uint8_t> in(BUFFER_SIZE, 0);
+    dev::h256 hash;
+    bench.batch(in.size()).unit("byte").run([&] {
+        dev::sha3(dev::bytesConstRef(in.data(), in.size()), hash.ref());
+    });
+}
+
+static void Keccak256_32b(benchmark::Bench& bench)
+{
+    dev::h256 hash;
+    bench.batch(hash.size).unit("byte").run([&] {
+        hash = dev::sha3(hash);
+    });
+}
+
+static void Keccak256TrieNodes(benchmark::Bench& bench, bool fBatch)
+{
+    const std::vector<uint8_t> in(TRIE_NODE_SIZE * NUM_TRIE_NODES, 0xa3);
+    std::vector<dev::bytesConstRef> inputs;
+    for (size_t i = 0; i < NUM_TRIE_NODES; i++) {
+        inputs.emplace_back(in.data() + i * TRIE_NODE_SIZE, TRIE_NODE_SIZE);
+    }
+    std::vector<dev::h256> hashes(NUM_TRIE_NODES);
+    bench.batch(NUM_TRIE_NODES).unit("node").run([&] {
+        if (fBatch) {
+            dev::sha3(inputs.data(), inputs.size(), hashes.data());
+        } else {
+            for (size_t i = 0; i < NUM_TRIE_NODES; i++) {
+                hashes[i] = dev::sha3(inputs[i]);
+            }
+        }
+    });
+}
+
+static void Keccak256TrieNodesSerial(benchmark::Bench& bench)
+{
+    Keccak256TrieNodes(bench, false);
+}
+
+static void Keccak256TrieNodesBatch(benchmark::Bench& bench)
+{
+    Keccak256TrieNodes(bench, true);
+}
+
+BENCHMARK(Keccak256_1M);
+BENCHMARK(Keccak256_32b);
+BENCHMARK(Keccak256TrieNodesSerial);
+BENCHMARK(Keccak256TrieNodesBatch);
@@ -0,0 +1,86 @@
+// Copyright (c) 2021 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+
+#include <llmq/quorums_signing_shares.h>
+#include <random.h>
+#include <sync.h>
+#include <uint256.h>
+
+#include <array>
+#include <thread>
+#include <vector>
+
+// Many signing sessions handled at once: some threads add the sig shares of their sessions like the network thread
+// does, while another thread walks through all shards like the worker thread does when collecting shares to send
+template<size_t SHARD_COUNT>
+static void SigSharesParallelSessions(benchmark::Bench& bench)
+{
+    const int nThreads = 4;
+    const int nSessionsPerThread = 100;
+    const int nMembers = 50;
+
+    std::array<llmq::CSigSharesShard, SHARD_COUNT> shards;
+    llmq::CSigSharesLockStats lockStats;
+
+    std::vector<uint256> signHashes(nThreads * nSessionsPerThread);
+    for (auto& signHash : signHashes) {
+        signHash = GetRandHash();
+    }
+    llmq::CSigShare sigShare;
+
+    bench.run([&] {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < nThreads; t++) {
+            threads.emplace_back([&, t] {
+                for (int m = 0; m < nMembers; m++) {
+                    for (int i = 0; i < nSessionsPerThread; i++) {
+                        const uint256& signHash = signHashes[t * nSessionsPerThread + i];
+                        auto& shard = shards[signHash.GetUint64(0) % SHARD_COUNT];
+                        llmq::CSigSharesCountedLock<RecursiveMutex> lock(shard.cs, lockStats, "shard.cs", __FILE__, __LINE__);
+                        llmq::SigShareKey k(signHash, (uint16_t)m);
+                        if (!shard.sigShares.Has(k)) {
+                            shard.sigShares.Add(k, sigShare);
+                            shard.timeSeenForSessions[signHash] = m;
+                        }
+                        shard.sigShares.CountForSignHash(signHash);
+                    }
+                }
+            });
+        }
+        threads.emplace_back([&] {
+            size_t nCount = 0;
+            for (int m = 0; m < nMembers; m++) {
+                for (auto& shard : shards) {
+                    llmq::CSigSharesCountedLock<RecursiveMutex> lock(shard.cs, lockStats, "shard.cs", __FILE__, __LINE__);
+                    shard.sigShares.ForEach([&](const llmq::SigShareKey& k, const llmq::CSigShare& sigShare) {
+                        nCount++;
+                    });
+                }
+            }
+        });
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        for (auto& shard : shards) {
+            LOCK(shard.cs);
+            shard.sigShares.Clear();
+            shard.timeSeenForSessions.clear();
+        }
+    });
+}
+
+static void SigSharesParallelSessions_SingleLock(benchmark::Bench& bench)
+{
+    SigSharesParallelSessions<1>(bench);
+}
+
+static void SigSharesParallelSessions_Sharded(benchmark::Bench& bench)
+{
+    SigSharesParallelSessions<llmq::CSigSharesManager::SHARD_COUNT>(bench);
+}
+
+BENCHMARK(SigSharesParallelSessions_SingleLock)
+BENCHMARK(SigSharesParallelSessions_Sharded)
@@ -0,0 +1,109 @@
+// Copyright (c) 2021 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <checkqueue.h>
+#include <consensus/validation.h>
+#include <key.h>
+#include <messagesigner.h>
+#include <random.h>
+#include <script/standard.h>
+#include <services/assetconsensus.h>
+#include <test/util/setup_common.h>
+#include <util/system.h>
+
+#include <vector>
+
+// roughly a 2MB block worth of notarized allocation sends
+static const size_t NUM_ALLOCATION_TXS = 6000;
+static const uint32_t BENCH_ASSET_GUID = 1234567;
+
+static std::vector<CTransactionRef> CreateNotarizedAllocationSends(const CKey& notaryKey)
+{
+    FastRandomContext insecure_rand(true);
+    std::vector<CTransactionRef> vtx;
+    vtx.reserve(NUM_ALLOCATION_TXS);
+    for (size_t i = 0; i < NUM_ALLOCATION_TXS; i++) {
+        CKey key;
+        key.MakeNewKey(true);
+        CMutableTransaction mtx;
+        mtx.nVersion = SYSCOIN_TX_VERSION_ALLOCATION_SEND;
+        mtx.vin.emplace_back(COutPoint(insecure_rand.rand256(), 0));
+        mtx.vout.emplace_back(0, GetScriptForDestination(WitnessV0KeyHash(key.GetPubKey())));
+        mtx.vout[0].assetInfo = CAssetCoinInfo(BENCH_ASSET_GUID, 100 + i);
+        mtx.vout.emplace_back(0, CScript() << OP_RETURN << std::vector<unsigned char>(64, 0));
+        mtx.voutAssets.emplace_back(BENCH_ASSET_GUID, std::vector<CAssetOutValue>{CAssetOutValue(0, 100 + i)});
+        std::vector<unsigned char> vchSig;
+        CHashSigner::SignHash(GetNotarySigHash(CTransaction(mtx), mtx.voutAssets[0]), notaryKey, vchSig);
+        mtx.voutAssets[0].vchNotarySig = vchSig;
+        vtx.push_back(MakeTransactionRef(std::move(mtx)));
+    }
+    return vtx;
+}
+
+static void SyscoinChecks(benchmark::Bench& bench, bool fParallel)
+{
+    // We shouldn't ever be running with the checkqueue on a single core machine.
+    if (fParallel && GetNumCores() <= 1) return;
+    const auto testing_setup = MakeNoLogFileContext<const BasicTestingSetup>();
+    passetdb.reset(new CAssetDB(1 << 20, true, true));
+
+    CKey notaryKey;
+    notaryKey.MakeNewKey(true);
+    const CKeyID notaryKeyID = notaryKey.GetPubKey().GetID();
+    AssetMap mapAssets;
+    CAsset asset;
+    asset.nPrecision = 8;
+    asset.vchNotaryKeyID = std::vector<unsigned char>(notaryKeyID.begin(), notaryKeyID.end());
+    asset.nUpdateMask = ASSET_INIT | ASSET_UPDATE_NOTARY_KEY;
+    mapAssets.try_emplace(BENCH_ASSET_GUID, std::move(asset));
+    assert(passetdb->Flush(mapAssets));
+
+    const std::vector<CTransactionRef> vtx = CreateNotarizedAllocationSends(notaryKey);
+    std::vector<CAssetsMap> vAssetOut(vtx.size());
+    for (size_t i = 0; i < vtx.size(); i++) {
+        std::string err;
+        assert(vtx[i]->GetAssetValueOut(vAssetOut[i], err));
+    }
+
+    CCheckQueue<CSyscoinCheck> queue{8};
+    if (fParallel) {
+        // The main thread should be counted to prevent thread oversubscription
+        queue.StartWorkerThreads(GetNumCores() - 1);
+    }
+    std::vector<TxValidationState> vStates(vtx.size());
+    bench.minEpochIterations(1).batch(vtx.size()).unit("tx").run([&] {
+        CCheckQueueControl<CSyscoinCheck> control(fParallel ? &queue : nullptr);
+        for (size_t i = 0; i < vtx.size(); i++) {
+            CAssetsMap mapAssetIn = vAssetOut[i];
+            CAssetsMap mapAssetOut = vAssetOut[i];
+            CSyscoinCheck check(*vtx[i], vtx[i]->GetHash(), 1, 0, uint256(), false, true, std::move(mapAssetIn), std::move(mapAssetOut), &vStates[i]);
+            if (fParallel) {
+                std::vector<CSyscoinCheck> vChecks(1);
+                check.swap(vChecks.back());
+                control.Add(vChecks);
+            } else {
+                assert(check());
+            }
+        }
+        assert(control.Wait());
+    });
+    if (fParallel) {
+        queue.StopWorkerThreads();
+    }
+    passetdb.reset();
+}
+
+static void SyscoinChecksSerial(benchmark::Bench& bench)
+{
+    SyscoinChecks(bench, false);
+}
+
+static void SyscoinChecksParallel(benchmark::Bench& bench)
+{
+    SyscoinChecks(bench, true);
+}
+
+BENCHMARK(SyscoinChecksSerial);
+BENCHMARK(SyscoinChecksParallel);
@@ -65,13 +65,12 @@ void CBLSWorker::Start()
 {
     int workerCount = GetNumCores() / 2;
     workerCount = std::max(std::min(1, workerCount), 4);
-    workerPool.resize(workerCount);
+    workerPool.Start(workerCount);
 }
 
 void CBLSWorker::Stop()
 {
-    workerPool.clear_queue();
-    workerPool.stop(true);
+    workerPool.Stop();
 }
 
 bool CBLSWorker::GenerateContributions(size_t quorumThreshold, const BLSIdVector& ids, BLSVerificationVectorPtr& vvecRet, BLSSecretKeyVector& skSharesRet)
@@ -136,7 +135,7 @@ struct Aggregator {
     std::shared_ptr<std::vector<const T*> > inputVec;
 
     bool parallel;
-    ctpl::thread_pool& workerPool;
+    CBLSWorkerPool& workerPool;
     RecursiveMutex &sigAggregateMutex;
     RecursiveMutex m;
     // items in the queue are all intermediate aggregation results of finished batches.
@@ -155,7 +154,7 @@ struct Aggregator {
     Aggregator(const std::vector<TP>& _inputVec,
                size_t start, size_t count,
                bool _parallel,
-               ctpl::thread_pool& _workerPool, RecursiveMutex &_sigAggregateMutex,
+               CBLSWorkerPool& _workerPool, RecursiveMutex &_sigAggregateMutex,
                DoneCallback _doneCallback) :
             parallel(_parallel),
             workerPool(_workerPool),
@@ -351,7 +350,7 @@ struct VectorAggregator {
     size_t start;
     size_t count;
     bool parallel;
-    ctpl::thread_pool& workerPool;
+    CBLSWorkerPool& workerPool;
     RecursiveMutex &sigAggregateMutex;
     std::atomic<size_t> doneCount;
 
@@ -360,7 +359,7 @@ struct VectorAggregator {
 
     VectorAggregator(const VectorVectorType& _vecs,
                      size_t _start, size_t _count,
-                     bool _parallel, ctpl::thread_pool& _workerPool, RecursiveMutex &_sigAggregateMutex,
+                     bool _parallel, CBLSWorkerPool& _workerPool, RecursiveMutex &_sigAggregateMutex,
                      DoneCallback _doneCallback) :
             doneCallback(std::move(_doneCallback)),
             vecs(_vecs),
@@ -433,7 +432,7 @@ struct ContributionVerifier {
     bool parallel;
     bool aggregated;
 
-    ctpl::thread_pool& workerPool;
+    CBLSWorkerPool& workerPool;
     RecursiveMutex &sigAggregateMutex;
     size_t batchCount;
     size_t verifyCount;
@@ -444,7 +443,7 @@ struct ContributionVerifier {
 
     ContributionVerifier(CBLSId _forId, const std::vector<BLSVerificationVectorPtr>& _vvecs,
                          const BLSSecretKeyVector& _skShares, size_t _batchSize,
-                         bool _parallel, bool _aggregated, ctpl::thread_pool& _workerPool, RecursiveMutex& _sigAggregateMutex,
+                         bool _parallel, bool _aggregated, CBLSWorkerPool& _workerPool, RecursiveMutex& _sigAggregateMutex,
                          std::function<void(const std::vector<bool>&)> _doneCallback) :
         forId(std::move(_forId)),
         vvecs(_vvecs),
@@ -646,7 +645,7 @@ BLSVerificationVectorPtr CBLSWorker::BuildQuorumVerificationVector(const std::ve
 }
 
 template <typename T>
-void AsyncAggregateHelper(ctpl::thread_pool& workerPool,
+void AsyncAggregateHelper(CBLSWorkerPool& workerPool,
                           const std::vector<T>& vec, size_t start, size_t count, bool parallel, RecursiveMutex& sigAggregateMutex,
                           std::function<void(const T&)> doneCallback)
 {
@@ -848,7 +847,7 @@ void CBLSWorker::AsyncSign(const CBLSSecretKey& secKey, const uint256& msgHash,
 {
     workerPool.push([secKey, msgHash, doneCallback](int threadId) {
         doneCallback(secKey.Sign(msgHash));
-    });
+    }, CBLSWorkerPool::Priority::HIGH);
 }
 
 std::future<CBLSSignature> CBLSWorker::AsyncSign(const CBLSSecretKey& secKey, const uint256& msgHash)
@@ -970,5 +969,5 @@ void CBLSWorker::PushSigVerifyBatch()
     sigVerifyQueue.reserve(SIG_VERIFY_BATCH_SIZE);
 
     sigVerifyBatchesInProgress++;
-    workerPool.push(f, batch);
+    workerPool.push([f, batch](int threadId) { f(threadId, batch); }, CBLSWorkerPool::Priority::HIGH);
 }
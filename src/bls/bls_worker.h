@@ -6,8 +6,7 @@
 #define SYSCOIN_BLS_BLS_WORKER_H
 
 #include <bls/bls.h>
-
-#include <ctpl.h>
+#include <bls/bls_workerpool.h>
 
 #include <future>
 #include <mutex>
@@ -25,7 +24,7 @@ public:
     typedef std::function<bool()> CancelCond;
 
 private:
-    ctpl::thread_pool workerPool;
+    CBLSWorkerPool workerPool;
     RecursiveMutex sigAggregateMutex;
     static const int SIG_VERIFY_BATCH_SIZE = 8;
     struct SigVerifyJob {
@@ -0,0 +1,184 @@
+// Copyright (c) 2021 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef SYSCOIN_BLS_BLS_WORKERPOOL_H
+#define SYSCOIN_BLS_BLS_WORKERPOOL_H
+
+#include <concurrentqueue.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work stealing thread pool for the BLS worker
+// Every worker has its own queue, so the many tiny tasks of the DKG don't contend on a single lock. Tasks pushed by a
+// worker go to its own queue, which it processes newest first, while idle workers steal the oldest tasks of the other
+// queues. High priority tasks (signing and signature verification) go to a shared lock free queue which workers
+// always look at first, so they don't wait behind long batches of contribution verification.
+class CBLSWorkerPool
+{
+public:
+    enum class Priority {
+        HIGH,
+        NORMAL,
+    };
+
+private:
+    typedef std::function<void(int)> Task;
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::thread> threads;
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    moodycamel::ConcurrentQueue<Task> highQueue;
+
+    // the queue tasks of other threads are pushed to, round robin
+    std::atomic<size_t> nNextQueue{0};
+    // tasks pushed and not taken by a worker yet
+    std::atomic<size_t> nPending{0};
+    std::atomic<size_t> nWaiting{0};
+    std::atomic<bool> fStop{false};
+
+    std::mutex mutexWait;
+    std::condition_variable cvWait;
+
+    static inline thread_local const CBLSWorkerPool* currentPool{nullptr};
+    static inline thread_local size_t currentIndex{0};
+
+public:
+    CBLSWorkerPool() = default;
+    ~CBLSWorkerPool() { Stop(); }
+
+    CBLSWorkerPool(const CBLSWorkerPool&) = delete;
+    CBLSWorkerPool& operator=(const CBLSWorkerPool&) = delete;
+
+    void Start(size_t nThreads)
+    {
+        if (!threads.empty()) {
+            return;
+        }
+        fStop = false;
+        // the queues are only created here, push() reads them without locking
+        queues.resize(std::max<size_t>(nThreads, 1));
+        for (auto& queue : queues) {
+            if (!queue) {
+                queue = std::make_unique<WorkerQueue>();
+            }
+        }
+        for (size_t i = 0; i < nThreads; i++) {
+            threads.emplace_back([this, i] { WorkerLoop(i); });
+        }
+    }
+
+    // Stop the workers, tasks which didn't start yet are dropped
+    void Stop()
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutexWait);
+            fStop = true;
+            cvWait.notify_all();
+        }
+        for (auto& thread : threads) {
+            if (thread.joinable()) {
+                thread.join();
+            }
+        }
+        threads.clear();
+        Task task;
+        while (highQueue.try_dequeue(task)) {}
+        for (auto& queue : queues) {
+            std::unique_lock<std::mutex> lock(queue->mutex);
+            queue->tasks.clear();
+        }
+        nPending = 0;
+    }
+
+    size_t Size() const { return threads.size(); }
+
+    template<typename F>
+    auto push(F&& f, Priority priority = Priority::NORMAL) -> std::future<decltype(f(0))>
+    {
+        auto pck = std::make_shared<std::packaged_task<decltype(f(0))(int)>>(std::forward<F>(f));
+        auto future = pck->get_future();
+        Task task([pck](int threadId) { (*pck)(threadId); });
+
+        // counted before the task can be taken, a worker decrements right after taking it
+        nPending++;
+        if (priority == Priority::HIGH || queues.empty()) {
+            // there are no worker queues before the first Start(), such tasks wait in the shared queue
+            highQueue.enqueue(std::move(task));
+        } else {
+            const size_t i = currentPool == this ? currentIndex : nNextQueue++ % queues.size();
+            std::unique_lock<std::mutex> lock(queues[i]->mutex);
+            queues[i]->tasks.emplace_back(std::move(task));
+        }
+        if (nWaiting > 0) {
+            std::unique_lock<std::mutex> lock(mutexWait);
+            cvWait.notify_one();
+        }
+        return future;
+    }
+
+private:
+    bool TryPop(size_t i, bool fBlockingSteal, Task& task)
+    {
+        if (highQueue.try_dequeue(task)) {
+            return true;
+        }
+        {
+            std::unique_lock<std::mutex> lock(queues[i]->mutex);
+            if (!queues[i]->tasks.empty()) {
+                task = std::move(queues[i]->tasks.back());
+                queues[i]->tasks.pop_back();
+                return true;
+            }
+        }
+        for (size_t n = 1; n < queues.size(); n++) {
+            WorkerQueue& victim = *queues[(i + n) % queues.size()];
+            std::unique_lock<std::mutex> lock(victim.mutex, std::defer_lock);
+            if (fBlockingSteal) {
+                lock.lock();
+            } else if (!lock.try_lock()) {
+                continue;
+            }
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void WorkerLoop(size_t i)
+    {
+        currentPool = this;
+        currentIndex = i;
+        while (!fStop) {
+            Task task;
+            // only wait for the busy queues when a task was missed without waiting
+            if (TryPop(i, false, task) || TryPop(i, true, task)) {
+                nPending--;
+                task(i);
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(mutexWait);
+            nWaiting++;
+            cvWait.wait(lock, [this] { return nPending > 0 || fStop; });
+            nWaiting--;
+        }
+        currentPool = nullptr;
+    }
+};
+
+#endif // SYSCOIN_BLS_BLS_WORKERPOOL_H
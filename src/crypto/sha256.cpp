@@ -22,11 +22,15 @@ void Transform(uint32_t* s, const unsigned char* chunk, size_t blocks);
 namespace sha256d64_sse41
 {
 void Transform_4way(unsigned char* out, const unsigned char* in);
+// SYSCOIN
+void TransformS64_4way(unsigned char* out, const unsigned char* in);
 }
 
 namespace sha256d64_avx2
 {
 void Transform_8way(unsigned char* out, const unsigned char* in);
+// SYSCOIN
+void TransformS64_8way(unsigned char* out, const unsigned char* in);
 }
 
 namespace sha256d64_shani
@@ -461,6 +465,9 @@ TransformD64Type TransformD64 = sha256::TransformD64;
 TransformD64Type TransformD64_2way = nullptr;
 TransformD64Type TransformD64_4way = nullptr;
 TransformD64Type TransformD64_8way = nullptr;
+// SYSCOIN multi-way single SHA256 of 64 byte inputs
+TransformD64Type TransformS64_4way = nullptr;
+TransformD64Type TransformS64_8way = nullptr;
 
 bool SelfTest() {
     // Input state (equal to the initial SHA256 state)
@@ -544,6 +551,22 @@ bool SelfTest() {
         if (!std::equal(out, out + 256, result_d64)) return false;
     }
 
+    // SYSCOIN Test TransformS64_4way and TransformS64_8way against the 1 way implementation, if available.
+    unsigned char result_s64[256];
+    for (size_t i = 0; i < 8; ++i) {
+        CSHA256().Write(data + 1 + 64 * i, 64).Finalize(result_s64 + 32 * i);
+    }
+    if (TransformS64_4way) {
+        unsigned char out[128];
+        TransformS64_4way(out, data + 1);
+        if (!std::equal(out, out + 128, result_s64)) return false;
+    }
+    if (TransformS64_8way) {
+        unsigned char out[256];
+        TransformS64_8way(out, data + 1);
+        if (!std::equal(out, out + 256, result_s64)) return false;
+    }
+
     return true;
 }
 
@@ -611,6 +634,8 @@ std::string SHA256AutoDetect()
 #endif
 #if defined(ENABLE_SSE41) && !defined(BUILD_SYSCOIN_INTERNAL)
         TransformD64_4way = sha256d64_sse41::Transform_4way;
+        // SYSCOIN
+        TransformS64_4way = sha256d64_sse41::TransformS64_4way;
         ret += ",sse41(4way)";
 #endif
     }
@@ -618,6 +643,8 @@ std::string SHA256AutoDetect()
 #if defined(ENABLE_AVX2) && !defined(BUILD_SYSCOIN_INTERNAL)
     if (have_avx2 && have_avx && enabled_avx) {
         TransformD64_8way = sha256d64_avx2::Transform_8way;
+        // SYSCOIN
+        TransformS64_8way = sha256d64_avx2::TransformS64_8way;
         ret += ",avx2(8way)";
     }
 #endif
@@ -717,3 +744,30 @@ void SHA256D64(unsigned char* out, const unsigned char* in, size_t blocks)
         --blocks;
     }
 }
+
+// SYSCOIN
+void SHA256S64(unsigned char* out, const unsigned char* in, size_t blocks)
+{
+    if (TransformS64_8way) {
+        while (blocks >= 8) {
+            TransformS64_8way(out, in);
+            out += 256;
+            in += 512;
+            blocks -= 8;
+        }
+    }
+    if (TransformS64_4way) {
+        while (blocks >= 4) {
+            TransformS64_4way(out, in);
+            out += 128;
+            in += 256;
+            blocks -= 4;
+        }
+    }
+    while (blocks) {
+        CSHA256().Write(in, 64).Finalize(out);
+        out += 32;
+        in += 64;
+        --blocks;
+    }
+}
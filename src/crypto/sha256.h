@@ -38,4 +38,12 @@ std::string SHA256AutoDetect();
  */
 void SHA256D64(unsigned char* output, const unsigned char* input, size_t blocks);
 
+// SYSCOIN
+/** Compute multiple single SHA256's of 64-byte blobs, using the multi-way implementations when available.
+ *  output:  pointer to a blocks*32 byte output buffer
+ *  input:   pointer to a blocks*64 byte input buffer
+ *  blocks:  the number of hashes to compute.
+ */
+void SHA256S64(unsigned char* output, const unsigned char* input, size_t blocks);
+
 #endif // SYSCOIN_CRYPTO_SHA256_H
@@ -72,7 +72,9 @@ void inline Write8(unsigned char* out, int offset, __m256i v) {
 
 }
 
-void Transform_8way(unsigned char* out, const unsigned char* in)
+// SYSCOIN computes the single SHA256 of the 64 byte inputs if fDouble is false
+template<bool fDouble>
+void TransformImpl_8way(unsigned char* out, const unsigned char* in)
 {
     // Transform 1
     __m256i a = K(0x6a09e667ul);
@@ -237,6 +239,19 @@ void Transform_8way(unsigned char* out, const unsigned char* in)
     w6 = Add(t6, g);
     w7 = Add(t7, h);
 
+    // SYSCOIN
+    if (!fDouble) {
+        Write8(out, 0, w0);
+        Write8(out, 4, w1);
+        Write8(out, 8, w2);
+        Write8(out, 12, w3);
+        Write8(out, 16, w4);
+        Write8(out, 20, w5);
+        Write8(out, 24, w6);
+        Write8(out, 28, w7);
+        return;
+    }
+
     // Transform 3
     a = K(0x6a09e667ul);
     b = K(0xbb67ae85ul);
@@ -323,6 +338,17 @@ void Transform_8way(unsigned char* out, const unsigned char* in)
     Write8(out, 28, Add(h, K(0x5be0cd19ul)));
 }
 
+// SYSCOIN
+void Transform_8way(unsigned char* out, const unsigned char* in)
+{
+    TransformImpl_8way<true>(out, in);
+}
+
+void TransformS64_8way(unsigned char* out, const unsigned char* in)
+{
+    TransformImpl_8way<false>(out, in);
+}
+
 }
 
 #endif
@@ -64,7 +64,9 @@ void inline Write4(unsigned char* out, int offset, __m128i v) {
 
 }
 
-void Transform_4way(unsigned char* out, const unsigned char* in)
+// SYSCOIN computes the single SHA256 of the 64 byte inputs if fDouble is false
+template<bool fDouble>
+void TransformImpl_4way(unsigned char* out, const unsigned char* in)
 {
     // Transform 1
     __m128i a = K(0x6a09e667ul);
@@ -229,6 +231,19 @@ void Transform_4way(unsigned char* out, const unsigned char* in)
     w6 = Add(t6, g);
     w7 = Add(t7, h);
 
+    // SYSCOIN
+    if (!fDouble) {
+        Write4(out, 0, w0);
+        Write4(out, 4, w1);
+        Write4(out, 8, w2);
+        Write4(out, 12, w3);
+        Write4(out, 16, w4);
+        Write4(out, 20, w5);
+        Write4(out, 24, w6);
+        Write4(out, 28, w7);
+        return;
+    }
+
     // Transform 3
     a = K(0x6a09e667ul);
     b = K(0xbb67ae85ul);
@@ -315,6 +330,17 @@ void Transform_4way(unsigned char* out, const unsigned char* in)
     Write4(out, 28, Add(h, K(0x5be0cd19ul)));
 }
 
+// SYSCOIN
+void Transform_4way(unsigned char* out, const unsigned char* in)
+{
+    TransformImpl_4way<true>(out, in);
+}
+
+void TransformS64_4way(unsigned char* out, const unsigned char* in)
+{
+    TransformImpl_4way<false>(out, in);
+}
+
 }
 
 #endif
@@ -4,6 +4,7 @@
 #include <uint256.h>
 #include <arith_uint256.h>
 #include <ethereum/ethereum.h>
+#include <ethereum/rlpreader.h>
 #include <ethereum/sha3.h>
 #include <logging.h>
 #include <util/strencodings.h>
@@ -115,6 +116,96 @@ bool VerifyProof(dev::bytesConstRef path, const dev::RLP& value, const dev::RLP&
   return false;
 }
 
+static inline uint8_t GetNibble(Span<const unsigned char> data, size_t nPos) {
+  return (nPos & 1) ? (data[nPos >> 1] & 0x0f) : (data[nPos >> 1] >> 4);
+}
+// same as nibblesToTraverse() but works on the payload bytes of the encoded path directly instead of their hex string
+static int NibblesToTraverse(Span<const unsigned char> encodedPartialPath, Span<const unsigned char> path, size_t pathPtr) {
+  if(encodedPartialPath.empty())
+    return -1;
+  const uint8_t prefix = GetNibble(encodedPartialPath, 0);
+  // nibblesToTraverse() parses the prefix as a decimal digit
+  if(prefix > 9)
+    return -1;
+  const size_t skip = (prefix == 0 || prefix == 2)? 2: 1;
+  const size_t partialPathSize = encodedPartialPath.size()*2 - skip;
+  if(pathPtr + partialPathSize > path.size()*2)
+    return -1;
+  for(size_t i = 0; i < partialPathSize; i++) {
+    if(GetNibble(encodedPartialPath, skip + i) != GetNibble(path, pathPtr + i))
+      return -1;
+  }
+  return partialPathSize;
+}
+bool VerifyProof(Span<const unsigned char> path, Span<const unsigned char> value, Span<const unsigned char> parentNodes, Span<const unsigned char> root) {
+    dev::RLPItem rlpParentNodes, nodeKey, currentNode, item;
+    if(!dev::RLPDecodeExact(parentNodes, rlpParentNodes) || !dev::RLPDecodeExact(root, nodeKey))
+      return false;
+    size_t len, itemCount;
+    if(!dev::RLPItemCount(rlpParentNodes, len))
+      return false;
+    const size_t pathSize = path.size()*2;
+    size_t pathPtr = 0;
+    Span<const unsigned char> remaining = rlpParentNodes.payload;
+    // nodes are hashed a batch at a time so the multi-buffer Keccak can be used
+    dev::RLPItem batchNodes[4];
+    dev::bytesConstRef batchInputs[4];
+    dev::h256 batchHashes[4];
+    for (size_t i = 0 ; i < len ; i++) {
+      if(i % 4 == 0) {
+        const size_t batchSize = std::min<size_t>(4, len - i);
+        for (size_t j = 0; j < batchSize; j++) {
+          // all items were validated by RLPItemCount()
+          dev::RLPDecodeItem(remaining, batchNodes[j]);
+          remaining = remaining.subspan(batchNodes[j].data.size());
+          batchInputs[j] = dev::bytesConstRef(batchNodes[j].data.data(), batchNodes[j].data.size());
+        }
+        dev::sha3(batchInputs, batchSize, batchHashes);
+      }
+      currentNode = batchNodes[i % 4];
+      const dev::h256 &nodeHash = batchHashes[i % 4];
+      if(nodeKey.payload.size() != nodeHash.size || memcmp(nodeKey.payload.data(), nodeHash.data(), nodeHash.size) != 0){
+        return false;
+      }
+
+      if(pathPtr > pathSize){
+        return false;
+      }
+      if(!dev::RLPItemCount(currentNode, itemCount))
+        return false;
+
+      switch(itemCount){
+        case 17://branch node
+          if(pathPtr == pathSize){
+            return dev::RLPListItem(currentNode, 16, item) && item.payload == value;
+          }
+          if(!dev::RLPListItem(currentNode, GetNibble(path, pathPtr), nodeKey))
+            return false;
+          pathPtr += 1;
+          break;
+        case 2: {
+          if(!dev::RLPListItem(currentNode, 0, item))
+            return false;
+          const int nibbles = NibblesToTraverse(item.payload, path, pathPtr);
+          if(nibbles <= -1)
+            return false;
+          pathPtr += nibbles;
+          if(!dev::RLPListItem(currentNode, 1, item))
+            return false;
+          if(pathPtr == pathSize) { //leaf node
+            return item.payload == value;
+          } else {//extension node
+            nodeKey = item;
+          }
+          break;
+        }
+        default:
+          return false;
+      }
+    }
+    return false;
+}
+
 /**
  * Parse eth input string expected to contain smart contract method call data. If the method call is not what we
  * expected, or the length of the expected string is not what we expect then return false.
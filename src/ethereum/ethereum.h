@@ -9,6 +9,9 @@
 #include <ethereum/commondata.h>
 #include <ethereum/rlp.h>
 #include <amount.h>
+#include <span.h>
 bool VerifyProof(dev::bytesConstRef path, const dev::RLP& value, const dev::RLP& parentNodes, const dev::RLP& root); 
+/** Same as VerifyProof() above but walks the proof in place without copying, path is the raw key and value the encoded value expected at it */
+bool VerifyProof(Span<const unsigned char> path, Span<const unsigned char> value, Span<const unsigned char> parentNodes, Span<const unsigned char> root);
 bool parseEthMethodInputData(const std::vector<unsigned char>& vchInputExpectedMethodHash,  const uint8_t& nERC20Precision, const uint8_t& nLocalPrecision, const std::vector<unsigned char>& vchInputData, CAmount& outputAmount, uint64_t& nAsset, std::string& witnessAddress);
 #endif // SYSCOIN_ETHEREUM_ETHEREUM_H
@@ -0,0 +1,94 @@
+// Copyright (c) 2021 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <ethereum/rlpreader.h>
+#include <ethereum/rlp.h>
+
+#include <limits>
+
+namespace dev {
+
+bool RLPDecodeItem(Span<const unsigned char> data, RLPItem& item)
+{
+    if (data.empty())
+        return false;
+    const unsigned char n = data[0];
+    size_t nOffset = 1;
+    size_t nLength = 0;
+    if (n < c_rlpDataImmLenStart) {
+        nOffset = 0;
+        nLength = 1;
+    } else if (n <= c_rlpDataIndLenZero) {
+        // a single byte below 0x80 must be encoded as itself
+        if (n == c_rlpDataImmLenStart + 1 && (data.size() < 2 || data[1] < c_rlpDataImmLenStart))
+            return false;
+        nLength = n - c_rlpDataImmLenStart;
+    } else if (n < c_rlpListStart || n > c_rlpListIndLenZero) {
+        const bool fList = n >= c_rlpListStart;
+        const size_t nLengthSize = fList ? n - c_rlpListIndLenZero : n - c_rlpDataIndLenZero;
+        if (data.size() <= nLengthSize || nLengthSize > sizeof(nLength))
+            return false;
+        // no leading zeroes
+        if (data[1] == 0)
+            return false;
+        for (size_t i = 0; i < nLengthSize; ++i)
+            nLength = (nLength << 8) | data[i + 1];
+        // long form is only allowed for lengths that don't fit the short form
+        if (nLength < (size_t)(c_rlpListStart - c_rlpDataImmLenStart - c_rlpMaxLengthBytes))
+            return false;
+        nOffset += nLengthSize;
+    } else {
+        nLength = n - c_rlpListStart;
+    }
+    if (nLength >= std::numeric_limits<size_t>::max() - 0x100)
+        return false;
+    if (nOffset + nLength > data.size())
+        return false;
+    item.data = data.first(nOffset + nLength);
+    item.payload = data.subspan(nOffset, nLength);
+    item.fList = n >= c_rlpListStart;
+    return true;
+}
+
+bool RLPDecodeExact(Span<const unsigned char> data, RLPItem& item)
+{
+    if (data.empty()) {
+        item = RLPItem();
+        return true;
+    }
+    return RLPDecodeItem(data, item) && item.data.size() == data.size();
+}
+
+bool RLPItemCount(const RLPItem& list, size_t& nCount)
+{
+    nCount = 0;
+    if (!list.fList)
+        return true;
+    Span<const unsigned char> remaining = list.payload;
+    RLPItem item;
+    while (!remaining.empty()) {
+        if (!RLPDecodeItem(remaining, item))
+            return false;
+        remaining = remaining.subspan(item.data.size());
+        nCount++;
+    }
+    return true;
+}
+
+bool RLPListItem(const RLPItem& list, size_t nIndex, RLPItem& item)
+{
+    if (!list.fList)
+        return false;
+    Span<const unsigned char> remaining = list.payload;
+    for (size_t i = 0; !remaining.empty(); i++) {
+        if (!RLPDecodeItem(remaining, item))
+            return false;
+        if (i == nIndex)
+            return true;
+        remaining = remaining.subspan(item.data.size());
+    }
+    return false;
+}
+
+} // namespace dev
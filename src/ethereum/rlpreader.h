@@ -0,0 +1,46 @@
+// Copyright (c) 2021 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef SYSCOIN_ETHEREUM_RLPREADER_H
+#define SYSCOIN_ETHEREUM_RLPREADER_H
+
+#include <span.h>
+
+#include <cstddef>
+
+namespace dev {
+
+/**
+ * A decoded RLP item referencing the buffer it was read from. Nothing is copied,
+ * the item is only valid for as long as the underlying buffer is.
+ */
+struct RLPItem {
+    /** The full encoding of the item (header and payload) */
+    Span<const unsigned char> data;
+    /** The payload of the item, for single byte data items this is the byte itself */
+    Span<const unsigned char> payload;
+    bool fList{false};
+
+    bool IsNull() const { return data.empty(); }
+};
+
+/**
+ * Decode the first item of an encoded buffer. The header is checked with the same rules
+ * dev::RLP applies (canonical lengths, no leading zeroes) and the item must fit in
+ * the buffer. Returns false wherever dev::RLP would throw.
+ */
+bool RLPDecodeItem(Span<const unsigned char> data, RLPItem& item);
+
+/** Decode a buffer that must hold exactly one item, like dev::RLP::VeryStrict. An empty buffer decodes to a null item. */
+bool RLPDecodeExact(Span<const unsigned char> data, RLPItem& item);
+
+/** Count the items of a list, validating the header of each one. Data and null items have no items. */
+bool RLPItemCount(const RLPItem& list, size_t& nCount);
+
+/** Get item nIndex of a list, returns false if it is out of range or any item before it is malformed. */
+bool RLPListItem(const RLPItem& list, size_t nIndex, RLPItem& item);
+
+} // namespace dev
+
+#endif // SYSCOIN_ETHEREUM_RLPREADER_H
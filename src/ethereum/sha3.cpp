@@ -20,14 +20,23 @@
  */
 
 #include <ethereum/sha3.h>
+#include <algorithm>
+#include <cassert>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <compat/cpuid.h>
+#include <crypto/common.h>
 #include <ethereum/rlp.h>
 using namespace std;
 using namespace dev;
 
+namespace keccak_avx2
+{
+void KeccakF1600_4way(uint64_t (&st)[25][4]);
+}
+
 namespace dev
 {
 
@@ -37,41 +46,6 @@ h256 EmptyListSHA3 = sha3(rlpList());
 namespace keccak
 {
 
-/** libkeccak-tiny
- *
- * A single-file implementation of SHA-3 and SHAKE.
- *
- * Implementor: David Leon Gil
- * License: CC0, attribution kindly requested. Blame taken too,
- * but not liability.
- */
-
-#define decshake(bits) \
-  int shake##bits(uint8_t*, size_t, const uint8_t*, size_t);
-
-#define decsha3(bits) \
-  int sha3_##bits(uint8_t*, size_t, const uint8_t*, size_t);
-
-decshake(128)
-decshake(256)
-decsha3(224)
-decsha3(256)
-decsha3(384)
-decsha3(512)
-
-/******** The Keccak-f[1600] permutation ********/
-
-/*** Constants. ***/
-static const uint8_t rho[24] = \
-  { 1,  3,   6, 10, 15, 21,
-	28, 36, 45, 55,  2, 14,
-	27, 41, 56,  8, 25, 43,
-	62, 18, 39, 61, 20, 44};
-static const uint8_t pi[24] = \
-  {10,  7, 11, 17, 18, 3,
-	5, 16,  8, 21, 24, 4,
-   15, 23, 19, 13, 12, 2,
-   20, 14, 22,  9, 6,  1};
 static const uint64_t RC[24] = \
   {1ULL, 0x8082ULL, 0x800000000000808aULL, 0x8000000080008000ULL,
    0x808bULL, 0x80000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
@@ -80,144 +54,302 @@ static const uint64_t RC[24] = \
    0x8000000000008002ULL, 0x8000000000000080ULL, 0x800aULL, 0x800000008000000aULL,
    0x8000000080008081ULL, 0x8000000000008080ULL, 0x80000001ULL, 0x8000000080008008ULL};
 
-/*** Helper macros to unroll the permutation. ***/
-#define rol(x, s) (((x) << s) | ((x) >> (64 - s)))
-#define REPEAT6(e) e e e e e e
-#define REPEAT24(e) REPEAT6(e e e e)
-#define REPEAT5(e) e e e e e
-#define FOR5(v, s, e) \
-  v = 0;            \
-  REPEAT5(e; v += s;)
-
-/*** Keccak-f[1600] ***/
-static inline void keccakf(void* state) {
-  uint64_t* a = (uint64_t*)state;
-  uint64_t b[5] = {0};
-  uint64_t t = 0;
-  uint8_t x, y;
-
-  for (int i = 0; i < 24; i++) {
-	// Theta
-	FOR5(x, 1,
-		 b[x] = 0;
-		 FOR5(y, 5,
-			  b[x] ^= a[x + y]; ))
-	FOR5(x, 1,
-		 FOR5(y, 5,
-			  a[y + x] ^= b[(x + 4) % 5] ^ rol(b[(x + 1) % 5], 1); ))
-	// Rho and pi
-	t = a[1];
-	x = 0;
-	REPEAT24(b[0] = a[pi[x]];
-			 a[pi[x]] = rol(t, rho[x]);
-			 t = b[0];
-			 x++; )
-	// Chi
-	FOR5(y,
-	   5,
-	   FOR5(x, 1,
-			b[x] = a[y + x];)
-	   FOR5(x, 1,
-			a[y + x] = b[x] ^ ((~b[(x + 1) % 5]) & b[(x + 2) % 5]); ))
-	// Iota
-	a[0] ^= RC[i];
-  }
+static inline uint64_t rol(uint64_t x, int s) { return (x << s) | (x >> (64 - s)); }
+
+/// Keccak-f[1600] with the lanes held in locals and two rounds per iteration
+static void KeccakF1600(uint64_t (&st)[25])
+{
+	// lanes 1, 2, 8, 12, 17 and 20 are kept complemented which saves most of the NOTs in chi
+	uint64_t Aba = st[0], Abe = ~st[1], Abi = ~st[2], Abo = st[3], Abu = st[4],
+		Aga = st[5], Age = st[6], Agi = st[7], Ago = ~st[8], Agu = st[9],
+		Aka = st[10], Ake = st[11], Aki = ~st[12], Ako = st[13], Aku = st[14],
+		Ama = st[15], Ame = st[16], Ami = ~st[17], Amo = st[18], Amu = st[19],
+		Asa = ~st[20], Ase = st[21], Asi = st[22], Aso = st[23], Asu = st[24];
+	uint64_t Eba, Ebe, Ebi, Ebo, Ebu,
+		Ega, Ege, Egi, Ego, Egu,
+		Eka, Eke, Eki, Eko, Eku,
+		Ema, Eme, Emi, Emo, Emu,
+		Esa, Ese, Esi, Eso, Esu;
+	uint64_t Ba, Be, Bi, Bo, Bu, Da, De, Di, Do, Du;
+	uint64_t Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
+	uint64_t Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
+	uint64_t Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
+	uint64_t Co = Abo ^ Ago ^ Ako ^ Amo ^ Aso;
+	uint64_t Cu = Abu ^ Agu ^ Aku ^ Amu ^ Asu;
+	for (int i = 0; i < 24; i += 2)
+	{
+		Da = Cu ^ rol(Ce, 1); De = Ca ^ rol(Ci, 1); Di = Ce ^ rol(Co, 1); Do = Ci ^ rol(Cu, 1); Du = Co ^ rol(Ca, 1);
+		Aba ^= Da; Ba = Aba;
+		Age ^= De; Be = rol(Age, 44);
+		Aki ^= Di; Bi = rol(Aki, 43);
+		Amo ^= Do; Bo = rol(Amo, 21);
+		Asu ^= Du; Bu = rol(Asu, 14);
+		Eba = Ba ^ (Be | Bi); Eba ^= RC[i]; Ca = Eba;
+		Ebe = Be ^ ((~Bi) | Bo); Ce = Ebe;
+		Ebi = Bi ^ (Bo & Bu); Ci = Ebi;
+		Ebo = Bo ^ (Bu | Ba); Co = Ebo;
+		Ebu = Bu ^ (Ba & Be); Cu = Ebu;
+		Abo ^= Do; Ba = rol(Abo, 28);
+		Agu ^= Du; Be = rol(Agu, 20);
+		Aka ^= Da; Bi = rol(Aka, 3);
+		Ame ^= De; Bo = rol(Ame, 45);
+		Asi ^= Di; Bu = rol(Asi, 61);
+		Ega = Ba ^ (Be | Bi); Ca ^= Ega;
+		Ege = Be ^ (Bi & Bo); Ce ^= Ege;
+		Egi = Bi ^ (Bo | (~Bu)); Ci ^= Egi;
+		Ego = Bo ^ (Bu | Ba); Co ^= Ego;
+		Egu = Bu ^ (Ba & Be); Cu ^= Egu;
+		Abe ^= De; Ba = rol(Abe, 1);
+		Agi ^= Di; Be = rol(Agi, 6);
+		Ako ^= Do; Bi = rol(Ako, 25);
+		Amu ^= Du; Bo = rol(Amu, 8);
+		Asa ^= Da; Bu = rol(Asa, 18);
+		Eka = Ba ^ (Be | Bi); Ca ^= Eka;
+		Eke = Be ^ (Bi & Bo); Ce ^= Eke;
+		Eki = Bi ^ ((~Bo) & Bu); Ci ^= Eki;
+		Eko = (~Bo) ^ (Bu | Ba); Co ^= Eko;
+		Eku = Bu ^ (Ba & Be); Cu ^= Eku;
+		Abu ^= Du; Ba = rol(Abu, 27);
+		Aga ^= Da; Be = rol(Aga, 36);
+		Ake ^= De; Bi = rol(Ake, 10);
+		Ami ^= Di; Bo = rol(Ami, 15);
+		Aso ^= Do; Bu = rol(Aso, 56);
+		Ema = Ba ^ (Be & Bi); Ca ^= Ema;
+		Eme = Be ^ (Bi | Bo); Ce ^= Eme;
+		Emi = Bi ^ ((~Bo) | Bu); Ci ^= Emi;
+		Emo = (~Bo) ^ (Bu & Ba); Co ^= Emo;
+		Emu = Bu ^ (Ba | Be); Cu ^= Emu;
+		Abi ^= Di; Ba = rol(Abi, 62);
+		Ago ^= Do; Be = rol(Ago, 55);
+		Aku ^= Du; Bi = rol(Aku, 39);
+		Ama ^= Da; Bo = rol(Ama, 41);
+		Ase ^= De; Bu = rol(Ase, 2);
+		Esa = Ba ^ ((~Be) & Bi); Ca ^= Esa;
+		Ese = (~Be) ^ (Bi | Bo); Ce ^= Ese;
+		Esi = Bi ^ (Bo & Bu); Ci ^= Esi;
+		Eso = Bo ^ (Bu | Ba); Co ^= Eso;
+		Esu = Bu ^ (Ba & Be); Cu ^= Esu;
+		Da = Cu ^ rol(Ce, 1); De = Ca ^ rol(Ci, 1); Di = Ce ^ rol(Co, 1); Do = Ci ^ rol(Cu, 1); Du = Co ^ rol(Ca, 1);
+		Eba ^= Da; Ba = Eba;
+		Ege ^= De; Be = rol(Ege, 44);
+		Eki ^= Di; Bi = rol(Eki, 43);
+		Emo ^= Do; Bo = rol(Emo, 21);
+		Esu ^= Du; Bu = rol(Esu, 14);
+		Aba = Ba ^ (Be | Bi); Aba ^= RC[i + 1]; Ca = Aba;
+		Abe = Be ^ ((~Bi) | Bo); Ce = Abe;
+		Abi = Bi ^ (Bo & Bu); Ci = Abi;
+		Abo = Bo ^ (Bu | Ba); Co = Abo;
+		Abu = Bu ^ (Ba & Be); Cu = Abu;
+		Ebo ^= Do; Ba = rol(Ebo, 28);
+		Egu ^= Du; Be = rol(Egu, 20);
+		Eka ^= Da; Bi = rol(Eka, 3);
+		Eme ^= De; Bo = rol(Eme, 45);
+		Esi ^= Di; Bu = rol(Esi, 61);
+		Aga = Ba ^ (Be | Bi); Ca ^= Aga;
+		Age = Be ^ (Bi & Bo); Ce ^= Age;
+		Agi = Bi ^ (Bo | (~Bu)); Ci ^= Agi;
+		Ago = Bo ^ (Bu | Ba); Co ^= Ago;
+		Agu = Bu ^ (Ba & Be); Cu ^= Agu;
+		Ebe ^= De; Ba = rol(Ebe, 1);
+		Egi ^= Di; Be = rol(Egi, 6);
+		Eko ^= Do; Bi = rol(Eko, 25);
+		Emu ^= Du; Bo = rol(Emu, 8);
+		Esa ^= Da; Bu = rol(Esa, 18);
+		Aka = Ba ^ (Be | Bi); Ca ^= Aka;
+		Ake = Be ^ (Bi & Bo); Ce ^= Ake;
+		Aki = Bi ^ ((~Bo) & Bu); Ci ^= Aki;
+		Ako = (~Bo) ^ (Bu | Ba); Co ^= Ako;
+		Aku = Bu ^ (Ba & Be); Cu ^= Aku;
+		Ebu ^= Du; Ba = rol(Ebu, 27);
+		Ega ^= Da; Be = rol(Ega, 36);
+		Eke ^= De; Bi = rol(Eke, 10);
+		Emi ^= Di; Bo = rol(Emi, 15);
+		Eso ^= Do; Bu = rol(Eso, 56);
+		Ama = Ba ^ (Be & Bi); Ca ^= Ama;
+		Ame = Be ^ (Bi | Bo); Ce ^= Ame;
+		Ami = Bi ^ ((~Bo) | Bu); Ci ^= Ami;
+		Amo = (~Bo) ^ (Bu & Ba); Co ^= Amo;
+		Amu = Bu ^ (Ba | Be); Cu ^= Amu;
+		Ebi ^= Di; Ba = rol(Ebi, 62);
+		Ego ^= Do; Be = rol(Ego, 55);
+		Eku ^= Du; Bi = rol(Eku, 39);
+		Ema ^= Da; Bo = rol(Ema, 41);
+		Ese ^= De; Bu = rol(Ese, 2);
+		Asa = Ba ^ ((~Be) & Bi); Ca ^= Asa;
+		Ase = (~Be) ^ (Bi | Bo); Ce ^= Ase;
+		Asi = Bi ^ (Bo & Bu); Ci ^= Asi;
+		Aso = Bo ^ (Bu | Ba); Co ^= Aso;
+		Asu = Bu ^ (Ba & Be); Cu ^= Asu;
+	}
+	st[0] = Aba;
+	st[1] = ~Abe;
+	st[2] = ~Abi;
+	st[3] = Abo;
+	st[4] = Abu;
+	st[5] = Aga;
+	st[6] = Age;
+	st[7] = Agi;
+	st[8] = ~Ago;
+	st[9] = Agu;
+	st[10] = Aka;
+	st[11] = Ake;
+	st[12] = ~Aki;
+	st[13] = Ako;
+	st[14] = Aku;
+	st[15] = Ama;
+	st[16] = Ame;
+	st[17] = ~Ami;
+	st[18] = Amo;
+	st[19] = Amu;
+	st[20] = ~Asa;
+	st[21] = Ase;
+	st[22] = Asi;
+	st[23] = Aso;
+	st[24] = Asu;
 }
 
-/******** The FIPS202-defined functions. ********/
-
-/*** Some helper macros. ***/
-
-#define _(S) do { S } while (0)
-#define FOR(i, ST, L, S) \
-  _(for (size_t i = 0; i < L; i += ST) { S; })
-#define mkapply_ds(NAME, S)                                          \
-  static inline void NAME(uint8_t* dst,                              \
-						  const uint8_t* src,                        \
-						  size_t len) {                              \
-	FOR(i, 1, len, S);                                               \
-  }
-#define mkapply_sd(NAME, S)                                          \
-  static inline void NAME(const uint8_t* src,                        \
-						  uint8_t* dst,                              \
-						  size_t len) {                              \
-	FOR(i, 1, len, S);                                               \
-  }
-
-mkapply_ds(xorin, dst[i] ^= src[i])  // xorin
-mkapply_sd(setout, dst[i] = src[i])  // setout
-
-#define P keccakf
-#define Plen 200
-
-// Fold P*F over the full blocks of an input.
-#define foldP(I, L, F) \
-  while (L >= rate) {  \
-	F(a, I, rate);     \
-	P(a);              \
-	I += rate;         \
-	L -= rate;         \
-  }
-
-/** The sponge-based hash construction. **/
-static inline int hash(uint8_t* out, size_t outlen,
-					   const uint8_t* in, size_t inlen,
-					   size_t rate, uint8_t delim) {
-  if ((out == NULL) || ((in == NULL) && inlen != 0) || (rate >= Plen)) {
-	return -1;
-  }
-  uint8_t a[Plen] = {0};
-  // Absorb input.
-  foldP(in, inlen, xorin);
-  // Xor in the DS and pad frame.
-  a[inlen] ^= delim;
-  a[rate - 1] ^= 0x80;
-  // Xor in the last block.
-  xorin(a, in, inlen);
-  // Apply P
-  P(a);
-  // Squeeze output.
-  foldP(out, outlen, setout);
-  setout(a, out, outlen);
-  memset(a, 0, 200);
-  return 0;
+/// Keccak-256 absorbs 136 bytes (17 lanes) per permutation
+static const size_t RATE = 136;
+static const size_t RATE_LANES = RATE / 8;
+
+/// Input of one hash, fed to the sponge one block at a time with the padding applied to the last block
+struct Sponge
+{
+	Sponge(bytesConstRef _input): in(_input.data()), fullBlocks(_input.size() / RATE), blocks(fullBlocks + 1)
+	{
+		const size_t rem = _input.size() % RATE;
+		memset(last, 0, RATE);
+		if (rem)
+			memcpy(last, in + fullBlocks * RATE, rem);
+		last[rem] ^= 0x01;
+		last[RATE - 1] ^= 0x80;
+	}
+	const uint8_t* block(size_t _i) const { return _i < fullBlocks ? in + _i * RATE : last; }
+
+	const uint8_t* in;
+	size_t fullBlocks;
+	size_t blocks;
+	uint8_t last[RATE];
+};
+
+static void absorb(uint64_t (&a)[25], Sponge const& _s, size_t _from)
+{
+	for (size_t i = _from; i < _s.blocks; i++)
+	{
+		const uint8_t* block = _s.block(i);
+		for (size_t j = 0; j < RATE_LANES; j++)
+			a[j] ^= ReadLE64(block + j * 8);
+		KeccakF1600(a);
+	}
+}
+
+static void squeeze(uint64_t const (&a)[25], uint8_t* o_output)
+{
+	for (size_t j = 0; j < 4; j++)
+		WriteLE64(o_output + j * 8, a[j]);
 }
 
-/*** Helper macros to define SHA3 and SHAKE instances. ***/
-#define defshake(bits)                                            \
-  int shake##bits(uint8_t* out, size_t outlen,                    \
-				  const uint8_t* in, size_t inlen) {              \
-	return hash(out, outlen, in, inlen, 200 - (bits / 4), 0x1f);  \
-  }
-#define defsha3(bits)                                             \
-  int sha3_##bits(uint8_t* out, size_t outlen,                    \
-				  const uint8_t* in, size_t inlen) {              \
-	if (outlen > (bits/8)) {                                      \
-	  return -1;                                                  \
-	}                                                             \
-	return hash(out, outlen, in, inlen, 200 - (bits / 4), 0x01);  \
-  }
-
-/*** FIPS202 SHAKE VOFs ***/
-defshake(128)
-defshake(256)
-
-/*** FIPS202 SHA3 FOFs ***/
-defsha3(224)
-defsha3(256)
-defsha3(384)
-defsha3(512)
+/// Four-way Keccak-f[1600] over interleaved states, null unless the CPU supports it
+typedef void (*Transform4WayType)(uint64_t (&)[25][4]);
+static Transform4WayType KeccakF1600_4way = nullptr;
+
+/// Hash four inputs, absorbing in lockstep until the shortest one is done and finishing the others one by one
+static void sha3_256_4way(bytesConstRef const* _inputs, h256* o_outputs)
+{
+	const Sponge s[4] = {Sponge(_inputs[0]), Sponge(_inputs[1]), Sponge(_inputs[2]), Sponge(_inputs[3])};
+	const size_t common = std::min(std::min(s[0].blocks, s[1].blocks), std::min(s[2].blocks, s[3].blocks));
+	uint64_t a4[25][4] = {};
+	for (size_t i = 0; i < common; i++)
+	{
+		for (size_t j = 0; j < RATE_LANES; j++)
+			for (size_t k = 0; k < 4; k++)
+				a4[j][k] ^= ReadLE64(s[k].block(i) + j * 8);
+		KeccakF1600_4way(a4);
+	}
+	for (size_t k = 0; k < 4; k++)
+	{
+		uint64_t a[25];
+		for (size_t j = 0; j < 25; j++)
+			a[j] = a4[j][k];
+		absorb(a, s[k], common);
+		squeeze(a, o_outputs[k].data());
+	}
+}
+
+static bool SelfTest()
+{
+	// Keccak-256 of the empty string and of 200 bytes, which spans two blocks
+	static const h256 emptyHash("c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470");
+	static const h256 longHash("3a57666b048777f2c953dc4456f45a2588e1cb6f2da760122d530ac2ce607d4a");
+	uint8_t data[200];
+	memset(data, 0xa3, sizeof(data));
+	const bytesConstRef inputs[4] = {bytesConstRef(), bytesConstRef(data, sizeof(data)), bytesConstRef(data, sizeof(data)), bytesConstRef()};
+	h256 outputs[4];
+	sha3(inputs, 4, outputs);
+	return outputs[0] == emptyHash && outputs[1] == longHash && outputs[2] == longHash && outputs[3] == emptyHash && sha3(inputs[1]) == longHash;
+}
+
+#if defined(USE_ASM) && (defined(__x86_64__) || defined(__amd64__) || defined(__i386__))
+/** Check whether the OS has enabled AVX registers. */
+static bool AVXEnabled()
+{
+	uint32_t a, d;
+	__asm__("xgetbv" : "=a"(a), "=d"(d) : "c"(0));
+	return (a & 6) == 6;
+}
+#endif
 
 }
 
 bool sha3(bytesConstRef _input, bytesRef o_output)
 {
-	// FIXME: What with unaligned memory?
 	if (o_output.size() != 32)
 		return false;
-	keccak::sha3_256(o_output.data(), 32, _input.data(), _input.size());
-//	keccak::keccak(ret.data(), 32, (uint64_t const*)_input.data(), _input.size());
+	uint64_t a[25] = {};
+	keccak::absorb(a, keccak::Sponge(_input), 0);
+	keccak::squeeze(a, o_output.data());
 	return true;
 }
 
+void sha3(bytesConstRef const* _inputs, size_t _count, h256* o_outputs)
+{
+	size_t i = 0;
+	if (keccak::KeccakF1600_4way)
+		for (; i + 4 <= _count; i += 4)
+			keccak::sha3_256_4way(_inputs + i, o_outputs + i);
+	for (; i < _count; i++)
+		o_outputs[i] = sha3(_inputs[i]);
+}
+
+std::string sha3AutoDetect()
+{
+	std::string ret = "standard";
+#if defined(USE_ASM) && defined(HAVE_GETCPUID)
+	bool have_avx = false;
+	bool have_avx2 = false;
+	bool enabled_avx = false;
+	(void)keccak::AVXEnabled;
+	(void)have_avx2;
+
+	uint32_t eax, ebx, ecx, edx;
+	GetCPUID(1, 0, eax, ebx, ecx, edx);
+	have_avx = (ecx >> 28) & 1;
+	if (((ecx >> 27) & 1) && have_avx)
+		enabled_avx = keccak::AVXEnabled();
+	GetCPUID(7, 0, eax, ebx, ecx, edx);
+	have_avx2 = (ebx >> 5) & 1;
+
+#if defined(ENABLE_AVX2) && !defined(BUILD_SYSCOIN_INTERNAL)
+	if (have_avx2 && have_avx && enabled_avx)
+	{
+		keccak::KeccakF1600_4way = keccak_avx2::KeccakF1600_4way;
+		ret = "avx2(4way)";
+	}
+#endif
+#endif
+
+	assert(keccak::SelfTest());
+	return ret;
+}
+
 }
@@ -37,6 +37,13 @@ namespace dev
 /// @returns false if o_output.size() != 32.
 bool sha3(bytesConstRef _input, bytesRef o_output);
 
+/// Calculate SHA3-256 hashes of @a _count inputs into @a o_outputs, four at a time when the CPU supports it.
+void sha3(bytesConstRef const* _inputs, size_t _count, h256* o_outputs);
+
+/// Select the fastest Keccak implementation the CPU supports.
+/// @returns a description of the implementation in use.
+std::string sha3AutoDetect();
+
 /// Calculate SHA3-256 hash of the given input, returning as a 256-bit hash.
 inline h256 sha3(bytesConstRef _input) { h256 ret; sha3(_input, ret.ref()); return ret; }
 inline SecureFixedHash<32> sha3Secure(bytesConstRef _input) { SecureFixedHash<32> ret; sha3(_input, ret.writable().ref()); return ret; }
@@ -0,0 +1,93 @@
+// Copyright (c) 2021 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifdef ENABLE_AVX2
+
+#include <stdint.h>
+#include <immintrin.h>
+
+namespace keccak_avx2 {
+namespace {
+
+const uint64_t RC[24] = {
+    0x0000000000000001, 0x0000000000008082, 0x800000000000808a, 0x8000000080008000,
+    0x000000000000808b, 0x0000000080000001, 0x8000000080008081, 0x8000000000008009,
+    0x000000000000008a, 0x0000000000000088, 0x0000000080008009, 0x000000008000000a,
+    0x000000008000808b, 0x800000000000008b, 0x8000000000008089, 0x8000000000008003,
+    0x8000000000008002, 0x8000000000000080, 0x000000000000800a, 0x800000008000000a,
+    0x8000000080008081, 0x8000000000008080, 0x0000000080000001, 0x8000000080008008
+};
+
+__m256i inline Xor(__m256i x, __m256i y) { return _mm256_xor_si256(x, y); }
+__m256i inline Xor(__m256i x, __m256i y, __m256i z, __m256i w, __m256i v) { return Xor(Xor(Xor(x, y), Xor(z, w)), v); }
+/** (~x) & y */
+__m256i inline AndNot(__m256i x, __m256i y) { return _mm256_andnot_si256(x, y); }
+template <int n> __m256i inline Rol(__m256i x) { return _mm256_or_si256(_mm256_slli_epi64(x, n), _mm256_srli_epi64(x, 64 - n)); }
+
+}
+
+/** Keccak-f[1600] on four states at once, lane i of state k is st[i][k]. */
+void KeccakF1600_4way(uint64_t (&st)[25][4])
+{
+    __m256i a[25], b[25];
+    for (int i = 0; i < 25; i++) {
+        a[i] = _mm256_loadu_si256((const __m256i*)st[i]);
+    }
+    for (int round = 0; round < 24; round++) {
+        // Theta
+        const __m256i c0 = Xor(a[0], a[5], a[10], a[15], a[20]);
+        const __m256i c1 = Xor(a[1], a[6], a[11], a[16], a[21]);
+        const __m256i c2 = Xor(a[2], a[7], a[12], a[17], a[22]);
+        const __m256i c3 = Xor(a[3], a[8], a[13], a[18], a[23]);
+        const __m256i c4 = Xor(a[4], a[9], a[14], a[19], a[24]);
+        const __m256i d0 = Xor(c4, Rol<1>(c1));
+        const __m256i d1 = Xor(c0, Rol<1>(c2));
+        const __m256i d2 = Xor(c1, Rol<1>(c3));
+        const __m256i d3 = Xor(c2, Rol<1>(c4));
+        const __m256i d4 = Xor(c3, Rol<1>(c0));
+        // Rho and pi
+        b[0] = Xor(a[0], d0);
+        b[1] = Rol<44>(Xor(a[6], d1));
+        b[2] = Rol<43>(Xor(a[12], d2));
+        b[3] = Rol<21>(Xor(a[18], d3));
+        b[4] = Rol<14>(Xor(a[24], d4));
+        b[5] = Rol<28>(Xor(a[3], d3));
+        b[6] = Rol<20>(Xor(a[9], d4));
+        b[7] = Rol<3>(Xor(a[10], d0));
+        b[8] = Rol<45>(Xor(a[16], d1));
+        b[9] = Rol<61>(Xor(a[22], d2));
+        b[10] = Rol<1>(Xor(a[1], d1));
+        b[11] = Rol<6>(Xor(a[7], d2));
+        b[12] = Rol<25>(Xor(a[13], d3));
+        b[13] = Rol<8>(Xor(a[19], d4));
+        b[14] = Rol<18>(Xor(a[20], d0));
+        b[15] = Rol<27>(Xor(a[4], d4));
+        b[16] = Rol<36>(Xor(a[5], d0));
+        b[17] = Rol<10>(Xor(a[11], d1));
+        b[18] = Rol<15>(Xor(a[17], d2));
+        b[19] = Rol<56>(Xor(a[23], d3));
+        b[20] = Rol<62>(Xor(a[2], d2));
+        b[21] = Rol<55>(Xor(a[8], d3));
+        b[22] = Rol<39>(Xor(a[14], d4));
+        b[23] = Rol<41>(Xor(a[15], d0));
+        b[24] = Rol<2>(Xor(a[21], d1));
+        // Chi
+        for (int y = 0; y < 25; y += 5) {
+            a[y + 0] = Xor(b[y + 0], AndNot(b[y + 1], b[y + 2]));
+            a[y + 1] = Xor(b[y + 1], AndNot(b[y + 2], b[y + 3]));
+            a[y + 2] = Xor(b[y + 2], AndNot(b[y + 3], b[y + 4]));
+            a[y + 3] = Xor(b[y + 3], AndNot(b[y + 4], b[y + 0]));
+            a[y + 4] = Xor(b[y + 4], AndNot(b[y + 0], b[y + 1]));
+        }
+        // Iota
+        a[0] = Xor(a[0], _mm256_set1_epi64x(RC[round]));
+    }
+    for (int i = 0; i < 25; i++) {
+        _mm256_storeu_si256((__m256i*)st[i], a[i]);
+    }
+}
+
+}
+
+#endif
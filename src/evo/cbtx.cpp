@@ -12,6 +12,7 @@
 #include <chainparams.h>
 #include <consensus/merkle.h>
 #include <univalue.h>
+#include <util/check.h>
 #include <validation.h>
 
 bool CheckCbTx(const CTransaction& tx, const CBlockIndex* pindexPrev, TxValidationState& state, bool fJustCheck)
@@ -129,7 +130,8 @@ bool CalcCbTxMerkleRootMNList(const CBlock& block, const CBlockIndex* pindexPrev
 
     try {
         CDeterministicMNList tmpMNList;
-        if (!deterministicMNManager->BuildNewListFromBlock(block, pindexPrev, state, view, tmpMNList, false, qcIn)) {
+        CDeterministicMNListDiff blockDiff;
+        if (!deterministicMNManager->BuildNewListFromBlock(block, pindexPrev, state, view, tmpMNList, false, qcIn, &blockDiff)) {
             // pass the state returned by the function above
             return false;
         }
@@ -137,33 +139,50 @@ bool CalcCbTxMerkleRootMNList(const CBlock& block, const CBlockIndex* pindexPrev
         int64_t nTime2 = GetTimeMicros(); nTimeDMN += nTime2 - nTime1;
         LogPrint(BCLog::BENCHMARK, "            - BuildNewListFromBlock: %.2fms [%.2fs]\n", 0.001 * (nTime2 - nTime1), nTimeDMN * 0.000001);
 
-        CSimplifiedMNList sml(tmpMNList);
-
-        int64_t nTime3 = GetTimeMicros(); nTimeSMNL += nTime3 - nTime2;
-        LogPrint(BCLog::BENCHMARK, "            - CSimplifiedMNList: %.2fms [%.2fs]\n", 0.001 * (nTime3 - nTime2), nTimeSMNL * 0.000001);
-
-        static CSimplifiedMNList smlCached;
-        static uint256 merkleRootCached;
-        static bool mutatedCached{false};
-
-        if (sml.mnList == smlCached.mnList) {
-            merkleRootRet = merkleRootCached;
-            if (mutatedCached) {
-                return state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, "mutated-cached-calc-cb-mnmerkleroot");
+        // the tree follows the chain with the stored list diffs of the blocks, so only changed entries are hashed
+        static CSimplifiedMNListMerkleTree merkleTree;
+        CDeterministicMNList prevList;
+        deterministicMNManager->GetListForBlock(pindexPrev, prevList);
+        if (merkleTree.GetBlockHash() != pindexPrev->GetBlockHash()) {
+            CDeterministicMNListDiff prevDiff;
+            if (pindexPrev->pprev && pindexPrev->pprev->GetBlockHash() == merkleTree.GetBlockHash() &&
+                deterministicMNManager->GetListDiffForBlock(pindexPrev, prevDiff)) {
+                merkleTree.Update(prevList, prevDiff);
+            } else {
+                merkleTree.Build(prevList);
             }
-            return true;
         }
-
+        merkleTree.Update(tmpMNList, blockDiff);
         bool mutated = false;
-        merkleRootRet = sml.CalcMerkleRoot(&mutated);
+        merkleRootRet = merkleTree.GetRoot(&mutated);
+
+        // move the tree back to pindexPrev, the next call is for this block's successor or another block on top of pindexPrev
+        std::set<uint256> setChanged;
+        for (const auto& dmn : blockDiff.addedMNs) {
+            setChanged.emplace(dmn->proTxHash);
+        }
+        for (const uint64_t nInternalId : blockDiff.removedMns) {
+            setChanged.emplace(prevList.GetMNByInternalId(nInternalId)->proTxHash);
+        }
+        for (const auto& p : blockDiff.updatedMNs) {
+            setChanged.emplace(tmpMNList.GetMNByInternalId(p.first)->proTxHash);
+        }
+        CDeterministicMNListDiff undoDiff;
+        tmpMNList.BuildDiff(prevList, setChanged, undoDiff);
+        merkleTree.Update(prevList, undoDiff);
+
+        int64_t nTime3 = GetTimeMicros(); nTimeSMNL += nTime3 - nTime2;
+        LogPrint(BCLog::BENCHMARK, "            - CSimplifiedMNListMerkleTree: %.2fms [%.2fs]\n", 0.001 * (nTime3 - nTime2), nTimeSMNL * 0.000001);
+
+#ifdef ABORT_ON_FAILED_ASSUME
+        // debug builds check the tree against a full recomputation
+        bool mutatedFull = false;
+        Assert(CSimplifiedMNList(tmpMNList).CalcMerkleRoot(&mutatedFull) == merkleRootRet && mutatedFull == mutated);
+#endif
 
         int64_t nTime4 = GetTimeMicros(); nTimeMerkle += nTime4 - nTime3;
         LogPrint(BCLog::BENCHMARK, "            - CalcMerkleRoot: %.2fms [%.2fs]\n", 0.001 * (nTime4 - nTime3), nTimeMerkle * 0.000001);
 
-        smlCached = std::move(sml);
-        merkleRootCached = merkleRootRet;
-        mutatedCached = mutated;
-
         if (mutated) {
             return state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, "mutated-calc-cb-mnmerkleroot");
         }
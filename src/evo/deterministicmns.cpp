@@ -9,6 +9,8 @@
 #include <base58.h>
 #include <chainparams.h>
 #include <core_io.h>
+#include <crypto/sha256.h>
+#include <memusage.h>
 #include <script/standard.h>
 #include <node/ui_interface.h>
 #include <validation.h>
@@ -66,6 +68,12 @@ void CDeterministicMNState::ToJson(UniValue& obj) const
     }
 }
 
+size_t CDeterministicMNState::DynamicMemoryUsage() const
+{
+    // scripts are only allocated when they don't fit the prevector, the lazy operator key always holds its serialized buffer
+    return memusage::DynamicUsage(scriptPayout) + memusage::DynamicUsage(scriptOperatorPayout) + memusage::MallocUsage(CBLSPublicKey::SerSize);
+}
+
 uint64_t CDeterministicMN::GetInternalId() const
 {
     // can't get it if it wasn't set yet
@@ -102,6 +110,11 @@ void CDeterministicMN::ToJson(UniValue& obj) const
     obj.pushKV("state", stateObj);
 }
 
+size_t CDeterministicMN::DynamicMemoryUsage() const
+{
+    return memusage::DynamicUsage(pdmnState) + pdmnState->DynamicMemoryUsage();
+}
+
 bool CDeterministicMNList::IsMNValid(const uint256& proTxHash) const
 {
     auto p = mnMap.find(proTxHash);
@@ -236,12 +249,13 @@ void CDeterministicMNList::GetProjectedMNPayees(size_t nCount, std::vector<CDete
     }
 
     result.clear();
-    result.reserve(nCount);
+    result.reserve(GetValidMNsCount());
 
     ForEachMN(true, [&](const CDeterministicMNCPtr& dmn) {
         result.emplace_back(dmn);
     });
-    std::sort(result.begin(), result.end(), [&](const CDeterministicMNCPtr& a, const CDeterministicMNCPtr& b) {
+    // only the first nCount payees need to be ordered
+    std::partial_sort(result.begin(), result.begin() + nCount, result.end(), [&](const CDeterministicMNCPtr& a, const CDeterministicMNCPtr& b) {
         return CompareByLastPaid(a, b);
     });
 
@@ -254,17 +268,18 @@ void CDeterministicMNList::CalculateQuorum(size_t maxSize, const uint256& modifi
     std::vector<std::pair<arith_uint256, CDeterministicMNCPtr>> scores;
     CalculateScores(modifier, scores);
 
-    // sort is descending order
-    std::sort(scores.rbegin(), scores.rend(), [](const std::pair<arith_uint256, CDeterministicMNCPtr>& a, std::pair<arith_uint256, CDeterministicMNCPtr>& b) {
+    // descending order, only the top maxSize entries need to be ordered
+    const size_t nSize = std::min(maxSize, scores.size());
+    std::partial_sort(scores.begin(), scores.begin() + nSize, scores.end(), [](const std::pair<arith_uint256, CDeterministicMNCPtr>& a, const std::pair<arith_uint256, CDeterministicMNCPtr>& b) {
         if (a.first == b.first) {
             // this should actually never happen, but we should stay compatible with how the non deterministic MNs did the sorting
-            return a.second->collateralOutpoint < b.second->collateralOutpoint;
+            return b.second->collateralOutpoint < a.second->collateralOutpoint;
         }
-        return a.first < b.first;
+        return b.first < a.first;
     });
 
     // take top maxSize entries and return it
-    members.resize(std::min(maxSize, scores.size()));
+    members.resize(nSize);
     for (size_t i = 0; i < members.size(); i++) {
         members[i] = std::move(scores[i].second);
     }
@@ -274,25 +289,31 @@ void CDeterministicMNList::CalculateScores(const uint256& modifier, std::vector<
 {
     scores.clear();
     scores.reserve(GetAllMNsCount());
+    // calculate sha256(sha256(proTxHash, confirmedHash), modifier) per MN
+    // Please note that this is not a double-sha256 but a single-sha256
+    // The first part is already precalculated (confirmedHashWithProRegTxHash)
+    // Every input is exactly 64 bytes so all of them are hashed at once by the multi-way SHA256 implementations
+    std::vector<unsigned char> vchInputs;
+    vchInputs.reserve(GetAllMNsCount() * 64);
     ForEachMN(true, [&](const CDeterministicMNCPtr& dmn) {
         if (dmn->pdmnState->confirmedHash.IsNull()) {
             // we only take confirmed MNs into account to avoid hash grinding on the ProRegTxHash to sneak MNs into a
             // future quorums
             return;
         }
-        // calculate sha256(sha256(proTxHash, confirmedHash), modifier) per MN
-        // Please note that this is not a double-sha256 but a single-sha256
-        // The first part is already precalculated (confirmedHashWithProRegTxHash)
-        // TODO When https://github.com/bitcoin/bitcoin/pull/13191 gets backported, implement something that is similar but for single-sha256
-        uint256 h;
-        CSHA256 sha256;
-        sha256.Write(dmn->pdmnState->confirmedHashWithProRegTxHash.begin(), dmn->pdmnState->confirmedHashWithProRegTxHash.size());
-        sha256.Write(modifier.begin(), modifier.size());
-        sha256.Finalize(h.begin());
-
-        scores.emplace_back(UintToArith256(h), dmn);
+        const uint256& confirmedHashWithProRegTxHash = dmn->pdmnState->confirmedHashWithProRegTxHash;
+        vchInputs.insert(vchInputs.end(), confirmedHashWithProRegTxHash.begin(), confirmedHashWithProRegTxHash.end());
+        vchInputs.insert(vchInputs.end(), modifier.begin(), modifier.end());
+        scores.emplace_back(arith_uint256(), dmn);
     });
-
+    if (scores.empty()) {
+        return;
+    }
+    std::vector<uint256> vecHashes(scores.size());
+    SHA256S64(vecHashes.data()->begin(), vchInputs.data(), scores.size());
+    for (size_t i = 0; i < scores.size(); i++) {
+        scores[i].first = UintToArith256(vecHashes[i]);
+    }
 }
 
 int CDeterministicMNList::CalcMaxPoSePenalty() const
@@ -380,6 +401,31 @@ void CDeterministicMNList::BuildDiff(const CDeterministicMNList& to, CDeterminis
     });
 }
 
+void CDeterministicMNList::BuildDiff(const CDeterministicMNList& to, const std::set<uint256>& proTxHashes, CDeterministicMNListDiff& diffRet) const
+{
+    for (const auto& proTxHash : proTxHashes) {
+        auto fromPtr = GetMN(proTxHash);
+        auto toPtr = to.GetMN(proTxHash);
+        if (fromPtr == nullptr) {
+            // not in either list if it was added and removed again in between
+            if (toPtr != nullptr) {
+                diffRet.addedMNs.emplace_back(toPtr);
+            }
+        } else if (toPtr == nullptr) {
+            diffRet.removedMns.emplace(fromPtr->GetInternalId());
+        } else if (fromPtr != toPtr || fromPtr->pdmnState != toPtr->pdmnState) {
+            CDeterministicMNStateDiff stateDiff(*fromPtr->pdmnState, *toPtr->pdmnState);
+            if (stateDiff.fields) {
+                diffRet.updatedMNs.try_emplace(toPtr->GetInternalId(), std::move(stateDiff));
+            }
+        }
+    }
+
+    std::sort(diffRet.addedMNs.begin(), diffRet.addedMNs.end(), [](const CDeterministicMNCPtr& a, const CDeterministicMNCPtr& b) {
+        return a->GetInternalId() < b->GetInternalId();
+    });
+}
+
 CSimplifiedMNListDiff CDeterministicMNList::BuildSimplifiedDiff(const CDeterministicMNList& to) const
 {
     CSimplifiedMNListDiff diffRet;
@@ -432,6 +478,46 @@ CDeterministicMNList CDeterministicMNList::ApplyDiff(const CBlockIndex* pindex,
     return result;
 }
 
+static bool IsSameMN(const CDeterministicMN& a, const CDeterministicMN& b)
+{
+    if (a.proTxHash != b.proTxHash || a.GetInternalId() != b.GetInternalId() || a.collateralOutpoint != b.collateralOutpoint || a.nOperatorReward != b.nOperatorReward) {
+        return false;
+    }
+    return a.pdmnState == b.pdmnState || CDeterministicMNStateDiff::IsEqual(*a.pdmnState, *b.pdmnState);
+}
+
+size_t CDeterministicMNList::InternMNs(const CDeterministicMNList& base)
+{
+    size_t nShared = 0;
+    // unique properties are keyed by proTxHash so only the masternode map changes
+    MnMap newMap = mnMap;
+    for (const auto& p : mnMap) {
+        const auto baseDmn = base.mnMap.find(p.first);
+        if (!baseDmn) {
+            continue;
+        }
+        if (*baseDmn == p.second) {
+            nShared++;
+        } else if (IsSameMN(**baseDmn, *p.second)) {
+            newMap = newMap.set(p.first, *baseDmn);
+            nShared++;
+        }
+    }
+    mnMap = newMap;
+    return nShared;
+}
+
+size_t CDeterministicMNList::DynamicMemoryUsage() const
+{
+    size_t nUsage = mnMap.size() * memusage::MallocUsage(sizeof(MnMap::value_type)) +
+        mnInternalIdMap.size() * memusage::MallocUsage(sizeof(MnInternalIdMap::value_type)) +
+        mnUniquePropertyMap.size() * memusage::MallocUsage(sizeof(MnUniquePropertyMap::value_type));
+    for (const auto& p : mnMap) {
+        nUsage += (memusage::DynamicUsage(p.second) + p.second->DynamicMemoryUsage()) / p.second.use_count();
+    }
+    return nUsage;
+}
+
 void CDeterministicMNList::AddMN(const CDeterministicMNCPtr& dmn, bool fBumpTotalCount)
 {
     assert(dmn != nullptr);
@@ -559,17 +645,18 @@ bool CDeterministicMNManager::ProcessBlock(const CBlock& block, const CBlockInde
         CDeterministicMNListDiff diff;
         oldList.BuildDiff(newList, diff);
         if(evoDb) {
+            WritePendingSnapshots();
             evoDb->Write(std::make_pair(DB_LIST_DIFF, newList.GetBlockHash()), diff);
             if ((nHeight % DISK_SNAPSHOT_PERIOD) == 0 || oldList.GetHeight() == -1) {
                 evoDb->Write(std::make_pair(DB_LIST_SNAPSHOT, newList.GetBlockHash()), newList);
-                mnListsCache.try_emplace(newList.GetBlockHash(), newList);
+                CacheList(newList.GetBlockHash(), newList);
                 LogPrintf("CDeterministicMNManager::%s -- Wrote snapshot. nHeight=%d, mapCurMNs.allMNsCount=%d\n",
                     __func__, nHeight, newList.GetAllMNsCount());
             }
         }
 
         diff.nHeight = pindex->nHeight;
-        mnListDiffsCache.try_emplace(pindex->GetBlockHash(), diff);
+        mnListDiffsCache.Insert(pindex->GetBlockHash(), diff, EstimateUsage(diff));
     } catch (const std::exception& e) {
         LogPrintf("CDeterministicMNManager::%s -- internal error: %s\n", __func__, e.what());
         return _state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, "failed-dmn-block");
@@ -605,8 +692,8 @@ bool CDeterministicMNManager::UndoBlock(const CBlock& block, const CBlockIndex*
             GetListForBlock(pindex->pprev, prevList);
         }
 
-        mnListsCache.erase(blockHash);
-        mnListDiffsCache.erase(blockHash);
+        mnListsCache.Erase(blockHash);
+        mnListDiffsCache.Erase(blockHash);
     }
 
     if (diff.HasChanges()) {
@@ -626,7 +713,7 @@ void CDeterministicMNManager::UpdatedBlockTip(const CBlockIndex* pindex)
     tipIndex = pindex;
 }
 
-bool CDeterministicMNManager::BuildNewListFromBlock(const CBlock& block, const CBlockIndex* pindexPrev, BlockValidationState& _state, CCoinsViewCache& view, CDeterministicMNList& mnListRet, bool debugLogs, const llmq::CFinalCommitmentTxPayload *qcIn)
+bool CDeterministicMNManager::BuildNewListFromBlock(const CBlock& block, const CBlockIndex* pindexPrev, BlockValidationState& _state, CCoinsViewCache& view, CDeterministicMNList& mnListRet, bool debugLogs, const llmq::CFinalCommitmentTxPayload *qcIn, CDeterministicMNListDiff* pDiffRet)
 {
     AssertLockHeld(cs_main);
     AssertLockHeld(cs);
@@ -638,8 +725,11 @@ bool CDeterministicMNManager::BuildNewListFromBlock(const CBlock& block, const C
     CDeterministicMNList newList = oldList;
     newList.SetBlockHash(uint256()); // we can't know the final block hash, so better not return a (invalid) block hash
     newList.SetHeight(nHeight);
+    // every masternode the block touches, only these can differ between oldList and newList
+    std::set<uint256> setChanged;
 
-    auto payee = oldList.GetMNPayee();
+    // served from the payee schedule, the block template asked for the same payee
+    auto payee = GetMNPayee(pindexPrev);
     // at least 2 rounds of payments before registered MN's gets put in list
     const size_t &mnCountThreshold = oldList.GetValidMNsCount()*2;
     // we iterate the oldList here and update the newList
@@ -657,6 +747,7 @@ bool CDeterministicMNManager::BuildNewListFromBlock(const CBlock& block, const C
             auto newState = std::make_shared<CDeterministicMNState>(*dmn->pdmnState);
             newState->UpdateConfirmedHash(dmn->proTxHash, pindexPrev->GetBlockHash());
             newList.UpdateMN(dmn->proTxHash, newState);
+            setChanged.emplace(dmn->proTxHash);
         }
     });
     // decrease PoSe ban score
@@ -666,10 +757,10 @@ bool CDeterministicMNManager::BuildNewListFromBlock(const CBlock& block, const C
         // in Syscoin the llmq50_60 service checks 50 nodes every 60 blocks (1 hour) so to make the ratio equivalent so that scores decrementing are at the same ratio as the PoSe check strategy
         // we need to offset the ratio of 50/60 by 2.5 (rounded up to 3)
         if((nHeight % 3) == 0) {
-            DecreasePoSePenalties(newList);
+            DecreasePoSePenalties(newList, setChanged);
         }
     } else {
-        DecreasePoSePenalties(newList);
+        DecreasePoSePenalties(newList, setChanged);
     }
     // coinbase can be quorum commitments
     // qcIn passed in by createnewblock, but connectblock will pass in null, use gettxpayload there if version is for mn quorum
@@ -691,7 +782,7 @@ bool CDeterministicMNManager::BuildNewListFromBlock(const CBlock& block, const C
                     return _state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, "bad-qc-quorum-hash");
                 }
 
-                HandleQuorumCommitment(commitment, quorumIndex, newList, debugLogs);
+                HandleQuorumCommitment(commitment, quorumIndex, newList, debugLogs, setChanged);
             }
         }
     }
@@ -729,6 +820,7 @@ bool CDeterministicMNManager::BuildNewListFromBlock(const CBlock& block, const C
                     // In that case the new ProRegTx will replace the old one. This means the old one is removed
                     // and the new one is added like a completely fresh one, which is also at the bottom of the payment list
                     newList.RemoveMN(replacedDmn->proTxHash);
+                    setChanged.emplace(replacedDmn->proTxHash);
                     if (debugLogs) {
                         LogPrintf("CDeterministicMNManager::%s -- MN %s removed from list because collateral was used for a new ProRegTx. collateralOutpoint=%s, nHeight=%d, mapCurMNs.allMNsCount=%d\n",
                                 __func__, replacedDmn->proTxHash.ToString(), dmn->collateralOutpoint.ToStringShort(), nHeight, newList.GetAllMNsCount());
@@ -759,6 +851,7 @@ bool CDeterministicMNManager::BuildNewListFromBlock(const CBlock& block, const C
                 dmn->pdmnState = dmnState;
 
                 newList.AddMN(dmn);
+                setChanged.emplace(dmn->proTxHash);
 
                 if (debugLogs) {
                     LogPrintf("CDeterministicMNManager::%s -- MN %s added at height %d: %s\n",
@@ -796,6 +889,7 @@ bool CDeterministicMNManager::BuildNewListFromBlock(const CBlock& block, const C
                 }
 
                 newList.UpdateMN(proTx.proTxHash, newState);
+                setChanged.emplace(proTx.proTxHash);
                 if (debugLogs) {
                     LogPrintf("CDeterministicMNManager::%s -- MN %s updated at height %d: %s\n",
                         __func__, proTx.proTxHash.ToString(), nHeight, proTx.ToString());
@@ -823,6 +917,7 @@ bool CDeterministicMNManager::BuildNewListFromBlock(const CBlock& block, const C
                 newState->scriptPayout = proTx.scriptPayout;
 
                 newList.UpdateMN(proTx.proTxHash, newState);
+                setChanged.emplace(proTx.proTxHash);
 
                 if (debugLogs) {
                     LogPrintf("CDeterministicMNManager::%s -- MN %s updated at height %d: %s\n",
@@ -846,6 +941,7 @@ bool CDeterministicMNManager::BuildNewListFromBlock(const CBlock& block, const C
                 newState->nRevocationReason = proTx.nReason;
 
                 newList.UpdateMN(proTx.proTxHash, newState);
+                setChanged.emplace(proTx.proTxHash);
 
                 if (debugLogs) {
                     LogPrintf("CDeterministicMNManager::%s -- MN %s revoked operator key at height %d: %s\n",
@@ -865,6 +961,7 @@ bool CDeterministicMNManager::BuildNewListFromBlock(const CBlock& block, const C
             auto dmn = newList.GetMNByCollateral(in.prevout);
             if (dmn && dmn->collateralOutpoint == in.prevout) {
                 newList.RemoveMN(dmn->proTxHash);
+                setChanged.emplace(dmn->proTxHash);
 
                 if (debugLogs) {
                     LogPrintf("CDeterministicMNManager::%s -- MN %s removed from list because collateral was spent. collateralOutpoint=%s, nHeight=%d, mapCurMNs.allMNsCount=%d\n",
@@ -880,14 +977,18 @@ bool CDeterministicMNManager::BuildNewListFromBlock(const CBlock& block, const C
         auto newState = std::make_shared<CDeterministicMNState>(*newList.GetMN(payee->proTxHash)->pdmnState);
         newState->nLastPaidHeight = nHeight;
         newList.UpdateMN(payee->proTxHash, newState);
+        setChanged.emplace(payee->proTxHash);
     }
 
+    if (pDiffRet) {
+        oldList.BuildDiff(newList, setChanged, *pDiffRet);
+    }
     mnListRet = std::move(newList);
 
     return true;
 }
 
-void CDeterministicMNManager::HandleQuorumCommitment(const llmq::CFinalCommitment& qc, const CBlockIndex* pindexQuorum, CDeterministicMNList& mnList, bool debugLogs)
+void CDeterministicMNManager::HandleQuorumCommitment(const llmq::CFinalCommitment& qc, const CBlockIndex* pindexQuorum, CDeterministicMNList& mnList, bool debugLogs, std::set<uint256>& setChangedRet)
 {
     // The commitment has already been validated at this point so it's safe to use members of it
     std::vector<CDeterministicMNCPtr> members;
@@ -903,11 +1004,12 @@ void CDeterministicMNManager::HandleQuorumCommitment(const llmq::CFinalCommitmen
             // If there were enough blocks between failures, the MN has a chance to recover as he reduces his penalty by 1 every block
             // If it however fails 3 times in the timespan of a single payment cycle, it should definitely get banned
             mnList.PoSePunish(members[i]->proTxHash, mnList.CalcPenalty(66), debugLogs);
+            setChangedRet.emplace(members[i]->proTxHash);
         }
     }
 }
 
-void CDeterministicMNManager::DecreasePoSePenalties(CDeterministicMNList& mnList)
+void CDeterministicMNManager::DecreasePoSePenalties(CDeterministicMNList& mnList, std::set<uint256>& setChangedRet)
 {
     std::vector<uint256> toDecrease;
     toDecrease.reserve(mnList.GetValidMNsCount() / 10);
@@ -921,6 +1023,7 @@ void CDeterministicMNManager::DecreasePoSePenalties(CDeterministicMNList& mnList
 
     for (const auto& proTxHash : toDecrease) {
         mnList.PoSeDecrease(proTxHash);
+        setChangedRet.emplace(proTxHash);
     }
 }
 
@@ -928,61 +1031,128 @@ void CDeterministicMNManager::GetListForBlock(const CBlockIndex* pindex, CDeterm
 {
     LOCK(cs);
     snapshot.clear();
-    std::list<const CBlockIndex*> listDiffIndexes;
+    stats.nLookups++;
+    // diffs to replay on top of the snapshot, newest first
+    std::vector<std::pair<const CBlockIndex*, const CDeterministicMNListDiff*> > vecDiffs;
     while (true && pindex) {
         // try using cache before reading from disk
-        auto itLists = mnListsCache.find(pindex->GetBlockHash());
-        if (itLists != mnListsCache.end()) {
-            snapshot = itLists->second;
+        if (const auto* cachedList = mnListsCache.Find(pindex->GetBlockHash())) {
+            snapshot = *cachedList;
+            break;
+        }
+        auto itPending = mapPendingSnapshots.find(pindex->GetBlockHash());
+        if (itPending != mapPendingSnapshots.end()) {
+            snapshot = itPending->second;
             break;
         }
 
         if (evoDb && evoDb->Read(std::make_pair(DB_LIST_SNAPSHOT, pindex->GetBlockHash()), snapshot)) {
-            mnListsCache.try_emplace(pindex->GetBlockHash(), snapshot);
+            stats.nDiskReads++;
+            // share the masternodes that didn't change since with the tip list instead of keeping copies in the cache
+            if (tipIndex) {
+                if (const auto* tipList = mnListsCache.Find(tipIndex->GetBlockHash())) {
+                    stats.nMNsInterned += snapshot.InternMNs(*tipList);
+                }
+            }
+            CacheList(pindex->GetBlockHash(), snapshot);
             break;
         }
         // no snapshot found yet, check diffs
-        auto itDiffs = mnListDiffsCache.find(pindex->GetBlockHash());
-        if (itDiffs != mnListDiffsCache.end()) {
-            listDiffIndexes.emplace_front(pindex);
-            pindex = pindex->pprev;
-            continue;
-        }
-        CDeterministicMNListDiff diff;
-        if (evoDb && !evoDb->Read(std::make_pair(DB_LIST_DIFF, pindex->GetBlockHash()), diff)) {
+        const CDeterministicMNListDiff* cachedDiff = FindListDiff(pindex);
+        if (!cachedDiff) {
             // no snapshot and no diff on disk means that it's the initial snapshot
             snapshot = CDeterministicMNList(pindex->GetBlockHash(), -1, 0);
-            mnListsCache.try_emplace(pindex->GetBlockHash(), snapshot);
+            CacheList(pindex->GetBlockHash(), snapshot);
             break;
         }
-        diff.nHeight = pindex->nHeight;
-        mnListDiffsCache.try_emplace(pindex->GetBlockHash(), std::move(diff));
-        listDiffIndexes.emplace_front(pindex);
+        vecDiffs.emplace_back(pindex, cachedDiff);
         pindex = pindex->pprev;
     }
-    for (const auto& diffIndex : listDiffIndexes) {
-        const auto& diff = mnListDiffsCache.at(diffIndex->GetBlockHash());
+    // snapshots are missing on this path (e.g. they were not written by an older version), queue them while
+    // replaying so the next lookups through it replay at most MAX_LIST_REPLAY diffs
+    const bool fQueueSnapshots = evoDb && vecDiffs.size() > (size_t)MAX_LIST_REPLAY;
+    uint64_t nSnapshotsQueued{0};
+    for (auto it = vecDiffs.rbegin(); it != vecDiffs.rend(); ++it) {
+        const CBlockIndex* diffIndex = it->first;
+        const auto& diff = *it->second;
         if (diff.HasChanges()) {
             snapshot = snapshot.ApplyDiff(diffIndex, diff);
         } else {
             snapshot.SetBlockHash(diffIndex->GetBlockHash());
             snapshot.SetHeight(diffIndex->nHeight);
         }
+        if (fQueueSnapshots && (diffIndex->nHeight % DISK_SNAPSHOT_PERIOD) == 0) {
+            mapPendingSnapshots.try_emplace(diffIndex->GetBlockHash(), snapshot);
+            nSnapshotsQueued++;
+        }
+    }
+    if (vecDiffs.empty()) {
+        stats.nDirectHits++;
+    }
+    stats.nDiffsReplayed += vecDiffs.size();
+    stats.nMaxReplay = std::max(stats.nMaxReplay, (uint64_t)vecDiffs.size());
+    if (fQueueSnapshots) {
+        LogPrint(BCLog::BENCHMARK, "CDeterministicMNManager::%s -- replayed %d diffs for block %s, queued %d snapshots\n",
+            __func__, vecDiffs.size(), snapshot.GetBlockHash().ToString(), nSnapshotsQueued);
     }
     if (tipIndex) {
         // always keep a snapshot for the tip
         if (snapshot.GetBlockHash() == tipIndex->GetBlockHash()) {
-            mnListsCache.try_emplace(snapshot.GetBlockHash(), snapshot);
+            CacheList(snapshot.GetBlockHash(), snapshot);
         } else {
             // keep snapshots for yet alive quorums
             for (auto& p_llmq : Params().GetConsensus().llmqs) {
                 if ((snapshot.GetHeight() % p_llmq.second.dkgInterval == 0) && (snapshot.GetHeight() + p_llmq.second.dkgInterval * (p_llmq.second.keepOldConnections + 1) >= tipIndex->nHeight)) {
-                    mnListsCache.try_emplace(snapshot.GetBlockHash(), snapshot);
+                    CacheList(snapshot.GetBlockHash(), snapshot);
                     break;
                 }
             }
         }
     }
+    mnListsCache.Trim();
+    mnListDiffsCache.Trim();
+}
+
+void CDeterministicMNManager::WritePendingSnapshots()
+{
+    AssertLockHeld(cs_main);
+    LOCK(cs);
+    if (!evoDb) {
+        return;
+    }
+    for (const auto& [blockHash, snapshot] : mapPendingSnapshots) {
+        evoDb->Write(std::make_pair(DB_LIST_SNAPSHOT, blockHash), snapshot);
+    }
+    stats.nSnapshotsWritten += mapPendingSnapshots.size();
+    mapPendingSnapshots.clear();
+}
+
+const CDeterministicMNListDiff* CDeterministicMNManager::FindListDiff(const CBlockIndex* pindex)
+{
+    const CDeterministicMNListDiff* cachedDiff = mnListDiffsCache.Find(pindex->GetBlockHash());
+    if (cachedDiff) {
+        return cachedDiff;
+    }
+    CDeterministicMNListDiff diff;
+    if (evoDb && !evoDb->Read(std::make_pair(DB_LIST_DIFF, pindex->GetBlockHash()), diff)) {
+        return nullptr;
+    }
+    stats.nDiskReads++;
+    diff.nHeight = pindex->nHeight;
+    const size_t nUsage = EstimateUsage(diff);
+    return &mnListDiffsCache.Insert(pindex->GetBlockHash(), std::move(diff), nUsage);
+}
+
+bool CDeterministicMNManager::GetListDiffForBlock(const CBlockIndex* pindex, CDeterministicMNListDiff& diffRet)
+{
+    LOCK(cs);
+    const CDeterministicMNListDiff* cachedDiff = FindListDiff(pindex);
+    if (!cachedDiff) {
+        return false;
+    }
+    diffRet = *cachedDiff;
+    mnListDiffsCache.Trim();
+    return true;
 }
 
 void CDeterministicMNManager::GetListAtChainTip(CDeterministicMNList& result)
@@ -995,6 +1165,107 @@ void CDeterministicMNManager::GetListAtChainTip(CDeterministicMNList& result)
     GetListForBlock(tipIndex, result);
 }
 
+CDeterministicMNCPtr CDeterministicMNManager::GetMNPayee(const CBlockIndex* pindexPrev)
+{
+    if (!pindexPrev) {
+        return nullptr;
+    }
+    LOCK(cs);
+    CDeterministicMNList mnList;
+    GetListForBlock(pindexPrev, mnList);
+    UpdatePayeeSchedule(pindexPrev, mnList);
+    return payeeSchedule.GetPayee(mnList);
+}
+
+void CDeterministicMNManager::GetProjectedMNPayees(const CBlockIndex* pindexPrev, size_t nCount, std::vector<CDeterministicMNCPtr>& result)
+{
+    result.clear();
+    if (!pindexPrev) {
+        return;
+    }
+    LOCK(cs);
+    CDeterministicMNList mnList;
+    GetListForBlock(pindexPrev, mnList);
+    UpdatePayeeSchedule(pindexPrev, mnList);
+    if (nCount > payeeSchedule.size() && payeeSchedule.size() < mnList.GetValidMNsCount()) {
+        mnList.GetProjectedMNPayees(nCount, result);
+        return;
+    }
+    payeeSchedule.GetPayees(mnList, nCount, result);
+}
+
+void CDeterministicMNManager::UpdatePayeeSchedule(const CBlockIndex* pindexPrev, const CDeterministicMNList& mnList)
+{
+    AssertLockHeld(cs);
+
+    if (pindexPrev->GetBlockHash() == payeeSchedule.GetBlockHash()) {
+        return;
+    }
+    CDeterministicMNListDiff diff;
+    if (pindexPrev->pprev && pindexPrev->pprev->GetBlockHash() == payeeSchedule.GetBlockHash() &&
+        GetListDiffForBlock(pindexPrev, diff) && payeeSchedule.Advance(pindexPrev->GetBlockHash(), mnList, diff)) {
+        return;
+    }
+    payeeSchedule.Build(pindexPrev->GetBlockHash(), mnList, PAYEE_SCHEDULE_SIZE);
+}
+
+void CDeterministicMNPayeeSchedule::Build(const uint256& _blockHash, const CDeterministicMNList& mnList, size_t nCount)
+{
+    std::vector<CDeterministicMNCPtr> projectedPayees;
+    mnList.GetProjectedMNPayees(nCount, projectedPayees);
+    blockHash = _blockHash;
+    payees.clear();
+    for (const auto& dmn : projectedPayees) {
+        payees.emplace_back(dmn->proTxHash);
+    }
+}
+
+bool CDeterministicMNPayeeSchedule::Advance(const uint256& _blockHash, const CDeterministicMNList& mnList, const CDeterministicMNListDiff& diff)
+{
+    // the order of the payees only depends on these fields and on which masternodes are in the list
+    static const uint32_t ORDER_FIELDS = CDeterministicMNStateDiff::Field_nRegisteredHeight |
+                                         CDeterministicMNStateDiff::Field_nLastPaidHeight |
+                                         CDeterministicMNStateDiff::Field_nPoSeRevivedHeight |
+                                         CDeterministicMNStateDiff::Field_nPoSeBanHeight;
+
+    if (payees.size() < 2 || !diff.addedMNs.empty() || !diff.removedMns.empty()) {
+        return false;
+    }
+    bool fPaidFirst = false;
+    for (const auto& p : diff.updatedMNs) {
+        if (!(p.second.fields & ORDER_FIELDS)) {
+            continue;
+        }
+        auto dmn = mnList.GetMNByInternalId(p.first);
+        if (!dmn || dmn->proTxHash != payees.front() || (p.second.fields & ORDER_FIELDS) != CDeterministicMNStateDiff::Field_nLastPaidHeight) {
+            return false;
+        }
+        fPaidFirst = true;
+    }
+    if (!fPaidFirst) {
+        return false;
+    }
+    blockHash = _blockHash;
+    payees.pop_front();
+    return true;
+}
+
+CDeterministicMNCPtr CDeterministicMNPayeeSchedule::GetPayee(const CDeterministicMNList& mnList) const
+{
+    if (payees.empty()) {
+        return nullptr;
+    }
+    return mnList.GetMN(payees.front());
+}
+
+void CDeterministicMNPayeeSchedule::GetPayees(const CDeterministicMNList& mnList, size_t nCount, std::vector<CDeterministicMNCPtr>& result) const
+{
+    result.clear();
+    for (size_t i = 0; i < std::min(nCount, payees.size()); i++) {
+        result.emplace_back(mnList.GetMN(payees[i]));
+    }
+}
+
 bool CDeterministicMNManager::IsProTxWithCollateral(const CTransactionRef& tx, uint32_t n)
 {
     if (tx->nVersion != SYSCOIN_TX_VERSION_MN_REGISTER) {
@@ -1022,49 +1293,89 @@ bool CDeterministicMNManager::IsDIP3Enforced(int nHeight)
     return nHeight >= Params().GetConsensus().DIP0003EnforcementHeight;
 }
 
+CDeterministicMNListStats CDeterministicMNManager::GetListStats()
+{
+    LOCK(cs);
+    CDeterministicMNListStats ret = stats;
+    ret.nListsCached = mnListsCache.Size();
+    ret.nListsUsage = mnListsCache.Usage();
+    ret.nDiffsCached = mnListDiffsCache.Size();
+    ret.nDiffsUsage = mnListDiffsCache.Usage();
+    return ret;
+}
+
+void CDeterministicMNManager::CacheList(const uint256& blockHash, const CDeterministicMNList& mnList)
+{
+    AssertLockHeld(cs);
+    // estimating the usage walks all masternodes, only do it for lists which are not cached yet
+    if (mnListsCache.Find(blockHash)) {
+        return;
+    }
+    mnListsCache.Insert(blockHash, mnList, EstimateUsage(mnList));
+}
+
+size_t CDeterministicMNManager::EstimateUsage(const CDeterministicMNList& mnList)
+{
+    // masternodes shared with other lists are only counted in part, see CDeterministicMNList::DynamicMemoryUsage()
+    return sizeof(CDeterministicMNList) + mnList.DynamicMemoryUsage();
+}
+
+size_t CDeterministicMNManager::EstimateUsage(const CDeterministicMNListDiff& diff)
+{
+    size_t nUsage = sizeof(CDeterministicMNListDiff) +
+        diff.updatedMNs.size() * (sizeof(uint64_t) + sizeof(CDeterministicMNStateDiff)) +
+        diff.removedMns.size() * sizeof(uint64_t);
+    for (const auto& dmn : diff.addedMNs) {
+        nUsage += memusage::DynamicUsage(dmn) + dmn->DynamicMemoryUsage();
+    }
+    return nUsage;
+}
+
 void CDeterministicMNManager::CleanupCache(int nHeight)
 {
     AssertLockHeld(cs);
 
     std::vector<uint256> toDeleteLists;
     std::vector<uint256> toDeleteDiffs;
-    for (const auto& p : mnListsCache) {
-        if (p.second.GetHeight() + LIST_DIFFS_CACHE_SIZE < nHeight) {
-            toDeleteLists.emplace_back(p.first);
-            continue;
+    mnListsCache.ForEach([&](const uint256& hash, const CDeterministicMNList& mnList) {
+        if (mnList.GetHeight() + LIST_DIFFS_CACHE_SIZE < nHeight) {
+            toDeleteLists.emplace_back(hash);
+            return;
         }
         bool fQuorumCache{false};
         for (auto& p_llmq : Params().GetConsensus().llmqs) {
-            if ((p.second.GetHeight() % p_llmq.second.dkgInterval == 0) && (p.second.GetHeight() + p_llmq.second.dkgInterval * (p_llmq.second.keepOldConnections + 1) >= nHeight)) {
+            if ((mnList.GetHeight() % p_llmq.second.dkgInterval == 0) && (mnList.GetHeight() + p_llmq.second.dkgInterval * (p_llmq.second.keepOldConnections + 1) >= nHeight)) {
                 fQuorumCache = true;
                 break;
             }
         }
         if (fQuorumCache) {
             // at least one quorum could be using it, keep it
-            continue;
+            return;
         }
         // no alive quorums using it, see if it was a cache for the tip or for a now outdated quorum
-        if (tipIndex && tipIndex->pprev && p.first == tipIndex->pprev->GetBlockHash()) {
-            toDeleteLists.emplace_back(p.first);
+        if (tipIndex && tipIndex->pprev && hash == tipIndex->pprev->GetBlockHash()) {
+            toDeleteLists.emplace_back(hash);
         } else {
             for (auto& p_llmq : Params().GetConsensus().llmqs) {
-                if (p.second.GetHeight() % p_llmq.second.dkgInterval == 0) {
-                    toDeleteLists.emplace_back(p.first);
+                if (mnList.GetHeight() % p_llmq.second.dkgInterval == 0) {
+                    toDeleteLists.emplace_back(hash);
                     break;
                 }
             }
         }
-    }
+    });
     for (const auto& h : toDeleteLists) {
-        mnListsCache.erase(h);
+        mnListsCache.Erase(h);
     }
-    for (const auto& p : mnListDiffsCache) {
-        if (p.second.nHeight + LIST_DIFFS_CACHE_SIZE < nHeight) {
-            toDeleteDiffs.emplace_back(p.first);
+    mnListDiffsCache.ForEach([&](const uint256& hash, const CDeterministicMNListDiff& diff) {
+        if (diff.nHeight + LIST_DIFFS_CACHE_SIZE < nHeight) {
+            toDeleteDiffs.emplace_back(hash);
         }
-    }
+    });
     for (const auto& h : toDeleteDiffs) {
-        mnListDiffsCache.erase(h);
+        mnListDiffsCache.Erase(h);
     }
+    mnListsCache.Trim();
+    mnListDiffsCache.Trim();
 }
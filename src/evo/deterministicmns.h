@@ -14,6 +14,9 @@
 
 #include <immer/map.hpp>
 
+#include <deque>
+#include <list>
+#include <set>
 #include <unordered_map>
 #include <unordered_set>
 #include <script/standard.h>
@@ -117,6 +120,7 @@ public:
 public:
     std::string ToString() const;
     void ToJson(UniValue& obj) const;
+    size_t DynamicMemoryUsage() const;
 };
 typedef std::shared_ptr<CDeterministicMNState> CDeterministicMNStatePtr;
 typedef std::shared_ptr<const CDeterministicMNState> CDeterministicMNStateCPtr;
@@ -172,6 +176,13 @@ public:
         DMN_STATE_DIFF_ALL_FIELDS
 #undef DMN_STATE_DIFF_LINE
     }
+    static bool IsEqual(const CDeterministicMNState& a, const CDeterministicMNState& b)
+    {
+#define DMN_STATE_DIFF_LINE(f) if (a.f != b.f) return false;
+        DMN_STATE_DIFF_ALL_FIELDS
+#undef DMN_STATE_DIFF_LINE
+        return true;
+    }
     SERIALIZE_METHODS(CDeterministicMNStateDiff, obj) {
         READWRITE(VARINT(obj.fields));
         #define DMN_STATE_DIFF_LINE(f) if (obj.fields & Field_##f) READWRITE(obj.state.f);
@@ -220,6 +231,7 @@ public:
 
     std::string ToString() const;
     void ToJson(UniValue& obj) const;
+    size_t DynamicMemoryUsage() const;
 };
 typedef std::shared_ptr<const CDeterministicMN> CDeterministicMNCPtr;
 
@@ -411,9 +423,23 @@ public:
     void PoSeDecrease(const uint256& proTxHash);
 
     void BuildDiff(const CDeterministicMNList& to, CDeterministicMNListDiff& ret) const;
+    /** Same as BuildDiff but only compares the given masternodes, all others must be equal in both lists */
+    void BuildDiff(const CDeterministicMNList& to, const std::set<uint256>& proTxHashes, CDeterministicMNListDiff& ret) const;
     CSimplifiedMNListDiff BuildSimplifiedDiff(const CDeterministicMNList& to) const;
     CDeterministicMNList ApplyDiff(const CBlockIndex* pindex, const CDeterministicMNListDiff& diff) const;
 
+    /**
+     * Share the masternodes that are identical in base instead of keeping a copy of them. Lists derived from
+     * each other share their masternodes already, lists read from disk start with a copy of every masternode.
+     * Returns the number of masternodes now shared with base.
+     */
+    size_t InternMNs(const CDeterministicMNList& base);
+    /**
+     * Memory usage of the list. Masternodes also referenced by other lists only count for their share, map
+     * nodes that lists derived from each other share are counted in full.
+     */
+    size_t DynamicMemoryUsage() const;
+
     void AddMN(const CDeterministicMNCPtr& dmn, bool fBumpTotalCount = true);
     void UpdateMN(const CDeterministicMNCPtr& oldDmn, const CDeterministicMNStateCPtr& pdmnState);
     void UpdateMN(const uint256& proTxHash, const CDeterministicMNStateCPtr& pdmnState);
@@ -540,20 +566,146 @@ public:
     }
 };
 
+/**
+ * The masternodes paid in the blocks following a list, in payment order. Instead of sorting the list of every block,
+ * the schedule is moved forward with the diff of the next block, as long as that block changed nothing which affects
+ * the order besides paying the first masternode of the schedule. The paid masternode moves behind all the others, so
+ * the rest of the schedule still is the start of the payment order.
+ */
+class CDeterministicMNPayeeSchedule
+{
+private:
+    uint256 blockHash;
+    // proTxHashes
+    std::deque<uint256> payees;
+
+public:
+    const uint256& GetBlockHash() const { return blockHash; }
+    size_t size() const { return payees.size(); }
+
+    void Build(const uint256& _blockHash, const CDeterministicMNList& mnList, size_t nCount);
+    /** Move to the list of the next block, false if the schedule has to be built again */
+    bool Advance(const uint256& _blockHash, const CDeterministicMNList& mnList, const CDeterministicMNListDiff& diff);
+
+    CDeterministicMNCPtr GetPayee(const CDeterministicMNList& mnList) const;
+    void GetPayees(const CDeterministicMNList& mnList, size_t nCount, std::vector<CDeterministicMNCPtr>& result) const;
+};
+
+/**
+ * Cache of lists or diffs keyed by block hash. Entries carry an estimate of their memory usage and the
+ * least recently used ones are evicted by Trim() once the total goes over the limit. Inserting never
+ * evicts so references returned by Find() stay valid until the next Trim() or Erase().
+ */
+template<typename T>
+class CDeterministicMNLRUCache
+{
+private:
+    struct Entry {
+        T value;
+        size_t nUsage;
+        std::list<uint256>::iterator itLRU;
+    };
+    std::unordered_map<uint256, Entry, StaticSaltedHasher> mapEntries;
+    // most recently used first
+    std::list<uint256> listLRU;
+    size_t nUsage{0};
+    const size_t nMaxUsage;
+
+public:
+    explicit CDeterministicMNLRUCache(size_t nMaxUsageIn) : nMaxUsage(nMaxUsageIn) {}
+
+    const T* Find(const uint256& hash)
+    {
+        auto it = mapEntries.find(hash);
+        if (it == mapEntries.end()) {
+            return nullptr;
+        }
+        listLRU.splice(listLRU.begin(), listLRU, it->second.itLRU);
+        return &it->second.value;
+    }
+    // like try_emplace, an existing entry is kept but marked as used
+    const T& Insert(const uint256& hash, T value, size_t nValueUsage)
+    {
+        auto it = mapEntries.find(hash);
+        if (it != mapEntries.end()) {
+            listLRU.splice(listLRU.begin(), listLRU, it->second.itLRU);
+            return it->second.value;
+        }
+        listLRU.emplace_front(hash);
+        nUsage += nValueUsage;
+        return mapEntries.try_emplace(hash, Entry{std::move(value), nValueUsage, listLRU.begin()}).first->second.value;
+    }
+    void Erase(const uint256& hash)
+    {
+        auto it = mapEntries.find(hash);
+        if (it == mapEntries.end()) {
+            return;
+        }
+        nUsage -= it->second.nUsage;
+        listLRU.erase(it->second.itLRU);
+        mapEntries.erase(it);
+    }
+    // evict the least recently used entries until the usage is within the limit, the most recent one is always kept
+    void Trim()
+    {
+        while (nUsage > nMaxUsage && listLRU.size() > 1) {
+            Erase(listLRU.back());
+        }
+    }
+    template<typename Callback>
+    void ForEach(Callback&& cb) const
+    {
+        for (const auto& p : mapEntries) {
+            cb(p.first, p.second.value);
+        }
+    }
+    size_t Size() const { return mapEntries.size(); }
+    size_t Usage() const { return nUsage; }
+};
+
+/** Cost of list lookups, counted since startup */
+struct CDeterministicMNListStats {
+    uint64_t nLookups{0};
+    // lookups that were served from a cached or stored list without replaying diffs
+    uint64_t nDirectHits{0};
+    uint64_t nDiffsReplayed{0};
+    uint64_t nMaxReplay{0};
+    uint64_t nDiskReads{0};
+    uint64_t nSnapshotsWritten{0};
+    // masternodes of lists read from disk that were shared with the tip list instead of being kept as a copy
+    uint64_t nMNsInterned{0};
+    size_t nListsCached{0};
+    size_t nListsUsage{0};
+    size_t nDiffsCached{0};
+    size_t nDiffsUsage{0};
+};
+
 class CDeterministicMNManager
 {
     static const int DISK_SNAPSHOT_PERIOD = 576; // once per day
     static const int DISK_SNAPSHOTS = 3; // keep cache for 3 disk snapshots to have 2 full days covered
     static const int LIST_DIFFS_CACHE_SIZE = DISK_SNAPSHOT_PERIOD * DISK_SNAPSHOTS;
+    // a lookup never replays more diffs than this once the missing snapshots on its path have been written
+    static const int MAX_LIST_REPLAY = DISK_SNAPSHOT_PERIOD;
+    static const size_t MN_LISTS_CACHE_MAX_USAGE = 64 * 1024 * 1024;
+    static const size_t MN_LIST_DIFFS_CACHE_MAX_USAGE = 32 * 1024 * 1024;
+    // upcoming payees kept in the payee schedule, enough for the payee of about a day of blocks to be looked up
+    // without scanning the list
+    static const size_t PAYEE_SCHEDULE_SIZE = 576;
 
 public:
     mutable RecursiveMutex cs;
 
 private:
 
-    std::unordered_map<uint256, CDeterministicMNList, StaticSaltedHasher> mnListsCache;
-    std::unordered_map<uint256, CDeterministicMNListDiff, StaticSaltedHasher> mnListDiffsCache;
+    CDeterministicMNLRUCache<CDeterministicMNList> mnListsCache GUARDED_BY(cs){MN_LISTS_CACHE_MAX_USAGE};
+    CDeterministicMNLRUCache<CDeterministicMNListDiff> mnListDiffsCache GUARDED_BY(cs){MN_LIST_DIFFS_CACHE_MAX_USAGE};
+    CDeterministicMNListStats stats GUARDED_BY(cs);
+    // snapshots missing on the path of a long replay, lookups run on any thread so they are only written to
+    // the evo db by WritePendingSnapshots() when the next block is connected, until then lookups start from them
+    std::map<uint256, CDeterministicMNList> mapPendingSnapshots GUARDED_BY(cs);
     const CBlockIndex* tipIndex{};
+    CDeterministicMNPayeeSchedule payeeSchedule GUARDED_BY(cs);
 
 public:
     explicit CDeterministicMNManager();
@@ -564,12 +716,22 @@ public:
     void UpdatedBlockTip(const CBlockIndex* pindex);
 
     // the returned list will not contain the correct block hash (we can't know it yet as the coinbase TX is not updated yet)
-    bool BuildNewListFromBlock(const CBlock& block, const CBlockIndex* pindexPrev, BlockValidationState& state, CCoinsViewCache& view, CDeterministicMNList& mnListRet, bool debugLogs, const llmq::CFinalCommitmentTxPayload *qcIn = nullptr) EXCLUSIVE_LOCKS_REQUIRED(cs_main, cs);
-    static void HandleQuorumCommitment(const llmq::CFinalCommitment& qc, const CBlockIndex* pindexQuorum, CDeterministicMNList& mnList, bool debugLogs);
-    static void DecreasePoSePenalties(CDeterministicMNList& mnList);
+    // pDiffRet receives the changes to the list of pindexPrev, built from the masternodes the block touched only
+    bool BuildNewListFromBlock(const CBlock& block, const CBlockIndex* pindexPrev, BlockValidationState& state, CCoinsViewCache& view, CDeterministicMNList& mnListRet, bool debugLogs, const llmq::CFinalCommitmentTxPayload *qcIn = nullptr, CDeterministicMNListDiff* pDiffRet = nullptr) EXCLUSIVE_LOCKS_REQUIRED(cs_main, cs);
+    static void HandleQuorumCommitment(const llmq::CFinalCommitment& qc, const CBlockIndex* pindexQuorum, CDeterministicMNList& mnList, bool debugLogs, std::set<uint256>& setChangedRet);
+    static void DecreasePoSePenalties(CDeterministicMNList& mnList, std::set<uint256>& setChangedRet);
 
     void GetListForBlock(const CBlockIndex* pindex, CDeterministicMNList& result);
     void GetListAtChainTip(CDeterministicMNList& result);
+    /** Get the masternode paid in the block following pindexPrev, same as GetMNPayee() of its list */
+    CDeterministicMNCPtr GetMNPayee(const CBlockIndex* pindexPrev);
+    /** Get the masternodes paid in the blocks following pindexPrev, same as GetProjectedMNPayees() of its list */
+    void GetProjectedMNPayees(const CBlockIndex* pindexPrev, size_t nCount, std::vector<CDeterministicMNCPtr>& result);
+    /** Write the snapshots queued by lookups into the evo db transaction of the block being connected */
+    void WritePendingSnapshots() EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+    /** Get the changes a block made to the list, false if no diff is stored for it */
+    bool GetListDiffForBlock(const CBlockIndex* pindex, CDeterministicMNListDiff& diffRet);
+    CDeterministicMNListStats GetListStats();
 
     // Test if given TX is a ProRegTx which also contains the collateral at index n
     static bool IsProTxWithCollateral(const CTransactionRef& tx, uint32_t n);
@@ -578,6 +740,12 @@ public:
 
 private:
     void CleanupCache(int nHeight) EXCLUSIVE_LOCKS_REQUIRED(cs);
+    void UpdatePayeeSchedule(const CBlockIndex* pindexPrev, const CDeterministicMNList& mnList) EXCLUSIVE_LOCKS_REQUIRED(cs);
+    const CDeterministicMNListDiff* FindListDiff(const CBlockIndex* pindex) EXCLUSIVE_LOCKS_REQUIRED(cs);
+    // adds the list to mnListsCache unless it's cached already, the usage is estimated once when it's added
+    void CacheList(const uint256& blockHash, const CDeterministicMNList& mnList) EXCLUSIVE_LOCKS_REQUIRED(cs);
+    static size_t EstimateUsage(const CDeterministicMNList& mnList);
+    static size_t EstimateUsage(const CDeterministicMNListDiff& diff);
 };
 
 extern std::unique_ptr<CDeterministicMNManager> deterministicMNManager;
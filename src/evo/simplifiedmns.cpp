@@ -16,6 +16,7 @@
 #include <base58.h>
 #include <chainparams.h>
 #include <consensus/merkle.h>
+#include <crypto/sha256.h>
 #include <univalue.h>
 #include <validation.h>
 #include <node/blockstorage.h>
@@ -90,6 +91,180 @@ uint256 CSimplifiedMNList::CalcMerkleRoot(bool* pmutated) const
     return ComputeMerkleRoot(leaves, pmutated);
 }
 
+CSimplifiedMNListMerkleTree::CSimplifiedMNListMerkleTree() : vLevels(1) {}
+
+CSimplifiedMNListMerkleTree::~CSimplifiedMNListMerkleTree() = default;
+
+void CSimplifiedMNListMerkleTree::Recalc(std::vector<size_t>& vDirty, size_t nDirtyFrom)
+{
+    std::sort(vDirty.begin(), vDirty.end());
+    size_t l = 0;
+    for (; vLevels[l].size() > 1; l++) {
+        if (vLevels.size() == l + 1) {
+            vLevels.emplace_back();
+            vPairEqual.emplace_back();
+        }
+        std::vector<uint256>& vHashes = vLevels[l];
+        std::vector<uint256>& vParents = vLevels[l + 1];
+        std::vector<bool>& vEqual = vPairEqual[l];
+        const size_t nHashes = vHashes.size();
+        const size_t nParents = (nHashes + 1) / 2;
+        // a node with an inserted or erased node before it has new children, as have all nodes after it
+        nDirtyFrom = std::min(nDirtyFrom / 2, nParents);
+        for (size_t i = nParents; i < vEqual.size(); i++) {
+            nEqualPairs -= vEqual[i];
+        }
+        vParents.resize(nParents);
+        vEqual.resize(nParents);
+
+        const auto setEqual = [&](size_t i) {
+            const bool fEqual = 2 * i + 1 < nHashes && vHashes[2 * i] == vHashes[2 * i + 1];
+            if (vEqual[i] != fEqual) {
+                vEqual[i] = fEqual;
+                nEqualPairs = fEqual ? nEqualPairs + 1 : nEqualPairs - 1;
+            }
+        };
+        for (size_t& i : vDirty) {
+            i /= 2;
+        }
+        vDirty.erase(std::unique(vDirty.begin(), vDirty.end()), vDirty.end());
+        for (const size_t i : vDirty) {
+            if (i >= nDirtyFrom) {
+                break;
+            }
+            unsigned char buf[64];
+            memcpy(buf, vHashes[2 * i].begin(), 32);
+            memcpy(buf + 32, vHashes[std::min(2 * i + 1, nHashes - 1)].begin(), 32);
+            SHA256D64(vParents[i].begin(), buf, 1);
+            setEqual(i);
+        }
+        if (nDirtyFrom < nParents) {
+            // the last node of an odd level is paired with itself, as in ComputeMerkleRoot
+            if (nHashes & 1) {
+                vHashes.push_back(vHashes.back());
+            }
+            SHA256D64(vParents[nDirtyFrom].begin(), vHashes[2 * nDirtyFrom].begin(), nParents - nDirtyFrom);
+            vHashes.resize(nHashes);
+            for (size_t i = nDirtyFrom; i < nParents; i++) {
+                setEqual(i);
+            }
+        }
+    }
+    // drop the levels above the root when the tree got smaller
+    for (size_t k = l; k < vPairEqual.size(); k++) {
+        for (const bool fEqual : vPairEqual[k]) {
+            nEqualPairs -= fEqual;
+        }
+    }
+    vLevels.resize(l + 1);
+    vPairEqual.resize(l);
+}
+
+void CSimplifiedMNListMerkleTree::Build(const CDeterministicMNList& dmnList)
+{
+    std::vector<std::pair<uint256, uint256>> vLeaves;
+    vLeaves.reserve(dmnList.GetAllMNsCount());
+    dmnList.ForEachMN(false, [&](const CDeterministicMNCPtr& dmn) {
+        vLeaves.emplace_back(dmn->proTxHash, CSimplifiedMNListEntry(*dmn).CalcHash());
+    });
+    std::sort(vLeaves.begin(), vLeaves.end());
+
+    vProTxHashes.clear();
+    vProTxHashes.reserve(vLeaves.size());
+    vLevels.assign(1, {});
+    vLevels[0].reserve(vLeaves.size());
+    vPairEqual.clear();
+    nEqualPairs = 0;
+    for (const auto& p : vLeaves) {
+        vProTxHashes.emplace_back(p.first);
+        vLevels[0].emplace_back(p.second);
+    }
+    std::vector<size_t> vDirty;
+    Recalc(vDirty, 0);
+    mnList = std::make_unique<CDeterministicMNList>(dmnList);
+}
+
+void CSimplifiedMNListMerkleTree::Update(const CDeterministicMNList& dmnList, const CDeterministicMNListDiff& diff)
+{
+    if (!mnList) {
+        Build(dmnList);
+        return;
+    }
+
+    try {
+        ApplyDiff(dmnList, diff);
+    } catch (...) {
+        // the tree is left half updated, rebuild it on the next call
+        mnList.reset();
+        throw;
+    }
+}
+
+void CSimplifiedMNListMerkleTree::ApplyDiff(const CDeterministicMNList& dmnList, const CDeterministicMNListDiff& diff)
+{
+    std::vector<uint256>& vLeaves = vLevels[0];
+    std::vector<size_t> vDirty;
+    size_t nDirtyFrom = std::numeric_limits<size_t>::max();
+    const auto findLeaf = [&](const CDeterministicMNCPtr& dmn) {
+        if (!dmn) {
+            throw std::runtime_error(strprintf("%s: masternode of list diff not found", __func__));
+        }
+        const auto it = std::lower_bound(vProTxHashes.begin(), vProTxHashes.end(), dmn->proTxHash);
+        return std::make_pair(size_t(it - vProTxHashes.begin()), it != vProTxHashes.end() && *it == dmn->proTxHash);
+    };
+    for (const uint64_t nInternalId : diff.removedMns) {
+        const auto [nPos, fFound] = findLeaf(mnList->GetMNByInternalId(nInternalId));
+        if (!fFound) {
+            throw std::runtime_error(strprintf("%s: removed masternode not in tree", __func__));
+        }
+        vProTxHashes.erase(vProTxHashes.begin() + nPos);
+        vLeaves.erase(vLeaves.begin() + nPos);
+        nDirtyFrom = std::min(nDirtyFrom, nPos);
+    }
+    for (const auto& dmn : diff.addedMNs) {
+        const auto [nPos, fFound] = findLeaf(dmn);
+        if (fFound) {
+            throw std::runtime_error(strprintf("%s: added masternode %s already in tree", __func__, dmn->proTxHash.ToString()));
+        }
+        vProTxHashes.insert(vProTxHashes.begin() + nPos, dmn->proTxHash);
+        vLeaves.insert(vLeaves.begin() + nPos, CSimplifiedMNListEntry(*dmn).CalcHash());
+        nDirtyFrom = std::min(nDirtyFrom, nPos);
+    }
+    for (const auto& p : diff.updatedMNs) {
+        const auto dmn = dmnList.GetMNByInternalId(p.first);
+        const auto [nPos, fFound] = findLeaf(dmn);
+        if (!fFound) {
+            throw std::runtime_error(strprintf("%s: updated masternode %s not in tree", __func__, dmn->proTxHash.ToString()));
+        }
+        // most state changes do not touch the simplified entry
+        const uint256 hash = CSimplifiedMNListEntry(*dmn).CalcHash();
+        if (vLeaves[nPos] != hash) {
+            vLeaves[nPos] = hash;
+            vDirty.emplace_back(nPos);
+        }
+    }
+    if (!vDirty.empty() || nDirtyFrom != std::numeric_limits<size_t>::max()) {
+        Recalc(vDirty, nDirtyFrom);
+    }
+    *mnList = dmnList;
+}
+
+uint256 CSimplifiedMNListMerkleTree::GetBlockHash() const
+{
+    return mnList ? mnList->GetBlockHash() : uint256();
+}
+
+uint256 CSimplifiedMNListMerkleTree::GetRoot(bool* pmutated) const
+{
+    if (pmutated) {
+        *pmutated = nEqualPairs != 0;
+    }
+    if (vLevels.back().empty()) {
+        return uint256();
+    }
+    return vLevels.back()[0];
+}
+
 CSimplifiedMNListDiff::CSimplifiedMNListDiff() = default;
 
 CSimplifiedMNListDiff::~CSimplifiedMNListDiff() = default;
@@ -176,6 +351,61 @@ void CSimplifiedMNListDiff::ToJson(UniValue& obj) const
     obj.pushKV("merkleRootQuorums", merkleRootQuorums.ToString()); 
 }
 
+// light clients ask for the same diffs after every block, keep the built responses
+static const size_t MNLISTDIFF_CACHE_MAX_USAGE = 16 * 1024 * 1024;
+// diffs over more blocks than this are built from the full lists instead of the diffs of the blocks
+static const int MAX_COMPOSED_DIFF_BLOCKS = 100;
+
+static Mutex cs_mnListDiffCache;
+static CDeterministicMNLRUCache<CSimplifiedMNListDiff> mnListDiffCache GUARDED_BY(cs_mnListDiffCache){MNLISTDIFF_CACHE_MAX_USAGE};
+static CSimplifiedMNListDiffStats mnListDiffStats GUARDED_BY(cs_mnListDiffCache);
+
+// only look at the masternodes changed by the blocks after the base block, false if a block diff is missing
+static bool ComposeSimplifiedMNListDiff(const CBlockIndex* baseBlockIndex, const CBlockIndex* blockIndex,
+    const CDeterministicMNList& baseDmnList, const CDeterministicMNList& dmnList, CSimplifiedMNListDiff& diffRet)
+{
+    std::set<uint64_t> setInternalIds;
+    for (const CBlockIndex* pindex = blockIndex; pindex != baseBlockIndex; pindex = pindex->pprev) {
+        CDeterministicMNListDiff diff;
+        if (!deterministicMNManager->GetListDiffForBlock(pindex, diff)) {
+            return false;
+        }
+        for (const auto& dmn : diff.addedMNs) {
+            setInternalIds.emplace(dmn->GetInternalId());
+        }
+        for (const auto& p : diff.updatedMNs) {
+            setInternalIds.emplace(p.first);
+        }
+        setInternalIds.insert(diff.removedMns.begin(), diff.removedMns.end());
+    }
+
+    diffRet = CSimplifiedMNListDiff();
+    diffRet.baseBlockHash = baseDmnList.GetBlockHash();
+    diffRet.blockHash = dmnList.GetBlockHash();
+    // internal ids are never reused, so both lists agree on the masternode of an id
+    for (const uint64_t nInternalId : setInternalIds) {
+        const auto fromPtr = baseDmnList.GetMNByInternalId(nInternalId);
+        const auto toPtr = dmnList.GetMNByInternalId(nInternalId);
+        if (toPtr) {
+            if (!fromPtr || CSimplifiedMNListEntry(*fromPtr) != CSimplifiedMNListEntry(*toPtr)) {
+                diffRet.mnList.emplace_back(*toPtr);
+            }
+        } else if (fromPtr) {
+            diffRet.deletedMNs.emplace_back(fromPtr->proTxHash);
+        }
+    }
+    return true;
+}
+
+CSimplifiedMNListDiffStats GetSimplifiedMNListDiffStats()
+{
+    LOCK(cs_mnListDiffCache);
+    CSimplifiedMNListDiffStats ret = mnListDiffStats;
+    ret.nCached = mnListDiffCache.Size();
+    ret.nUsage = mnListDiffCache.Usage();
+    return ret;
+}
+
 bool BuildSimplifiedMNListDiff(const uint256& baseBlockHash, const uint256& blockHash, CSimplifiedMNListDiff& mnListDiffRet, std::string& errorRet)
 {
     if(!deterministicMNManager)
@@ -205,11 +435,29 @@ bool BuildSimplifiedMNListDiff(const uint256& baseBlockHash, const uint256& bloc
         return false;
     }
     
+    // the response only depends on the two blocks, which are both in the active chain
+    const uint256 cacheKey = ::SerializeHash(std::make_pair(baseBlockHash, blockHash));
+    {
+        LOCK(cs_mnListDiffCache);
+        mnListDiffStats.nRequests++;
+        if (const auto* cachedDiff = mnListDiffCache.Find(cacheKey)) {
+            mnListDiffStats.nCacheHits++;
+            mnListDiffRet = *cachedDiff;
+            return true;
+        }
+    }
+
     LOCK(deterministicMNManager->cs);
     CDeterministicMNList baseDmnList, dmnList;
     deterministicMNManager->GetListForBlock(baseBlockIndex, baseDmnList);
     deterministicMNManager->GetListForBlock(blockIndex, dmnList);
-    mnListDiffRet = baseDmnList.BuildSimplifiedDiff(dmnList);
+    bool fComposed = false;
+    if (blockIndex->nHeight - baseBlockIndex->nHeight <= MAX_COMPOSED_DIFF_BLOCKS) {
+        fComposed = ComposeSimplifiedMNListDiff(baseBlockIndex, blockIndex, baseDmnList, dmnList, mnListDiffRet);
+    }
+    if (!fComposed) {
+        mnListDiffRet = baseDmnList.BuildSimplifiedDiff(dmnList);
+    }
     // We need to return the value that was provided by the other peer as it otherwise won't be able to recognize the
     // response. This will usually be identical to the block found in baseBlockIndex. The only difference is when a
     // null block hash was provided to get the diff from the genesis block.
@@ -241,5 +489,12 @@ bool BuildSimplifiedMNListDiff(const uint256& baseBlockHash, const uint256& bloc
     }
     vMatch[0] = true; // only coinbase matches
     mnListDiffRet.cbTxMerkleTree = CPartialMerkleTree(vHashes, vMatch);
+
+    LOCK(cs_mnListDiffCache);
+    if (fComposed) {
+        mnListDiffStats.nComposed++;
+    }
+    mnListDiffCache.Insert(cacheKey, mnListDiffRet, sizeof(CSimplifiedMNListDiff) + ::GetSerializeSize(mnListDiffRet, PROTOCOL_VERSION));
+    mnListDiffCache.Trim();
     return true;
 }
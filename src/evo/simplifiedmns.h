@@ -13,6 +13,7 @@
 extern RecursiveMutex cs_main;
 class UniValue;
 class CDeterministicMNList;
+class CDeterministicMNListDiff;
 class CDeterministicMN;
 
 namespace llmq
@@ -75,6 +76,47 @@ public:
     uint256 CalcMerkleRoot(bool* pmutated = nullptr) const;
 };
 
+/**
+ * Merkle tree over the simplified entries of a masternode list, sorted by proRegTxHash.
+ * Every level of the tree is kept so moving it to another list only rehashes the entries
+ * which differ between the two lists and the paths from them to the root. The root
+ * matches CSimplifiedMNList::CalcMerkleRoot of the same list.
+ */
+class CSimplifiedMNListMerkleTree
+{
+private:
+    // the list the tree currently represents
+    std::unique_ptr<CDeterministicMNList> mnList;
+    // sorted proRegTxHashes of the leaves
+    std::vector<uint256> vProTxHashes;
+    // vLevels[0] are the entry hashes, the last level holds the root
+    std::vector<std::vector<uint256>> vLevels;
+    // vPairEqual[l][i] is set if both children of node i of level l + 1 are equal
+    std::vector<std::vector<bool>> vPairEqual;
+    size_t nEqualPairs{0};
+
+    void Recalc(std::vector<size_t>& vDirty, size_t nDirtyFrom);
+    void ApplyDiff(const CDeterministicMNList& dmnList, const CDeterministicMNListDiff& diff);
+
+public:
+    CSimplifiedMNListMerkleTree();
+    ~CSimplifiedMNListMerkleTree();
+
+    /** Rebuild the tree from every entry of a list */
+    void Build(const CDeterministicMNList& dmnList);
+    /**
+     * Move the tree to another list, only hashing the entries of diff. The diff must lead from the list
+     * the tree holds to dmnList, e.g. the stored diff of a block when moving from its parent to it.
+     */
+    void Update(const CDeterministicMNList& dmnList, const CDeterministicMNListDiff& diff);
+
+    /** Block hash of the list the tree holds, null if there is none */
+    uint256 GetBlockHash() const;
+    size_t GetLeafCount() const { return vProTxHashes.size(); }
+    /** Root of the tree, pmutated is set as by ComputeMerkleRoot */
+    uint256 GetRoot(bool* pmutated = nullptr) const;
+};
+
 /// P2P messages
 
 class CGetSimplifiedMNListDiff
@@ -119,6 +161,18 @@ public:
     void ToJson(UniValue& obj) const;
 };
 
+/** Counters of the GETMNLISTDIFF/protx diff responses since startup */
+struct CSimplifiedMNListDiffStats {
+    uint64_t nRequests{0};
+    // served from the cache of built responses
+    uint64_t nCacheHits{0};
+    // built from the diffs of the blocks in between instead of the full lists
+    uint64_t nComposed{0};
+    size_t nCached{0};
+    size_t nUsage{0};
+};
+
 bool BuildSimplifiedMNListDiff(const uint256& baseBlockHash, const uint256& blockHash, CSimplifiedMNListDiff& mnListDiffRet, std::string& errorRet);
+CSimplifiedMNListDiffStats GetSimplifiedMNListDiffStats();
 
 #endif //SYSCOIN_EVO_SIMPLIFIEDMNS_H
@@ -4,9 +4,11 @@
 
 #include <governance/governance.h>
 #include <bloom.h>
+#include <bls/bls_batchverifier.h>
 #include <chain.h>
 #include <consensus/validation.h>
 #include <governance/governanceclasses.h>
+#include <governance/governancedb.h>
 #include <governance/governanceobject.h>
 #include <governance/governancevalidators.h>
 #include <governance/governancevote.h>
@@ -20,6 +22,7 @@
 #include <util/system.h>
 #include <protocol.h>
 #include <evo/deterministicmns.h>
+#include <flatdatabase.h>
 #include <validationinterface.h>
 #include <shutdown.h>
 
@@ -27,7 +30,7 @@ CGovernanceManager governance;
 
 int nSubmittedFinalBudget;
 
-const std::string CGovernanceManager::SERIALIZATION_VERSION_STRING = "CGovernanceManager-Version-15";
+const std::string CGovernanceManager::SERIALIZATION_VERSION_STRING = "CGovernanceManager-Version-16";
 const int CGovernanceManager::MAX_TIME_FUTURE_DEVIATION = 60 * 60;
 const int CGovernanceManager::RELIABLE_PROPAGATION_TIME = 80;
 
@@ -72,7 +75,7 @@ bool CGovernanceManager::HaveVoteForHash(const uint256& nHash) const
     LOCK(cs);
 
     CGovernanceObject* pGovobj = nullptr;
-    return cmapVoteToObject.Get(nHash, pGovobj) && pGovobj->GetVoteFile().HasVote(nHash);
+    return cmapVoteToObject.Get(nHash, pGovobj) && governanceDb && governanceDb->HasVote(pGovobj->GetHash(), nHash);
 }
 
 int CGovernanceManager::GetVoteCount() const
@@ -86,7 +89,12 @@ bool CGovernanceManager::SerializeVoteForHash(const uint256& nHash, CDataStream&
     LOCK(cs);
 
     CGovernanceObject* pGovobj = nullptr;
-    return cmapVoteToObject.Get(nHash, pGovobj) && pGovobj->GetVoteFile().SerializeVoteToStream(nHash, ss);
+    CGovernanceVote vote;
+    if (!cmapVoteToObject.Get(nHash, pGovobj) || !governanceDb || !governanceDb->ReadVote(pGovobj->GetHash(), nHash, vote)) {
+        return false;
+    }
+    ss << vote;
+    return true;
 }
 
 void CGovernanceManager::ProcessMessage(CNode* pfrom, const std::string& strCommand, CDataStream& vRecv, CConnman& connman, PeerManager& peerman)
@@ -107,15 +115,80 @@ void CGovernanceManager::ProcessMessage(CNode* pfrom, const std::string& strComm
 
         vRecv >> nProp;
         vRecv >> filter;
-        
+
+        // peers which page the sync append the cursor of the page they want, the first page has a null cursor
+        bool fPaged = !vRecv.empty();
+        uint256 nCursor;
+        if (fPaged) {
+            vRecv >> nCursor;
+        }
+
         if (nProp == uint256()) {
-            SyncObjects(pfrom, connman, peerman);
+            SyncObjects(pfrom, fPaged, nCursor, connman, peerman);
         } else {
-            SyncSingleObjVotes(pfrom, nProp, filter, connman);
+            SyncSingleObjVotes(pfrom, nProp, filter, fPaged, nCursor, connman);
         }
         LogPrint(BCLog::GOBJECT, "MNGOVERNANCESYNC -- syncing governance objects to our peer %s\n", pfrom->addr.ToString());
     }
 
+    // A PAGE OF THE GOVERNANCE DATA WE ASKED FOR WAS SENT, ASK FOR THE NEXT ONE
+    else if (strCommand == NetMsgType::SYNCSTATUSCOUNT) {
+        int nItemID;
+        int nCount;
+        vRecv >> nItemID >> nCount;
+
+        if (nItemID != MASTERNODE_SYNC_GOVOBJ && nItemID != MASTERNODE_SYNC_GOVOBJ_VOTE) return;
+
+        // only paged replies carry a cursor, the object list of a peer which doesn't page was sent completely
+        if (vRecv.empty()) {
+            if (nItemID == MASTERNODE_SYNC_GOVOBJ) {
+                LOCK(cs);
+                auto itPeer = mapPagedSyncRequests.find(pfrom->GetId());
+                if (itPeer != mapPagedSyncRequests.end()) {
+                    itPeer->second.erase(uint256());
+                }
+            }
+            return;
+        }
+
+        uint256 nProp;
+        uint256 nCursor;
+        vRecv >> nProp >> nCursor;
+        if ((nItemID == MASTERNODE_SYNC_GOVOBJ) != nProp.IsNull()) return;
+
+        {
+            LOCK(cs);
+            // follow the pages of our own requests only and only forward, so that a peer can't make us ask for pages
+            // we didn't want or for the same page again
+            auto& mapRequests = mapPagedSyncRequests[pfrom->GetId()];
+            auto it = mapRequests.find(nProp);
+            if (it == mapRequests.end() || (!nCursor.IsNull() && !(it->second < nCursor))) {
+                if (mapRequests.empty()) {
+                    mapPagedSyncRequests.erase(pfrom->GetId());
+                }
+                LogPrint(BCLog::GOBJECT, "SYNCSTATUSCOUNT -- unexpected page, nItemID=%d nProp=%s nCursor=%s peer=%d\n", nItemID, nProp.ToString(), nCursor.ToString(), pfrom->GetId());
+                return;
+            }
+            setPagedSyncPeers.emplace(pfrom->GetId());
+
+            if (nCursor.IsNull() || (nItemID == MASTERNODE_SYNC_GOVOBJ_VOTE && !mapObjects.count(nProp))) {
+                LogPrint(BCLog::GOBJECT, "SYNCSTATUSCOUNT -- no more pages to request, nItemID=%d nProp=%s peer=%d\n", nItemID, nProp.ToString(), pfrom->GetId());
+                mapRequests.erase(it);
+                if (mapRequests.empty()) {
+                    mapPagedSyncRequests.erase(pfrom->GetId());
+                }
+                return;
+            }
+        }
+        LogPrint(BCLog::GOBJECT, "SYNCSTATUSCOUNT -- requesting next page, nItemID=%d nProp=%s nCursor=%s peer=%d\n", nItemID, nProp.ToString(), nCursor.ToString(), pfrom->GetId());
+
+        if (nItemID == MASTERNODE_SYNC_GOVOBJ) {
+            PushPagedSyncRequest(pfrom, uint256(), CBloomFilter(), nCursor, connman);
+        } else {
+            RequestGovernanceObject(pfrom, nProp, connman, true, nCursor);
+        }
+    }
+
     // A NEW GOVERNANCE OBJECT HAS ARRIVED
     else if (strCommand == NetMsgType::MNGOVERNANCEOBJECT) {
         // MAKE SURE WE HAVE A VALID REFERENCE TO THE TIP BEFORE CONTINUING
@@ -223,29 +296,248 @@ void CGovernanceManager::ProcessMessage(CNode* pfrom, const std::string& strComm
             return;
         }
 
+        // the signature is verified later as part of a batch
+        if (QueueVote(pfrom->GetId(), vote)) {
+            return;
+        }
+
         CGovernanceException exception;
-        if (ProcessVote(pfrom, vote, exception, connman)) {
-            LogPrint(BCLog::GOBJECT, "MNGOVERNANCEOBJECTVOTE -- %s new\n", strHash);
-            masternodeSync.BumpAssetLastTime("MNGOVERNANCEOBJECTVOTE");
-            vote.Relay(connman);
-        } else {
-            LogPrint(BCLog::GOBJECT, "MNGOVERNANCEOBJECTVOTE -- Rejected vote, error = %s\n", exception.what());
-            if ((exception.GetNodePenalty() != 0) && masternodeSync.IsSynced()) {
-                {
-                    LOCK(cs_main);
-                    peerman.ForgetTxHash(pfrom->GetId(), nHash);
-                }
-                peerman.Misbehaving(pfrom->GetId(), exception.GetNodePenalty(), "rejected vote");
+        bool fAccepted = ProcessVote(pfrom, vote, exception, connman);
+        ProcessVoteResult(pfrom->GetId(), vote, fAccepted, exception, connman, peerman);
+    }
+}
+
+void CGovernanceManager::ProcessVoteResult(NodeId nodeId, const CGovernanceVote& vote, bool fAccepted, const CGovernanceException& exception, CConnman& connman, PeerManager& peerman)
+{
+    const uint256& nHash = vote.GetHash();
+    if (fAccepted) {
+        LogPrint(BCLog::GOBJECT, "MNGOVERNANCEOBJECTVOTE -- %s new\n", nHash.ToString());
+        masternodeSync.BumpAssetLastTime("MNGOVERNANCEOBJECTVOTE");
+        vote.Relay(connman);
+    } else {
+        LogPrint(BCLog::GOBJECT, "MNGOVERNANCEOBJECTVOTE -- Rejected vote, error = %s\n", exception.what());
+        if ((exception.GetNodePenalty() != 0) && masternodeSync.IsSynced()) {
+            {
+                LOCK(cs_main);
+                peerman.ForgetTxHash(nodeId, nHash);
             }
-            return;
+            peerman.Misbehaving(nodeId, exception.GetNodePenalty(), "rejected vote");
         }
-        {
-            LOCK(cs_main);
-            peerman.ForgetTxHash(pfrom->GetId(), nHash);
+        return;
+    }
+    {
+        LOCK(cs_main);
+        peerman.ForgetTxHash(nodeId, nHash);
+    }
+    // SEND NOTIFICATION TO SCRIPT/ZMQ
+    GetMainSignals().NotifyGovernanceVote(std::make_shared<const CGovernanceVote>(vote));
+}
+
+bool CGovernanceManager::QueueVote(NodeId nodeId, const CGovernanceVote& vote)
+{
+    bool fUseVotingKey;
+    {
+        LOCK(cs);
+        // known, invalid and orphan votes don't need a signature check, ProcessVote handles them directly
+        if (cmapVoteToObject.HasKey(vote.GetHash()) || cmapInvalidVotes.HasKey(vote.GetHash())) {
+            return false;
+        }
+        auto it = mapObjects.find(vote.GetParentHash());
+        if (it == mapObjects.end() || it->second.IsSetCachedDelete() || it->second.IsSetExpired()) {
+            return false;
+        }
+        fUseVotingKey = it->second.GetObjectType() == GOVERNANCE_OBJECT_PROPOSAL && vote.GetSignal() == VOTE_SIGNAL_FUNDING;
+    }
+
+    LOCK(cs_pendingVotes);
+    if (!workThread.joinable() || pendingVotes.size() >= MAX_PENDING_VOTES) {
+        return false;
+    }
+    pendingVotes.emplace_back(PendingVote{nodeId, vote, fUseVotingKey, GetTimeMillis()});
+    if (pendingVotes.size() > voteVerifyStats.nMaxPending) {
+        voteVerifyStats.nMaxPending = pendingVotes.size();
+    }
+    return true;
+}
+
+std::vector<VoteSigCheck> CGovernanceManager::VerifyVoteSignatures(const std::vector<PendingVote>& vecVotes, size_t start, size_t count, const CDeterministicMNList& mnList)
+{
+    std::vector<VoteSigCheck> ret(count, VoteSigCheck::VALID);
+
+    // sources are nodes, so that a node sending invalid votes doesn't cause per vote verification for all others
+    CBLSBatchVerifier<NodeId, size_t> batchVerifier(false, true);
+    for (size_t i = start; i < start + count; i++) {
+        const CGovernanceVote& vote = vecVotes[i].vote;
+        auto dmn = mnList.GetMNByCollateral(vote.GetMasternodeOutpoint());
+        if (!dmn) {
+            // the masternode might have been added after mnList was taken
+            ret[i - start] = VoteSigCheck::UNCHECKED;
+            continue;
         }
-        // SEND NOTIFICATION TO SCRIPT/ZMQ
-        GetMainSignals().NotifyGovernanceVote(std::make_shared<const CGovernanceVote>(vote));
+        if (vecVotes[i].fUseVotingKey) {
+            ret[i - start] = vote.CheckSignature(dmn->pdmnState->keyIDVoting) ? VoteSigCheck::VALID : VoteSigCheck::INVALID;
+            continue;
+        }
+        CBLSSignature sig(vote.GetSignature());
+        const CBLSPublicKey& pubKey = dmn->pdmnState->pubKeyOperator.Get();
+        if (!sig.IsValid() || !pubKey.IsValid()) {
+            ret[i - start] = VoteSigCheck::INVALID;
+            continue;
+        }
+        batchVerifier.PushMessage(vecVotes[i].nodeId, i, vote.GetSignatureHash(), sig, pubKey);
+    }
+    batchVerifier.Verify();
+    for (size_t i : batchVerifier.badMessages) {
+        ret[i - start] = VoteSigCheck::INVALID;
     }
+    return ret;
+}
+
+void CGovernanceManager::UncheckChangedVoteKeys(const std::vector<PendingVote>& vecVotes, const CDeterministicMNList& mnListVerified, const CDeterministicMNList& mnListTip, std::vector<VoteSigCheck>& vecResults)
+{
+    if (mnListVerified.GetBlockHash() == mnListTip.GetBlockHash()) {
+        return;
+    }
+    for (size_t i = 0; i < vecVotes.size(); i++) {
+        if (vecResults[i] != VoteSigCheck::VALID) {
+            continue;
+        }
+        const COutPoint& mnOutpoint = vecVotes[i].vote.GetMasternodeOutpoint();
+        auto dmnVerified = mnListVerified.GetMNByCollateral(mnOutpoint);
+        auto dmnTip = mnListTip.GetMNByCollateral(mnOutpoint);
+        if (!dmnVerified || !dmnTip) {
+            vecResults[i] = VoteSigCheck::UNCHECKED;
+        } else if (vecVotes[i].fUseVotingKey ? dmnVerified->pdmnState->keyIDVoting != dmnTip->pdmnState->keyIDVoting :
+                                               !(dmnVerified->pdmnState->pubKeyOperator == dmnTip->pdmnState->pubKeyOperator)) {
+            vecResults[i] = VoteSigCheck::UNCHECKED;
+        }
+    }
+}
+
+bool CGovernanceManager::ProcessPendingVotes(CConnman& connman, PeerManager& peerman)
+{
+    std::vector<PendingVote> vecVotes;
+    {
+        LOCK(cs_pendingVotes);
+        size_t nCount = std::min(pendingVotes.size(), MAX_VOTES_PER_BATCH);
+        vecVotes.reserve(nCount);
+        for (size_t i = 0; i < nCount; i++) {
+            vecVotes.emplace_back(std::move(pendingVotes.front()));
+            pendingVotes.pop_front();
+        }
+    }
+    if (vecVotes.empty()) {
+        return false;
+    }
+
+    CDeterministicMNList mnList;
+    if (deterministicMNManager) {
+        deterministicMNManager->GetListAtChainTip(mnList);
+    }
+
+    int64_t nVerifyStart = GetTimeMicros();
+    std::vector<std::future<std::vector<VoteSigCheck>>> futures;
+    for (size_t start = 0; start < vecVotes.size(); start += VOTES_PER_VERIFY_TASK) {
+        size_t count = std::min(VOTES_PER_VERIFY_TASK, vecVotes.size() - start);
+        futures.emplace_back(verifyPool.push([&vecVotes, &mnList, start, count](int) {
+            return VerifyVoteSignatures(vecVotes, start, count, mnList);
+        }));
+    }
+    std::vector<VoteSigCheck> vecResults;
+    vecResults.reserve(vecVotes.size());
+    for (auto& future : futures) {
+        auto vecTaskResults = future.get();
+        vecResults.insert(vecResults.end(), vecTaskResults.begin(), vecTaskResults.end());
+    }
+    voteVerifyStats.nVerifyTimeUs += GetTimeMicros() - nVerifyStart;
+
+    // ProcessVote looks the masternode up in the list at the tip, which might have changed keys in the meantime
+    CDeterministicMNList mnListTip;
+    if (deterministicMNManager) {
+        deterministicMNManager->GetListAtChainTip(mnListTip);
+        UncheckChangedVoteKeys(vecVotes, mnList, mnListTip, vecResults);
+    }
+
+    int64_t nNow = GetTimeMillis();
+    for (size_t i = 0; i < vecVotes.size(); i++) {
+        const PendingVote& pendingVote = vecVotes[i];
+        if (vecResults[i] == VoteSigCheck::INVALID) {
+            voteVerifyStats.nInvalid++;
+        }
+        // invalid signatures are only punished after the same checks of the vote and its object as without batching
+        CGovernanceException exception;
+        bool fAccepted = ProcessVote(nullptr, pendingVote.vote, exception, connman, vecResults[i], &mnListTip);
+        ProcessVoteResult(pendingVote.nodeId, pendingVote.vote, fAccepted, exception, connman, peerman);
+        voteVerifyStats.nLatencyMs += nNow - pendingVote.nTimeReceived;
+    }
+    voteVerifyStats.nBatches++;
+    voteVerifyStats.nVotes += vecVotes.size();
+
+    LogPrint(BCLog::GOBJECT, "CGovernanceManager::%s -- processed %d votes, verification took %dus\n", __func__, vecVotes.size(), GetTimeMicros() - nVerifyStart);
+    return true;
+}
+
+void CGovernanceManager::WorkThreadMain(CConnman& connman, PeerManager& peerman)
+{
+    while (!workInterrupt) {
+        bool fMoreWork = ProcessPendingVotes(connman, peerman);
+        if (!fMoreWork && !workInterrupt.sleep_for(std::chrono::milliseconds(100))) {
+            return;
+        }
+    }
+}
+
+void CGovernanceManager::StartWorkerThread(CConnman& connman, PeerManager& peerman)
+{
+    // can't start new thread if we have one running already
+    if (workThread.joinable()) {
+        assert(false);
+    }
+
+    workInterrupt.reset();
+    verifyPool.Start(std::max(1, std::min(GetNumCores() - 1, MAX_VERIFY_THREADS)));
+    LOCK(cs_pendingVotes);
+    workThread = std::thread(&TraceThread<std::function<void()> >,
+        "govvotes",
+        std::function<void()>(std::bind(&CGovernanceManager::WorkThreadMain, this, std::ref(connman), std::ref(peerman))));
+}
+
+void CGovernanceManager::InterruptWorkerThread()
+{
+    workInterrupt();
+}
+
+void CGovernanceManager::StopWorkerThread()
+{
+    std::thread thread;
+    {
+        // from now on QueueVote refuses votes
+        LOCK(cs_pendingVotes);
+        thread = std::move(workThread);
+        // votes which were not verified yet are dropped, they are synced again from other peers
+        pendingVotes.clear();
+    }
+    if (!thread.joinable()) {
+        return;
+    }
+    // make sure to call InterruptWorkerThread() first
+    assert(workInterrupt);
+
+    thread.join();
+    verifyPool.Stop();
+}
+
+UniValue CGovernanceVoteVerifyStats::ToJson(size_t nPending) const
+{
+    UniValue ret(UniValue::VOBJ);
+    ret.pushKV("pending", (int64_t)nPending);
+    ret.pushKV("max_pending", nMaxPending.load());
+    ret.pushKV("batches", nBatches.load());
+    ret.pushKV("votes", nVotes.load());
+    ret.pushKV("invalid", nInvalid.load());
+    ret.pushKV("verify_time_us", nVerifyTimeUs.load());
+    ret.pushKV("avg_latency_ms", nVotes ? (double)nLatencyMs / nVotes : 0.0);
+    return ret;
 }
 
 void CGovernanceManager::CheckOrphanVotes(CGovernanceObject& govobj, CConnman& connman)
@@ -267,6 +559,9 @@ void CGovernanceManager::CheckOrphanVotes(CGovernanceObject& govobj, CConnman& c
         } else if (govobj.ProcessVote(nullptr, vote, e, connman)) {
             vote.Relay(connman);
             fRemove = true;
+            if (govobj.GetObjectType() == GOVERNANCE_OBJECT_TRIGGER) {
+                triggerman.InvalidateSuperblockCache();
+            }
         }
         if (fRemove) {
             cmmapOrphanVotes.Erase(nHash, pairVote);
@@ -304,6 +599,10 @@ void CGovernanceManager::AddGovernanceObject(CGovernanceObject& govobj, CConnman
             return;
         }
 
+        if (governanceDb) {
+            governanceDb->WriteObject(objpair.first->second);
+        }
+
         // SHOULD WE ADD THIS OBJECT TO ANY OTHER MANAGERS?
 
         LogPrint(BCLog::GOBJECT, "CGovernanceManager::AddGovernanceObject -- Before trigger block, GetDataAsPlainString = %s, nObjectType = %d\n",
@@ -419,6 +718,9 @@ void CGovernanceManager::UpdateCachesAndClean()
 
             mapErasedGovernanceObjects.insert(std::make_pair(nHash, nTimeExpired));
             mapObjects.erase(it++);
+            if (governanceDb) {
+                governanceDb->EraseObject(nHash);
+            }
         } else {
             // NOTE: triggers are handled via triggerman
             if (pObj->GetObjectType() == GOVERNANCE_OBJECT_PROPOSAL) {
@@ -432,6 +734,9 @@ void CGovernanceManager::UpdateCachesAndClean()
         }
     }
 
+    // votes were cleared, funding flags updated and objects erased
+    triggerman.InvalidateSuperblockCache();
+
     // forget about expired deleted objects
     auto s_it = mapErasedGovernanceObjects.begin();
     while (s_it != mapErasedGovernanceObjects.end()) {
@@ -543,6 +848,8 @@ void CGovernanceManager::DoMaintenance(CConnman& connman)
     // CHECK AND REMOVE - REPROCESS GOVERNANCE OBJECTS
 
     UpdateCachesAndClean();
+
+    FlushToDB();
 }
 
 bool CGovernanceManager::ConfirmInventoryRequest(const GenTxid& gtxid)
@@ -588,7 +895,7 @@ bool CGovernanceManager::ConfirmInventoryRequest(const GenTxid& gtxid)
     return true;
 }
 
-void CGovernanceManager::SyncSingleObjVotes(CNode* pnode, const uint256& nProp, const CBloomFilter& filter, CConnman& connman)
+void CGovernanceManager::SyncSingleObjVotes(CNode* pnode, const uint256& nProp, const CBloomFilter& filter, bool fPaged, const uint256& nCursor, CConnman& connman)
 {
     // do not provide any data until our node is synced
     if (!masternodeSync.IsSynced()) return;
@@ -618,50 +925,90 @@ void CGovernanceManager::SyncSingleObjVotes(CNode* pnode, const uint256& nProp,
         return;
     }
 
-    auto fileVotes = govobj.GetVoteFile();
+    if (!governanceDb) {
+        return;
+    }
+
+    CDeterministicMNList mnList;
+    if (deterministicMNManager) {
+        deterministicMNManager->GetListAtChainTip(mnList);
+    }
 
-    for (const auto& vote : fileVotes.GetVotes()) {
+    // pages are cut from the votes ordered by hash, so that they don't depend on the order votes were received in,
+    // and include the votes skipped below, so that a page never reads more than SYNC_PAGE_SIZE votes
+    int nVotesRead = 0;
+    uint256 nLastHash;
+    uint256 nNextCursor;
+    governanceDb->ForEachVote(nProp, fPaged ? nCursor : uint256(), [&](const CGovernanceVote& vote) {
         const uint256 &nVoteHash = vote.GetHash();
 
+        if (fPaged && nVotesRead >= SYNC_PAGE_SIZE) {
+            nNextCursor = nLastHash;
+            return false;
+        }
+        ++nVotesRead;
+        nLastHash = nVoteHash;
+
         bool onlyVotingKeyAllowed = govobj.GetObjectType() == GOVERNANCE_OBJECT_PROPOSAL && vote.GetSignal() == VOTE_SIGNAL_FUNDING;
 
-        if (filter.contains(nVoteHash) || !vote.IsValid(onlyVotingKeyAllowed)) {
-            continue;
+        if (filter.contains(nVoteHash) || !vote.IsValid(onlyVotingKeyAllowed, true, &mnList)) {
+            return true;
         }
         pnode->PushOtherInventory(CInv(MSG_GOVERNANCE_OBJECT_VOTE, nVoteHash));
         ++nVoteCount;
-    }
+        return true;
+    });
 
     CNetMsgMaker msgMaker(pnode->GetCommonVersion());
-    connman.PushMessage(pnode, msgMaker.Make(NetMsgType::SYNCSTATUSCOUNT, MASTERNODE_SYNC_GOVOBJ_VOTE, nVoteCount));
+    if (fPaged) {
+        connman.PushMessage(pnode, msgMaker.Make(NetMsgType::SYNCSTATUSCOUNT, MASTERNODE_SYNC_GOVOBJ_VOTE, nVoteCount, nProp, nNextCursor));
+    } else {
+        connman.PushMessage(pnode, msgMaker.Make(NetMsgType::SYNCSTATUSCOUNT, MASTERNODE_SYNC_GOVOBJ_VOTE, nVoteCount));
+    }
     LogPrint(BCLog::GOBJECT, "CGovernanceManager::%s -- sent %d votes to peer=%d\n", __func__, nVoteCount, pnode->GetId());
 }
 
-void CGovernanceManager::SyncObjects(CNode* pnode, CConnman& connman, PeerManager& peerman) const
+void CGovernanceManager::SyncObjects(CNode* pnode, bool fPaged, const uint256& nCursor, CConnman& connman, PeerManager& peerman)
 {
     // do not provide any data until our node is synced
     if (!masternodeSync.IsSynced()) return;
 
-    if (netfulfilledman.HasFulfilledRequest(pnode->addr, NetMsgType::MNGOVERNANCESYNC)) {
-        // Asking for the whole list multiple times in a short period of time is no good
-        LogPrint(BCLog::GOBJECT, "CGovernanceManager::%s -- peer already asked me for the list\n", __func__);
-        peerman.Misbehaving(pnode->GetId(), 20, "peer already asked for list");
-        return;
+    if (!fPaged || nCursor.IsNull()) {
+        if (netfulfilledman.HasFulfilledRequest(pnode->addr, NetMsgType::MNGOVERNANCESYNC)) {
+            // Asking for the whole list multiple times in a short period of time is no good
+            LogPrint(BCLog::GOBJECT, "CGovernanceManager::%s -- peer already asked me for the list\n", __func__);
+            peerman.Misbehaving(pnode->GetId(), 20, "peer already asked for list");
+            return;
+        }
+        netfulfilledman.AddFulfilledRequest(pnode->addr, NetMsgType::MNGOVERNANCESYNC);
+    } else {
+        // the following pages are only sent in order, the same limit as for the whole list applies
+        LOCK(cs);
+        auto it = mapObjSyncCursors.find(pnode->GetId());
+        if (it == mapObjSyncCursors.end() || it->second != nCursor) {
+            LogPrint(BCLog::GOBJECT, "CGovernanceManager::%s -- peer asked for a page we didn't offer, nCursor=%s peer=%d\n", __func__, nCursor.ToString(), pnode->GetId());
+            return;
+        }
     }
-    netfulfilledman.AddFulfilledRequest(pnode->addr, NetMsgType::MNGOVERNANCESYNC);
 
     int nObjCount = 0;
 
     // SYNC GOVERNANCE OBJECTS WITH OTHER CLIENT
 
-    LogPrint(BCLog::GOBJECT, "CGovernanceManager::%s -- syncing all objects to peer=%d\n", __func__, pnode->GetId());
+    LogPrint(BCLog::GOBJECT, "CGovernanceManager::%s -- syncing all objects to peer=%d, nCursor = %s\n", __func__, pnode->GetId(), nCursor.ToString());
 
     LOCK(cs);
 
+    uint256 nNextCursor;
+
     // all valid objects, no votes
-    for (const auto& objPair : mapObjects) {
-        uint256 nHash = objPair.first;
-        const CGovernanceObject& govobj = objPair.second;
+    for (auto it = nCursor.IsNull() ? mapObjects.begin() : mapObjects.upper_bound(nCursor); it != mapObjects.end(); ++it) {
+        if (fPaged && nObjCount >= SYNC_PAGE_SIZE) {
+            nNextCursor = std::prev(it)->first;
+            break;
+        }
+        uint256 nHash = it->first;
+        const CGovernanceObject& govobj = it->second;
         std::string strHash = nHash.ToString();
 
         LogPrint(BCLog::GOBJECT, "CGovernanceManager::%s -- attempting to sync govobj: %s, peer=%d\n", __func__, strHash, pnode->GetId());
@@ -679,7 +1026,16 @@ void CGovernanceManager::SyncObjects(CNode* pnode, CConnman& connman, PeerManage
     }
 
     CNetMsgMaker msgMaker(pnode->GetCommonVersion());
-    connman.PushMessage(pnode, msgMaker.Make(NetMsgType::SYNCSTATUSCOUNT, MASTERNODE_SYNC_GOVOBJ, nObjCount));
+    if (fPaged) {
+        if (nNextCursor.IsNull()) {
+            mapObjSyncCursors.erase(pnode->GetId());
+        } else {
+            mapObjSyncCursors[pnode->GetId()] = nNextCursor;
+        }
+        connman.PushMessage(pnode, msgMaker.Make(NetMsgType::SYNCSTATUSCOUNT, MASTERNODE_SYNC_GOVOBJ, nObjCount, uint256(), nNextCursor));
+    } else {
+        connman.PushMessage(pnode, msgMaker.Make(NetMsgType::SYNCSTATUSCOUNT, MASTERNODE_SYNC_GOVOBJ, nObjCount));
+    }
     LogPrint(BCLog::GOBJECT, "CGovernanceManager::%s -- sent %d objects to peer=%d\n", __func__, nObjCount, pnode->GetId());
 }
 
@@ -775,7 +1131,7 @@ bool CGovernanceManager::MasternodeRateCheck(const CGovernanceObject& govobj, bo
     return false;
 }
 
-bool CGovernanceManager::ProcessVote(CNode* pfrom, const CGovernanceVote& vote, CGovernanceException& exception, CConnman& connman)
+bool CGovernanceManager::ProcessVote(CNode* pfrom, const CGovernanceVote& vote, CGovernanceException& exception, CConnman& connman, VoteSigCheck sigCheck, const CDeterministicMNList* pmnList)
 {
     ENTER_CRITICAL_SECTION(cs)
     const uint256 &nHashVote = vote.GetHash();
@@ -824,7 +1180,10 @@ bool CGovernanceManager::ProcessVote(CNode* pfrom, const CGovernanceVote& vote,
         return false;
     }
 
-    bool fOk = govobj.ProcessVote(pfrom, vote, exception, connman) && cmapVoteToObject.Insert(nHashVote, &govobj);
+    bool fOk = govobj.ProcessVote(pfrom, vote, exception, connman, sigCheck, pmnList) && cmapVoteToObject.Insert(nHashVote, &govobj);
+    if (fOk && govobj.GetObjectType() == GOVERNANCE_OBJECT_TRIGGER) {
+        triggerman.InvalidateSuperblockCache();
+    }
     LEAVE_CRITICAL_SECTION(cs)
     return fOk;
 }
@@ -894,7 +1253,7 @@ void CGovernanceManager::CheckPostponedObjects(CConnman& connman)
     }
 }
 
-void CGovernanceManager::RequestGovernanceObject(CNode* pfrom, const uint256& nHash, CConnman& connman, bool fUseFilter)
+void CGovernanceManager::RequestGovernanceObject(CNode* pfrom, const uint256& nHash, CConnman& connman, bool fUseFilter, const uint256& nCursor)
 {
     if (!pfrom) {
         return;
@@ -902,8 +1261,6 @@ void CGovernanceManager::RequestGovernanceObject(CNode* pfrom, const uint256& nH
 
     LogPrint(BCLog::GOBJECT, "CGovernanceManager::RequestGovernanceObject -- nHash %s peer=%d\n", nHash.ToString(), pfrom->GetId());
 
-    CNetMsgMaker msgMaker(pfrom->GetCommonVersion());
-
     CBloomFilter filter;
 
     int nVoteCount = 0;
@@ -913,16 +1270,30 @@ void CGovernanceManager::RequestGovernanceObject(CNode* pfrom, const uint256& nH
 
         if (pObj) {
             filter = CBloomFilter(Params().GetConsensus().nGovernanceFilterElements, GOVERNANCE_FILTER_FP_RATE, GetRandInt(999999), BLOOM_UPDATE_ALL);
-            std::vector<CGovernanceVote> vecVotes = pObj->GetVoteFile().GetVotes();
-            nVoteCount = vecVotes.size();
-            for (const auto& vote : vecVotes) {
-                filter.insert(vote.GetHash());
+            const std::vector<uint256> vecVoteHashes = pObj->GetVoteHashes();
+            nVoteCount = vecVoteHashes.size();
+            for (const auto& nVoteHash : vecVoteHashes) {
+                filter.insert(nVoteHash);
             }
         }
     }
 
-    LogPrint(BCLog::GOBJECT, "CGovernanceManager::RequestGovernanceObject -- nHash %s nVoteCount %d peer=%d\n", nHash.ToString(), nVoteCount, pfrom->GetId());
-    connman.PushMessage(pfrom, msgMaker.Make(NetMsgType::MNGOVERNANCESYNC, nHash, filter));
+    LogPrint(BCLog::GOBJECT, "CGovernanceManager::RequestGovernanceObject -- nHash %s nVoteCount %d nCursor %s peer=%d\n", nHash.ToString(), nVoteCount, nCursor.ToString(), pfrom->GetId());
+    PushPagedSyncRequest(pfrom, nHash, filter, nCursor, connman);
+}
+
+void CGovernanceManager::PushPagedSyncRequest(CNode* pnode, const uint256& nProp, const CBloomFilter& filter, const uint256& nCursor, CConnman& connman)
+{
+    WITH_LOCK(cs, mapPagedSyncRequests[pnode->GetId()][nProp] = nCursor);
+
+    // the cursor asks for a paged reply, peers which don't support it ignore it and send everything at once
+    CNetMsgMaker msgMaker(pnode->GetCommonVersion());
+    connman.PushMessage(pnode, msgMaker.Make(NetMsgType::MNGOVERNANCESYNC, nProp, filter, nCursor));
+}
+
+void CGovernanceManager::RequestObjectList(CNode* pnode, CConnman& connman)
+{
+    PushPagedSyncRequest(pnode, uint256(), CBloomFilter(), uint256(), connman);
 }
 
 int CGovernanceManager::RequestGovernanceObjectVotes(CNode* pnode, CConnman& connman, const PeerManager& peerman)
@@ -934,8 +1305,6 @@ int CGovernanceManager::RequestGovernanceObjectVotes(CNode* pnode, CConnman& con
 
 int CGovernanceManager::RequestGovernanceObjectVotes(const std::vector<CNode*>& vNodesCopy, CConnman& connman, const PeerManager& peerman)
 {
-    static std::map<uint256, std::map<CService, int64_t> > mapAskedRecently;
-
     if (vNodesCopy.empty()) return -1;
 
     int64_t nNow = GetTime();
@@ -949,9 +1318,9 @@ int CGovernanceManager::RequestGovernanceObjectVotes(const std::vector<CNode*>&
     // Testnet is ~40 times smaller in masternode count, but only ~1000 masternodes usually vote,
     // so 1 obj on mainnet == ~10 objs or ~1000 votes on testnet. However we want to test a higher
     // number of votes to make sure it's robust enough, so aim at 2000 votes per masternode per request.
-    // On mainnet nMaxObjRequestsPerNode is always set to 1.
+    // On mainnet nMaxObjRequestsPerNode is always set to 1, unless the peer pages its replies.
     int nMaxObjRequestsPerNode = 1;
-    size_t nProjectedVotes = 2000;
+    size_t nProjectedVotes = SYNC_PAGE_SIZE;
     if (Params().NetworkIDString() != CBaseChainParams::MAIN) {
         CDeterministicMNList mnList;
         if(deterministicMNManager)
@@ -959,23 +1328,28 @@ int CGovernanceManager::RequestGovernanceObjectVotes(const std::vector<CNode*>&
         nMaxObjRequestsPerNode = std::max(1, int(nProjectedVotes / std::max(1, (int)mnList.GetValidMNsCount())));
     }
 
+    std::set<NodeId> setPagedPeers;
+    size_t nAskedRecently;
     {
-        LOCK(cs);
+        LOCK2(cs, cs_askedRecently);
 
         if (mapObjects.empty()) return -2;
 
+        setPagedPeers = setPagedSyncPeers;
+
         for (const auto& objPair : mapObjects) {
             uint256 nHash = objPair.first;
-            if (mapAskedRecently.count(nHash)) {
-                auto it = mapAskedRecently[nHash].begin();
-                while (it != mapAskedRecently[nHash].end()) {
+            auto itAsked = mapAskedRecently.find(nHash);
+            if (itAsked != mapAskedRecently.end()) {
+                auto it = itAsked->second.begin();
+                while (it != itAsked->second.end()) {
                     if (it->second < nNow) {
-                        mapAskedRecently[nHash].erase(it++);
+                        itAsked->second.erase(it++);
                     } else {
                         ++it;
                     }
                 }
-                if (mapAskedRecently[nHash].size() >= nPeersPerHashMax) continue;
+                if (itAsked->second.size() >= nPeersPerHashMax) continue;
             }
 
             if (objPair.second.GetObjectType() == GOVERNANCE_OBJECT_TRIGGER) {
@@ -984,31 +1358,35 @@ int CGovernanceManager::RequestGovernanceObjectVotes(const std::vector<CNode*>&
                 vOtherObjHashes.push_back(nHash);
             }
         }
+        nAskedRecently = mapAskedRecently.size();
     }
 
     LogPrint(BCLog::GOBJECT, "CGovernanceManager::RequestGovernanceObjectVotes -- start: vTriggerObjHashes %d vOtherObjHashes %d mapAskedRecently %d\n",
-        vTriggerObjHashes.size(), vOtherObjHashes.size(), mapAskedRecently.size());
+        vTriggerObjHashes.size(), vOtherObjHashes.size(), nAskedRecently);
 
     FastRandomContext insecure_rand;
     Shuffle(vTriggerObjHashes.begin(), vTriggerObjHashes.end(), insecure_rand);
     Shuffle(vOtherObjHashes.begin(), vOtherObjHashes.end(), insecure_rand);
 
-    for (int i = 0; i < nMaxObjRequestsPerNode; ++i) {
-        uint256 nHashGovobj;
-
+    // Every object is asked from a single peer per call, so that different peers are asked for different objects
+    // in parallel. The following calls ask other peers for the same object, up to nPeersPerHashMax, which only send
+    // the votes we didn't receive yet thanks to the filter.
+    std::map<NodeId, int> mapRequestsPerNode;
+    while (!vTriggerObjHashes.empty() || !vOtherObjHashes.empty()) {
         // ask for triggers first
-        if (vTriggerObjHashes.size()) {
-            nHashGovobj = vTriggerObjHashes.back();
-        } else {
-            if (vOtherObjHashes.empty()) break;
-            nHashGovobj = vOtherObjHashes.back();
-        }
+        auto& vObjHashes = vTriggerObjHashes.empty() ? vOtherObjHashes : vTriggerObjHashes;
+        const uint256 nHashGovobj = vObjHashes.back();
+
         bool fAsked = false;
+        bool fNodesLeft = false;
         for (CNode* pnode : vNodesCopy) {
             /// Don't try to sync any data from outbound non-relay "masternode" connections.
             // Inbound connection this early is most likely a "masternode" connection
             // initiated from another node, so skip it too.
             if (!pnode->CanRelay() || (fMasternodeMode && pnode->IsInboundConn())) continue;
+            // peers paging their replies never send more than a page per request
+            const int nMaxRequests = setPagedPeers.count(pnode->GetId()) ? std::max(nMaxObjRequestsPerNode, MAX_PAGED_OBJ_REQUESTS_PER_NODE) : nMaxObjRequestsPerNode;
+            if (mapRequestsPerNode[pnode->GetId()] >= nMaxRequests) continue;
             // stop early to prevent setAskFor overflow
             size_t nProjectedSize;
             {
@@ -1016,30 +1394,41 @@ int CGovernanceManager::RequestGovernanceObjectVotes(const std::vector<CNode*>&
                 nProjectedSize = peerman.GetRequestedCount(pnode->GetId()) + nProjectedVotes;
             }
             if (nProjectedSize > GetMaxInv()) continue;
+            fNodesLeft = true;
             // to early to ask the same node
-            if (mapAskedRecently[nHashGovobj].count(pnode->addr)) continue;
-            
+            if (WITH_LOCK(cs_askedRecently, return mapAskedRecently[nHashGovobj].count(pnode->addr))) continue;
 
             RequestGovernanceObject(pnode, nHashGovobj, connman, true);
-            mapAskedRecently[nHashGovobj][pnode->addr] = nNow + nTimeout;
+            WITH_LOCK(cs_askedRecently, mapAskedRecently[nHashGovobj][pnode->addr] = nNow + nTimeout);
+            mapRequestsPerNode[pnode->GetId()]++;
             fAsked = true;
-            // stop loop if max number of peers per obj was asked
-            if (mapAskedRecently[nHashGovobj].size() >= nPeersPerHashMax) break;
-        }
-        // NOTE: this should match `if` above (the one before `while`)
-        if (vTriggerObjHashes.size()) {
-            vTriggerObjHashes.pop_back();
-        } else {
-            vOtherObjHashes.pop_back();
+            break;
         }
-        if (!fAsked) i--;
+        // all peers are busy, keep the rest of the objects for the next call
+        if (!fAsked && !fNodesLeft) break;
+        vObjHashes.pop_back();
     }
     LogPrint(BCLog::GOBJECT, "CGovernanceManager::RequestGovernanceObjectVotes -- end: vTriggerObjHashes %d vOtherObjHashes %d mapAskedRecently %d\n",
-        vTriggerObjHashes.size(), vOtherObjHashes.size(), mapAskedRecently.size());
+        vTriggerObjHashes.size(), vOtherObjHashes.size(), WITH_LOCK(cs_askedRecently, return mapAskedRecently.size()));
 
     return int(vTriggerObjHashes.size() + vOtherObjHashes.size());
 }
 
+void CGovernanceManager::PeerDisconnected(const CNode& node)
+{
+    {
+        LOCK(cs);
+        mapObjSyncCursors.erase(node.GetId());
+        setPagedSyncPeers.erase(node.GetId());
+        mapPagedSyncRequests.erase(node.GetId());
+    }
+    // the votes the peer didn't send yet can be asked from other peers right away
+    LOCK(cs_askedRecently);
+    for (auto& p : mapAskedRecently) {
+        p.second.erase(node.addr);
+    }
+}
+
 bool CGovernanceManager::AcceptObjectMessage(const uint256& nHash)
 {
     LOCK(cs);
@@ -1071,9 +1460,8 @@ void CGovernanceManager::RebuildIndexes()
     cmapVoteToObject.Clear();
     for (auto& objPair : mapObjects) {
         CGovernanceObject& govobj = objPair.second;
-        std::vector<CGovernanceVote> vecVotes = govobj.GetVoteFile().GetVotes();
-        for (size_t i = 0; i < vecVotes.size(); ++i) {
-            cmapVoteToObject.Insert(vecVotes[i].GetHash(), &govobj);
+        for (const auto& nVoteHash : govobj.GetVoteHashes()) {
+            cmapVoteToObject.Insert(nVoteHash, &govobj);
         }
     }
 }
@@ -1106,6 +1494,190 @@ void CGovernanceManager::InitOnLoad()
     LogPrint(BCLog::GOBJECT, "     %s\n", ToString());
 }
 
+/**
+ * Reads governance.dat as written by CGovernanceManager before governanceDb, which kept every object with all of its
+ * votes in memory and dumped them to the flat file on shutdown
+ */
+class CGovernanceFlatFile
+{
+public:
+    static const std::string SERIALIZATION_VERSION_STRING;
+
+    struct object_rec {
+        CGovernanceObject govobj;
+        std::vector<CGovernanceVote> vecVotes;
+
+        template<typename Stream>
+        void Unserialize(Stream& s)
+        {
+            // the current votes are rebuilt from the votes by LoadVotes
+            CGovernanceObject::vote_m_t mapCurrentMNVotes;
+            int nMemoryVotes;
+            s >> govobj >> mapCurrentMNVotes >> nMemoryVotes >> vecVotes;
+        }
+    };
+
+    bool fValid{false};
+    std::map<uint256, int64_t> mapErasedGovernanceObjects;
+    CacheMap<uint256, CGovernanceVote> cmapInvalidVotes;
+    CGovernanceManager::vote_cmm_t cmmapOrphanVotes;
+    std::map<uint256, object_rec> mapObjects;
+    CGovernanceManager::txout_m_t mapLastMasternodeObject;
+    CDeterministicMNList lastMNListForVotingKeys;
+
+    template<typename Stream>
+    void Unserialize(Stream& s)
+    {
+        Clear();
+        std::string strVersion;
+        s >> strVersion;
+        if (strVersion != SERIALIZATION_VERSION_STRING) {
+            return;
+        }
+        s >> mapErasedGovernanceObjects;
+        s >> cmapInvalidVotes;
+        s >> cmmapOrphanVotes;
+        s >> mapObjects;
+        s >> mapLastMasternodeObject;
+        s >> lastMNListForVotingKeys;
+        fValid = true;
+    }
+
+    void Clear()
+    {
+        fValid = false;
+        mapErasedGovernanceObjects.clear();
+        cmapInvalidVotes.Clear();
+        cmmapOrphanVotes.Clear();
+        mapObjects.clear();
+        mapLastMasternodeObject.clear();
+        lastMNListForVotingKeys = CDeterministicMNList();
+    }
+
+    void CheckAndRemove() {}
+
+    std::string ToString() const
+    {
+        return strprintf("Governance flat file: objects: %d, erased objects: %d", mapObjects.size(), mapErasedGovernanceObjects.size());
+    }
+};
+
+const std::string CGovernanceFlatFile::SERIALIZATION_VERSION_STRING = "CGovernanceManager-Version-15";
+
+void CGovernanceManager::MigrateFlatFile()
+{
+    const fs::path pathFlatFile = GetDataDir() / "governance.dat";
+    if (!governanceDb || !fs::exists(pathFlatFile)) {
+        return;
+    }
+
+    int64_t nStart = GetTimeMillis();
+
+    CGovernanceFlatFile flatFile;
+    CFlatDB<CGovernanceFlatFile> flatdb("governance.dat", "magicGovernanceCache");
+    if (!flatdb.Load(flatFile) || !flatFile.fValid) {
+        LogPrintf("CGovernanceManager::%s -- unable to read %s, governance objects and votes are synced again\n", __func__, pathFlatFile.string());
+    } else {
+        LOCK(cs);
+
+        // votes first, so that a crash before the objects are written only repeats the migration
+        size_t nVoteCount = 0;
+        std::vector<const CGovernanceObject*> vecObjects;
+        for (const auto& objPair : flatFile.mapObjects) {
+            governanceDb->WriteVotes(objPair.second.vecVotes);
+            nVoteCount += objPair.second.vecVotes.size();
+            vecObjects.emplace_back(&objPair.second.govobj);
+        }
+
+        Clear();
+        mapErasedGovernanceObjects = flatFile.mapErasedGovernanceObjects;
+        for (const auto& item : flatFile.cmapInvalidVotes.GetItemList()) {
+            cmapInvalidVotes.Insert(item.key, item.value);
+        }
+        for (const auto& item : flatFile.cmmapOrphanVotes.GetItemList()) {
+            cmmapOrphanVotes.Insert(item.key, item.value);
+        }
+        mapLastMasternodeObject = flatFile.mapLastMasternodeObject;
+        lastMNListForVotingKeys = std::make_shared<CDeterministicMNList>(flatFile.lastMNListForVotingKeys);
+        governanceDb->WriteManagerState(*this, vecObjects);
+        // the state is read back together with the objects by LoadFromDB
+        Clear();
+
+        LogPrintf("Migrated %d governance objects and %d votes from %s  %dms\n", vecObjects.size(), nVoteCount, pathFlatFile.string(), GetTimeMillis() - nStart);
+    }
+
+    fs::remove(pathFlatFile);
+}
+
+void CGovernanceManager::LoadFromDB()
+{
+    if (!governanceDb) {
+        return;
+    }
+
+    LOCK(cs);
+    int64_t nStart = GetTimeMillis();
+
+    Clear();
+    if (!governanceDb->ReadManagerState(*this)) {
+        LogPrint(BCLog::GOBJECT, "CGovernanceManager::%s -- no governance state in db\n", __func__);
+    }
+
+    size_t nVoteCount = 0;
+    governanceDb->ForEachObject([&](const uint256& nHash, CGovernanceObject& govobj) {
+        if (govobj.GetHash() != nHash) {
+            LogPrintf("CGovernanceManager::%s -- object %s stored as %s, skipping\n", __func__, govobj.GetHash().ToString(), nHash.ToString());
+            return true;
+        }
+        auto objpair = mapObjects.try_emplace(nHash, govobj);
+        objpair.first->second.SetStored();
+        auto vecVotes = governanceDb->ReadVotes(nHash);
+        nVoteCount += vecVotes.size();
+        objpair.first->second.LoadVotes(vecVotes);
+        return !ShutdownRequested();
+    });
+
+    LogPrintf("Loaded %d governance objects and %d votes from db  %dms\n", mapObjects.size(), nVoteCount, GetTimeMillis() - nStart);
+}
+
+void CGovernanceManager::FlushToDB()
+{
+    if (!governanceDb) {
+        return;
+    }
+
+    LOCK(cs);
+    int64_t nStart = GetTimeMillis();
+
+    std::vector<const CGovernanceObject*> vecObjects;
+    for (const auto& objPair : mapObjects) {
+        if (objPair.second.HasUnstoredFlags()) {
+            vecObjects.emplace_back(&objPair.second);
+        }
+    }
+    governanceDb->WriteManagerState(*this, vecObjects);
+    for (auto& objPair : mapObjects) {
+        objPair.second.SetStored();
+    }
+
+    LogPrint(BCLog::GOBJECT, "CGovernanceManager::%s -- flushed %d of %d objects  %dms\n", __func__, vecObjects.size(), mapObjects.size(), GetTimeMillis() - nStart);
+}
+
+void CGovernanceManager::Clear()
+{
+    LOCK(cs);
+
+    LogPrint(BCLog::GOBJECT, "Governance object manager was cleared\n");
+    mapObjects.clear();
+    mapErasedGovernanceObjects.clear();
+    cmapVoteToObject.Clear();
+    cmapInvalidVotes.Clear();
+    cmmapOrphanVotes.Clear();
+    mapLastMasternodeObject.clear();
+    // the cached superblocks point to the cleared triggers
+    triggerman.InvalidateSuperblockCache();
+}
+
 std::string CGovernanceManager::ToString() const
 {
     LOCK(cs);
@@ -1163,6 +1735,8 @@ UniValue CGovernanceManager::ToJson() const
     jsonObj.pushKV("other", nOtherCount);
     jsonObj.pushKV("erased", (int)mapErasedGovernanceObjects.size());
     jsonObj.pushKV("votes", (int)cmapVoteToObject.GetSize());
+    size_t nPendingVotes = WITH_LOCK(cs_pendingVotes, return pendingVotes.size());
+    jsonObj.pushKV("vote_verification", voteVerifyStats.ToJson(nPendingVotes));
     return jsonObj;
 }
 
@@ -1186,6 +1760,9 @@ void CGovernanceManager::UpdatedBlockTip(const CBlockIndex* pindex, CConnman& co
 
     CheckPostponedObjects(connman);
 
+    // the new masternode list may change the votes required to fund triggers
+    WITH_LOCK(cs, triggerman.InvalidateSuperblockCache());
+
     CSuperblockManager::ExecuteBestSuperblock(pindex->nHeight);
 }
 
@@ -5,9 +5,16 @@
 #ifndef SYSCOIN_GOVERNANCE_GOVERNANCE_H
 #define SYSCOIN_GOVERNANCE_GOVERNANCE_H
 
+#include <bls/bls_workerpool.h>
 #include <cachemap.h>
 #include <cachemultimap.h>
 #include <governance/governanceobject.h>
+#include <netaddress.h>
+#include <threadinterrupt.h>
+
+#include <atomic>
+#include <deque>
+#include <thread>
 
 class CBloomFilter;
 class CBlockIndex;
@@ -17,6 +24,11 @@ class CGovernanceTriggerManager;
 class CGovernanceObject;
 class CGovernanceVote;
 class PeerManager;
+typedef int64_t NodeId;
+namespace governance_classes_tests
+{
+class CSuperblockCacheForTest;
+}
 
 extern CGovernanceManager governance;
 
@@ -118,12 +130,29 @@ public:
     }
 };
 
+/** Counters of the batched verification of incoming votes */
+class CGovernanceVoteVerifyStats
+{
+public:
+    std::atomic<uint64_t> nBatches{0};
+    std::atomic<uint64_t> nVotes{0};
+    std::atomic<uint64_t> nInvalid{0};
+    std::atomic<uint64_t> nMaxPending{0};
+    // time spent on signature verification
+    std::atomic<uint64_t> nVerifyTimeUs{0};
+    // time votes waited in the queue until they were processed
+    std::atomic<uint64_t> nLatencyMs{0};
+
+    UniValue ToJson(size_t nPending) const;
+};
+
 //
 // Governance Manager : Contains all proposals for the budget
 //
 class CGovernanceManager
 {
     friend class CGovernanceObject;
+    friend class governance_classes_tests::CSuperblockCacheForTest;
 
 public: // Types
     struct last_object_rec {
@@ -152,9 +181,27 @@ public: // Types
 
     typedef std::set<uint256> hash_s_t;
 
+    struct PendingVote {
+        NodeId nodeId;
+        CGovernanceVote vote;
+        // proposal funding votes are signed with the voting key (ECDSA), all others with the operator key (BLS)
+        bool fUseVotingKey;
+        int64_t nTimeReceived;
+    };
+
 private:
     static const int MAX_CACHE_SIZE = 1000000;
 
+    // votes beyond this are verified directly by the message handler
+    static const size_t MAX_PENDING_VOTES = 100000;
+    static const size_t MAX_VOTES_PER_BATCH = 4000;
+    // votes verified by a single task of the verification pool
+    static const size_t VOTES_PER_VERIFY_TASK = 250;
+    static const int MAX_VERIFY_THREADS = 4;
+
+    // votes of this many objects are fetched at once from a peer which pages its replies
+    static const int MAX_PAGED_OBJ_REQUESTS_PER_NODE = 4;
+
     static const std::string SERIALIZATION_VERSION_STRING;
 
     static const int MAX_TIME_FUTURE_DEVIATION;
@@ -193,6 +240,28 @@ private:
     // used to check for changed voting keys
     CDeterministicMNListPtr lastMNListForVotingKeys;
 
+    // incoming votes for known objects, verified in batches by the worker thread
+    mutable Mutex cs_pendingVotes;
+    std::deque<PendingVote> pendingVotes GUARDED_BY(cs_pendingVotes);
+
+    std::thread workThread;
+    CThreadInterrupt workInterrupt;
+    CBLSWorkerPool verifyPool;
+
+    CGovernanceVoteVerifyStats voteVerifyStats;
+
+    // the page of our object list each peer may ask for next
+    std::map<NodeId, uint256> mapObjSyncCursors;
+    // peers which reply to MNGOVERNANCESYNC in pages
+    std::set<NodeId> setPagedSyncPeers;
+    // the MNGOVERNANCESYNC requests sent to each peer which weren't answered completely yet, by the object whose votes
+    // were asked for (null for the object list) and the cursor of the page asked for
+    std::map<NodeId, std::map<uint256, uint256>> mapPagedSyncRequests;
+
+    // peers asked for the votes of an object and the time until they may be asked again
+    Mutex cs_askedRecently;
+    std::map<uint256, std::map<CService, int64_t> > mapAskedRecently GUARDED_BY(cs_askedRecently);
+
     class ScopedLockBool
     {
         bool& ref;
@@ -214,6 +283,9 @@ private:
     };
 
 public:
+    // objects sent or votes read per MNGOVERNANCESYNC request of a peer which pages its sync
+    static const int SYNC_PAGE_SIZE = 2000;
+
     // critical section to protect the inner data structures
     mutable RecursiveMutex cs;
 
@@ -228,8 +300,11 @@ public:
      */
     bool ConfirmInventoryRequest(const GenTxid& gtxid);
 
-    void SyncSingleObjVotes(CNode* pnode, const uint256& nProp, const CBloomFilter& filter, CConnman& connman);
-    void SyncObjects(CNode* pnode, CConnman& connman, PeerManager &peerman) const;
+    // fPaged replies with at most SYNC_PAGE_SIZE items with hashes above nCursor, and the cursor of the next page
+    void SyncSingleObjVotes(CNode* pnode, const uint256& nProp, const CBloomFilter& filter, bool fPaged, const uint256& nCursor, CConnman& connman);
+    void SyncObjects(CNode* pnode, bool fPaged, const uint256& nCursor, CConnman& connman, PeerManager &peerman);
+    // ask for the first page of the object list of the peer, the following pages are requested as they arrive
+    void RequestObjectList(CNode* pnode, CConnman& connman);
 
     void ProcessMessage(CNode* pfrom, const std::string& strCommand, CDataStream& vRecv, CConnman& connman, PeerManager& peerman);
 
@@ -247,22 +322,12 @@ public:
 
     void CheckAndRemove() { UpdateCachesAndClean(); }
 
-    void Clear()
-    {
-        LOCK(cs);
-
-        LogPrint(BCLog::GOBJECT, "Governance object manager was cleared\n");
-        mapObjects.clear();
-        mapErasedGovernanceObjects.clear();
-        cmapVoteToObject.Clear();
-        cmapInvalidVotes.Clear();
-        cmmapOrphanVotes.Clear();
-        mapLastMasternodeObject.clear();
-    }
+    void Clear();
 
     std::string ToString() const;
     UniValue ToJson() const;
 
+    // Objects and votes are stored in CGovernanceDB as they are accepted, this only covers the remaining state
     template<typename Stream>
     void Serialize(Stream& s) const
     {
@@ -273,7 +338,6 @@ public:
         s << mapErasedGovernanceObjects;
         s << cmapInvalidVotes;
         s << cmmapOrphanVotes;
-        s << mapObjects;
         s << mapLastMasternodeObject;
         s << *lastMNListForVotingKeys;
    
@@ -292,7 +356,6 @@ public:
         s >> mapErasedGovernanceObjects;
         s >> cmapInvalidVotes;
         s >> cmmapOrphanVotes;
-        s >> mapObjects;
         s >> mapLastMasternodeObject;
         s >> *lastMNListForVotingKeys;
     }
@@ -345,18 +408,50 @@ public:
 
     void InitOnLoad();
 
+    // Move the objects, votes and state of the governance.dat flat file used before governanceDb into it, then remove the file
+    void MigrateFlatFile();
+    // Load objects, votes and the remaining state from governanceDb
+    void LoadFromDB();
+    // Write the state which is not written as it changes (changed object flags, rate checks, orphan and invalid votes)
+    void FlushToDB();
+
     int RequestGovernanceObjectVotes(CNode* pnode, CConnman& connman, const PeerManager& peerman);
     int RequestGovernanceObjectVotes(const std::vector<CNode*>& vNodesCopy, CConnman& connman, const PeerManager& peerman);
 
+    // forget the sync state of the peer, so the votes it didn't send are fetched from other peers
+    void PeerDisconnected(const CNode& node);
+
+    void StartWorkerThread(CConnman& connman, PeerManager& peerman);
+    void InterruptWorkerThread();
+    void StopWorkerThread();
+
+    const CGovernanceVoteVerifyStats& GetVoteVerifyStats() const { return voteVerifyStats; }
+
+    /// Verify the signatures of vecVotes[start, start + count) against the keys in mnList, votes of masternodes which
+    /// are not in mnList are left unchecked
+    static std::vector<VoteSigCheck> VerifyVoteSignatures(const std::vector<PendingVote>& vecVotes, size_t start, size_t count, const CDeterministicMNList& mnList);
+    /// Mark valid votes as unchecked if the key they were verified with is not the one of the masternode in mnListTip anymore
+    static void UncheckChangedVoteKeys(const std::vector<PendingVote>& vecVotes, const CDeterministicMNList& mnListVerified, const CDeterministicMNList& mnListTip, std::vector<VoteSigCheck>& vecResults);
+
 private:
-    void RequestGovernanceObject(CNode* pfrom, const uint256& nHash, CConnman& connman, bool fUseFilter = false);
+    void RequestGovernanceObject(CNode* pfrom, const uint256& nHash, CConnman& connman, bool fUseFilter = false, const uint256& nCursor = uint256());
+    // remembers the request, so that only the pages which were asked for are followed
+    void PushPagedSyncRequest(CNode* pnode, const uint256& nProp, const CBloomFilter& filter, const uint256& nCursor, CConnman& connman);
 
     void AddInvalidVote(const CGovernanceVote& vote)
     {
         cmapInvalidVotes.Insert(vote.GetHash(), vote);
     }
 
-    bool ProcessVote(CNode* pfrom, const CGovernanceVote& vote, CGovernanceException& exception, CConnman& connman);
+    // sigCheck and pmnList are passed on to CGovernanceObject::ProcessVote
+    bool ProcessVote(CNode* pfrom, const CGovernanceVote& vote, CGovernanceException& exception, CConnman& connman, VoteSigCheck sigCheck = VoteSigCheck::UNCHECKED, const CDeterministicMNList* pmnList = nullptr);
+
+    /// Queue a vote for batched verification, returns false if it has to be processed directly
+    bool QueueVote(NodeId nodeId, const CGovernanceVote& vote);
+    void WorkThreadMain(CConnman& connman, PeerManager& peerman);
+    bool ProcessPendingVotes(CConnman& connman, PeerManager& peerman);
+    /// Relay and notify accepted votes, penalize the peer for invalid ones
+    void ProcessVoteResult(NodeId nodeId, const CGovernanceVote& vote, bool fAccepted, const CGovernanceException& exception, CConnman& connman, PeerManager& peerman);
 
     /// Called to indicate a requested object has been received
     bool AcceptObjectMessage(const uint256& nHash);
@@ -99,6 +99,8 @@ CAmount ParsePaymentAmount(const std::string& strAmount)
 
 bool CGovernanceTriggerManager::AddNewTrigger(uint256 nHash)
 {
+    AssertLockHeld(governance.cs);
+
     // IF WE ALREADY HAVE THIS HASH, RETURN
     if (mapTrigger.count(nHash)) {
         LogPrint(BCLog::GOBJECT, "CGovernanceTriggerManager::AddNewTrigger -- Already have hash, nHash = %s, count = %d, size = %s\n",
@@ -121,6 +123,7 @@ bool CGovernanceTriggerManager::AddNewTrigger(uint256 nHash)
     pSuperblock->SetStatus(SEEN_OBJECT_IS_VALID);
 
     mapTrigger.insert(std::make_pair(nHash, pSuperblock));
+    InvalidateSuperblockCache();
 
     return true;
 }
@@ -133,6 +136,8 @@ bool CGovernanceTriggerManager::AddNewTrigger(uint256 nHash)
 
 void CGovernanceTriggerManager::CleanAndRemove()
 {
+    AssertLockHeld(governance.cs);
+
     // Remove triggers that are invalid or expired
     LogPrint(BCLog::GOBJECT, "CGovernanceTriggerManager::CleanAndRemove -- mapTrigger.size() = %d\n", mapTrigger.size());
 
@@ -184,6 +189,7 @@ void CGovernanceTriggerManager::CleanAndRemove()
             LogPrint(BCLog::GOBJECT, "CGovernanceTriggerManager::CleanAndRemove -- Removing trigger object %s\n", strDataAsPlainString);
             // delete the trigger
             mapTrigger.erase(it++);
+            InvalidateSuperblockCache();
         } else {
             ++it;
         }
@@ -213,6 +219,18 @@ std::vector<CSuperblock_sptr> CGovernanceTriggerManager::GetActiveTriggers()
     return vecResults;
 }
 
+/**
+*   Invalidate Superblock Cache
+*
+*   - Forget the evaluated triggers, they are evaluated again on the next query
+*/
+
+void CGovernanceTriggerManager::InvalidateSuperblockCache()
+{
+    AssertLockHeld(governance.cs);
+    mapSuperblockCache.clear();
+}
+
 /**
 *   Is Superblock Triggered
 *
@@ -227,6 +245,12 @@ bool CSuperblockManager::IsSuperblockTriggered(int nBlockHeight)
     }
 
     LOCK(governance.cs);
+    return GetCachedSuperblock(nBlockHeight).fTriggered;
+}
+
+bool CSuperblockManager::FindTriggeredSuperblock(int nBlockHeight)
+{
+    AssertLockHeld(governance.cs);
     // GET ALL ACTIVE TRIGGERS
     std::vector<CSuperblock_sptr> vecTriggers = triggerman.GetActiveTriggers();
 
@@ -278,8 +302,20 @@ bool CSuperblockManager::GetBestSuperblock(CSuperblock_sptr& pSuperblockRet, int
         return false;
     }
 
+    AssertLockHeld(governance.cs);
+    const auto& entry = GetCachedSuperblock(nBlockHeight);
+    if (!entry.pBestSuperblock) {
+        return false;
+    }
+    pSuperblockRet = entry.pBestSuperblock;
+    return true;
+}
+
+CSuperblock_sptr CSuperblockManager::FindBestSuperblock(int nBlockHeight)
+{
     AssertLockHeld(governance.cs);
     std::vector<CSuperblock_sptr> vecTriggers = triggerman.GetActiveTriggers();
+    CSuperblock_sptr pSuperblockRet;
     int nYesCount = 0;
 
     for (const auto& pSuperblock : vecTriggers) {
@@ -302,29 +338,27 @@ bool CSuperblockManager::GetBestSuperblock(CSuperblock_sptr& pSuperblockRet, int
         }
     }
 
-    return nYesCount > 0;
+    return pSuperblockRet;
 }
 
 /**
-*   Get Superblock Payments
+*   Get Cached Superblock
 *
-*   - Returns payments for superblock
+*   - Evaluates the triggers for the height once, until the cache is invalidated
 */
 
-bool CSuperblockManager::GetSuperblockPayments(int nBlockHeight, std::vector<CTxOut>& voutSuperblockRet)
+const CGovernanceTriggerManager::SuperblockCacheEntry& CSuperblockManager::GetCachedSuperblock(int nBlockHeight)
 {
-    LOCK(governance.cs);
-
-    // GET THE BEST SUPERBLOCK FOR THIS BLOCK HEIGHT
+    AssertLockHeld(governance.cs);
 
-    CSuperblock_sptr pSuperblock;
-    if (!CSuperblockManager::GetBestSuperblock(pSuperblock, nBlockHeight)) {
-        LogPrint(BCLog::GOBJECT, "CSuperblockManager::GetSuperblockPayments -- Can't find superblock for height %d\n", nBlockHeight);
-        return false;
+    auto it = triggerman.mapSuperblockCache.find(nBlockHeight);
+    if (it != triggerman.mapSuperblockCache.end()) {
+        return it->second;
     }
 
-    // make sure it's empty, just in case
-    voutSuperblockRet.clear();
+    CGovernanceTriggerManager::SuperblockCacheEntry entry;
+    entry.fTriggered = FindTriggeredSuperblock(nBlockHeight);
+    entry.pBestSuperblock = FindBestSuperblock(nBlockHeight);
 
     // GET SUPERBLOCK OUTPUTS
 
@@ -334,13 +368,13 @@ bool CSuperblockManager::GetSuperblockPayments(int nBlockHeight, std::vector<CTx
     //       Consider at least following limits:
     //          - max coinbase tx size
     //          - max "budget" available
-    for (int i = 0; i < pSuperblock->CountPayments(); i++) {
+    for (int i = 0; entry.pBestSuperblock && i < entry.pBestSuperblock->CountPayments(); i++) {
         CGovernancePayment payment;
-        if (pSuperblock->GetPayment(i, payment)) {
+        if (entry.pBestSuperblock->GetPayment(i, payment)) {
             // SET COINBASE OUTPUT TO SUPERBLOCK SETTING
 
             CTxOut txout = CTxOut(payment.nAmount, payment.script);
-            voutSuperblockRet.push_back(txout);
+            entry.vecPayments.push_back(txout);
 
             // PRINT NICE LOG OUTPUT FOR SUPERBLOCK PAYMENT
 
@@ -356,6 +390,29 @@ bool CSuperblockManager::GetSuperblockPayments(int nBlockHeight, std::vector<CTx
         }
     }
 
+    return triggerman.mapSuperblockCache.emplace(nBlockHeight, std::move(entry)).first->second;
+}
+
+/**
+*   Get Superblock Payments
+*
+*   - Returns payments for superblock
+*/
+
+bool CSuperblockManager::GetSuperblockPayments(int nBlockHeight, std::vector<CTxOut>& voutSuperblockRet)
+{
+    LOCK(governance.cs);
+
+    // GET THE BEST SUPERBLOCK FOR THIS BLOCK HEIGHT
+
+    CSuperblock_sptr pSuperblock;
+    if (!CSuperblockManager::GetBestSuperblock(pSuperblock, nBlockHeight)) {
+        LogPrint(BCLog::GOBJECT, "CSuperblockManager::GetSuperblockPayments -- Can't find superblock for height %d\n", nBlockHeight);
+        return false;
+    }
+
+    voutSuperblockRet = GetCachedSuperblock(nBlockHeight).vecPayments;
+
     return true;
 }
 
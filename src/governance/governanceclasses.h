@@ -5,6 +5,7 @@
 #define SYSCOIN_GOVERNANCE_GOVERNANCECLASSES_H
 #include <amount.h>
 #include <governance/governance.h>
+#include <primitives/transaction.h>
 #include <script/script.h>
 #include <script/standard.h>
 #include <util/system.h>
@@ -33,18 +34,33 @@ class CGovernanceTriggerManager
 {
     friend class CSuperblockManager;
     friend class CGovernanceManager;
+    friend class governance_classes_tests::CSuperblockCacheForTest;
 
 private:
+    struct SuperblockCacheEntry {
+        // a trigger for the height has enough funding votes
+        bool fTriggered{false};
+        // the trigger with the most funding votes, null if there is none
+        CSuperblock_sptr pBestSuperblock;
+        std::vector<CTxOut> vecPayments;
+    };
 
     std::map<uint256, CSuperblock_sptr> mapTrigger;
 
+    // evaluated triggers per superblock height, so that block templates and block validation don't scan all
+    // triggers and count their votes every time
+    std::map<int, SuperblockCacheEntry> mapSuperblockCache GUARDED_BY(governance.cs);
+
     std::vector<CSuperblock_sptr> GetActiveTriggers() EXCLUSIVE_LOCKS_REQUIRED(governance.cs);
-    bool AddNewTrigger(uint256 nHash);
-    void CleanAndRemove();
+    bool AddNewTrigger(uint256 nHash) EXCLUSIVE_LOCKS_REQUIRED(governance.cs);
+    void CleanAndRemove() EXCLUSIVE_LOCKS_REQUIRED(governance.cs);
 
 public:
     CGovernanceTriggerManager() :
         mapTrigger() {}
+
+    // must be called whenever triggers, their votes or the masternode list change
+    void InvalidateSuperblockCache() EXCLUSIVE_LOCKS_REQUIRED(governance.cs);
 };
 
 /**
@@ -57,6 +73,9 @@ class CSuperblockManager
 {
 private:
     static bool GetBestSuperblock(CSuperblock_sptr& pSuperblockRet, int nBlockHeight) EXCLUSIVE_LOCKS_REQUIRED(governance.cs);
+    static const CGovernanceTriggerManager::SuperblockCacheEntry& GetCachedSuperblock(int nBlockHeight) EXCLUSIVE_LOCKS_REQUIRED(governance.cs);
+    static bool FindTriggeredSuperblock(int nBlockHeight) EXCLUSIVE_LOCKS_REQUIRED(governance.cs);
+    static CSuperblock_sptr FindBestSuperblock(int nBlockHeight) EXCLUSIVE_LOCKS_REQUIRED(governance.cs);
 
 public:
     static bool IsSuperblockTriggered(int nBlockHeight);
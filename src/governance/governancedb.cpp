@@ -0,0 +1,149 @@
+// Copyright (c) 2021 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <governance/governancedb.h>
+
+#include <governance/governanceobject.h>
+#include <governance/governancevote.h>
+#include <util/system.h>
+
+static const std::string DB_OBJECT = "gov_o";
+static const std::string DB_VOTE = "gov_v";
+
+const std::string CGovernanceDB::DB_MANAGER_STATE = "gov_m";
+
+std::unique_ptr<CGovernanceDB> governanceDb;
+
+CGovernanceDB::CGovernanceDB(size_t nCacheSize, bool fMemory, bool fWipe) :
+    db(fMemory ? "" : (GetDataDir() / "governance"), nCacheSize, fMemory, fWipe)
+{
+}
+
+void CGovernanceDB::WriteObject(CGovernanceObject& govobj)
+{
+    CDBBatch batch(db);
+    WriteObject(batch, govobj);
+    db.WriteBatch(batch);
+    govobj.SetStored();
+}
+
+void CGovernanceDB::WriteObject(CDBBatch& batch, const CGovernanceObject& govobj)
+{
+    batch.Write(std::make_pair(DB_OBJECT, govobj.GetHash()), govobj);
+}
+
+void CGovernanceDB::EraseObject(const uint256& nHash)
+{
+    CDBBatch batch(db);
+    batch.Erase(std::make_pair(DB_OBJECT, nHash));
+
+    std::unique_ptr<CDBIterator> pcursor(db.NewIterator());
+    auto start = std::make_tuple(DB_VOTE, nHash, uint256());
+    pcursor->Seek(start);
+    while (pcursor->Valid()) {
+        decltype(start) k;
+        if (!pcursor->GetKey(k) || std::get<0>(k) != DB_VOTE || std::get<1>(k) != nHash) {
+            break;
+        }
+        batch.Erase(k);
+        pcursor->Next();
+    }
+    pcursor.reset();
+
+    db.WriteBatch(batch);
+}
+
+void CGovernanceDB::ForEachObject(const std::function<bool(const uint256& nHash, CGovernanceObject& govobj)>& func)
+{
+    std::unique_ptr<CDBIterator> pcursor(db.NewIterator());
+    auto start = std::make_pair(DB_OBJECT, uint256());
+    pcursor->Seek(start);
+    while (pcursor->Valid()) {
+        decltype(start) k;
+        if (!pcursor->GetKey(k) || k.first != DB_OBJECT) {
+            break;
+        }
+        CGovernanceObject govobj;
+        if (!pcursor->GetValue(govobj)) {
+            LogPrintf("CGovernanceDB::%s -- failed to read object %s\n", __func__, k.second.ToString());
+        } else if (!func(k.second, govobj)) {
+            break;
+        }
+        pcursor->Next();
+    }
+}
+
+void CGovernanceDB::WriteVote(const CGovernanceVote& vote, const std::set<uint256>& replacedVoteHashes)
+{
+    CDBBatch batch(db);
+    batch.Write(std::make_tuple(DB_VOTE, vote.GetParentHash(), vote.GetHash()), vote);
+    for (const auto& nVoteHash : replacedVoteHashes) {
+        batch.Erase(std::make_tuple(DB_VOTE, vote.GetParentHash(), nVoteHash));
+    }
+    db.WriteBatch(batch);
+}
+
+void CGovernanceDB::WriteVotes(const std::vector<CGovernanceVote>& vecVotes)
+{
+    CDBBatch batch(db);
+    for (const auto& vote : vecVotes) {
+        batch.Write(std::make_tuple(DB_VOTE, vote.GetParentHash(), vote.GetHash()), vote);
+    }
+    db.WriteBatch(batch);
+}
+
+void CGovernanceDB::EraseVotes(const uint256& nParentHash, const std::set<uint256>& voteHashes)
+{
+    if (voteHashes.empty()) {
+        return;
+    }
+    CDBBatch batch(db);
+    for (const auto& nVoteHash : voteHashes) {
+        batch.Erase(std::make_tuple(DB_VOTE, nParentHash, nVoteHash));
+    }
+    db.WriteBatch(batch);
+}
+
+bool CGovernanceDB::HasVote(const uint256& nParentHash, const uint256& nVoteHash)
+{
+    return db.Exists(std::make_tuple(DB_VOTE, nParentHash, nVoteHash));
+}
+
+bool CGovernanceDB::ReadVote(const uint256& nParentHash, const uint256& nVoteHash, CGovernanceVote& vote)
+{
+    return db.Read(std::make_tuple(DB_VOTE, nParentHash, nVoteHash), vote);
+}
+
+std::vector<CGovernanceVote> CGovernanceDB::ReadVotes(const uint256& nParentHash)
+{
+    std::vector<CGovernanceVote> vecVotes;
+    ForEachVote(nParentHash, uint256(), [&](const CGovernanceVote& vote) {
+        vecVotes.emplace_back(vote);
+        return true;
+    });
+    return vecVotes;
+}
+
+void CGovernanceDB::ForEachVote(const uint256& nParentHash, const uint256& nCursor, const std::function<bool(const CGovernanceVote& vote)>& func)
+{
+    // keys are compared bytewise, which is the order of uint256
+    std::unique_ptr<CDBIterator> pcursor(db.NewIterator());
+    auto start = std::make_tuple(DB_VOTE, nParentHash, nCursor);
+    pcursor->Seek(start);
+    while (pcursor->Valid()) {
+        decltype(start) k;
+        if (!pcursor->GetKey(k) || std::get<0>(k) != DB_VOTE || std::get<1>(k) != nParentHash) {
+            break;
+        }
+        if (std::get<2>(k) != nCursor) {
+            CGovernanceVote vote;
+            if (!pcursor->GetValue(vote)) {
+                LogPrintf("CGovernanceDB::%s -- failed to read vote %s\n", __func__, std::get<2>(k).ToString());
+            } else if (!func(vote)) {
+                break;
+            }
+        }
+        pcursor->Next();
+    }
+}
@@ -0,0 +1,80 @@
+// Copyright (c) 2021 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef SYSCOIN_GOVERNANCE_GOVERNANCEDB_H
+#define SYSCOIN_GOVERNANCE_GOVERNANCEDB_H
+
+#include <dbwrapper.h>
+#include <uint256.h>
+
+#include <functional>
+#include <memory>
+#include <set>
+#include <vector>
+
+class CGovernanceObject;
+class CGovernanceVote;
+
+static const size_t GOVERNANCE_DB_CACHE_SIZE = 8 << 20;
+
+/**
+ * On-disk store of governance objects and their votes
+ *
+ * Objects and votes are written as they are accepted, so that a restart (or a crash) doesn't require a full re-sync
+ * of governance. Votes are keyed by their parent object, which allows to load and erase them per object. The objects
+ * only keep the outcome of the current votes in memory, votes are read from here when they are sent to peers.
+ */
+class CGovernanceDB
+{
+private:
+    CDBWrapper db;
+
+public:
+    explicit CGovernanceDB(size_t nCacheSize, bool fMemory = false, bool fWipe = false);
+
+    // Marks the object as stored
+    void WriteObject(CGovernanceObject& govobj);
+    // Also erases all votes of the object
+    void EraseObject(const uint256& nHash);
+    // Calls func for every stored object, stops when func returns false
+    void ForEachObject(const std::function<bool(const uint256& nHash, CGovernanceObject& govobj)>& func);
+
+    // Writes the vote and erases the votes it replaced in one batch
+    void WriteVote(const CGovernanceVote& vote, const std::set<uint256>& replacedVoteHashes);
+    void WriteVotes(const std::vector<CGovernanceVote>& vecVotes);
+    void EraseVotes(const uint256& nParentHash, const std::set<uint256>& voteHashes);
+    bool HasVote(const uint256& nParentHash, const uint256& nVoteHash);
+    bool ReadVote(const uint256& nParentHash, const uint256& nVoteHash, CGovernanceVote& vote);
+    // Votes of the object ordered by their hash
+    std::vector<CGovernanceVote> ReadVotes(const uint256& nParentHash);
+    // Calls func for the votes of the object with a hash above nCursor in hash order, stops when func returns false
+    void ForEachVote(const uint256& nParentHash, const uint256& nCursor, const std::function<bool(const CGovernanceVote& vote)>& func);
+
+    template<typename T>
+    bool ReadManagerState(T& state)
+    {
+        return db.Read(DB_MANAGER_STATE, state);
+    }
+
+    // Also writes the given objects
+    template<typename T>
+    void WriteManagerState(const T& state, const std::vector<const CGovernanceObject*>& vecObjects)
+    {
+        CDBBatch batch(db);
+        batch.Write(DB_MANAGER_STATE, state);
+        for (const auto* pObj : vecObjects) {
+            WriteObject(batch, *pObj);
+        }
+        db.WriteBatch(batch);
+    }
+
+private:
+    static const std::string DB_MANAGER_STATE;
+
+    void WriteObject(CDBBatch& batch, const CGovernanceObject& govobj);
+};
+
+extern std::unique_ptr<CGovernanceDB> governanceDb;
+
+#endif // SYSCOIN_GOVERNANCE_GOVERNANCEDB_H
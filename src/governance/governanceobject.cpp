@@ -4,6 +4,7 @@
 
 #include <governance/governanceobject.h>
 #include <core_io.h>
+#include <governance/governancedb.h>
 #include <governance/governancevalidators.h>
 #include <governance/governancevote.h>
 #include <governance/governance.h>
@@ -15,6 +16,7 @@
 #include <util/system.h>
 #include <validation.h>
 
+#include <algorithm>
 #include <string>
 #include <univalue.h>
 
@@ -38,8 +40,8 @@ CGovernanceObject::CGovernanceObject() :
     fDirtyCache(true),
     fExpired(false),
     fUnparsable(false),
-    mapCurrentMNVotes(),
-    fileVotes()
+    storedFlags(),
+    mapCurrentMNVotes()
 {
     // PARSE JSON DATA STORAGE (VCHDATA)
     LoadData();
@@ -65,8 +67,8 @@ CGovernanceObject::CGovernanceObject(const uint256& nHashParentIn, int nRevision
     fDirtyCache(true),
     fExpired(false),
     fUnparsable(false),
-    mapCurrentMNVotes(),
-    fileVotes()
+    storedFlags(),
+    mapCurrentMNVotes()
 {
     // PARSE JSON DATA STORAGE (VCHDATA)
     LoadData();
@@ -92,20 +94,52 @@ CGovernanceObject::CGovernanceObject(const CGovernanceObject& other) :
     fDirtyCache(other.fDirtyCache),
     fExpired(other.fExpired),
     fUnparsable(other.fUnparsable),
-    mapCurrentMNVotes(other.mapCurrentMNVotes),
-    fileVotes(other.fileVotes)
+    storedFlags(other.storedFlags),
+    mapCurrentMNVotes(other.mapCurrentMNVotes)
 {
 }
 
+// hash of the vote a vote instance was taken from, the signature is not part of it
+static uint256 GetVoteHash(const COutPoint& mnOutpoint, const uint256& nParentHash, int nSignal, const vote_instance_t& voteInstance)
+{
+    CGovernanceVote vote(mnOutpoint, nParentHash, vote_signal_enum_t(nSignal), voteInstance.eOutcome);
+    vote.SetTime(voteInstance.nCreationTime);
+    return vote.GetHash();
+}
+
+static std::set<uint256> GetRecordVoteHashes(const COutPoint& mnOutpoint, const uint256& nParentHash, const vote_rec_t& voteRecord)
+{
+    std::set<uint256> voteHashes;
+    for (const auto& p : voteRecord.mapInstances) {
+        voteHashes.emplace(GetVoteHash(mnOutpoint, nParentHash, p.first, p.second));
+    }
+    return voteHashes;
+}
+
 bool CGovernanceObject::ProcessVote(CNode* pfrom,
     const CGovernanceVote& vote,
     CGovernanceException& exception,
-    CConnman& connman)
+    CConnman& connman,
+    VoteSigCheck sigCheck,
+    const CDeterministicMNList* pmnList)
 {
     LOCK(cs);
 
+    // the current vote of the masternode for this signal, only the latest one is kept
+    const int nSignal = int(vote.GetSignal());
+    vote_instance_t voteInstance;
+    bool fHasInstance = false;
+    auto itRecord = mapCurrentMNVotes.find(vote.GetMasternodeOutpoint());
+    if (itRecord != mapCurrentMNVotes.end()) {
+        auto itInstance = itRecord->second.mapInstances.find(nSignal);
+        if (itInstance != itRecord->second.mapInstances.end()) {
+            voteInstance = itInstance->second;
+            fHasInstance = true;
+        }
+    }
+
     // do not process already known valid votes twice
-    if (fileVotes.HasVote(vote.GetHash())) {
+    if (fHasInstance && voteInstance.nCreationTime == vote.GetTimestamp() && voteInstance.eOutcome == vote.GetOutcome()) {
         // nothing to do here, not an error
         std::ostringstream ostr;
         ostr << "CGovernanceObject::ProcessVote -- Already known valid vote";
@@ -114,9 +148,12 @@ bool CGovernanceObject::ProcessVote(CNode* pfrom,
         return false;
     }
     CDeterministicMNList mnList;
-    if(deterministicMNManager)
-        deterministicMNManager->GetListAtChainTip(mnList);
-    auto dmn = mnList.GetMNByCollateral(vote.GetMasternodeOutpoint());
+    if (!pmnList) {
+        if(deterministicMNManager)
+            deterministicMNManager->GetListAtChainTip(mnList);
+        pmnList = &mnList;
+    }
+    auto dmn = pmnList->GetMNByCollateral(vote.GetMasternodeOutpoint());
 
     if (!dmn) {
         std::ostringstream ostr;
@@ -125,8 +162,6 @@ bool CGovernanceObject::ProcessVote(CNode* pfrom,
         return false;
     }
 
-    auto it = mapCurrentMNVotes.try_emplace(vote.GetMasternodeOutpoint()).first;
-    vote_rec_t& voteRecordRef = it->second;
     vote_signal_enum_t eSignal = vote.GetSignal();
     if (eSignal == VOTE_SIGNAL_NONE) {
         std::ostringstream ostr;
@@ -142,22 +177,20 @@ bool CGovernanceObject::ProcessVote(CNode* pfrom,
         exception = CGovernanceException(ostr.str(), GOVERNANCE_EXCEPTION_PERMANENT_ERROR, 20);
         return false;
     }
-    auto it2 = voteRecordRef.mapInstances.try_emplace(int(eSignal)).first;
-    vote_instance_t& voteInstanceRef = it2->second;
 
     // Reject obsolete votes
-    if (vote.GetTimestamp() < voteInstanceRef.nCreationTime) {
+    if (vote.GetTimestamp() < voteInstance.nCreationTime) {
         std::ostringstream ostr;
         ostr << "CGovernanceObject::ProcessVote -- Obsolete vote";
         LogPrint(BCLog::GOBJECT, "%s\n", ostr.str());
         exception = CGovernanceException(ostr.str(), GOVERNANCE_EXCEPTION_NONE);
         return false;
-    } else if (vote.GetTimestamp() == voteInstanceRef.nCreationTime) {
+    } else if (fHasInstance && vote.GetTimestamp() == voteInstance.nCreationTime) {
         // Someone is doing something fishy, there can be no two votes from the same masternode
         // with the same timestamp for the same object and signal and yet different hash/outcome.
         std::ostringstream ostr;
         ostr << "CGovernanceObject::ProcessVote -- Invalid vote, same timestamp for the different outcome";
-        if (vote.GetOutcome() < voteInstanceRef.eOutcome) {
+        if (vote.GetOutcome() < voteInstance.eOutcome) {
             // This is an arbitrary comparison, we have to agree on some way
             // to pick the "winning" vote.
             ostr << ", rejected";
@@ -170,9 +203,9 @@ bool CGovernanceObject::ProcessVote(CNode* pfrom,
     }
 
     int64_t nNow = GetAdjustedTime();
-    int64_t nVoteTimeUpdate = voteInstanceRef.nTime;
+    int64_t nVoteTimeUpdate = voteInstance.nTime;
     if (governance.AreRateChecksEnabled()) {
-        int64_t nTimeDelta = nNow - voteInstanceRef.nTime;
+        int64_t nTimeDelta = nNow - voteInstance.nTime;
         if (nTimeDelta < GOVERNANCE_UPDATE_MIN) {
             std::ostringstream ostr;
             ostr << "CGovernanceObject::ProcessVote -- Masternode voting too often"
@@ -188,8 +221,9 @@ bool CGovernanceObject::ProcessVote(CNode* pfrom,
 
     bool onlyVotingKeyAllowed = nObjectType == GOVERNANCE_OBJECT_PROPOSAL && vote.GetSignal() == VOTE_SIGNAL_FUNDING;
 
-    // Finally check that the vote is actually valid (done last because of cost of signature verification)
-    if (!vote.IsValid(onlyVotingKeyAllowed)) {
+    // Finally check that the vote is actually valid (done last because of cost of signature verification),
+    // a signature which failed the batched check is treated the same as one failing here
+    if (sigCheck == VoteSigCheck::INVALID || !vote.IsValid(onlyVotingKeyAllowed, sigCheck == VoteSigCheck::UNCHECKED, pmnList)) {
         std::ostringstream ostr;
         ostr << "CGovernanceObject::ProcessVote -- Invalid vote"
              << ", MN outpoint = " << vote.GetMasternodeOutpoint().ToStringShort()
@@ -211,12 +245,63 @@ bool CGovernanceObject::ProcessVote(CNode* pfrom,
         return false;
     }
 
-    voteInstanceRef = vote_instance_t(vote.GetOutcome(), nVoteTimeUpdate, vote.GetTimestamp());
-    fileVotes.AddVote(vote);
+    std::set<uint256> replacedVotes;
+    if (fHasInstance) {
+        replacedVotes.emplace(GetVoteHash(vote.GetMasternodeOutpoint(), vote.GetParentHash(), nSignal, voteInstance));
+    }
+    mapCurrentMNVotes[vote.GetMasternodeOutpoint()].mapInstances[nSignal] = vote_instance_t(vote.GetOutcome(), nVoteTimeUpdate, vote.GetTimestamp());
+    if (governanceDb) {
+        governanceDb->WriteVote(vote, replacedVotes);
+    }
     fDirtyCache = true;
     return true;
 }
 
+void CGovernanceObject::LoadVotes(const std::vector<CGovernanceVote>& vecVotes)
+{
+    LOCK(cs);
+
+    // replay in the order the votes were created, so that newer votes replace older ones like in ProcessVote
+    std::vector<const CGovernanceVote*> vecSorted;
+    vecSorted.reserve(vecVotes.size());
+    for (const auto& vote : vecVotes) {
+        vecSorted.emplace_back(&vote);
+    }
+    std::sort(vecSorted.begin(), vecSorted.end(), [](const CGovernanceVote* a, const CGovernanceVote* b) {
+        return a->GetTimestamp() < b->GetTimestamp();
+    });
+
+    uint256 nParentHash = GetHash();
+    for (const auto* pVote : vecSorted) {
+        const CGovernanceVote& vote = *pVote;
+        if (vote.GetParentHash() != nParentHash) {
+            continue;
+        }
+        vote_instance_t& voteInstanceRef = mapCurrentMNVotes[vote.GetMasternodeOutpoint()].mapInstances[int(vote.GetSignal())];
+        if (vote.GetTimestamp() > voteInstanceRef.nCreationTime ||
+            (vote.GetTimestamp() == voteInstanceRef.nCreationTime && vote.GetOutcome() >= voteInstanceRef.eOutcome)) {
+            voteInstanceRef = vote_instance_t(vote.GetOutcome(), vote.GetTimestamp(), vote.GetTimestamp());
+        }
+    }
+
+    // votes which were replaced but not erased yet, e.g. after a crash
+    std::set<uint256> currentVotes;
+    for (const auto& p : mapCurrentMNVotes) {
+        const auto voteHashes = GetRecordVoteHashes(p.first, nParentHash, p.second);
+        currentVotes.insert(voteHashes.begin(), voteHashes.end());
+    }
+    std::set<uint256> replacedVotes;
+    for (const auto& vote : vecVotes) {
+        if (!currentVotes.count(vote.GetHash())) {
+            replacedVotes.emplace(vote.GetHash());
+        }
+    }
+    if (governanceDb) {
+        governanceDb->EraseVotes(nParentHash, replacedVotes);
+    }
+    fDirtyCache = true;
+}
+
 void CGovernanceObject::ClearMasternodeVotes()
 {
     LOCK(cs);
@@ -224,10 +309,13 @@ void CGovernanceObject::ClearMasternodeVotes()
     if(deterministicMNManager)
         deterministicMNManager->GetListAtChainTip(mnList);
 
+    const uint256 nParentHash = GetHash();
     auto it = mapCurrentMNVotes.begin();
     while (it != mapCurrentMNVotes.end()) {
         if (!mnList.HasMNByCollateral(it->first)) {
-            fileVotes.RemoveVotesFromMasternode(it->first);
+            if (governanceDb) {
+                governanceDb->EraseVotes(nParentHash, GetRecordVoteHashes(it->first, nParentHash, it->second));
+            }
             mapCurrentMNVotes.erase(it++);
             fDirtyCache = true;
         } else {
@@ -246,21 +334,34 @@ std::set<uint256> CGovernanceObject::RemoveInvalidVotes(const COutPoint& mnOutpo
         return {};
     }
 
-    auto removedVotes = fileVotes.RemoveInvalidVotes(mnOutpoint, nObjectType == GOVERNANCE_OBJECT_PROPOSAL);
-    if (removedVotes.empty()) {
+    auto nParentHash = GetHash();
+    if (!governanceDb) {
+        // the signatures are only stored with the votes on disk, without them the votes can't be checked
+        LogPrintf("CGovernanceObject::%s -- no governance db, can't check the votes for %s from MN %s\n", __func__, nParentHash.ToString(), mnOutpoint.ToString());
         return {};
     }
 
-    auto nParentHash = GetHash();
+    std::set<uint256> removedVotes;
     for (auto jt = it->second.mapInstances.begin(); jt != it->second.mapInstances.end(); ) {
-        CGovernanceVote tmpVote(mnOutpoint, nParentHash, (vote_signal_enum_t)jt->first, jt->second.eOutcome);
-        tmpVote.SetTime(jt->second.nCreationTime);
-        if (removedVotes.count(tmpVote.GetHash())) {
+        const uint256 nVoteHash = GetVoteHash(mnOutpoint, nParentHash, jt->first, jt->second);
+        const bool useVotingKey = nObjectType == GOVERNANCE_OBJECT_PROPOSAL && jt->first == VOTE_SIGNAL_FUNDING;
+        CGovernanceVote vote;
+        if (!governanceDb->ReadVote(nParentHash, nVoteHash, vote)) {
+            // keep it, a vote which can't be read now might be readable on the next check
+            LogPrintf("CGovernanceObject::%s -- failed to read vote %s, skipping\n", __func__, nVoteHash.ToString());
+            ++jt;
+        } else if (!vote.IsValid(useVotingKey)) {
+            removedVotes.emplace(nVoteHash);
             jt = it->second.mapInstances.erase(jt);
         } else {
             ++jt;
         }
     }
+    if (removedVotes.empty()) {
+        return {};
+    }
+
+    governanceDb->EraseVotes(nParentHash, removedVotes);
     if (it->second.mapInstances.empty()) {
         mapCurrentMNVotes.erase(it);
     }
@@ -653,6 +754,20 @@ bool CGovernanceObject::GetCurrentMNVotes(const COutPoint& mnCollateralOutpoint,
     return true;
 }
 
+std::vector<uint256> CGovernanceObject::GetVoteHashes() const
+{
+    LOCK(cs);
+
+    const uint256 nParentHash = GetHash();
+    std::vector<uint256> vecResult;
+    for (const auto& p : mapCurrentMNVotes) {
+        for (const auto& p2 : p.second.mapInstances) {
+            vecResult.emplace_back(GetVoteHash(p.first, nParentHash, p2.first, p2.second));
+        }
+    }
+    return vecResult;
+}
+
 void CGovernanceObject::Relay(CConnman& connman)
 {
     // Do not relay until fully synced
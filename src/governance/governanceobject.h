@@ -8,12 +8,16 @@
 #include <logging.h>
 #include <governance/governanceexceptions.h>
 #include <governance/governancevote.h>
-#include <governance/governancevotedb.h>
+#include <streams.h>
 #include <sync.h>
 #include <util/system.h>
 #include <threadsafety.h>
 
 #include <univalue.h>
+
+#include <map>
+#include <optional>
+#include <set>
 extern RecursiveMutex cs_main;
 
 class CBLSSecretKey;
@@ -159,9 +163,11 @@ private:
     /// Failed to parse object data
     bool fUnparsable;
 
-    vote_m_t mapCurrentMNVotes;
+    /// nDeletionTime and fExpired as they were last written to CGovernanceDB, unset if the object wasn't written yet
+    std::optional<std::pair<int64_t, bool>> storedFlags;
 
-    CGovernanceObjectVoteFile fileVotes;
+    /// the outcome of the current vote of every masternode and signal, the votes themselves are kept in CGovernanceDB
+    vote_m_t mapCurrentMNVotes;
 
 public:
     CGovernanceObject();
@@ -232,9 +238,15 @@ public:
         fExpired = true;
     }
 
-    const CGovernanceObjectVoteFile& GetVoteFile() const
+    /// The object itself never changes, it only has to be written to CGovernanceDB again when the flags stored with it do
+    bool HasUnstoredFlags() const
     {
-        return fileVotes;
+        return storedFlags != std::make_pair(nDeletionTime, fExpired);
+    }
+
+    void SetStored()
+    {
+        storedFlags = std::make_pair(nDeletionTime, fExpired);
     }
 
     // Signature related functions
@@ -285,6 +297,8 @@ public:
     int GetAbstainCount(vote_signal_enum_t eVoteSignalIn) const;
 
     bool GetCurrentMNVotes(const COutPoint& mnCollateralOutpoint, vote_rec_t& voteRecord) const;
+    /// Hashes of the current votes, which are the ones stored in CGovernanceDB
+    std::vector<uint256> GetVoteHashes() const;
     UniValue ToJson() const;
     
     // FUNCTIONS FOR DEALING WITH DATA STRING
@@ -300,8 +314,8 @@ public:
             READWRITE(obj.vchSig);
         }
         if (s.GetType() & SER_DISK) {
-            // Only include these for the disk file format
-            READWRITE(obj.nDeletionTime, obj.fExpired, obj.mapCurrentMNVotes, obj.fileVotes);
+            // Only include these for the disk format, votes are stored separately and replayed with LoadVotes
+            READWRITE(obj.nDeletionTime, obj.fExpired);
         }
     }
 
@@ -312,7 +326,12 @@ public:
     bool ProcessVote(CNode* pfrom,
         const CGovernanceVote& vote,
         CGovernanceException& exception,
-        CConnman& connman);
+        CConnman& connman,
+        VoteSigCheck sigCheck = VoteSigCheck::UNCHECKED,
+        const CDeterministicMNList* pmnList = nullptr);
+
+    /// Restore the votes of this object read from CGovernanceDB, they were validated when they were accepted
+    void LoadVotes(const std::vector<CGovernanceVote>& vecVotes);
 
     /// Called when MN's which have voted on this object have been removed
     void ClearMasternodeVotes();
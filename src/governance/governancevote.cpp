@@ -205,7 +205,7 @@ bool CGovernanceVote::CheckSignature(const CBLSPublicKey& pubKey) const
     return true;
 }
 
-bool CGovernanceVote::IsValid(bool useVotingKey) const
+bool CGovernanceVote::IsValid(bool useVotingKey, bool fCheckSignature, const CDeterministicMNList* pmnList) const
 {
     if (nTime > GetAdjustedTime() + (60 * 60)) {
         LogPrint(BCLog::GOBJECT, "CGovernanceVote::IsValid -- vote is too far ahead of current time - %s - nTime %lli - Max Time %lli\n", GetHash().ToString(), nTime, GetAdjustedTime() + (60 * 60));
@@ -224,14 +224,21 @@ bool CGovernanceVote::IsValid(bool useVotingKey) const
         return false;
     }
     CDeterministicMNList mnList;
-    if(deterministicMNManager)
-        deterministicMNManager->GetListAtChainTip(mnList);
-    auto dmn = mnList.GetMNByCollateral(masternodeOutpoint);
+    if (!pmnList) {
+        if(deterministicMNManager)
+            deterministicMNManager->GetListAtChainTip(mnList);
+        pmnList = &mnList;
+    }
+    auto dmn = pmnList->GetMNByCollateral(masternodeOutpoint);
     if (!dmn) {
         LogPrint(BCLog::GOBJECT, "CGovernanceVote::IsValid -- Unknown Masternode - %s\n", masternodeOutpoint.ToStringShort());
         return false;
     }
 
+    if (!fCheckSignature) {
+        return true;
+    }
+
     if (useVotingKey) {
         return CheckSignature(dmn->pdmnState->keyIDVoting);
     } else {
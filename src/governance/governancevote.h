@@ -11,6 +11,7 @@ class CGovernanceVote;
 class CBLSPublicKey;
 class CBLSSecretKey;
 class CConnman;
+class CDeterministicMNList;
 class CKey;
 class CKeyID;
 
@@ -34,6 +35,9 @@ enum vote_signal_enum_t {
 
 static const int MAX_SUPPORTED_VOTE_SIGNAL = VOTE_SIGNAL_ENDORSED;
 
+// result of the batched signature check of a vote, unchecked votes get a full check when they are processed
+enum class VoteSigCheck { VALID, INVALID, UNCHECKED };
+
 /**
 * Governance Voting
 *
@@ -96,12 +100,15 @@ public:
     }
 
     void SetSignature(const std::vector<unsigned char>& vchSigIn) { vchSig = vchSigIn; }
+    const std::vector<unsigned char>& GetSignature() const { return vchSig; }
 
     bool Sign(const CKey& key, const CKeyID& keyID);
     bool CheckSignature(const CKeyID& keyID) const;
     bool Sign(const CBLSSecretKey& key);
     bool CheckSignature(const CBLSPublicKey& pubKey) const;
-    bool IsValid(bool useVotingKey) const;
+    // fCheckSignature is false when the signature was already verified as part of a batch,
+    // pmnList is the masternode list at the tip if the caller already has it
+    bool IsValid(bool useVotingKey, bool fCheckSignature = true, const CDeterministicMNList* pmnList = nullptr) const;
     void Relay(CConnman& connman) const;
 
     const COutPoint& GetMasternodeOutpoint() const { return masternodeOutpoint; }
@@ -0,0 +1,202 @@
+// Copyright (c) 2021 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <chainparams.h>
+#include <crypto/sha256.h>
+#include <index/assetaddressindex.h>
+#include <node/blockstorage.h>
+#include <script/script.h>
+#include <undo.h>
+#include <validation.h>
+
+static constexpr uint8_t DB_ADDRESS_BALANCE{'a'};
+
+namespace {
+
+/** Balance entries are keyed by script hash then asset so one seek reads every asset of a script */
+struct DBBalanceKey {
+    uint256 scriptHash;
+    uint64_t nAsset;
+
+    DBBalanceKey() : nAsset(0) {}
+    DBBalanceKey(const uint256& scriptHash_in, uint64_t nAsset_in) : scriptHash(scriptHash_in), nAsset(nAsset_in) {}
+
+    template <typename Stream>
+    void Serialize(Stream& s) const
+    {
+        ser_writedata8(s, DB_ADDRESS_BALANCE);
+        s << scriptHash;
+        s << Using<BigEndianFormatter<8>>(nAsset);
+    }
+
+    template <typename Stream>
+    void Unserialize(Stream& s)
+    {
+        const uint8_t prefix{ser_readdata8(s)};
+        if (prefix != DB_ADDRESS_BALANCE) {
+            throw std::ios_base::failure("Invalid format for assetaddressindex DB key");
+        }
+        s >> scriptHash;
+        s >> Using<BigEndianFormatter<8>>(nAsset);
+    }
+};
+
+struct BalanceDelta {
+    CAmount nValue{0};
+    CAmount nAssetValue{0};
+    int64_t nCount{0};
+};
+
+uint256 GetScriptHash(const CScript& scriptPubKey)
+{
+    uint256 hash;
+    CSHA256().Write(scriptPubKey.data(), scriptPubKey.size()).Finalize(hash.begin());
+    return hash;
+}
+
+void AddOutput(std::map<std::pair<uint256, uint64_t>, BalanceDelta>& mapDeltas, const CTxOut& out, int nSign)
+{
+    if (out.scriptPubKey.IsUnspendable()) {
+        return;
+    }
+    const uint256 scriptHash = GetScriptHash(out.scriptPubKey);
+    BalanceDelta& total = mapDeltas[std::make_pair(scriptHash, uint64_t{0})];
+    total.nValue += nSign * out.nValue;
+    total.nCount += nSign;
+    if (!out.assetInfo.IsNull()) {
+        BalanceDelta& asset = mapDeltas[std::make_pair(scriptHash, out.assetInfo.nAsset)];
+        asset.nValue += nSign * out.nValue;
+        asset.nAssetValue += nSign * out.assetInfo.nValue;
+        asset.nCount += nSign;
+    }
+}
+
+} // namespace
+
+std::unique_ptr<AssetAddressIndex> g_asset_address_index;
+
+AssetAddressIndex::AssetAddressIndex(size_t n_cache_size, bool f_memory, bool f_wipe)
+{
+    fs::path path{GetDataDir() / "indexes" / "assetaddressindex"};
+    fs::create_directories(path);
+
+    m_db = std::make_unique<BaseIndex::DB>(path / "db", n_cache_size, f_memory, f_wipe);
+}
+
+bool AssetAddressIndex::ApplyBlock(const CBlock& block, const CBlockIndex* pindex, bool fConnect)
+{
+    // Ignore genesis block, its outputs are not spendable
+    if (pindex->nHeight == 0) {
+        return true;
+    }
+    CBlockUndo block_undo;
+    if (!UndoReadFromDisk(block_undo, pindex)) {
+        return false;
+    }
+    const int nSign = fConnect ? 1 : -1;
+    // net out every change of the block first so each balance is read and written once
+    std::map<std::pair<uint256, uint64_t>, BalanceDelta> mapDeltas;
+    for (size_t i = 0; i < block.vtx.size(); ++i) {
+        const auto& tx{block.vtx.at(i)};
+        for (const CTxOut& out : tx->vout) {
+            AddOutput(mapDeltas, out, nSign);
+        }
+        // The coinbase tx has no undo data since no former output is spent
+        if (!tx->IsCoinBase()) {
+            const auto& tx_undo{block_undo.vtxundo.at(i - 1)};
+            for (const Coin& coin : tx_undo.vprevout) {
+                AddOutput(mapDeltas, coin.out, -nSign);
+            }
+        }
+    }
+
+    CDBBatch batch(*m_db);
+    for (const auto& [key, delta] : mapDeltas) {
+        if (delta.nCount == 0 && delta.nValue == 0 && delta.nAssetValue == 0) {
+            continue;
+        }
+        const DBBalanceKey dbKey(key.first, key.second);
+        // a missing entry is an empty balance
+        CAddressBalance balance;
+        if (!m_db->Read(dbKey, balance)) {
+            balance = CAddressBalance();
+        }
+        if ((int64_t)balance.nCount + delta.nCount < 0) {
+            return error("%s: negative output count for script %s in block %s", __func__, key.first.ToString(), pindex->GetBlockHash().ToString());
+        }
+        balance.nValue += delta.nValue;
+        balance.nAssetValue += delta.nAssetValue;
+        balance.nCount += delta.nCount;
+        if (balance.IsNull()) {
+            batch.Erase(dbKey);
+        } else {
+            batch.Write(dbKey, balance);
+        }
+    }
+    return m_db->WriteBatch(batch);
+}
+
+bool AssetAddressIndex::WriteBlock(const CBlock& block, const CBlockIndex* pindex)
+{
+    return ApplyBlock(block, pindex, true);
+}
+
+bool AssetAddressIndex::Rewind(const CBlockIndex* current_tip, const CBlockIndex* new_tip)
+{
+    assert(current_tip->GetAncestor(new_tip->nHeight) == new_tip);
+
+    {
+        LOCK(cs_main);
+        CBlockIndex* iter_tip{g_chainman.m_blockman.LookupBlockIndex(current_tip->GetBlockHash())};
+        const auto& consensus_params{Params().GetConsensus()};
+
+        do {
+            CBlock block;
+
+            if (!ReadBlockFromDisk(block, iter_tip, consensus_params)) {
+                return error("%s: Failed to read block %s from disk",
+                             __func__, iter_tip->GetBlockHash().ToString());
+            }
+
+            if (!ApplyBlock(block, iter_tip, false)) {
+                return error("%s: Failed to reverse block %s",
+                             __func__, iter_tip->GetBlockHash().ToString());
+            }
+
+            iter_tip = iter_tip->GetAncestor(iter_tip->nHeight - 1);
+        } while (new_tip != iter_tip);
+    }
+
+    return BaseIndex::Rewind(current_tip, new_tip);
+}
+
+bool AssetAddressIndex::GetBalance(const CScript& scriptPubKey, uint64_t nAsset, CAddressBalance& balance) const
+{
+    if (!m_db->Read(DBBalanceKey(GetScriptHash(scriptPubKey), nAsset), balance)) {
+        balance = CAddressBalance();
+    }
+    return true;
+}
+
+bool AssetAddressIndex::GetAssetBalances(const CScript& scriptPubKey, std::map<uint64_t, CAddressBalance>& mapBalances) const
+{
+    mapBalances.clear();
+    const uint256 scriptHash = GetScriptHash(scriptPubKey);
+    std::unique_ptr<CDBIterator> pcursor(m_db->NewIterator());
+    // skip the Syscoin total stored under asset 0
+    pcursor->Seek(DBBalanceKey(scriptHash, 1));
+    DBBalanceKey key;
+    while (pcursor->Valid()) {
+        if (!pcursor->GetKey(key) || key.scriptHash != scriptHash) {
+            break;
+        }
+        CAddressBalance balance;
+        if (!pcursor->GetValue(balance)) {
+            return error("%s: failed to read balance of script %s", __func__, scriptHash.ToString());
+        }
+        mapBalances.emplace(key.nAsset, balance);
+        pcursor->Next();
+    }
+    return true;
+}
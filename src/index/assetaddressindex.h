@@ -0,0 +1,70 @@
+// Copyright (c) 2021 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef SYSCOIN_INDEX_ASSETADDRESSINDEX_H
+#define SYSCOIN_INDEX_ASSETADDRESSINDEX_H
+
+#include <amount.h>
+#include <chain.h>
+#include <index/base.h>
+#include <serialize.h>
+
+#include <map>
+
+class CScript;
+
+/** Confirmed balance of the unspent outputs paying to a script, in total or for one asset */
+struct CAddressBalance {
+    /** Sum of the Syscoin value of the outputs */
+    CAmount nValue{0};
+    /** Sum of the asset value of the outputs, always 0 for the Syscoin total */
+    CAmount nAssetValue{0};
+    /** Number of unspent outputs */
+    uint64_t nCount{0};
+
+    SERIALIZE_METHODS(CAddressBalance, obj)
+    {
+        READWRITE(obj.nValue, obj.nAssetValue, obj.nCount);
+    }
+
+    bool IsNull() const { return nCount == 0; }
+};
+
+/**
+ * AssetAddressIndex keeps the confirmed balance and unspent output count of every
+ * script. Each script has a Syscoin total over all of its outputs (asset 0) and an
+ * entry for every asset it holds, so balances are read without scanning outputs.
+ */
+class AssetAddressIndex final : public BaseIndex
+{
+private:
+    std::unique_ptr<BaseIndex::DB> m_db;
+
+    /** Apply the outputs created and spent by a block, or undo them if fConnect is false */
+    bool ApplyBlock(const CBlock& block, const CBlockIndex* pindex, bool fConnect);
+
+protected:
+    bool WriteBlock(const CBlock& block, const CBlockIndex* pindex) override;
+
+    bool Rewind(const CBlockIndex* current_tip, const CBlockIndex* new_tip) override;
+
+    BaseIndex::DB& GetDB() const override { return *m_db; }
+
+    const char* GetName() const override { return "assetaddressindex"; }
+
+public:
+    /// Constructs the index, which becomes available to be queried.
+    explicit AssetAddressIndex(size_t n_cache_size, bool f_memory = false, bool f_wipe = false);
+
+    /// Look up the balance of a script, nAsset 0 is the Syscoin total over all of its outputs.
+    bool GetBalance(const CScript& scriptPubKey, uint64_t nAsset, CAddressBalance& balance) const;
+
+    /// Look up the balances of every asset a script holds, keyed by asset (excluding the Syscoin total).
+    bool GetAssetBalances(const CScript& scriptPubKey, std::map<uint64_t, CAddressBalance>& mapBalances) const;
+};
+
+/// The global asset address index. May be null.
+extern std::unique_ptr<AssetAddressIndex> g_asset_address_index;
+
+#endif // SYSCOIN_INDEX_ASSETADDRESSINDEX_H
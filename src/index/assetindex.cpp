@@ -0,0 +1,197 @@
+// Copyright (c) 2021 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <chainparams.h>
+#include <index/assetindex.h>
+#include <node/blockstorage.h>
+#include <serialize.h>
+#include <services/asset.h>
+#include <util/strencodings.h>
+#include <validation.h>
+
+static constexpr uint8_t DB_ASSET_SYMBOL{'s'};
+static constexpr uint8_t DB_ASSET_CONTRACT{'c'};
+static constexpr uint8_t DB_ASSET_NOTARY{'n'};
+
+namespace {
+
+/**
+ * Index entries are keyed by type, indexed value and guid so that all guids sharing
+ * a value are adjacent and can be read with a single seek. The guid is stored big
+ * endian to keep them in numeric order.
+ */
+struct DBAssetKey {
+    uint8_t type;
+    std::vector<unsigned char> vchKey;
+    uint32_t nBaseAsset;
+
+    DBAssetKey() : type(0), nBaseAsset(0) {}
+    DBAssetKey(uint8_t type_in, const std::vector<unsigned char>& vchKey_in, uint32_t nBaseAsset_in) : type(type_in), vchKey(vchKey_in), nBaseAsset(nBaseAsset_in) {}
+
+    template <typename Stream>
+    void Serialize(Stream& s) const
+    {
+        ser_writedata8(s, type);
+        s << vchKey;
+        ser_writedata32be(s, nBaseAsset);
+    }
+
+    template <typename Stream>
+    void Unserialize(Stream& s)
+    {
+        type = ser_readdata8(s);
+        if (type != DB_ASSET_SYMBOL && type != DB_ASSET_CONTRACT && type != DB_ASSET_NOTARY) {
+            throw std::ios_base::failure("Invalid format for assetindex DB key");
+        }
+        s >> vchKey;
+        nBaseAsset = ser_readdata32be(s);
+    }
+};
+
+std::vector<unsigned char> SymbolKey(const std::string& strSymbol)
+{
+    const std::string strUpper = ToUpper(strSymbol);
+    return std::vector<unsigned char>(strUpper.begin(), strUpper.end());
+}
+
+/** Move the entry of an asset from vchOld to vchNew, empty values are not indexed */
+void UpdateEntry(CDBBatch& batch, uint8_t type, const std::vector<unsigned char>& vchOld, const std::vector<unsigned char>& vchNew, uint32_t nBaseAsset)
+{
+    if (!vchOld.empty()) {
+        batch.Erase(DBAssetKey(type, vchOld, nBaseAsset));
+    }
+    if (!vchNew.empty()) {
+        batch.Write(DBAssetKey(type, vchNew, nBaseAsset), uint8_t{0});
+    }
+}
+
+/** Apply (or undo if fConnect is false) the index changes of an asset activate or update transaction */
+void IndexAssetTx(CDBBatch& batch, const CTransaction& tx, bool fConnect)
+{
+    if (tx.nVersion != SYSCOIN_TX_VERSION_ASSET_ACTIVATE && tx.nVersion != SYSCOIN_TX_VERSION_ASSET_UPDATE) {
+        return;
+    }
+    if (tx.voutAssets.empty()) {
+        return;
+    }
+    const CAsset theAsset(tx);
+    if (theAsset.IsNull()) {
+        return;
+    }
+    const uint32_t nBaseAsset = GetBaseAssetID(tx.voutAssets[0].key);
+    const std::vector<unsigned char> vchEmpty;
+    if (tx.nVersion == SYSCOIN_TX_VERSION_ASSET_ACTIVATE) {
+        const std::vector<unsigned char> vchSymbol = SymbolKey(DecodeBase64(theAsset.strSymbol));
+        UpdateEntry(batch, DB_ASSET_SYMBOL, fConnect ? vchEmpty : vchSymbol, fConnect ? vchSymbol : vchEmpty, nBaseAsset);
+        UpdateEntry(batch, DB_ASSET_CONTRACT, fConnect ? vchEmpty : theAsset.vchContract, fConnect ? theAsset.vchContract : vchEmpty, nBaseAsset);
+        UpdateEntry(batch, DB_ASSET_NOTARY, fConnect ? vchEmpty : theAsset.vchNotaryKeyID, fConnect ? theAsset.vchNotaryKeyID : vchEmpty, nBaseAsset);
+        return;
+    }
+    // updates carry the previous values, consensus ensures they match what was stored
+    if (theAsset.nUpdateMask & ASSET_UPDATE_CONTRACT) {
+        UpdateEntry(batch, DB_ASSET_CONTRACT, fConnect ? theAsset.vchPrevContract : theAsset.vchContract, fConnect ? theAsset.vchContract : theAsset.vchPrevContract, nBaseAsset);
+    }
+    if (theAsset.nUpdateMask & ASSET_UPDATE_NOTARY_KEY) {
+        UpdateEntry(batch, DB_ASSET_NOTARY, fConnect ? theAsset.vchPrevNotaryKeyID : theAsset.vchNotaryKeyID, fConnect ? theAsset.vchNotaryKeyID : theAsset.vchPrevNotaryKeyID, nBaseAsset);
+    }
+}
+
+} // namespace
+
+std::unique_ptr<AssetIndex> g_asset_index;
+
+AssetIndex::AssetIndex(size_t n_cache_size, bool f_memory, bool f_wipe)
+{
+    fs::path path{GetDataDir() / "indexes" / "assetindex"};
+    fs::create_directories(path);
+
+    m_db = std::make_unique<BaseIndex::DB>(path / "db", n_cache_size, f_memory, f_wipe);
+}
+
+bool AssetIndex::WriteBlock(const CBlock& block, const CBlockIndex* pindex)
+{
+    CDBBatch batch(*m_db);
+    for (const auto& tx : block.vtx) {
+        IndexAssetTx(batch, *tx, true);
+    }
+    if (batch.SizeEstimate() == 0) {
+        return true;
+    }
+    return m_db->WriteBatch(batch);
+}
+
+bool AssetIndex::ReverseBlock(const CBlock& block, const CBlockIndex* pindex)
+{
+    CDBBatch batch(*m_db);
+    for (auto it = block.vtx.rbegin(); it != block.vtx.rend(); ++it) {
+        IndexAssetTx(batch, **it, false);
+    }
+    if (batch.SizeEstimate() == 0) {
+        return true;
+    }
+    return m_db->WriteBatch(batch);
+}
+
+bool AssetIndex::Rewind(const CBlockIndex* current_tip, const CBlockIndex* new_tip)
+{
+    assert(current_tip->GetAncestor(new_tip->nHeight) == new_tip);
+
+    {
+        LOCK(cs_main);
+        CBlockIndex* iter_tip{g_chainman.m_blockman.LookupBlockIndex(current_tip->GetBlockHash())};
+        const auto& consensus_params{Params().GetConsensus()};
+
+        do {
+            CBlock block;
+
+            if (!ReadBlockFromDisk(block, iter_tip, consensus_params)) {
+                return error("%s: Failed to read block %s from disk",
+                             __func__, iter_tip->GetBlockHash().ToString());
+            }
+
+            if (!ReverseBlock(block, iter_tip)) {
+                return error("%s: Failed to reverse block %s",
+                             __func__, iter_tip->GetBlockHash().ToString());
+            }
+
+            iter_tip = iter_tip->GetAncestor(iter_tip->nHeight - 1);
+        } while (new_tip != iter_tip);
+    }
+
+    return BaseIndex::Rewind(current_tip, new_tip);
+}
+
+bool AssetIndex::FindAssets(uint8_t type, const std::vector<unsigned char>& vchKey, std::vector<uint32_t>& guids) const
+{
+    guids.clear();
+    if (vchKey.empty()) {
+        return false;
+    }
+    std::unique_ptr<CDBIterator> pcursor(m_db->NewIterator());
+    pcursor->Seek(DBAssetKey(type, vchKey, 0));
+    DBAssetKey key;
+    while (pcursor->Valid()) {
+        if (!pcursor->GetKey(key) || key.type != type || key.vchKey != vchKey) {
+            break;
+        }
+        guids.push_back(key.nBaseAsset);
+        pcursor->Next();
+    }
+    return !guids.empty();
+}
+
+bool AssetIndex::FindAssetsBySymbol(const std::string& strSymbol, std::vector<uint32_t>& guids) const
+{
+    return FindAssets(DB_ASSET_SYMBOL, SymbolKey(strSymbol), guids);
+}
+
+bool AssetIndex::FindAssetsByContract(const std::vector<unsigned char>& vchContract, std::vector<uint32_t>& guids) const
+{
+    return FindAssets(DB_ASSET_CONTRACT, vchContract, guids);
+}
+
+bool AssetIndex::FindAssetsByNotary(const std::vector<unsigned char>& vchNotaryKeyID, std::vector<uint32_t>& guids) const
+{
+    return FindAssets(DB_ASSET_NOTARY, vchNotaryKeyID, guids);
+}
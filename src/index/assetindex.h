@@ -0,0 +1,55 @@
+// Copyright (c) 2021 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef SYSCOIN_INDEX_ASSETINDEX_H
+#define SYSCOIN_INDEX_ASSETINDEX_H
+
+#include <chain.h>
+#include <index/base.h>
+
+#include <vector>
+
+/**
+ * AssetIndex maps asset symbols, Ethereum contract addresses and notary keys to the
+ * guids of the assets using them. Symbols are not unique so every lookup may return
+ * several guids. Entries are derived from asset activate and update transactions
+ * alone, updates carry the previous contract and notary key which lets blocks be
+ * reversed during a reorg without undo data.
+ */
+class AssetIndex final : public BaseIndex
+{
+private:
+    std::unique_ptr<BaseIndex::DB> m_db;
+
+    bool ReverseBlock(const CBlock& block, const CBlockIndex* pindex);
+
+    bool FindAssets(uint8_t type, const std::vector<unsigned char>& vchKey, std::vector<uint32_t>& guids) const;
+
+protected:
+    bool WriteBlock(const CBlock& block, const CBlockIndex* pindex) override;
+
+    bool Rewind(const CBlockIndex* current_tip, const CBlockIndex* new_tip) override;
+
+    BaseIndex::DB& GetDB() const override { return *m_db; }
+
+    const char* GetName() const override { return "assetindex"; }
+
+public:
+    /// Constructs the index, which becomes available to be queried.
+    explicit AssetIndex(size_t n_cache_size, bool f_memory = false, bool f_wipe = false);
+
+    /// Look up the assets created with a symbol, matched case-insensitively.
+    bool FindAssetsBySymbol(const std::string& strSymbol, std::vector<uint32_t>& guids) const;
+
+    /// Look up the assets currently bridged to an Ethereum contract.
+    bool FindAssetsByContract(const std::vector<unsigned char>& vchContract, std::vector<uint32_t>& guids) const;
+
+    /// Look up the assets currently notarized by a key.
+    bool FindAssetsByNotary(const std::vector<unsigned char>& vchNotaryKeyID, std::vector<uint32_t>& guids) const;
+};
+
+/// The global asset index. May be null.
+extern std::unique_ptr<AssetIndex> g_asset_index;
+
+#endif // SYSCOIN_INDEX_ASSETINDEX_H
@@ -21,6 +21,8 @@
 #include <httprpc.h>
 #include <httpserver.h>
 #include <index/blockfilterindex.h>
+#include <index/assetaddressindex.h>
+#include <index/assetindex.h>
 #include <index/coinstatsindex.h>
 #include <index/txindex.h>
 #include <init/common.h>
@@ -91,6 +93,7 @@
 #include <masternode/activemasternode.h>
 #include <dsnotificationinterface.h>
 #include <governance/governance.h>
+#include <governance/governancedb.h>
 #include <masternode/masternodesync.h>
 #include <masternode/masternodemeta.h>
 #include <masternode/masternodeutils.h>
@@ -108,6 +111,7 @@
 #include <llmq/quorums.h>
 #include <llmq/quorums_init.h>
 #include <evo/deterministicmns.h>
+#include <ethereum/sha3.h>
 #include <curl/curl.h>
 static CDSNotificationInterface* pdsNotificationInterface = NULL;
 
@@ -203,6 +207,7 @@ void Interrupt(NodeContext& node)
     InterruptTorControl();
     // SYSCOIN
     llmq::InterruptLLMQSystem();
+    governance.InterruptWorkerThread();
     InterruptMapPort();
     if (node.connman)
         node.connman->Interrupt();
@@ -213,6 +218,13 @@ void Interrupt(NodeContext& node)
     if (g_coin_stats_index) {
         g_coin_stats_index->Interrupt();
     }
+    // SYSCOIN
+    if (g_asset_index) {
+        g_asset_index->Interrupt();
+    }
+    if (g_asset_address_index) {
+        g_asset_address_index->Interrupt();
+    }
 }
 
 void Shutdown(NodeContext& node)
@@ -236,6 +248,7 @@ void Shutdown(NodeContext& node)
     StopHTTPServer();
     // SYSCOIN
     llmq::StopLLMQSystem();
+    governance.StopWorkerThread();
     for (const auto& client : node.chain_clients) {
         client->flush();
     }
@@ -271,8 +284,7 @@ void Shutdown(NodeContext& node)
         CFlatDB<CSporkManager> flatdb6("sporks.dat", "magicSporkCache");
         flatdb6.Dump(sporkManager);
         if (!fDisableGovernance) {
-            CFlatDB<CGovernanceManager> flatdb3("governance.dat", "magicGovernanceCache");
-            flatdb3.Dump(governance);
+            governance.FlushToDB();
         }
     }
     if (node.mempool && node.mempool->IsLoaded() && node.args->GetArg("-persistmempool", DEFAULT_PERSIST_MEMPOOL)) {
@@ -305,6 +317,15 @@ void Shutdown(NodeContext& node)
         g_coin_stats_index->Stop();
         g_coin_stats_index.reset();
     }
+    // SYSCOIN
+    if (g_asset_index) {
+        g_asset_index->Stop();
+        g_asset_index.reset();
+    }
+    if (g_asset_address_index) {
+        g_asset_address_index->Stop();
+        g_asset_address_index.reset();
+    }
     ForEachBlockFilterIndex([](BlockFilterIndex& index) { index.Stop(); });
     DestroyAllBlockFilterIndexes();
 
@@ -336,6 +357,7 @@ void Shutdown(NodeContext& node)
         llmq::DestroyLLMQSystem();
         deterministicMNManager.reset();
         evoDb.reset();
+        governanceDb.reset();
     }
     for (const auto& client : node.chain_clients) {
         client->stop();
@@ -470,6 +492,8 @@ void SetupServerArgs(NodeContext& node)
 #endif
     argsman.AddArg("-blockreconstructionextratxn=<n>", strprintf("Extra transactions to keep in memory for compact block reconstructions (default: %u)", DEFAULT_BLOCK_RECONSTRUCTION_EXTRA_TXN), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-blocksonly", strprintf("Whether to reject transactions from network peers. Automatic broadcast and rebroadcast of any transactions from inbound peers is disabled, unless the peer has the 'forcerelay' permission. RPC transactions are not affected. (default: %u)", DEFAULT_BLOCKSONLY), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    // SYSCOIN
+    argsman.AddArg("-assetaddressindex", strprintf("Maintain the confirmed Syscoin and asset balances of every address, used by the getaddressbalance RPC (default: %u)", DEFAULT_ASSETADDRESSINDEX), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-coinstatsindex", strprintf("Maintain coinstats index used by the gettxoutsetinfo RPC (default: %u)", DEFAULT_COINSTATSINDEX), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-conf=<file>", strprintf("Specify path to read-only configuration file. Relative paths will be prefixed by datadir location. (default: %s)", SYSCOIN_CONF_FILENAME), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-datadir=<dir>", "Specify data directory", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
@@ -513,9 +537,10 @@ void SetupServerArgs(NodeContext& node)
     argsman.AddArg("-mnconf=<file>", strprintf("Specify masternode configuration file (default: %s)", "masternode.conf"), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-mnconflock=<n>", strprintf("Lock masternodes from masternode configuration file (default: %u)", 1), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-maxrecsigsage=<n>", strprintf("Number of seconds to keep LLMQ recovery sigs (default: %u)", DEFAULT_MAX_RECOVERED_SIGS_AGE), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-llmqrecsigscachesize=<n>", strprintf("Number of LLMQ recovery sig lookups to cache by id, session and hash each (default: %u)", llmq::DEFAULT_RECSIGS_CACHE_SIZE), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-masternodeblsprivkey=<n>", "Set the masternode private key", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-minsporkkeys=<n>", "Overrides minimum spork signers to change spork value. Only useful for regtest. Using this on mainnet or testnet will ban you.", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
-    argsman.AddArg("-assetindex=<n>", strprintf("Wallet is Asset aware, won't spend assets when sending only Syscoin (0-1, default: 0)"), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);		
+    argsman.AddArg("-assetindex=<n>", strprintf("Wallet is Asset aware, won't spend assets when sending only Syscoin. Also maintains an index of assets by symbol, contract and notary used by the listassets and assetlookup RPCs, unless pruning (0-1, default: 0)"), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);		
     argsman.AddArg("-dip3params=<n:m>", "DIP3 params used for testing only", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);	
     argsman.AddArg("-llmqtestparams=<n:m>", "LLMQ params used for testing only", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-mncollateral=<n>", strprintf("Masternode Collateral required, used for testing only (default: %u)", DEFAULT_MN_COLLATERAL_REQUIRED), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
@@ -603,6 +628,8 @@ void SetupServerArgs(NodeContext& node)
     argsman.AddArg("-zmqpubrawgovernanceobject=<address>", "Enable publish raw governance objects transaction in <address>", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
     argsman.AddArg("-zmqpubrawmempooltx=<address>", "Enable publish raw transaction in <address> when entering mempool only", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
     argsman.AddArg("-zmqpubrawmempooltxhwm=<n>", strprintf("Set publish raw mempool transaction outbound message high water mark (default: %d)", CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubzdagstatus=<address>", "Enable publish Z-DAG status changes of asset allocations in the mempool in <address>", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubzdagstatushwm=<n>", strprintf("Set publish Z-DAG status outbound message high water mark (default: %d)", CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
     argsman.AddArg("-zmqpubsequencehwm=<n>", strprintf("Set publish hash sequence message high water mark (default: %d)", CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
 #else
     // SYSCOIN
@@ -617,6 +644,8 @@ void SetupServerArgs(NodeContext& node)
     hidden_args.emplace_back("-zmqpubrawmempooltx=<address>");
     hidden_args.emplace_back("-zmqpubrawmempoolhwm=<n>");
     hidden_args.emplace_back("-zmqpubsequence=<n>");
+    hidden_args.emplace_back("-zmqpubzdagstatus=<address>");
+    hidden_args.emplace_back("-zmqpubzdagstatushwm=<n>");
     hidden_args.emplace_back("-zmqpubhashblockhwm=<n>");
     hidden_args.emplace_back("-zmqpubhashtxhwm=<n>");
     hidden_args.emplace_back("-zmqpubrawblockhwm=<n>");
@@ -997,6 +1026,9 @@ bool AppInitParameterInteraction(const ArgsManager& args)
             return InitError(_("Prune mode is incompatible with -txindex."));
         if (args.GetBoolArg("-coinstatsindex", DEFAULT_COINSTATSINDEX))
             return InitError(_("Prune mode is incompatible with -coinstatsindex."));
+        // SYSCOIN
+        if (args.GetBoolArg("-assetaddressindex", DEFAULT_ASSETADDRESSINDEX))
+            return InitError(_("Prune mode is incompatible with -assetaddressindex."));
     }
 
     // -bind and -whitebind can't be set when not listening
@@ -1208,6 +1240,9 @@ bool AppInitSanityChecks()
     // ********************************************************* Step 4: sanity checks
 
     init::SetGlobals();
+    // SYSCOIN
+    const std::string keccak_algo = dev::sha3AutoDetect();
+    LogPrintf("Using the '%s' Keccak implementation\n", keccak_algo);
 
     if (!init::SanityChecks()) {
         return InitError(strprintf(_("Initialization sanity check failed. %s is shutting down."), PACKAGE_NAME));
@@ -1291,6 +1326,8 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
 
     InitSignatureCache();
     InitScriptExecutionCache();
+    // SYSCOIN
+    InitMintProofCache();
 
     int script_threads = args.GetArg("-par", DEFAULT_SCRIPTCHECK_THREADS);
     if (script_threads <= 0) {
@@ -1870,6 +1907,19 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
         g_coin_stats_index = std::make_unique<CoinStatsIndex>(/* cache size */ 0, false, fReindex);
         g_coin_stats_index->Start();
     }
+    // SYSCOIN
+    if (fAssetIndex) {
+        if (fPruneMode) {
+            LogPrintf("Prune mode is enabled, asset lookups by symbol, contract and notary are not indexed\n");
+        } else {
+            g_asset_index = std::make_unique<AssetIndex>(/* cache size */ 0, false, fReindex);
+            g_asset_index->Start();
+        }
+    }
+    if (args.GetBoolArg("-assetaddressindex", DEFAULT_ASSETADDRESSINDEX)) {
+        g_asset_address_index = std::make_unique<AssetAddressIndex>(/* cache size */ 0, false, fReindex);
+        g_asset_address_index->Start();
+    }
 
     // ********************************************************* Step 9: load wallet
     for (const auto& client : node.chain_clients) {
@@ -2014,19 +2064,20 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
         }
     }
 
-    strDBName = "governance.dat";
     uiInterface.InitMessage(_("Loading governance cache...").translated);
-    CFlatDB<CGovernanceManager> flatdb3(strDBName, "magicGovernanceCache");
-    if (fLoadCacheFiles && !fDisableGovernance) {
-        if(!flatdb3.Load(governance)) {
-            return InitError(strprintf(_("Failed to load governance cache from %s\n"), (pathDB / strDBName).string()));
-        }
+    const bool fLoadGovernance = fLoadCacheFiles && !fDisableGovernance;
+    try {
+        governanceDb.reset(new CGovernanceDB(GOVERNANCE_DB_CACHE_SIZE, false, !fLoadGovernance));
+    } catch (const std::exception& e) {
+        return InitError(strprintf(_("Failed to load governance cache from %s: %s\n"), (pathDB / "governance").string(), e.what()));
+    }
+    if (fLoadGovernance) {
+        // the flat file was replaced by the governance db, its content is moved over once
+        governance.MigrateFlatFile();
+        governance.LoadFromDB();
         governance.InitOnLoad();
-    } else {
-        CGovernanceManager governanceTmp;
-        if(!flatdb3.Dump(governanceTmp)) {
-            return InitError(strprintf(_("Failed to clear governance cache at %s\n"), (pathDB / strDBName).string()));
-        }
+    } else if (fs::exists(pathDB / "governance.dat")) {
+        fs::remove(pathDB / "governance.dat");
     }
 
     strDBName = "netfulfilled.dat";
@@ -2051,6 +2102,7 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
     node.scheduler->scheduleEvery(std::bind(CMasternodeUtils::DoMaintenance, std::ref(*node.connman)), std::chrono::minutes{1});
     if (!fDisableGovernance) {
         node.scheduler->scheduleEvery([&] { governance.DoMaintenance(*node.connman); }, std::chrono::minutes{5});
+        governance.StartWorkerThread(*node.connman, *node.peerman);
     }
     llmq::StartLLMQSystem();
     // ********************************************************* Step 12: start node
@@ -14,6 +14,7 @@
 #include <evo/deterministicmns.h>
 
 #include <masternode/activemasternode.h>
+#include <random.h>
 #include <chainparams.h>
 #include <init.h>
 #include <masternode/masternodesync.h>
@@ -25,6 +26,8 @@
 namespace llmq
 {
 
+static const std::string DB_QUORUM_DATA = "q_Qdata";
+// entries of older versions, only read to move them to DB_QUORUM_DATA
 static const std::string DB_QUORUM_SK_SHARE = "q_Qsk";
 static const std::string DB_QUORUM_QUORUM_VVEC = "q_Qqvvec";
 
@@ -41,6 +44,12 @@ static uint256 MakeQuorumKey(const CQuorum& q)
     return hw.GetHash();
 }
 
+bool CQuorumDataRecord::SetSkShare(const CBLSPublicKey& pubKeyOperator, const CBLSSecretKey& skShareIn)
+{
+    skShare.ivSeed = GetRandHash();
+    return skShare.Encrypt(0, pubKeyOperator, skShareIn, PROTOCOL_VERSION);
+}
+
 CQuorum::CQuorum(const Consensus::LLMQParams& _params, CBLSWorker& _blsWorker) : params(_params), blsCache(_blsWorker)
 {
 }
@@ -99,18 +108,23 @@ int CQuorum::GetMemberIndex(const uint256& proTxHash) const
     return -1;
 }
 
-void CQuorum::WriteContributions()
+bool CQuorum::WriteContributions()
 {
-    if(!evoDb)
-        return;
-    uint256 dbKey = MakeQuorumKey(*this);
+    if(!evoDb || quorumVvec == nullptr)
+        return false;
 
-    if (quorumVvec != nullptr) {
-        evoDb->GetRawDB().Write(std::make_pair(DB_QUORUM_QUORUM_VVEC, dbKey), *quorumVvec);
-    }
+    CQuorumDataRecord record;
+    record.quorumKey = MakeQuorumKey(*this);
+    record.quorumVvec = *quorumVvec;
     if (skShare.IsValid()) {
-        evoDb->GetRawDB().Write(std::make_pair(DB_QUORUM_SK_SHARE, dbKey), skShare);
+        if (!activeMasternodeInfo.blsPubKeyOperator || !record.SetSkShare(*activeMasternodeInfo.blsPubKeyOperator, skShare)) {
+            // don't store the vvec alone, we would not try to build the skShare again after a restart
+            LogPrint(BCLog::LLMQ, "CQuorum::%s -- failed to encrypt skShare for quorum %s\n", __func__, qc->quorumHash.ToString());
+            return false;
+        }
     }
+    evoDb->GetRawDB().Write(std::make_tuple(DB_QUORUM_DATA, params.type, qc->quorumHash), record);
+    return true;
 }
 
 bool CQuorum::ReadContributions()
@@ -119,17 +133,47 @@ bool CQuorum::ReadContributions()
         return false;
     uint256 dbKey = MakeQuorumKey(*this);
 
+    CQuorumDataRecord record;
+    if (!evoDb->GetRawDB().Read(std::make_tuple(DB_QUORUM_DATA, params.type, qc->quorumHash), record) || record.quorumKey != dbKey) {
+        return ReadLegacyContributions(dbKey);
+    }
+    quorumVvec = std::make_shared<BLSVerificationVector>(std::move(record.quorumVvec));
+
+    // An invalid skShare usually means that we are not a member of the quorum but observed the whole DKG process to
+    // have the quorum verification vector. Failing to decrypt it is not fatal either, the quorum is still usable as a
+    // non-member. Decrypting with another operator key does not reliably fail, so the result is checked against the
+    // verification vector
+    if (record.skShare.IsValid()) {
+        if (!activeMasternodeInfo.blsKeyOperator || !record.skShare.Decrypt(0, *activeMasternodeInfo.blsKeyOperator, skShare, PROTOCOL_VERSION) ||
+            skShare.GetPublicKey() != GetPubKeyShare(GetMemberIndex(activeMasternodeInfo.proTxHash))) {
+            skShare.Reset();
+            LogPrint(BCLog::LLMQ, "CQuorum::%s -- failed to decrypt skShare for quorum %s\n", __func__, qc->quorumHash.ToString());
+        }
+    }
+
+    return true;
+}
+
+// Reads the unencrypted entries of older versions and moves them to a CQuorumDataRecord
+bool CQuorum::ReadLegacyContributions(const uint256& dbKey)
+{
     BLSVerificationVector qv;
-    if (evoDb->Read(std::make_pair(DB_QUORUM_QUORUM_VVEC, dbKey), qv)) {
-        quorumVvec = std::make_shared<BLSVerificationVector>(std::move(qv));
-    } else {
+    if (!evoDb->Read(std::make_pair(DB_QUORUM_QUORUM_VVEC, dbKey), qv)) {
         return false;
     }
+    quorumVvec = std::make_shared<BLSVerificationVector>(std::move(qv));
 
     // We ignore the return value here as it is ok if this fails. If it fails, it usually means that we are not a
     // member of the quorum but observed the whole DKG process to have the quorum verification vector.
     evoDb->Read(std::make_pair(DB_QUORUM_SK_SHARE, dbKey), skShare);
 
+    // the legacy entries are the only copy of the skShare until the record replacing them is written, e.g. it can't be
+    // encrypted without an operator key, so they are kept until that succeeds
+    if (WriteContributions()) {
+        evoDb->GetRawDB().Erase(std::make_pair(DB_QUORUM_QUORUM_VVEC, dbKey));
+        evoDb->GetRawDB().Erase(std::make_pair(DB_QUORUM_SK_SHARE, dbKey));
+    }
+
     return true;
 }
 
@@ -170,6 +214,12 @@ void CQuorumManager::UpdatedBlockTip(const CBlockIndex* pindexNew, bool fInitial
     for (auto& p : Params().GetConsensus().llmqs) {
         EnsureQuorumConnections(p.first, pindexNew);
     }
+
+    if (!fInitialDownload) {
+        for (auto& p : Params().GetConsensus().llmqs) {
+            CleanupOldQuorumData(p.first, pindexNew);
+        }
+    }
 }
 
 void CQuorumManager::EnsureQuorumConnections(uint8_t llmqType, const CBlockIndex* pindexNew)
@@ -198,6 +248,49 @@ void CQuorumManager::EnsureQuorumConnections(uint8_t llmqType, const CBlockIndex
     }
 }
 
+// Removes the stored vvecs and skShares of quorums which are not used for signing anymore. They are built again from
+// the DKG contributions if such an old quorum is requested later. Runs once per DKG interval of the LLMQ type and
+// keeps the quorums we keep connections for, so quorums are not rebuilt and erased again block after block
+void CQuorumManager::CleanupOldQuorumData(uint8_t llmqType, const CBlockIndex* pindexNew) const
+{
+    const auto& params = Params().GetConsensus().llmqs.at(llmqType);
+    if (!evoDb || pindexNew->nHeight % params.dkgInterval != 0) {
+        return;
+    }
+
+    std::set<uint256> setQuorumsToKeep;
+    std::vector<CQuorumCPtr> vecQuorums;
+    // the quorum of the round starting now is mined later in the interval, keep one more until the next cleanup
+    ScanQuorums(llmqType, pindexNew, (size_t)std::max(params.keepOldConnections + 1, params.signingActiveQuorumCount), vecQuorums);
+    for (auto& quorum : vecQuorums) {
+        setQuorumsToKeep.emplace(quorum->qc->quorumHash);
+    }
+
+    std::unique_ptr<CDBIterator> pcursor(evoDb->GetRawDB().NewIterator());
+    auto start = std::make_tuple(DB_QUORUM_DATA, llmqType, uint256());
+    pcursor->Seek(start);
+
+    CDBBatch batch(evoDb->GetRawDB());
+    size_t nErased{0};
+    while (pcursor->Valid()) {
+        decltype(start) k;
+        if (!pcursor->GetKey(k) || std::get<0>(k) != DB_QUORUM_DATA || std::get<1>(k) != llmqType) {
+            break;
+        }
+        if (!setQuorumsToKeep.count(std::get<2>(k))) {
+            batch.Erase(k);
+            nErased++;
+        }
+        pcursor->Next();
+    }
+    pcursor.reset();
+
+    if (nErased > 0) {
+        LogPrint(BCLog::LLMQ, "CQuorumManager::%s -- removing data of %d old quorums of type %d\n", __func__, nErased, llmqType);
+        evoDb->GetRawDB().WriteBatch(batch);
+    }
+}
+
 bool CQuorumManager::BuildQuorumFromCommitment(const uint8_t llmqType, const CBlockIndex* pindexQuorum, std::shared_ptr<CQuorum>& quorum) const
 {
     assert(pindexQuorum);
@@ -216,8 +309,10 @@ bool CQuorumManager::BuildQuorumFromCommitment(const uint8_t llmqType, const CBl
     quorum->Init(qc, pindexQuorum, minedBlockHash, members);
 
     bool hasValidVvec = false;
+    cxxtimer::Timer t(true);
     if (quorum->ReadContributions()) {
         hasValidVvec = true;
+        LogPrint(BCLog::LLMQ, "CQuorumManager::%s -- loaded quorum vvec and skShare for block %s. time=%d\n", __func__, qc->quorumHash.ToString(), t.count());
     } else {
         if (BuildQuorumContributions(qc, quorum)) {
             quorum->WriteContributions();
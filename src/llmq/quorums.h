@@ -5,6 +5,7 @@
 #ifndef SYSCOIN_LLMQ_QUORUMS_H
 #define SYSCOIN_LLMQ_QUORUMS_H
 
+#include <ctpl.h>
 #include <threadinterrupt.h>
 
 #include <validationinterface.h>
@@ -13,6 +14,7 @@
 #include <unordered_lru_cache.h>
 
 #include <bls/bls.h>
+#include <bls/bls_ies.h>
 #include <bls/bls_worker.h>
 class CNode;
 class CConnman;
@@ -36,6 +38,29 @@ class CDKGSessionManager;
  * the public key shares of individual members, which are needed to verify signature shares of these members.
  */
 
+/**
+ * Compact on-disk form of the quorum verification vector and of our secret key share, stored per quorum hash so that
+ * quorums don't need to be rebuilt from the DKG contributions after a restart. The secret key share is encrypted to our
+ * operator key.
+ */
+class CQuorumDataRecord
+{
+public:
+    // guards against loading the data of a quorum with another member list
+    uint256 quorumKey;
+    BLSVerificationVector quorumVvec;
+    // not valid if we are not a member of the quorum
+    CBLSIESEncryptedObject<CBLSSecretKey> skShare;
+
+    SERIALIZE_METHODS(CQuorumDataRecord, obj)
+    {
+        READWRITE(obj.quorumKey, obj.quorumVvec, obj.skShare);
+    }
+
+    // encrypts skShareIn to the operator key with a fresh IV seed, the blob is not valid without one
+    bool SetSkShare(const CBLSPublicKey& pubKeyOperator, const CBLSSecretKey& skShareIn);
+};
+
 class CQuorum;
 typedef std::shared_ptr<CQuorum> CQuorumPtr;
 typedef std::shared_ptr<const CQuorum> CQuorumCPtr;
@@ -72,9 +97,13 @@ public:
     CBLSPublicKey GetPubKeyShare(size_t memberIdx) const;
     const CBLSSecretKey& GetSkShare() const;
 
-private:
-    void WriteContributions();
+    // store and load quorumVvec and skShare, the skShare is encrypted to the operator key of this node
+    // WriteContributions returns false if nothing was written
+    bool WriteContributions();
     bool ReadContributions();
+
+private:
+    bool ReadLegacyContributions(const uint256& dbKey);
 };
 
 /**
@@ -118,6 +147,7 @@ public:
 private:
     // all private methods here are cs_main-free
     void EnsureQuorumConnections(uint8_t llmqType, const CBlockIndex *pindexNew);
+    void CleanupOldQuorumData(uint8_t llmqType, const CBlockIndex* pindexNew) const;
 
     bool BuildQuorumFromCommitment(const uint8_t llmqType, const CBlockIndex* pindexQuorum, std::shared_ptr<CQuorum>& quorum) const EXCLUSIVE_LOCKS_REQUIRED(quorumsCacheCs);
     bool BuildQuorumContributions(const CFinalCommitmentPtr& fqc, std::shared_ptr<CQuorum>& quorum) const;
@@ -15,6 +15,8 @@
 #include <txmempool.h>
 #include <validation.h>
 #include <scheduler.h>
+
+#include <cxxtimer.hpp>
 namespace llmq
 {
 
@@ -195,6 +197,92 @@ bool CChainLocksHandler::TryUpdateBestChainLock(const CBlockIndex* pindex)
     return false;
 }
 
+// the signature of a share must be verified already
+static void PushChainLockRecoveredSig(const CChainLockSig& clsig, const CQuorumCPtr& quorum, const uint256& requestId)
+{
+    const auto& llmqType = Params().GetConsensus().llmqTypeChainLocks;
+    if (quorumSigningManager->HasRecoveredSigForId(llmqType, requestId)) {
+        return;
+    }
+    // We can reconstruct the CRecoveredSig from the clsig and pass it to the signing manager, which
+    // avoids unnecessary double-verification of the signature.
+    std::shared_ptr<CRecoveredSig> rs = std::make_shared<CRecoveredSig>();
+    rs->llmqType = llmqType;
+    rs->quorumHash = quorum->qc->quorumHash;
+    rs->id = requestId;
+    rs->msgHash = clsig.blockHash;
+    rs->sig.Set(clsig.sig);
+    rs->UpdateHash();
+    quorumSigningManager->PushReconstructedRecoveredSig(rs);
+}
+
+bool CChainLocksHandler::PrepareChainLockShare(const CChainLockSig& clsig, const CBlockIndex* pindexScan, PendingChainLockShare& share)
+{
+    const auto& consensus = Params().GetConsensus();
+    const auto& llmqType = consensus.llmqTypeChainLocks;
+    const auto& signingActiveQuorumCount = consensus.llmqs.at(llmqType).signingActiveQuorumCount;
+
+    std::vector<CQuorumCPtr> quorums_scanned;
+    llmq::quorumManager->ScanQuorums(llmqType, pindexScan, signingActiveQuorumCount, quorums_scanned);
+    const size_t nSigner = std::find(clsig.signers.begin(), clsig.signers.end(), true) - clsig.signers.begin();
+    if (nSigner >= quorums_scanned.size()) {
+        return false;
+    }
+    for (size_t i = 0; i <= nSigner; ++i) {
+        if (quorums_scanned[i] == nullptr) {
+            return false;
+        }
+    }
+    share.nQuorumIndex = nSigner;
+    share.quorum = quorums_scanned[nSigner];
+    share.requestId = ::SerializeHash(std::make_tuple(CLSIG_REQUESTID_PREFIX, clsig.nHeight, share.quorum->qc->quorumHash));
+    share.signHash = CLLMQUtils::BuildSignHash(llmqType, share.quorum->qc->quorumHash, share.requestId, clsig.blockHash);
+    return true;
+}
+
+void CChainLocksHandler::ProcessPendingChainLockShares()
+{
+    std::vector<PendingChainLockShare> vShares;
+    {
+        LOCK(cs);
+        vShares = std::move(pendingShares);
+        pendingShares.clear();
+    }
+    if (vShares.empty()) {
+        return;
+    }
+
+    // It's ok to perform insecure batched verification here as we verify against the quorum public keys, which are not
+    // craftable by individual entities, making the rogue public key attack impossible
+    CBLSBatchVerifier<NodeId, uint256> batchVerifier(false, true);
+    size_t verifyCount = 0;
+    for (const auto& share : vShares) {
+        if (!share.clsig.sig.IsValid()) {
+            batchVerifier.badMessages.emplace(share.hash);
+            continue;
+        }
+        batchVerifier.PushMessage(share.from, share.hash, share.signHash, share.clsig.sig, share.quorum->qc->quorumPublicKey);
+        verifyCount++;
+    }
+
+    cxxtimer::Timer verifyTimer(true);
+    batchVerifier.Verify();
+    verifyTimer.stop();
+    verifyStats.Add(batchVerifier, verifyCount);
+
+    LogPrint(BCLog::CHAINLOCKS, "CChainLocksHandler::%s -- verified CLSIG share(s). count=%d, vt=%d, nodes=%d\n", __func__, verifyCount, verifyTimer.count(), batchVerifier.GetUniqueSourceCount());
+
+    for (auto& share : vShares) {
+        if (batchVerifier.badMessages.count(share.hash)) {
+            LogPrint(BCLog::CHAINLOCKS, "CChainLocksHandler::%s -- invalid CLSIG (%s), peer=%d\n", __func__, share.clsig.ToString(), share.from);
+            peerman.Misbehaving(share.from, 10, "invalid CLSIG");
+            continue;
+        }
+        PushChainLockRecoveredSig(share.clsig, share.quorum, share.requestId);
+        ProcessVerifiedChainLockShare(share.from, share.clsig, share.pindexSig, std::make_pair(share.nQuorumIndex, share.quorum));
+    }
+}
+
 bool CChainLocksHandler::VerifyChainLockShare(const CChainLockSig& clsig, const CBlockIndex* pindexScan, const uint256& idIn, std::pair<int, CQuorumCPtr>& ret)
 {
     const auto& consensus = Params().GetConsensus();
@@ -232,18 +320,8 @@ bool CChainLocksHandler::VerifyChainLockShare(const CChainLockSig& clsig, const
                 __func__, clsig.ToString(), requestId.ToString(), signHash.ToString());
 
         if (clsig.sig.VerifyInsecure(quorum->qc->quorumPublicKey, signHash)) {
-            if (idIn.IsNull() && !quorumSigningManager->HasRecoveredSigForId(llmqType, requestId)) {
-                // We can reconstruct the CRecoveredSig from the clsig and pass it to the signing manager, which
-                // avoids unnecessary double-verification of the signature. We can do this here because we just
-                // verified the sig.
-                std::shared_ptr<CRecoveredSig> rs = std::make_shared<CRecoveredSig>();
-                rs->llmqType = llmqType;
-                rs->quorumHash = quorum->qc->quorumHash;
-                rs->id = requestId;
-                rs->msgHash = clsig.blockHash;
-                rs->sig.Set(clsig.sig);
-                rs->UpdateHash();
-                quorumSigningManager->PushReconstructedRecoveredSig(rs);
+            if (idIn.IsNull()) {
+                PushChainLockRecoveredSig(clsig, quorum, requestId);
             }
             ret = std::make_pair(i, quorum);
             return true;
@@ -313,7 +391,6 @@ void CChainLocksHandler::ProcessMessage(CNode* pfrom, const std::string& strComm
 void CChainLocksHandler::ProcessNewChainLock(const NodeId from, llmq::CChainLockSig& clsig, const uint256&hash, const uint256& idIn )
 {
     assert((from == -1) ^ idIn.IsNull());
-    bool enforced = false;
     if (from != -1) {
         LOCK(cs_main);
         peerman.ReceivedResponse(from, hash);
@@ -384,54 +461,39 @@ void CChainLocksHandler::ProcessNewChainLock(const NodeId from, llmq::CChainLock
         // A part of a multi-quorum CLSIG signed by a single quorum
         std::pair<int, CQuorumCPtr> ret;
         clsig.signers.resize(signingActiveQuorumCount, false);
-        if (!VerifyChainLockShare(clsig, pindexScan, idIn, ret)) {
-            LogPrint(BCLog::CHAINLOCKS, "CChainLocksHandler::%s -- invalid CLSIG (%s), peer=%d\n", __func__, clsig.ToString(), from);
-            if (from != -1) {
+        if (from != -1 && std::count(clsig.signers.begin(), clsig.signers.end(), true) == 1) {
+            // shares of other nodes name their quorum, verify them in one batch with the shares which arrive shortly after
+            PendingChainLockShare share;
+            if (!PrepareChainLockShare(clsig, pindexScan, share)) {
+                LogPrint(BCLog::CHAINLOCKS, "CChainLocksHandler::%s -- invalid CLSIG (%s), peer=%d\n", __func__, clsig.ToString(), from);
                 peerman.Misbehaving(from, 10, "invalid CLSIG");
-            }
-            return;
-        }
-        CInv clsigAggInv;
-        {
-            LOCK(cs);
-            clsig.signers[ret.first] = true;
-            if (std::count(clsig.signers.begin(), clsig.signers.end(), true) > 1) {
-                // this should never happen
-                LogPrint(BCLog::CHAINLOCKS, "CChainLocksHandler::%s -- ERROR in VerifyChainLockShare, CLSIG (%s), peer=%d\n", __func__, clsig.ToString(), from);
                 return;
             }
-            auto it = bestChainLockShares.find(clsig.nHeight);
-            if (it == bestChainLockShares.end()) {
-                bestChainLockShares[clsig.nHeight].try_emplace(ret.second, std::make_shared<const CChainLockSig>(clsig));
-            } else {
-                it->second.try_emplace(ret.second, std::make_shared<const CChainLockSig>(clsig));
+            share.from = from;
+            share.hash = hash;
+            share.clsig = clsig;
+            share.pindexSig = pindexSig;
+            bool fSchedule;
+            {
+                LOCK(cs);
+                fSchedule = pendingShares.empty();
+                pendingShares.emplace_back(std::move(share));
             }
-            mostRecentChainLockShare = clsig;
-            if (TryUpdateBestChainLock(pindexSig)) {
-                clsigAggInv = CInv(MSG_CLSIG, ::SerializeHash(bestChainLockWithKnownBlock));
+            if (fSchedule) {
+                scheduler->scheduleFromNow([&]() {
+                    ProcessPendingChainLockShares();
+                }, std::chrono::milliseconds{PENDING_SHARES_BATCH_DELAY});
             }
+            return;
         }
-        // Note: do not hold cs while calling RelayInv
-        AssertLockNotHeld(cs);
-        if (clsigAggInv.type == MSG_CLSIG) {
-            // We just created an aggregated CLSIG, relay it
-            connman.RelayOtherInv(clsigAggInv);
-        } else {
-            CInv clsigInv(MSG_CLSIG, ::SerializeHash(clsig));
-            // Relay partial CLSIGs to full nodes only, SPV wallets should wait for the aggregated CLSIG.
-            connman.ForEachNode([&](CNode* pnode) {
-                bool fSPV{false};
-                if(pnode->m_tx_relay != nullptr) {
-                    LOCK(pnode->m_tx_relay->cs_filter);
-                    fSPV = pnode->m_tx_relay->pfilter != nullptr;
-                }
-                if (!fSPV && pnode->CanRelay()) {
-                    pnode->PushOtherInventory(clsigInv);
-                }
-            });
-            // Try signing the tip ourselves
-            TrySignChainTip();
+        if (!VerifyChainLockShare(clsig, pindexScan, idIn, ret)) {
+            LogPrint(BCLog::CHAINLOCKS, "CChainLocksHandler::%s -- invalid CLSIG (%s), peer=%d\n", __func__, clsig.ToString(), from);
+            if (from != -1) {
+                peerman.Misbehaving(from, 10, "invalid CLSIG");
+            }
+            return;
         }
+        ProcessVerifiedChainLockShare(from, clsig, pindexSig, ret);
     } else {
         CInv clsigInv(MSG_CLSIG, hash);
         // An aggregated CLSIG
@@ -451,8 +513,58 @@ void CChainLocksHandler::ProcessNewChainLock(const NodeId from, llmq::CChainLock
         // Note: do not hold cs while calling RelayInv
         AssertLockNotHeld(cs);
         connman.RelayOtherInv(clsigInv);
+        EnforceChainLockSig(from, clsig, pindexSig);
     }
-    
+}
+
+void CChainLocksHandler::ProcessVerifiedChainLockShare(const NodeId from, CChainLockSig& clsig, const CBlockIndex* pindexSig, const std::pair<int, CQuorumCPtr>& ret)
+{
+    CInv clsigAggInv;
+    {
+        LOCK(cs);
+        clsig.signers[ret.first] = true;
+        if (std::count(clsig.signers.begin(), clsig.signers.end(), true) > 1) {
+            // this should never happen
+            LogPrint(BCLog::CHAINLOCKS, "CChainLocksHandler::%s -- ERROR in VerifyChainLockShare, CLSIG (%s), peer=%d\n", __func__, clsig.ToString(), from);
+            return;
+        }
+        auto it = bestChainLockShares.find(clsig.nHeight);
+        if (it == bestChainLockShares.end()) {
+            bestChainLockShares[clsig.nHeight].try_emplace(ret.second, std::make_shared<const CChainLockSig>(clsig));
+        } else {
+            it->second.try_emplace(ret.second, std::make_shared<const CChainLockSig>(clsig));
+        }
+        mostRecentChainLockShare = clsig;
+        if (TryUpdateBestChainLock(pindexSig)) {
+            clsigAggInv = CInv(MSG_CLSIG, ::SerializeHash(bestChainLockWithKnownBlock));
+        }
+    }
+    // Note: do not hold cs while calling RelayInv
+    AssertLockNotHeld(cs);
+    if (clsigAggInv.type == MSG_CLSIG) {
+        // We just created an aggregated CLSIG, relay it
+        connman.RelayOtherInv(clsigAggInv);
+    } else {
+        CInv clsigInv(MSG_CLSIG, ::SerializeHash(clsig));
+        // Relay partial CLSIGs to full nodes only, SPV wallets should wait for the aggregated CLSIG.
+        connman.ForEachNode([&](CNode* pnode) {
+            bool fSPV{false};
+            if(pnode->m_tx_relay != nullptr) {
+                LOCK(pnode->m_tx_relay->cs_filter);
+                fSPV = pnode->m_tx_relay->pfilter != nullptr;
+            }
+            if (!fSPV && pnode->CanRelay()) {
+                pnode->PushOtherInventory(clsigInv);
+            }
+        });
+        // Try signing the tip ourselves
+        TrySignChainTip();
+    }
+    EnforceChainLockSig(from, clsig, pindexSig);
+}
+
+void CChainLocksHandler::EnforceChainLockSig(const NodeId from, const CChainLockSig& clsig, const CBlockIndex* pindexSig)
+{
     if (pindexSig == nullptr) {
         // we don't know the block/header for this CLSIG yet, so bail out for now
         // when the block or the header later comes in, we will enforce the correct chain
@@ -466,6 +578,7 @@ void CChainLocksHandler::ProcessNewChainLock(const NodeId from, llmq::CChainLock
     if (bChainLockMatchSigIndex) {
         CheckActiveState();
         const CBlockIndex* pindex;
+        bool enforced;
         {       
             LOCK(cs);
             pindex = bestChainLockBlockIndex;
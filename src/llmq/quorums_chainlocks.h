@@ -50,6 +50,19 @@ class CChainLocksHandler : public CRecoveredSigsListener
 {
     static const int64_t CLEANUP_INTERVAL = 1000 * 30;
     static const int64_t CLEANUP_SEEN_TIMEOUT = 24 * 60 * 60 * 1000;
+    // shares of other nodes wait this long (in ms) so they are verified in one batch with the shares arriving after them
+    static const int64_t PENDING_SHARES_BATCH_DELAY = 100;
+
+    struct PendingChainLockShare {
+        NodeId from;
+        uint256 hash;
+        CChainLockSig clsig;
+        const CBlockIndex* pindexSig;
+        int nQuorumIndex;
+        CQuorumCPtr quorum;
+        uint256 requestId;
+        uint256 signHash;
+    };
 
 
 private:
@@ -74,6 +87,9 @@ private:
 
     int64_t lastCleanupTime GUARDED_BY(cs) {0};
 
+    std::vector<PendingChainLockShare> pendingShares GUARDED_BY(cs);
+    CSigBatchVerifyStats verifyStats;
+
 public:
     CConnman& connman;
     PeerManager& peerman;
@@ -100,6 +116,8 @@ public:
     bool HasChainLock(int nHeight, const uint256& blockHash);
     bool HasConflictingChainLock(int nHeight, const uint256& blockHash);
 
+    const CSigBatchVerifyStats& GetVerifyStats() const { return verifyStats; }
+
 
 private:
     // these require locks to be held already
@@ -109,6 +127,10 @@ private:
     bool TryUpdateBestChainLock(const CBlockIndex* pindex) EXCLUSIVE_LOCKS_REQUIRED(cs);
     bool VerifyChainLockShare(const CChainLockSig& clsig, const CBlockIndex* pindexScan, const uint256& idIn, std::pair<int, CQuorumCPtr>& ret) LOCKS_EXCLUDED(cs);
     bool VerifyAggregatedChainLock(const CChainLockSig& clsig, const CBlockIndex* pindexScan) LOCKS_EXCLUDED(cs);
+    bool PrepareChainLockShare(const CChainLockSig& clsig, const CBlockIndex* pindexScan, PendingChainLockShare& share) LOCKS_EXCLUDED(cs);
+    void ProcessPendingChainLockShares() LOCKS_EXCLUDED(cs);
+    void ProcessVerifiedChainLockShare(NodeId from, CChainLockSig& clsig, const CBlockIndex* pindexSig, const std::pair<int, CQuorumCPtr>& ret) LOCKS_EXCLUDED(cs);
+    void EnforceChainLockSig(NodeId from, const CChainLockSig& clsig, const CBlockIndex* pindexSig) LOCKS_EXCLUDED(cs);
     void Cleanup();
 };
 
@@ -14,6 +14,8 @@ namespace llmq
 
 // If true, we will connect to all new quorums and watch their communication
 static const bool DEFAULT_WATCH_QUORUMS = false;
+// Number of recovered sig lookups cached per kind (by id, by session and by hash)
+static const unsigned int DEFAULT_RECSIGS_CACHE_SIZE = 30000;
 
 // Init/destroy LLMQ globals
 void InitLLMQSystem(bool unitTests, CConnman& connman, BanMan& banman, PeerManager& peerman, bool fWipe = false);
@@ -37,10 +37,113 @@ UniValue CRecoveredSig::ToJson() const
     return ret;
 }
 
-CRecoveredSigsDb::CRecoveredSigsDb(CDBWrapper& _db) :
-    db(_db)
+UniValue CSigBatchVerifyStats::ToJson() const
 {
+    UniValue ret(UniValue::VOBJ);
+    ret.pushKV("batches", nBatches.load());
+    ret.pushKV("sigs", nSigs.load());
+    ret.pushKV("failed_batches", nFailedBatches.load());
+    ret.pushKV("bad_sources", nBadSources.load());
+    return ret;
+}
+
+static const double RECSIGS_FILTER_FP_RATE = 0.001;
+
+CRecoveredSigsDb::CRecoveredSigsDb(CDBWrapper& _db, size_t cacheSize, unsigned int filterMinSize) :
+    db(_db),
+    hasSigForIdCache(std::max<size_t>(cacheSize, 1)),
+    hasSigForSessionCache(std::max<size_t>(cacheSize, 1)),
+    hasSigForHashCache(std::max<size_t>(cacheSize, 1)),
+    knownKeysFilterMinSize(std::max<unsigned int>(filterMinSize, 1))
+{
+    RebuildKnownKeysFilter();
+}
+
+void CRecoveredSigsDb::RebuildKnownKeysFilter()
+{
+    cxxtimer::Timer t(true);
+
+    if (!BeginKnownKeysFilterRebuild()) {
+        return;
+    }
+    FinishKnownKeysFilterRebuild(ReadKnownKeys());
+
+    LOCK(cs);
+    LogPrint(BCLog::LLMQ, "CRecoveredSigsDb::%s -- added %d keys to filter of size %d, time=%d\n", __func__, knownKeysFilterInserts, knownKeysFilterSize, t.count());
+}
+
+bool CRecoveredSigsDb::BeginKnownKeysFilterRebuild()
+{
+    LOCK(cs);
+    if (fRebuildingKnownKeysFilter) {
+        return false;
+    }
+    // keys written from now on are also recorded by AddKnownKey, as the db scan might not see them
+    fRebuildingKnownKeysFilter = true;
+    return true;
+}
+
+std::vector<uint256> CRecoveredSigsDb::ReadKnownKeys() const
+{
+    // collect first, so that the filter can be sized for the number of keys
+    std::vector<uint256> keyHashes;
+    std::unique_ptr<CDBIterator> pcursor(db.NewIterator());
+    for (const auto& prefix : {std::string("rs_h"), std::string("rs_r"), std::string("rs_s")}) {
+        pcursor->Seek(prefix);
+        while (pcursor->Valid()) {
+            std::string k;
+            if (!pcursor->GetKey(k) || k != prefix) {
+                break;
+            }
+            // the hash of the serialized key is what ::SerializeHash returns for the key tuples
+            keyHashes.emplace_back(Hash(pcursor->GetKey()));
+            pcursor->Next();
+        }
+    }
+    return keyHashes;
+}
+
+void CRecoveredSigsDb::FinishKnownKeysFilterRebuild(const std::vector<uint256>& keyHashes)
+{
+    // build the new filter without holding cs, so that lookups are not blocked while it's filled
+    const unsigned int newFilterSize = std::max<unsigned int>(knownKeysFilterMinSize, keyHashes.size() * 2);
+    auto newFilter = std::make_unique<CRollingBloomFilter>(newFilterSize, RECSIGS_FILTER_FP_RATE);
+    for (const auto& keyHash : keyHashes) {
+        newFilter->insert(keyHash);
+    }
+
+    LOCK(cs);
+    for (const auto& keyHash : keysAddedWhileRebuilding) {
+        newFilter->insert(keyHash);
+    }
+    knownKeysFilterSize = newFilterSize;
+    knownKeysFilterInserts = keyHashes.size() + keysAddedWhileRebuilding.size();
+    knownKeysFilter = std::move(newFilter);
+    fRebuildingKnownKeysFilter = false;
+    keysAddedWhileRebuilding.clear();
+}
+
+template<typename K>
+bool CRecoveredSigsDb::MaybeHasKey(const K& key) const
+{
+    AssertLockHeld(cs);
+    if (!knownKeysFilter || knownKeysFilterInserts >= knownKeysFilterSize) {
+        // keys might have been rolled out of the filter already
+        return true;
+    }
+    return knownKeysFilter->contains(::SerializeHash(key));
+}
 
+void CRecoveredSigsDb::AddKnownKey(const uint256& keyHash)
+{
+    AssertLockHeld(cs);
+    if (knownKeysFilter) {
+        knownKeysFilter->insert(keyHash);
+        knownKeysFilterInserts++;
+    }
+    if (fRebuildingKnownKeysFilter) {
+        keysAddedWhileRebuilding.emplace_back(keyHash);
+    }
 }
 
 // This converts time values in "rs_t" from host endianness to big endianness, which is required to have proper ordering of the keys
@@ -119,22 +222,30 @@ void CRecoveredSigsDb::AddVoteTimeKeys()
 bool CRecoveredSigsDb::HasRecoveredSig(uint8_t llmqType, const uint256& id, const uint256& msgHash)
 {
     auto k = std::make_tuple(std::string("rs_r"), llmqType, id, msgHash);
+    {
+        LOCK(cs);
+        if (!MaybeHasKey(k)) {
+            return false;
+        }
+    }
     return db.Exists(k);
 }
 
 bool CRecoveredSigsDb::HasRecoveredSigForId(uint8_t llmqType, const uint256& id)
 {
     auto cacheKey = std::make_pair(llmqType, id);
+    auto k = std::make_tuple(std::string("rs_r"), llmqType, id);
     bool ret;
     {
         LOCK(cs);
+        if (!MaybeHasKey(k)) {
+            return false;
+        }
         if (hasSigForIdCache.get(cacheKey, ret)) {
             return ret;
         }
     }
 
-
-    auto k = std::make_tuple(std::string("rs_r"), llmqType, id);
     ret = db.Exists(k);
 
     LOCK(cs);
@@ -144,15 +255,18 @@ bool CRecoveredSigsDb::HasRecoveredSigForId(uint8_t llmqType, const uint256& id)
 
 bool CRecoveredSigsDb::HasRecoveredSigForSession(const uint256& signHash)
 {
+    auto k = std::make_tuple(std::string("rs_s"), signHash);
     bool ret;
     {
         LOCK(cs);
+        if (!MaybeHasKey(k)) {
+            return false;
+        }
         if (hasSigForSessionCache.get(signHash, ret)) {
             return ret;
         }
     }
 
-    auto k = std::make_tuple(std::string("rs_s"), signHash);
     ret = db.Exists(k);
 
     LOCK(cs);
@@ -162,15 +276,18 @@ bool CRecoveredSigsDb::HasRecoveredSigForSession(const uint256& signHash)
 
 bool CRecoveredSigsDb::HasRecoveredSigForHash(const uint256& hash)
 {
+    auto k = std::make_tuple(std::string("rs_h"), hash);
     bool ret;
     {
         LOCK(cs);
+        if (!MaybeHasKey(k)) {
+            return false;
+        }
         if (hasSigForHashCache.get(hash, ret)) {
             return ret;
         }
     }
 
-    auto k = std::make_tuple(std::string("rs_h"), hash);
     ret = db.Exists(k);
 
     LOCK(cs);
@@ -242,6 +359,10 @@ void CRecoveredSigsDb::WriteRecoveredSig(const llmq::CRecoveredSig& recSig)
 
     {
         LOCK(cs);
+        AddKnownKey(::SerializeHash(k1));
+        AddKnownKey(::SerializeHash(k2));
+        AddKnownKey(::SerializeHash(k3));
+        AddKnownKey(::SerializeHash(k4));
         hasSigForIdCache.insert(std::make_pair(recSig.llmqType, recSig.id), true);
         hasSigForSessionCache.insert(signHash, true);
         hasSigForHashCache.insert(recSig.GetHash(), true);
@@ -335,6 +456,11 @@ void CRecoveredSigsDb::CleanupOldRecoveredSigs(int64_t maxAge)
     }
     pcursor.reset();
 
+    // rebuild the filter before it starts to forget keys, this also drops the keys of removed recovered sigs
+    if (WITH_LOCK(cs, return knownKeysFilterInserts >= knownKeysFilterSize / 2)) {
+        RebuildKnownKeysFilter();
+    }
+
     if (toDelete.empty()) {
         return;
     }
@@ -429,7 +555,7 @@ void CRecoveredSigsDb::CleanupOldVotes(int64_t maxAge)
 //////////////////
 
 CSigningManager::CSigningManager(CDBWrapper& llmqDb, bool fMemory, CConnman& _connman, PeerManager& _peerman) :
-    db(llmqDb),
+    db(llmqDb, gArgs.GetArg("-llmqrecsigscachesize", DEFAULT_RECSIGS_CACHE_SIZE)),
     connman(_connman),
     peerman(_peerman)
 {
@@ -657,6 +783,8 @@ bool CSigningManager::ProcessPendingRecoveredSigs()
     batchVerifier.Verify();
     verifyTimer.stop();
 
+    verifyStats.Add(batchVerifier, verifyCount);
+
     LogPrint(BCLog::LLMQ, "CSigningManager::%s -- verified recovered sig(s). count=%d, vt=%d, nodes=%d\n", __func__, verifyCount, verifyTimer.count(), recSigsByNode.size());
 
     std::unordered_set<uint256, StaticSaltedHasher> processed;
@@ -6,14 +6,18 @@
 #define SYSCOIN_LLMQ_QUORUMS_SIGNING_H
 
 #include <bls/bls.h>
+#include <bls/bls_batchverifier.h>
 
+#include <bloom.h>
 #include <consensus/params.h>
 #include <saltedhasher.h>
 #include <univalue.h>
 #include <unordered_lru_cache.h>
 
 #include <evo/evodb.h>
+#include <llmq/quorums_init.h>
 
+#include <atomic>
 #include <unordered_map>
 #include <sync.h>
 #include <random.h>
@@ -23,6 +27,10 @@ typedef int64_t NodeId;
 class CNode;
 class CConnman;
 class PeerManager;
+namespace llmq_signing_tests
+{
+class CRecoveredSigsDbForTest;
+}
 namespace llmq
 {
 
@@ -76,18 +84,34 @@ public:
     UniValue ToJson() const;
 };
 
+// minimum number of keys the filter of known keys is sized for, it's grown when the db holds more
+static const unsigned int DEFAULT_RECSIGS_FILTER_MIN_SIZE = 100000;
+
 class CRecoveredSigsDb
 {
+    friend class llmq_signing_tests::CRecoveredSigsDbForTest;
+
 private:
     CDBWrapper& db;
 
     mutable RecursiveMutex cs;
-    unordered_lru_cache<std::pair<uint8_t, uint256>, bool, StaticSaltedHasher, 30000> hasSigForIdCache GUARDED_BY(cs);
-    unordered_lru_cache<uint256, bool, StaticSaltedHasher, 30000> hasSigForSessionCache GUARDED_BY(cs);
-    unordered_lru_cache<uint256, bool, StaticSaltedHasher, 30000> hasSigForHashCache GUARDED_BY(cs);
+    unordered_lru_cache<std::pair<uint8_t, uint256>, bool, StaticSaltedHasher> hasSigForIdCache GUARDED_BY(cs);
+    unordered_lru_cache<uint256, bool, StaticSaltedHasher> hasSigForSessionCache GUARDED_BY(cs);
+    unordered_lru_cache<uint256, bool, StaticSaltedHasher> hasSigForHashCache GUARDED_BY(cs);
+
+    // Holds the hashes of all "rs_r", "rs_h" and "rs_s" keys in the db, so that lookups of unknown recovered sigs
+    // don't have to hit the disk. Removed keys stay in the filter, which only results in a db lookup. The filter forgets
+    // the oldest keys after knownKeysFilterSize inserts, so it's only used until then and rebuilt on the next cleanup.
+    std::unique_ptr<CRollingBloomFilter> knownKeysFilter GUARDED_BY(cs);
+    unsigned int knownKeysFilterSize GUARDED_BY(cs){0};
+    unsigned int knownKeysFilterInserts GUARDED_BY(cs){0};
+    // the filter is rebuilt outside of cs, keys written meanwhile are collected here and added before it's swapped in
+    bool fRebuildingKnownKeysFilter GUARDED_BY(cs){false};
+    std::vector<uint256> keysAddedWhileRebuilding GUARDED_BY(cs);
+    const unsigned int knownKeysFilterMinSize;
 
 public:
-    explicit CRecoveredSigsDb(CDBWrapper& _db);
+    explicit CRecoveredSigsDb(CDBWrapper& _db, size_t cacheSize = DEFAULT_RECSIGS_CACHE_SIZE, unsigned int filterMinSize = DEFAULT_RECSIGS_FILTER_MIN_SIZE);
 
     void ConvertInvalidTimeKeys();
     void AddVoteTimeKeys();
@@ -113,6 +137,15 @@ public:
 
 private:
     bool ReadRecoveredSig(uint8_t llmqType, const uint256& id, CRecoveredSig& ret);
+    void RebuildKnownKeysFilter() LOCKS_EXCLUDED(cs);
+    // the steps of RebuildKnownKeysFilter, the db is scanned without holding cs
+    bool BeginKnownKeysFilterRebuild() LOCKS_EXCLUDED(cs);
+    std::vector<uint256> ReadKnownKeys() const LOCKS_EXCLUDED(cs);
+    void FinishKnownKeysFilterRebuild(const std::vector<uint256>& keyHashes) LOCKS_EXCLUDED(cs);
+    // returns false if the key is surely not in the db
+    template<typename K>
+    bool MaybeHasKey(const K& key) const EXCLUSIVE_LOCKS_REQUIRED(cs);
+    void AddKnownKey(const uint256& keyHash) EXCLUSIVE_LOCKS_REQUIRED(cs);
     void RemoveRecoveredSig(CDBBatch& batch, uint8_t llmqType, const uint256& id, bool deleteHashKey, bool deleteTimeKey)  EXCLUSIVE_LOCKS_REQUIRED(cs);
 };
 
@@ -124,6 +157,30 @@ public:
     virtual void HandleNewRecoveredSig(const CRecoveredSig& recoveredSig) = 0;
 };
 
+/** Counters of the batched verification of signatures received from other nodes */
+class CSigBatchVerifyStats
+{
+public:
+    std::atomic<uint64_t> nBatches{0};
+    std::atomic<uint64_t> nSigs{0};
+    // batches with an invalid signature, which were verified again per node
+    std::atomic<uint64_t> nFailedBatches{0};
+    std::atomic<uint64_t> nBadSources{0};
+
+    template<typename SourceId, typename MessageId>
+    void Add(const CBLSBatchVerifier<SourceId, MessageId>& batchVerifier, size_t nSigsIn)
+    {
+        nBatches++;
+        nSigs += nSigsIn;
+        if (!batchVerifier.badSources.empty()) {
+            nFailedBatches++;
+            nBadSources += batchVerifier.badSources.size();
+        }
+    }
+
+    UniValue ToJson() const;
+};
+
 class CSigningManager
 {
     friend class CSigSharesManager;
@@ -145,6 +202,8 @@ private:
 
     std::vector<CRecoveredSigsListener*> recoveredSigsListeners GUARDED_BY(cs);
 
+    CSigBatchVerifyStats verifyStats;
+
 public:
     // when selecting a quorum for signing and verification, we use CQuorumManager::SelectQuorum with this offset as
     // starting height for scanning. This is because otherwise the resulting signatures would not be verifiable by nodes
@@ -167,6 +226,8 @@ public:
     // allows AlreadyHave to keep returning true. Cleanup will later remove the remains
     void TruncateRecoveredSig(uint8_t llmqType, const uint256& id);
 
+    const CSigBatchVerifyStats& GetVerifyStats() const { return verifyStats; }
+
 private:
     void ProcessMessageRecoveredSig(CNode* pfrom, const std::shared_ptr<const CRecoveredSig>& recoveredSig);
     static bool PreVerifyRecoveredSig(const CRecoveredSig& recoveredSig, bool& retBan);
@@ -23,6 +23,11 @@ namespace llmq
 
 CSigSharesManager* quorumSigSharesManager = nullptr;
 
+// Take the lock of a node state, the node state map or a shard and count if it was held by another thread
+#define LOCK_NODE(ns) CSigSharesCountedLock<decltype((ns).cs)> PASTE2(nodelock, __COUNTER__)((ns).cs, nodeLockStats, #ns, __FILE__, __LINE__)
+#define LOCK_NODE_STATES() CSigSharesCountedLock<decltype(cs)> PASTE2(nodeslock, __COUNTER__)(cs, nodeLockStats, "cs", __FILE__, __LINE__)
+#define LOCK_SHARD(shard) CSigSharesCountedLock<decltype((shard).cs)> PASTE2(shardlock, __COUNTER__)((shard).cs, shardLockStats, #shard, __FILE__, __LINE__)
+
 void CSigShare::UpdateKey()
 {
     key.first = CLLMQUtils::BuildSignHash(*this);
@@ -182,6 +187,14 @@ void CSigSharesNodeState::RemoveSession(const uint256& signHash)
     pendingIncomingSigShares.EraseAllForSignHash(signHash);
 }
 
+UniValue CSigSharesLockStats::ToJson() const
+{
+    UniValue ret(UniValue::VOBJ);
+    ret.pushKV("locks", (int64_t)nLocks);
+    ret.pushKV("contended", (int64_t)nContended);
+    return ret;
+}
+
 //////////////////////
 
 CSigSharesManager::CSigSharesManager(CConnman& _connman, BanMan& _banman, PeerManager& _peerman): connman(_connman), banman(_banman), peerman(_peerman)
@@ -337,14 +350,14 @@ bool CSigSharesManager::ProcessMessageSigSesAnn(CNode* pfrom, const CSigSesAnn&
         return true; // let's still try other announcements from the same message
     }
 
-    LOCK(cs);
-    auto& nodeState = nodeStates[pfrom->GetId()];
-    auto& session = nodeState.GetOrCreateSessionFromAnn(ann);
-    nodeState.sessionByRecvId.erase(session.recvSessionId);
-    nodeState.sessionByRecvId.erase(ann.sessionId);
+    auto nodeState = GetOrCreateNodeState(pfrom->GetId());
+    LOCK_NODE(*nodeState);
+    auto& session = nodeState->GetOrCreateSessionFromAnn(ann);
+    nodeState->sessionByRecvId.erase(session.recvSessionId);
+    nodeState->sessionByRecvId.erase(ann.sessionId);
     session.recvSessionId = ann.sessionId;
     session.quorum = quorum;
-    nodeState.sessionByRecvId.try_emplace(ann.sessionId, &session);
+    nodeState->sessionByRecvId.try_emplace(ann.sessionId, &session);
 
     return true;
 }
@@ -385,9 +398,12 @@ bool CSigSharesManager::ProcessMessageSigSharesInv(CNode* pfrom, const CSigShare
         return true;
     }
 
-    LOCK(cs);
-    auto& nodeState = nodeStates[pfrom->GetId()];
-    auto session = nodeState.GetSessionByRecvId(inv.sessionId);
+    auto nodeState = GetNodeState(pfrom->GetId());
+    if (!nodeState) {
+        return true;
+    }
+    LOCK_NODE(*nodeState);
+    auto session = nodeState->GetSessionByRecvId(inv.sessionId);
     if (!session) {
         return true;
     }
@@ -415,9 +431,12 @@ bool CSigSharesManager::ProcessMessageGetSigShares(CNode* pfrom, const CSigShare
     LogPrint(BCLog::LLMQ_SIGS, "CSigSharesManager::%s -- signHash=%s, inv={%s}, node=%d\n", __func__,
             sessionInfo.signHash.ToString(), inv.ToString(), pfrom->GetId());
 
-    LOCK(cs);
-    auto& nodeState = nodeStates[pfrom->GetId()];
-    auto session = nodeState.GetSessionByRecvId(inv.sessionId);
+    auto nodeState = GetNodeState(pfrom->GetId());
+    if (!nodeState) {
+        return true;
+    }
+    LOCK_NODE(*nodeState);
+    auto session = nodeState->GetSessionByRecvId(inv.sessionId);
     if (!session) {
         return true;
     }
@@ -441,19 +460,22 @@ bool CSigSharesManager::ProcessMessageBatchedSigShares(CNode* pfrom, const CBatc
     std::vector<CSigShare> sigShares;
     sigShares.reserve(batchedSigShares.sigShares.size());
 
+    auto nodeState = GetOrCreateNodeState(pfrom->GetId());
     {
-        LOCK(cs);
-        auto& nodeState = nodeStates[pfrom->GetId()];
+        LOCK_NODE(*nodeState);
+        // all shares of the batch belong to the same session
+        auto& shard = GetShard(sessionInfo.signHash);
+        LOCK_SHARD(shard);
 
         for (size_t i = 0; i < batchedSigShares.sigShares.size(); i++) {
             CSigShare sigShare = RebuildSigShare(sessionInfo, batchedSigShares, i);
-            nodeState.requestedSigShares.Erase(sigShare.GetKey());
+            nodeState->requestedSigShares.Erase(sigShare.GetKey());
 
             // TODO track invalid sig shares received for PoSe?
             // It's important to only skip seen *valid* sig shares here. If a node sends us a
             // batch of mostly valid sig shares with a single invalid one and thus batched
             // verification fails, we'd skip the valid ones in the future if received from other nodes
-            if (this->sigShares.Has(sigShare.GetKey())) {
+            if (shard.sigShares.Has(sigShare.GetKey())) {
                 continue;
             }
 
@@ -473,10 +495,9 @@ bool CSigSharesManager::ProcessMessageBatchedSigShares(CNode* pfrom, const CBatc
         return true;
     }
 
-    LOCK(cs);
-    auto& nodeState = nodeStates[pfrom->GetId()];
+    LOCK_NODE(*nodeState);
     for (auto& s : sigShares) {
-        nodeState.pendingIncomingSigShares.Add(s.GetKey(), s);
+        nodeState->pendingIncomingSigShares.Add(s.GetKey(), s);
     }
     return true;
 }
@@ -514,18 +535,21 @@ void CSigSharesManager::ProcessMessageSigShare(NodeId fromId, const CSigShare& s
     }
 
     {
-        LOCK(cs);
-
-        if (sigShares.Has(sigShare.GetKey())) {
+        auto& shard = GetShard(sigShare.GetSignHash());
+        LOCK_SHARD(shard);
+        if (shard.sigShares.Has(sigShare.GetKey())) {
             return;
         }
+    }
 
-        if (quorumSigningManager->HasRecoveredSigForId(sigShare.llmqType, sigShare.id)) {
-            return;
-        }
+    if (quorumSigningManager->HasRecoveredSigForId(sigShare.llmqType, sigShare.id)) {
+        return;
+    }
 
-        auto& nodeState = nodeStates[fromId];
-        nodeState.pendingIncomingSigShares.Add(sigShare.GetKey(), sigShare);
+    {
+        auto nodeState = GetOrCreateNodeState(fromId);
+        LOCK_NODE(*nodeState);
+        nodeState->pendingIncomingSigShares.Add(sigShare.GetKey(), sigShare);
     }
 
     LogPrint(BCLog::LLMQ_SIGS, "CSigSharesManager::%s -- signHash=%s, id=%s, msgHash=%s, member=%d, node=%d\n", __func__,
@@ -580,8 +604,8 @@ void CSigSharesManager::CollectPendingSigSharesToVerify(
         std::unordered_map<std::pair<uint8_t, uint256>, CQuorumCPtr, StaticSaltedHasher>& retQuorums)
 {
     {
-        LOCK(cs);
-        if (nodeStates.empty()) {
+        auto vecNodeStates = GetNodeStates();
+        if (vecNodeStates.empty()) {
             return;
         }
 
@@ -592,21 +616,26 @@ void CSigSharesManager::CollectPendingSigSharesToVerify(
         // the whole verification process
 
         std::unordered_set<std::pair<NodeId, uint256>, StaticSaltedHasher> uniqueSignHashes;
-        CLLMQUtils::IterateNodesRandom(nodeStates, [&]() {
+        CLLMQUtils::IterateNodesRandom(vecNodeStates, [&]() {
             return uniqueSignHashes.size() < maxUniqueSessions;
-        }, [&](NodeId nodeId, CSigSharesNodeState& ns) {
-            if (ns.pendingIncomingSigShares.Empty()) {
+        }, [&](NodeId nodeId, std::shared_ptr<CSigSharesNodeState>& ns) {
+            LOCK_NODE(*ns);
+            if (ns->pendingIncomingSigShares.Empty()) {
                 return false;
             }
-            auto& sigShare = *ns.pendingIncomingSigShares.GetFirst();
-            LOCK(cs);
-            bool alreadyHave = this->sigShares.Has(sigShare.GetKey());
+            auto& sigShare = *ns->pendingIncomingSigShares.GetFirst();
+            bool alreadyHave;
+            {
+                auto& shard = GetShard(sigShare.GetSignHash());
+                LOCK_SHARD(shard);
+                alreadyHave = shard.sigShares.Has(sigShare.GetKey());
+            }
             if (!alreadyHave) {
                 uniqueSignHashes.emplace(nodeId, sigShare.GetSignHash());
                 retSigShares[nodeId].emplace_back(sigShare);
             }
-            ns.pendingIncomingSigShares.Erase(sigShare.GetKey());
-            return !ns.pendingIncomingSigShares.Empty();
+            ns->pendingIncomingSigShares.Erase(sigShare.GetKey());
+            return !ns->pendingIncomingSigShares.Empty();
         }, rnd);
 
         if (retSigShares.empty()) {
@@ -687,6 +716,8 @@ bool CSigSharesManager::ProcessPendingSigShares()
     batchVerifier.Verify();
     verifyTimer.stop();
 
+    verifyStats.Add(batchVerifier, verifyCount);
+
     LogPrint(BCLog::LLMQ_SIGS, "CSigSharesManager::%s -- verified sig shares. count=%d, pt=%d, vt=%d, nodes=%d\n", __func__, verifyCount, prepareTimer.count(), verifyTimer.count(), sigSharesByNodes.size());
 
     for (auto& p : sigSharesByNodes) {
@@ -742,36 +773,36 @@ void CSigSharesManager::ProcessSigShare(const CSigShare& sigShare, const CQuorum
     }
 
     {
-        LOCK(cs);
+        auto& shard = GetShard(sigShare.GetSignHash());
+        LOCK_SHARD(shard);
 
-        if (!sigShares.Add(sigShare.GetKey(), sigShare)) {
+        if (!shard.sigShares.Add(sigShare.GetKey(), sigShare)) {
             return;
         }
         if (!CLLMQUtils::IsAllMembersConnectedEnabled(llmqType)) {
-            sigSharesQueuedToAnnounce.Add(sigShare.GetKey(), true);
+            shard.sigSharesQueuedToAnnounce.Add(sigShare.GetKey(), true);
         }
 
         // Update the time we've seen the last sigShare
-        timeSeenForSessions[sigShare.GetSignHash()] = GetAdjustedTime();
-
-        if (!quorumNodes.empty()) {
-            // don't announce and wait for other nodes to request this share and directly send it to them
-            // there is no way the other nodes know about this share as this is the one created on this node
-            for (auto otherNodeId : quorumNodes) {
-                auto& nodeState = nodeStates[otherNodeId];
-                auto& session = nodeState.GetOrCreateSessionFromShare(sigShare);
-                session.quorum = quorum;
-                session.requested.Set(sigShare.quorumMember, true);
-                session.knows.Set(sigShare.quorumMember, true);
-            }
-        }
+        shard.timeSeenForSessions[sigShare.GetSignHash()] = GetAdjustedTime();
 
-        size_t sigShareCount = sigShares.CountForSignHash(sigShare.GetSignHash());
+        size_t sigShareCount = shard.sigShares.CountForSignHash(sigShare.GetSignHash());
         if (sigShareCount >= (size_t)quorum->params.threshold) {
             canTryRecovery = true;
         }
     }
 
+    // don't announce and wait for other nodes to request this share and directly send it to them
+    // there is no way the other nodes know about this share as this is the one created on this node
+    for (auto otherNodeId : quorumNodes) {
+        auto nodeState = GetOrCreateNodeState(otherNodeId);
+        LOCK_NODE(*nodeState);
+        auto& session = nodeState->GetOrCreateSessionFromShare(sigShare);
+        session.quorum = quorum;
+        session.requested.Set(sigShare.quorumMember, true);
+        session.knows.Set(sigShare.quorumMember, true);
+    }
+
     if (canTryRecovery) {
         TryRecoverSig(quorum, sigShare.id, sigShare.msgHash);
     }
@@ -786,10 +817,11 @@ void CSigSharesManager::TryRecoverSig(const CQuorumCPtr& quorum, const uint256&
     std::vector<CBLSSignature> sigSharesForRecovery;
     std::vector<CBLSId> idsForRecovery;
     {
-        LOCK(cs);
-
         auto signHash = CLLMQUtils::BuildSignHash(quorum->params.type, quorum->qc->quorumHash, id, msgHash);
-        auto sigShares = this->sigShares.GetAllForSignHash(signHash);
+        auto& shard = GetShard(signHash);
+        LOCK_SHARD(shard);
+
+        auto sigShares = shard.sigShares.GetAllForSignHash(signHash);
         if (!sigShares) {
             return;
         }
@@ -862,26 +894,19 @@ CDeterministicMNCPtr CSigSharesManager::SelectMemberForRecovery(const CQuorumCPt
 
 void CSigSharesManager::CollectSigSharesToRequest(std::unordered_map<NodeId, std::unordered_map<uint256, CSigSharesInv, StaticSaltedHasher>>& sigSharesToRequest)
 {
-    AssertLockHeld(cs);
-
     int64_t now = GetAdjustedTime();
     const size_t maxRequestsForNode = 32;
 
     // avoid requesting from same nodes all the time
-    std::vector<NodeId> shuffledNodeIds;
-    shuffledNodeIds.reserve(nodeStates.size());
-    for (auto& p : nodeStates) {
-        if (p.second.sessions.empty()) {
-            continue;
-        }
-        shuffledNodeIds.emplace_back(p.first);
-    }
-    Shuffle(shuffledNodeIds.begin(), shuffledNodeIds.end(), rnd);
+    auto vecNodeStates = GetNodeStates();
+    Shuffle(vecNodeStates.begin(), vecNodeStates.end(), rnd);
 
-    for (auto& nodeId : shuffledNodeIds) {
-        auto& nodeState = nodeStates[nodeId];
+    for (auto& p : vecNodeStates) {
+        auto nodeId = p.first;
+        auto& nodeState = *p.second;
+        LOCK_NODE(nodeState);
 
-        if (nodeState.banned) {
+        if (nodeState.banned || nodeState.sessions.empty()) {
             continue;
         }
 
@@ -909,12 +934,15 @@ void CSigSharesManager::CollectSigSharesToRequest(std::unordered_map<NodeId, std
                 continue;
             }
 
+            auto& shard = GetShard(signHash);
+            LOCK_SHARD(shard);
+
             for (size_t i = 0; i < session.announced.inv.size(); i++) {
                 if (!session.announced.inv[i]) {
                     continue;
                 }
                 auto k = std::make_pair(signHash, (uint16_t) i);
-                if (sigShares.Has(k)) {
+                if (shard.sigShares.Has(k)) {
                     // we already have it
                     session.announced.inv[i] = false;
                     continue;
@@ -923,7 +951,7 @@ void CSigSharesManager::CollectSigSharesToRequest(std::unordered_map<NodeId, std
                     // too many pending requests for this node
                     break;
                 }
-                auto p = sigSharesRequested.Get(k);
+                auto p = shard.sigSharesRequested.Get(k);
                 if (p) {
                     if (now - p->second >= SIG_SHARE_REQUEST_TIMEOUT && nodeId != p->first) {
                         // other node timed out, re-request from this node
@@ -939,7 +967,7 @@ void CSigSharesManager::CollectSigSharesToRequest(std::unordered_map<NodeId, std
                 nodeState.requestedSigShares.Add(k, now);
 
                 // don't request it from other nodes until a timeout happens
-                auto& r = sigSharesRequested.GetOrAdd(k);
+                auto& r = shard.sigSharesRequested.GetOrAdd(k);
                 r.first = nodeId;
                 r.second = now;
 
@@ -962,11 +990,10 @@ void CSigSharesManager::CollectSigSharesToRequest(std::unordered_map<NodeId, std
 
 void CSigSharesManager::CollectSigSharesToSend(std::unordered_map<NodeId, std::unordered_map<uint256, CBatchedSigShares, StaticSaltedHasher>>& sigSharesToSend)
 {
-    AssertLockHeld(cs);
-
-    for (auto& p : nodeStates) {
+    for (auto& p : GetNodeStates()) {
         auto nodeId = p.first;
-        auto& nodeState = p.second;
+        auto& nodeState = *p.second;
+        LOCK_NODE(nodeState);
 
         if (nodeState.banned) {
             continue;
@@ -988,21 +1015,26 @@ void CSigSharesManager::CollectSigSharesToSend(std::unordered_map<NodeId, std::u
 
             CBatchedSigShares batchedSigShares;
 
-            for (size_t i = 0; i < session.requested.inv.size(); i++) {
-                if (!session.requested.inv[i]) {
-                    continue;
-                }
-                session.requested.inv[i] = false;
+            {
+                auto& shard = GetShard(signHash);
+                LOCK_SHARD(shard);
 
-                auto k = std::make_pair(signHash, (uint16_t)i);
-                const CSigShare* sigShare = sigShares.Get(k);
-                if (!sigShare) {
-                    // he requested something we don'have
+                for (size_t i = 0; i < session.requested.inv.size(); i++) {
+                    if (!session.requested.inv[i]) {
+                        continue;
+                    }
                     session.requested.inv[i] = false;
-                    continue;
-                }
 
-                batchedSigShares.sigShares.emplace_back((uint16_t)i, sigShare->sigShare);
+                    auto k = std::make_pair(signHash, (uint16_t)i);
+                    const CSigShare* sigShare = shard.sigShares.Get(k);
+                    if (!sigShare) {
+                        // he requested something we don'have
+                        session.requested.inv[i] = false;
+                        continue;
+                    }
+
+                    batchedSigShares.sigShares.emplace_back((uint16_t)i, sigShare->sigShare);
+                }
             }
 
             if (!batchedSigShares.sigShares.empty()) {
@@ -1018,56 +1050,67 @@ void CSigSharesManager::CollectSigSharesToSend(std::unordered_map<NodeId, std::u
 
 void CSigSharesManager::CollectSigSharesToSendConcentrated(std::unordered_map<NodeId, std::vector<CSigShare>>& sigSharesToSend, const std::unordered_map<uint256, NodeId, StaticSaltedHasher> &proTxToNode)
 {
-    AssertLockHeld(cs);
     auto curTime = GetTime<std::chrono::milliseconds>().count();
 
-    for (auto& p : signedSessions) {
-        if (!CLLMQUtils::IsAllMembersConnectedEnabled(p.second.quorum->params.type)) {
-            continue;
-        }
+    for (auto& shard : shards) {
+        LOCK_SHARD(shard);
+        for (auto& p : shard.signedSessions) {
+            if (!CLLMQUtils::IsAllMembersConnectedEnabled(p.second.quorum->params.type)) {
+                continue;
+            }
 
-        if (p.second.attempt > p.second.quorum->params.recoveryMembers) {
-            continue;
-        }
+            if (p.second.attempt > p.second.quorum->params.recoveryMembers) {
+                continue;
+            }
 
-        if (curTime >= p.second.nextAttemptTime) {
-            int64_t waitTime = exp2(p.second.attempt) * EXP_SEND_FOR_RECOVERY_TIMEOUT;
-            waitTime = std::min(MAX_SEND_FOR_RECOVERY_TIMEOUT, waitTime);
-            p.second.nextAttemptTime = curTime + waitTime;
-            auto dmn = SelectMemberForRecovery(p.second.quorum, p.second.sigShare.id, p.second.attempt);
-            p.second.attempt++;
+            if (curTime >= p.second.nextAttemptTime) {
+                int64_t waitTime = exp2(p.second.attempt) * EXP_SEND_FOR_RECOVERY_TIMEOUT;
+                waitTime = std::min(MAX_SEND_FOR_RECOVERY_TIMEOUT, waitTime);
+                p.second.nextAttemptTime = curTime + waitTime;
+                auto dmn = SelectMemberForRecovery(p.second.quorum, p.second.sigShare.id, p.second.attempt);
+                p.second.attempt++;
 
-            LogPrint(BCLog::LLMQ_SIGS, "CSigSharesManager::%s -- signHash=%s, sending to %s, attempt=%d\n", __func__,
-                     p.second.sigShare.GetSignHash().ToString(), dmn->proTxHash.ToString(), p.second.attempt);
+                LogPrint(BCLog::LLMQ_SIGS, "CSigSharesManager::%s -- signHash=%s, sending to %s, attempt=%d\n", __func__,
+                         p.second.sigShare.GetSignHash().ToString(), dmn->proTxHash.ToString(), p.second.attempt);
 
-            auto it = proTxToNode.find(dmn->proTxHash);
-            if (it == proTxToNode.end()) {
-                continue;
-            }
+                auto it = proTxToNode.find(dmn->proTxHash);
+                if (it == proTxToNode.end()) {
+                    continue;
+                }
 
-            auto& m = sigSharesToSend[it->second];
-            m.emplace_back(p.second.sigShare);
+                auto& m = sigSharesToSend[it->second];
+                m.emplace_back(p.second.sigShare);
+            }
         }
     }
 }
 
 void CSigSharesManager::CollectSigSharesToAnnounce(std::unordered_map<NodeId, std::unordered_map<uint256, CSigSharesInv, StaticSaltedHasher>>& sigSharesToAnnounce)
 {
-    AssertLockHeld(cs);
+    // take the queued shares out of the shards first, node states must not be locked while a shard is locked
+    std::vector<CSigShare> vecSigShares;
+    for (auto& shard : shards) {
+        LOCK_SHARD(shard);
+        shard.sigSharesQueuedToAnnounce.ForEach([&](const SigShareKey& sigShareKey, bool) {
+            AssertLockHeld(shard.cs);
+            const CSigShare* sigShare = shard.sigShares.Get(sigShareKey);
+            if (sigShare) {
+                vecSigShares.emplace_back(*sigShare);
+            }
+        });
+
+        // don't announce these anymore
+        shard.sigSharesQueuedToAnnounce.Clear();
+    }
 
     std::unordered_map<std::pair<uint8_t, uint256>, std::unordered_set<NodeId>, StaticSaltedHasher> quorumNodesMap;
 
-    sigSharesQueuedToAnnounce.ForEach([&](const SigShareKey& sigShareKey, bool) {
-        auto& signHash = sigShareKey.first;
-        auto quorumMember = sigShareKey.second;
-        LOCK(cs);
-        const CSigShare* sigShare = sigShares.Get(sigShareKey);
-        if (!sigShare) {
-            return;
-        }
+    for (const auto& sigShare : vecSigShares) {
+        auto& signHash = sigShare.GetSignHash();
+        auto quorumMember = sigShare.quorumMember;
 
         // announce to the nodes which we know through the intra-quorum-communication system
-        auto quorumKey = std::make_pair(sigShare->llmqType, sigShare->quorumHash);
+        auto quorumKey = std::make_pair(sigShare.llmqType, sigShare.quorumHash);
         auto it = quorumNodesMap.find(quorumKey);
         if (it == quorumNodesMap.end()) {
             std::set<NodeId> nodeIds;
@@ -1078,13 +1121,14 @@ void CSigSharesManager::CollectSigSharesToAnnounce(std::unordered_map<NodeId, st
         auto& quorumNodes = it->second;
 
         for (auto& nodeId : quorumNodes) {
-            auto& nodeState = nodeStates[nodeId];
+            auto nodeState = GetOrCreateNodeState(nodeId);
+            LOCK_NODE(*nodeState);
 
-            if (nodeState.banned) {
+            if (nodeState->banned) {
                 continue;
             }
 
-            auto& session = nodeState.GetOrCreateSessionFromShare(*sigShare);
+            auto& session = nodeState->GetOrCreateSessionFromShare(sigShare);
 
             if (session.knows.inv[quorumMember]) {
                 // he already knows that one
@@ -1093,16 +1137,13 @@ void CSigSharesManager::CollectSigSharesToAnnounce(std::unordered_map<NodeId, st
 
             auto& inv = sigSharesToAnnounce[nodeId][signHash];
             if (inv.inv.empty()) {
-                const auto& params = Params().GetConsensus().llmqs.at(sigShare->llmqType);
+                const auto& params = Params().GetConsensus().llmqs.at(sigShare.llmqType);
                 inv.Init((size_t)params.size);
             }
             inv.inv[quorumMember] = true;
             session.knows.inv[quorumMember] = true;
         }
-    });
-
-    // don't announce these anymore
-    sigSharesQueuedToAnnounce.Clear();
+    }
 }
 
 bool CSigSharesManager::SendMessages()
@@ -1113,12 +1154,15 @@ bool CSigSharesManager::SendMessages()
     std::unordered_map<NodeId, std::unordered_map<uint256, CSigSharesInv, StaticSaltedHasher>> sigSharesToAnnounce;
     std::unordered_map<NodeId, std::vector<CSigSesAnn>> sigSessionAnnouncements;
 
-    auto addSigSesAnnIfNeeded = [&](NodeId nodeId, const uint256& signHash) EXCLUSIVE_LOCKS_REQUIRED(cs){
-        auto& nodeState = nodeStates[nodeId];
-        auto session = nodeState.GetSessionBySignHash(signHash);
+    auto addSigSesAnnIfNeeded = [&](NodeId nodeId, const uint256& signHash) {
+        // only the worker thread removes node states and sessions, so they still exist
+        auto nodeState = GetNodeState(nodeId);
+        assert(nodeState);
+        LOCK_NODE(*nodeState);
+        auto session = nodeState->GetSessionBySignHash(signHash);
         assert(session);
         if (session->sendSessionId == (uint32_t)-1) {
-            session->sendSessionId = nodeState.nextSendSessionId++;
+            session->sendSessionId = nodeState->nextSendSessionId++;
 
             CSigSesAnn sigSesAnn;
             sigSesAnn.sessionId = session->sendSessionId;
@@ -1143,7 +1187,6 @@ bool CSigSharesManager::SendMessages()
         proTxToNode.try_emplace(pnode->verifiedProRegTxHash, pnode->GetId());
     }
     {
-        LOCK(cs);
         CollectSigSharesToRequest(sigSharesToRequest);
         CollectSigSharesToSend(sigShareBatchesToSend);
         CollectSigSharesToAnnounce(sigSharesToAnnounce);
@@ -1281,10 +1324,62 @@ bool CSigSharesManager::SendMessages()
     return didSend;
 }
 
+std::shared_ptr<CSigSharesNodeState> CSigSharesManager::GetNodeState(NodeId nodeId)
+{
+    LOCK_NODE_STATES();
+    auto it = nodeStates.find(nodeId);
+    if (it == nodeStates.end()) {
+        return nullptr;
+    }
+    return it->second;
+}
+
+std::shared_ptr<CSigSharesNodeState> CSigSharesManager::GetOrCreateNodeState(NodeId nodeId)
+{
+    LOCK_NODE_STATES();
+    auto& nodeState = nodeStates[nodeId];
+    if (!nodeState) {
+        nodeState = std::make_shared<CSigSharesNodeState>();
+    }
+    return nodeState;
+}
+
+std::vector<std::pair<NodeId, std::shared_ptr<CSigSharesNodeState>>> CSigSharesManager::GetNodeStates()
+{
+    LOCK_NODE_STATES();
+    return {nodeStates.begin(), nodeStates.end()};
+}
+
+void CSigSharesManager::RemoveNodeState(NodeId nodeId)
+{
+    std::shared_ptr<CSigSharesNodeState> nodeState;
+    {
+        LOCK_NODE_STATES();
+        auto it = nodeStates.find(nodeId);
+        if (it == nodeStates.end()) {
+            return;
+        }
+        nodeState = std::move(it->second);
+        nodeStates.erase(it);
+    }
+
+    // remove global requested state to force a re-request from another node
+    LOCK_NODE(*nodeState);
+    nodeState->requestedSigShares.ForEach([&](const SigShareKey& k, int64_t) {
+        auto& shard = GetShard(k.first);
+        LOCK_SHARD(shard);
+        shard.sigSharesRequested.Erase(k);
+    });
+}
+
 bool CSigSharesManager::GetSessionInfoByRecvId(NodeId nodeId, uint32_t sessionId, CSigSharesNodeState::SessionInfo& retInfo)
 {
-    LOCK(cs);
-    return nodeStates[nodeId].GetSessionInfoByRecvId(sessionId, retInfo);
+    auto nodeState = GetNodeState(nodeId);
+    if (!nodeState) {
+        return false;
+    }
+    LOCK_NODE(*nodeState);
+    return nodeState->GetSessionInfoByRecvId(sessionId, retInfo);
 }
 
 CSigShare CSigSharesManager::RebuildSigShare(const CSigSharesNodeState::SessionInfo& session, const CBatchedSigShares& batchedSigShares, size_t idx)
@@ -1315,9 +1410,9 @@ void CSigSharesManager::Cleanup()
     // quorumHash -> quorumPtr (as GetQuorum() requires cs_main, leading to deadlocks with cs held)
     std::unordered_map<std::pair<uint8_t, uint256>, CQuorumCPtr, StaticSaltedHasher> quorums;
 
-    {
-        LOCK(cs);
-        sigShares.ForEach([&](const SigShareKey& k, const CSigShare& sigShare) {
+    for (auto& shard : shards) {
+        LOCK_SHARD(shard);
+        shard.sigShares.ForEach([&](const SigShareKey& k, const CSigShare& sigShare) {
             quorums.try_emplace(std::make_pair(sigShare.llmqType, sigShare.quorumHash), nullptr);
         });
     }
@@ -1332,52 +1427,36 @@ void CSigSharesManager::Cleanup()
         }
     }
 
-    {
-        // Now delete sessions which are for inactive quorums
-        LOCK(cs);
-        std::unordered_set<uint256, StaticSaltedHasher> inactiveQuorumSessions;
-        sigShares.ForEach([&](const SigShareKey& k, const CSigShare& sigShare) {
-            if (!quorums.count(std::make_pair(sigShare.llmqType, sigShare.quorumHash))) {
-                inactiveQuorumSessions.emplace(sigShare.GetSignHash());
-            }
-        });
-        for (auto& signHash : inactiveQuorumSessions) {
-            RemoveSigSharesForSession(signHash);
-        }
-    }
+    // Sessions are removed after the shard is unlocked, as this also locks the node states
+    std::unordered_set<uint256, StaticSaltedHasher> sessionsToRemove;
 
-    {
-        LOCK(cs);
+    for (auto& shard : shards) {
+        LOCK_SHARD(shard);
 
-        // Remove sessions which were successfully recovered
-        std::unordered_set<uint256, StaticSaltedHasher> doneSessions;
-        sigShares.ForEach([&](const SigShareKey& k, const CSigShare& sigShare) {
-            if (doneSessions.count(sigShare.GetSignHash())) {
+        // Delete sessions which are for inactive quorums and sessions which were successfully recovered
+        shard.sigShares.ForEach([&](const SigShareKey& k, const CSigShare& sigShare) {
+            if (sessionsToRemove.count(sigShare.GetSignHash())) {
                 return;
             }
-            if (quorumSigningManager->HasRecoveredSigForSession(sigShare.GetSignHash())) {
-                doneSessions.emplace(sigShare.GetSignHash());
+            if (!quorums.count(std::make_pair(sigShare.llmqType, sigShare.quorumHash)) ||
+                quorumSigningManager->HasRecoveredSigForSession(sigShare.GetSignHash())) {
+                sessionsToRemove.emplace(sigShare.GetSignHash());
             }
         });
-        for (auto& signHash : doneSessions) {
-            RemoveSigSharesForSession(signHash);
-        }
 
         // Remove sessions which timed out
-        std::unordered_set<uint256, StaticSaltedHasher> timeoutSessions;
-        for (auto& p : timeSeenForSessions) {
+        for (auto& p : shard.timeSeenForSessions) {
             auto& signHash = p.first;
             int64_t lastSeenTime = p.second;
 
-            if (now - lastSeenTime >= SESSION_NEW_SHARES_TIMEOUT) {
-                timeoutSessions.emplace(signHash);
+            if (now - lastSeenTime < SESSION_NEW_SHARES_TIMEOUT || sessionsToRemove.count(signHash)) {
+                continue;
             }
-        }
-        for (auto& signHash : timeoutSessions) {
-            size_t count = sigShares.CountForSignHash(signHash);
+
+            size_t count = shard.sigShares.CountForSignHash(signHash);
 
             if (count > 0) {
-                auto m = sigShares.GetAllForSignHash(signHash);
+                auto m = shard.sigShares.GetAllForSignHash(signHash);
                 assert(m);
 
                 auto& oneSigShare = m->begin()->second;
@@ -1402,69 +1481,59 @@ void CSigSharesManager::Cleanup()
                 LogPrint(BCLog::LLMQ_SIGS, "CSigSharesManager::%s -- signing session timed out. signHash=%s, sigShareCount=%d\n", __func__,
                           signHash.ToString(), count);
             }
-            RemoveSigSharesForSession(signHash);
+            sessionsToRemove.emplace(signHash);
         }
     }
 
+    for (auto& signHash : sessionsToRemove) {
+        RemoveSigSharesForSession(signHash);
+    }
+
     // Find node states for peers that disappeared from CConnman
     std::unordered_set<NodeId> nodeStatesToDelete;
-    {
-        LOCK(cs);
-        for (const auto& p : nodeStates) {
-            nodeStatesToDelete.emplace(p.first);
-        }
+    for (const auto& p : GetNodeStates()) {
+        nodeStatesToDelete.emplace(p.first);
     }
     connman.ForEachNode([&](CNode* pnode) {
         nodeStatesToDelete.erase(pnode->GetId());
     });
 
     // Now delete these node states
-    LOCK(cs);
     for (const auto& nodeId : nodeStatesToDelete) {
-        auto it = nodeStates.find(nodeId);
-        if (it == nodeStates.end()) {
-            continue;
-        }
-        // remove global requested state to force a re-request from another node
-        it->second.requestedSigShares.ForEach([&](const SigShareKey& k, bool) {
-            LOCK(cs);
-            sigSharesRequested.Erase(k);
-        });
-        nodeStates.erase(nodeId);
+        RemoveNodeState(nodeId);
     }
 
+    LogPrint(BCLog::LLMQ_SIGS, "CSigSharesManager::%s -- lock contention: nodes=%d/%d, sessions=%d/%d\n", __func__,
+             nodeLockStats.nContended.load(), nodeLockStats.nLocks.load(), shardLockStats.nContended.load(), shardLockStats.nLocks.load());
+
     lastCleanupTime = GetAdjustedTime();
 }
 
 void CSigSharesManager::RemoveSigSharesForSession(const uint256& signHash)
 {
-    for (auto& p : nodeStates) {
-        auto& ns = p.second;
+    for (auto& p : GetNodeStates()) {
+        auto& ns = *p.second;
+        LOCK_NODE(ns);
         ns.RemoveSession(signHash);
     }
 
-    sigSharesRequested.EraseAllForSignHash(signHash);
-    sigSharesQueuedToAnnounce.EraseAllForSignHash(signHash);
-    sigShares.EraseAllForSignHash(signHash);
-    signedSessions.erase(signHash);
-    timeSeenForSessions.erase(signHash);
+    auto& shard = GetShard(signHash);
+    LOCK_SHARD(shard);
+    shard.sigSharesRequested.EraseAllForSignHash(signHash);
+    shard.sigSharesQueuedToAnnounce.EraseAllForSignHash(signHash);
+    shard.sigShares.EraseAllForSignHash(signHash);
+    shard.signedSessions.erase(signHash);
+    shard.timeSeenForSessions.erase(signHash);
 }
 
 void CSigSharesManager::RemoveBannedNodeStates()
 {
     // Called regularly to cleanup local node states for banned nodes
 
-    LOCK(cs);
-    for (auto it = nodeStates.begin(); it != nodeStates.end();) {
-        if (IsBanned(it->first, banman)) {
+    for (const auto& p : GetNodeStates()) {
+        if (IsBanned(p.first, banman)) {
             // re-request sigshares from other nodes
-            it->second.requestedSigShares.ForEach([&](const SigShareKey& k, int64_t) {
-                LOCK(cs);
-                sigSharesRequested.Erase(k);
-            });
-            it = nodeStates.erase(it);
-        } else {
-            ++it;
+            RemoveNodeState(p.first);
         }
     }
 }
@@ -1477,21 +1546,21 @@ void CSigSharesManager::BanNode(NodeId nodeId)
 
     peerman.Misbehaving(nodeId, 100, "banning node from sigshares manager");
 
-    LOCK(cs);
-    auto it = nodeStates.find(nodeId);
-    if (it == nodeStates.end()) {
+    auto nodeState = GetNodeState(nodeId);
+    if (!nodeState) {
         return;
     }
-    auto& nodeState = it->second;
+    LOCK_NODE(*nodeState);
 
     // Whatever we requested from him, let's request it from someone else now
-    nodeState.requestedSigShares.ForEach([&](const SigShareKey& k, int64_t) {
-        LOCK(cs);
-        sigSharesRequested.Erase(k);
+    nodeState->requestedSigShares.ForEach([&](const SigShareKey& k, int64_t) {
+        auto& shard = GetShard(k.first);
+        LOCK_SHARD(shard);
+        shard.sigSharesRequested.Erase(k);
     });
-    nodeState.requestedSigShares.Clear();
+    nodeState->requestedSigShares.Clear();
 
-    nodeState.banned = true;
+    nodeState->banned = true;
 }
 
 void CSigSharesManager::WorkThreadMain()
@@ -1530,7 +1599,7 @@ void CSigSharesManager::WorkThreadMain()
 
 void CSigSharesManager::AsyncSign(const CQuorumCPtr& quorum, const uint256& id, const uint256& msgHash)
 {
-    LOCK(cs);
+    LOCK(cs_pendingSigns);
     pendingSigns.emplace_back(quorum, id, msgHash);
 }
 
@@ -1538,7 +1607,7 @@ void CSigSharesManager::SignPendingSigShares()
 {
     std::vector<std::tuple<const CQuorumCPtr, uint256, uint256>> v;
     {
-        LOCK(cs);
+        LOCK(cs_pendingSigns);
         v = std::move(pendingSigns);
     }
 
@@ -1551,8 +1620,9 @@ void CSigSharesManager::SignPendingSigShares()
             ProcessSigShare(sigShare, pQuorum);
 
             if (CLLMQUtils::IsAllMembersConnectedEnabled(pQuorum->params.type)) {
-                LOCK(cs);
-                auto& session = signedSessions[sigShare.GetSignHash()];
+                auto& shard = GetShard(sigShare.GetSignHash());
+                LOCK_SHARD(shard);
+                auto& session = shard.signedSessions[sigShare.GetSignHash()];
                 session.sigShare = sigShare;
                 session.quorum = pQuorum;
                 session.nextAttemptTime = 0;
@@ -1612,17 +1682,21 @@ void CSigSharesManager::ForceReAnnouncement(const CQuorumCPtr& quorum, uint8_t l
         return;
     }
 
-    LOCK(cs);
     auto signHash = CLLMQUtils::BuildSignHash(llmqType, quorum->qc->quorumHash, id, msgHash);
-    auto sigs = sigShares.GetAllForSignHash(signHash);
-    if (sigs) {
-        for (auto& p : *sigs) {
-            // re-announce every sigshare to every node
-            sigSharesQueuedToAnnounce.Add(std::make_pair(signHash, p.first), true);
+    {
+        auto& shard = GetShard(signHash);
+        LOCK_SHARD(shard);
+        auto sigs = shard.sigShares.GetAllForSignHash(signHash);
+        if (sigs) {
+            for (auto& p : *sigs) {
+                // re-announce every sigshare to every node
+                shard.sigSharesQueuedToAnnounce.Add(std::make_pair(signHash, p.first), true);
+            }
         }
     }
-    for (auto& p : nodeStates) {
-        CSigSharesNodeState& nodeState = p.second;
+    for (auto& p : GetNodeStates()) {
+        CSigSharesNodeState& nodeState = *p.second;
+        LOCK_NODE(nodeState);
         auto session = nodeState.GetSessionBySignHash(signHash);
         if (!session) {
             continue;
@@ -1636,7 +1710,6 @@ void CSigSharesManager::ForceReAnnouncement(const CQuorumCPtr& quorum, uint8_t l
 
 void CSigSharesManager::HandleNewRecoveredSig(const llmq::CRecoveredSig& recoveredSig)
 {
-    LOCK(cs);
     RemoveSigSharesForSession(CLLMQUtils::BuildSignHash(recoveredSig));
 }
 
@@ -6,6 +6,7 @@
 #define SYSCOIN_LLMQ_QUORUMS_SIGNING_SHARES_H
 
 #include <chainparams.h>
+#include <llmq/quorums_signing.h>
 #include <net.h>
 #include <random.h>
 #include <saltedhasher.h>
@@ -13,6 +14,9 @@
 #include <sync.h>
 #include <uint256.h>
 
+#include <array>
+#include <atomic>
+#include <optional>
 #include <thread>
 #include <unordered_map>
 #include <threadsafety.h>
@@ -22,6 +26,8 @@ class CScheduler;
 class CConnman;
 class BanMan;
 class PeerMan;
+class CDeterministicMN;
+typedef std::shared_ptr<const CDeterministicMN> CDeterministicMNCPtr;
 namespace llmq
 {
 // <signHash, quorumMember>
@@ -277,6 +283,9 @@ public:
 class CSigSharesNodeState
 {
 public:
+    // guards the state of the node. Taken before the lock of a CSigSharesShard
+    mutable RecursiveMutex cs;
+
     // Used to avoid holding locks too long
     struct SessionInfo
     {
@@ -335,6 +344,62 @@ public:
     int attempt{0};
 };
 
+/**
+ * The state of signing sessions which is not specific to a node. It is sharded by signHash, so that the network thread,
+ * the worker thread and the signing callers only contend with each other when they handle sessions of the same shard.
+ */
+class CSigSharesShard
+{
+public:
+    // taken after the lock of a CSigSharesNodeState. The locks of two shards are never held at once
+    mutable RecursiveMutex cs;
+
+    SigShareMap<CSigShare> sigShares GUARDED_BY(cs);
+    std::unordered_map<uint256, CSignedSession, StaticSaltedHasher> signedSessions GUARDED_BY(cs);
+
+    // stores time of last receivedSigShare. Used to detect timeouts
+    std::unordered_map<uint256, int64_t, StaticSaltedHasher> timeSeenForSessions GUARDED_BY(cs);
+
+    SigShareMap<std::pair<NodeId, int64_t>> sigSharesRequested GUARDED_BY(cs);
+    SigShareMap<bool> sigSharesQueuedToAnnounce GUARDED_BY(cs);
+};
+
+/**
+ * Counts how often the locks of CSigSharesManager were held by another thread when they were taken.
+ * The numbers are an estimate: a lock is counted as contended when a non-blocking attempt to take it
+ * fails, it might be released again before the blocking attempt that follows.
+ */
+class CSigSharesLockStats
+{
+public:
+    std::atomic<uint64_t> nLocks{0};
+    std::atomic<uint64_t> nContended{0};
+
+    UniValue ToJson() const;
+};
+
+/** Takes a lock and counts it in a CSigSharesLockStats, the lock is only tried once before blocking */
+template<typename MutexType>
+class SCOPED_LOCKABLE CSigSharesCountedLock
+{
+private:
+    std::optional<UniqueLock<MutexType>> lock;
+
+public:
+    CSigSharesCountedLock(MutexType& mutex, CSigSharesLockStats& stats, const char* pszName, const char* pszFile, int nLine) EXCLUSIVE_LOCK_FUNCTION(mutex)
+    {
+        stats.nLocks++;
+        lock.emplace(mutex, pszName, pszFile, nLine, true);
+        if (!*lock) {
+            stats.nContended++;
+            lock.reset();
+            lock.emplace(mutex, pszName, pszFile, nLine);
+        }
+    }
+
+    ~CSigSharesCountedLock() UNLOCK_FUNCTION() {}
+};
+
 class CSigSharesManager : public CRecoveredSigsListener
 {
     static const int64_t SESSION_NEW_SHARES_TIMEOUT = 120;
@@ -351,28 +416,31 @@ class CSigSharesManager : public CRecoveredSigsListener
     const int64_t MAX_SEND_FOR_RECOVERY_TIMEOUT = 10000;
     const size_t MAX_MSGS_SIG_SHARES = 32;
 
+public:
+    static const size_t SHARD_COUNT = 16;
+
 private:
+    // guards the map of node states only, the node states have their own lock
     mutable RecursiveMutex cs;
 
     std::thread workThread;
     CThreadInterrupt workInterrupt;
 
-    SigShareMap<CSigShare> sigShares GUARDED_BY(cs);
-    std::unordered_map<uint256, CSignedSession, StaticSaltedHasher> signedSessions GUARDED_BY(cs);
-
-    // stores time of last receivedSigShare. Used to detect timeouts
-    std::unordered_map<uint256, int64_t, StaticSaltedHasher> timeSeenForSessions GUARDED_BY(cs);
+    std::unordered_map<NodeId, std::shared_ptr<CSigSharesNodeState>> nodeStates GUARDED_BY(cs);
+    std::array<CSigSharesShard, SHARD_COUNT> shards;
 
-    std::unordered_map<NodeId, CSigSharesNodeState> nodeStates GUARDED_BY(cs);
-    SigShareMap<std::pair<NodeId, int64_t>> sigSharesRequested GUARDED_BY(cs);
-    SigShareMap<bool> sigSharesQueuedToAnnounce GUARDED_BY(cs);
+    RecursiveMutex cs_pendingSigns;
+    std::vector<std::tuple<const CQuorumCPtr, uint256, uint256>> pendingSigns GUARDED_BY(cs_pendingSigns);
 
-    std::vector<std::tuple<const CQuorumCPtr, uint256, uint256>> pendingSigns GUARDED_BY(cs);
+    // only used by the worker thread
+    FastRandomContext rnd;
 
-    FastRandomContext rnd GUARDED_BY(cs);
+    CSigSharesLockStats nodeLockStats;
+    CSigSharesLockStats shardLockStats;
 
     int64_t lastCleanupTime{0};
     std::atomic<uint32_t> recoveredSigsCounter{0};
+    CSigBatchVerifyStats verifyStats;
     CConnman& connman;
     BanMan& banman;
     PeerManager& peerman;
@@ -397,6 +465,10 @@ public:
 
     static CDeterministicMNCPtr SelectMemberForRecovery(const CQuorumCPtr& quorum, const uint256& id, int attempt);
 
+    const CSigBatchVerifyStats& GetVerifyStats() const { return verifyStats; }
+    const CSigSharesLockStats& GetNodeLockStats() const { return nodeLockStats; }
+    const CSigSharesLockStats& GetShardLockStats() const { return shardLockStats; }
+
 private:
     // all of these return false when the currently processed message should be aborted (as each message actually contains multiple messages)
     bool ProcessMessageSigSesAnn(CNode* pfrom, const CSigSesAnn& ann);
@@ -420,20 +492,26 @@ private:
     void TryRecoverSig(const CQuorumCPtr& quorum, const uint256& id, const uint256& msgHash);
 
 private:
+    CSigSharesShard& GetShard(const uint256& signHash) { return shards[signHash.GetUint64(0) % SHARD_COUNT]; }
+    std::shared_ptr<CSigSharesNodeState> GetNodeState(NodeId nodeId);
+    std::shared_ptr<CSigSharesNodeState> GetOrCreateNodeState(NodeId nodeId);
+    std::vector<std::pair<NodeId, std::shared_ptr<CSigSharesNodeState>>> GetNodeStates();
+    void RemoveNodeState(NodeId nodeId);
+
     bool GetSessionInfoByRecvId(NodeId nodeId, uint32_t sessionId, CSigSharesNodeState::SessionInfo& retInfo);
     static CSigShare RebuildSigShare(const CSigSharesNodeState::SessionInfo& session, const CBatchedSigShares& batchedSigShares, size_t idx);
 
     void Cleanup();
-    void RemoveSigSharesForSession(const uint256& signHash) EXCLUSIVE_LOCKS_REQUIRED(cs);
+    void RemoveSigSharesForSession(const uint256& signHash);
     void RemoveBannedNodeStates();
 
     void BanNode(NodeId nodeId);
 
     bool SendMessages();
-    void CollectSigSharesToRequest(std::unordered_map<NodeId, std::unordered_map<uint256, CSigSharesInv, StaticSaltedHasher>>& sigSharesToRequest) EXCLUSIVE_LOCKS_REQUIRED(cs);
-    void CollectSigSharesToSend(std::unordered_map<NodeId, std::unordered_map<uint256, CBatchedSigShares, StaticSaltedHasher>>& sigSharesToSend) EXCLUSIVE_LOCKS_REQUIRED(cs);
-    void CollectSigSharesToSendConcentrated(std::unordered_map<NodeId, std::vector<CSigShare>>& sigSharesToSend, const std::unordered_map<uint256, NodeId, StaticSaltedHasher> &proTxToNode) EXCLUSIVE_LOCKS_REQUIRED(cs);
-    void CollectSigSharesToAnnounce(std::unordered_map<NodeId, std::unordered_map<uint256, CSigSharesInv, StaticSaltedHasher>>& sigSharesToAnnounce) EXCLUSIVE_LOCKS_REQUIRED(cs);
+    void CollectSigSharesToRequest(std::unordered_map<NodeId, std::unordered_map<uint256, CSigSharesInv, StaticSaltedHasher>>& sigSharesToRequest);
+    void CollectSigSharesToSend(std::unordered_map<NodeId, std::unordered_map<uint256, CBatchedSigShares, StaticSaltedHasher>>& sigSharesToSend);
+    void CollectSigSharesToSendConcentrated(std::unordered_map<NodeId, std::vector<CSigShare>>& sigSharesToSend, const std::unordered_map<uint256, NodeId, StaticSaltedHasher> &proTxToNode);
+    void CollectSigSharesToAnnounce(std::unordered_map<NodeId, std::unordered_map<uint256, CSigSharesInv, StaticSaltedHasher>>& sigSharesToAnnounce);
     void SignPendingSigShares();
     void WorkThreadMain();
 };
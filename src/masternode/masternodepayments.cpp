@@ -243,12 +243,10 @@ bool CMasternodePayments::GetBlockTxOuts(int nBlockHeight, const CAmount &blockR
     {
         LOCK(cs_main);
         const CBlockIndex* pindex = ::ChainActive()[nBlockHeight - 1];
-        if(!pindex)
+        if(!pindex || !deterministicMNManager)
             return false;
-        CDeterministicMNList dmnPayeeList;
-        if(deterministicMNManager)
-            deterministicMNManager->GetListForBlock(pindex, dmnPayeeList);
-        dmnPayee = dmnPayeeList.GetMNPayee();
+        // served from the payee schedule, which is shared by block templates and the validation of the block
+        dmnPayee = deterministicMNManager->GetMNPayee(pindex);
         if (!dmnPayee) {
             return false;
         }
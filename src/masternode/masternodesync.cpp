@@ -301,12 +301,7 @@ void CMasternodeSync::ProcessTick(CConnman& connman, const PeerManager& peerman)
 
 void CMasternodeSync::SendGovernanceSyncRequest(CNode* pnode, CConnman& connman)
 {
-    CNetMsgMaker msgMaker(pnode->GetCommonVersion());
-
-    CBloomFilter filter;
-
-    connman.PushMessage(pnode, msgMaker.Make(NetMsgType::MNGOVERNANCESYNC, uint256(), filter));
-    
+    governance.RequestObjectList(pnode, connman);
 }
 
 void CMasternodeSync::AcceptedBlockHeader(const CBlockIndex *pindexNew)
@@ -1150,6 +1150,8 @@ void PeerManagerImpl::FinalizeNode(const CNode& node)
         assert(m_txrequest.Size() == 0);
     }
     } // cs_main
+    // SYSCOIN
+    governance.PeerDisconnected(node);
     if (node.fSuccessfullyConnected && misbehavior == 0 &&
         !node.IsBlockOnlyConn() && !node.IsInboundConn()) {
         // Only change visible addrman state for full outbound peers.  We don't
@@ -4166,7 +4168,10 @@ void PeerManagerImpl::ProcessMessage(CNode& pfrom, const std::string& msg_type,
         sporkManager.ProcessSpork(&pfrom, msg_type, vRecv, m_connman, *this);
         return;
     } else if(msg_type == NetMsgType::SYNCSTATUSCOUNT) {
+        // the status count of a paged governance sync carries the cursor of the next page
+        CDataStream vRecvGovernance(vRecv);
         masternodeSync.ProcessMessage(&pfrom, msg_type, vRecv);
+        governance.ProcessMessage(&pfrom, msg_type, vRecvGovernance, m_connman, *this);
         return;
     } else if(msg_type == NetMsgType::MNGOVERNANCESYNC || 
         msg_type == NetMsgType::MNGOVERNANCEOBJECT || 
@@ -242,6 +242,8 @@ static const CRPCConvertParam vRPCConvertParams[] =
     { "listassets", 0, "count" },
     { "listassets", 1, "from" },
     { "listassets", 2, "options" },
+    { "getaddressbalance", 0, "addresses" },
+    { "assetallocationverifyzdagmany", 0, "txids" },
     { "syscoinsetethstatus", 1, "highest_block" },
     { "syscoinsetethheaders", 0, "headers" },
     { "syscoincheckmint", 0, "bridge_transfer_id" },
@@ -10,6 +10,7 @@
 #include <governance/governanceclasses.h>
 #include <node/blockstorage.h>
 #include <evo/deterministicmns.h>
+#include <evo/simplifiedmns.h>
 #include <net.h>
 #include <validation.h>
 RPCHelpMan masternodelist();
@@ -117,6 +118,65 @@ static RPCHelpMan masternode_count()
     };
 } 
 
+static RPCHelpMan masternode_liststats()
+{
+    return RPCHelpMan{"masternode_liststats",
+        "\nGet the cost of masternode list lookups since startup and the usage of the list caches\n",
+        {
+        },
+        RPCResult{
+            RPCResult::Type::OBJ, "", "",
+            {
+                {RPCResult::Type::NUM, "lookups", "Number of masternode lists looked up"},
+                {RPCResult::Type::NUM, "direct_hits", "Number of lookups served from a cached or stored list without replaying diffs"},
+                {RPCResult::Type::NUM, "diffs_replayed", "Number of list diffs replayed by all lookups"},
+                {RPCResult::Type::NUM, "max_replay", "Largest number of diffs replayed by a single lookup"},
+                {RPCResult::Type::NUM, "disk_reads", "Number of lists and diffs read from disk"},
+                {RPCResult::Type::NUM, "snapshots_written", "Number of missing list snapshots written by lookups"},
+                {RPCResult::Type::NUM, "mns_interned", "Number of masternodes of lists read from disk shared with the tip list instead of copied"},
+                {RPCResult::Type::NUM, "lists_cached", "Number of lists in the cache"},
+                {RPCResult::Type::NUM, "lists_usage", "Estimated memory usage of the cached lists in bytes"},
+                {RPCResult::Type::NUM, "diffs_cached", "Number of diffs in the cache"},
+                {RPCResult::Type::NUM, "diffs_usage", "Estimated memory usage of the cached diffs in bytes"},
+                {RPCResult::Type::NUM, "mnlistdiff_requests", "Number of simplified list diffs requested by peers or protx_diff"},
+                {RPCResult::Type::NUM, "mnlistdiff_cache_hits", "Number of simplified list diffs served from the cache"},
+                {RPCResult::Type::NUM, "mnlistdiff_composed", "Number of simplified list diffs built from the diffs of the blocks in between"},
+                {RPCResult::Type::NUM, "mnlistdiffs_cached", "Number of simplified list diffs in the cache"},
+                {RPCResult::Type::NUM, "mnlistdiffs_usage", "Estimated memory usage of the cached simplified list diffs in bytes"},
+            }},
+        RPCExamples{
+                HelpExampleCli("masternode_liststats", "")
+            + HelpExampleRpc("masternode_liststats", "")
+        },
+    [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+{
+    if(!deterministicMNManager)
+        throw JSONRPCError(RPC_INTERNAL_ERROR, "Masternode list is not available");
+    const CDeterministicMNListStats stats = deterministicMNManager->GetListStats();
+
+    UniValue obj(UniValue::VOBJ);
+    obj.pushKV("lookups", stats.nLookups);
+    obj.pushKV("direct_hits", stats.nDirectHits);
+    obj.pushKV("diffs_replayed", stats.nDiffsReplayed);
+    obj.pushKV("max_replay", stats.nMaxReplay);
+    obj.pushKV("disk_reads", stats.nDiskReads);
+    obj.pushKV("snapshots_written", stats.nSnapshotsWritten);
+    obj.pushKV("mns_interned", stats.nMNsInterned);
+    obj.pushKV("lists_cached", (uint64_t)stats.nListsCached);
+    obj.pushKV("lists_usage", (uint64_t)stats.nListsUsage);
+    obj.pushKV("diffs_cached", (uint64_t)stats.nDiffsCached);
+    obj.pushKV("diffs_usage", (uint64_t)stats.nDiffsUsage);
+    const CSimplifiedMNListDiffStats smlStats = GetSimplifiedMNListDiffStats();
+    obj.pushKV("mnlistdiff_requests", smlStats.nRequests);
+    obj.pushKV("mnlistdiff_cache_hits", smlStats.nCacheHits);
+    obj.pushKV("mnlistdiff_composed", smlStats.nComposed);
+    obj.pushKV("mnlistdiffs_cached", (uint64_t)smlStats.nCached);
+    obj.pushKV("mnlistdiffs_usage", (uint64_t)smlStats.nUsage);
+    return obj;
+},
+    };
+}
+
 UniValue GetNextMasternodeForPayment(size_t heightShift)
 {
     CDeterministicMNList mnList;
@@ -298,10 +358,8 @@ static RPCHelpMan masternode_winners()
         if (strFilter != "" && strPayments.find(strFilter) == std::string::npos) continue;
         obj.pushKV(strprintf("%d", h), strPayments);
     }
-    CDeterministicMNList projection;
-    deterministicMNManager->GetListForBlock(pindexTip,projection);
     std::vector<CDeterministicMNCPtr> projectedPayees;
-    projection.GetProjectedMNPayees(20, projectedPayees);
+    deterministicMNManager->GetProjectedMNPayees(pindexTip, 20, projectedPayees);
     for (size_t i = 0; i < projectedPayees.size(); i++) {
         int h = nChainTipHeight + 1 + i;
         std::string strPayments = GetRequiredPaymentsString(h, projectedPayees[i]);
@@ -606,6 +664,7 @@ static const CRPCCommand commands[] =
     { "masternode",            &masternode_winners,      },
     { "masternode",            &masternode_payments,     },
     { "masternode",            &masternode_count,        },
+    { "masternode",            &masternode_liststats,    },
     { "masternode",            &masternode_winner,       },
     { "masternode",            &masternode_status,       },
     { "masternode",            &masternode_current,      },
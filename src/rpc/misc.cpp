@@ -4,6 +4,8 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <httpserver.h>
+#include <index/assetaddressindex.h>
+#include <index/assetindex.h>
 #include <index/blockfilterindex.h>
 #include <index/coinstatsindex.h>
 #include <index/txindex.h>
@@ -897,6 +899,13 @@ static RPCHelpMan getindexinfo()
     if (g_coin_stats_index) {
         result.pushKVs(SummaryToJSON(g_coin_stats_index->GetSummary(), index_name));
     }
+    // SYSCOIN
+    if (g_asset_index) {
+        result.pushKVs(SummaryToJSON(g_asset_index->GetSummary(), index_name));
+    }
+    if (g_asset_address_index) {
+        result.pushKVs(SummaryToJSON(g_asset_address_index->GetSummary(), index_name));
+    }
 
     ForEachBlockFilterIndex([&result, &index_name](const BlockFilterIndex& index) {
         result.pushKVs(SummaryToJSON(index.GetSummary(), index_name));
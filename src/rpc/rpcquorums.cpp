@@ -12,6 +12,7 @@
 #include <llmq/quorums.h>
 #include <llmq/quorums_commitment.h>
 #include <llmq/quorums_blockprocessor.h>
+#include <llmq/quorums_chainlocks.h>
 #include <llmq/quorums_debug.h>
 #include <llmq/quorums_dkgsession.h>
 #include <llmq/quorums_signing.h>
@@ -597,6 +598,57 @@ static RPCHelpMan quorum_dkgsimerror()
     };
 } 
 
+static RPCHelpMan quorum_verifystats()
+{
+    const std::vector<RPCResult> statsFields{
+        {RPCResult::Type::NUM, "batches", "Number of verified batches"},
+        {RPCResult::Type::NUM, "sigs", "Number of signatures verified in these batches"},
+        {RPCResult::Type::NUM, "failed_batches", "Number of batches with an invalid signature, which were verified again per node"},
+        {RPCResult::Type::NUM, "bad_sources", "Number of nodes which sent an invalid signature"},
+    };
+    const std::vector<RPCResult> lockFields{
+        {RPCResult::Type::NUM, "locks", "Number of times the locks were taken"},
+        {RPCResult::Type::NUM, "contended", "Number of times the lock was held by another thread"},
+    };
+    return RPCHelpMan{"quorum_verifystats",
+        "\nGet the counters of the batched verification of signatures received from other nodes and of the lock\n"
+        "contention of the signature shares manager since startup.\n",
+        {
+        },
+        RPCResult{
+            RPCResult::Type::OBJ, "", "",
+            {
+                {RPCResult::Type::OBJ, "recsigs", "Recovered signatures", statsFields},
+                {RPCResult::Type::OBJ, "sigshares", "Signature shares", statsFields},
+                {RPCResult::Type::OBJ, "clsigs", "ChainLock signatures of single quorums", statsFields},
+                {RPCResult::Type::OBJ, "sigshares_locks", "Lock contention of the signature shares manager",
+                {
+                    {RPCResult::Type::OBJ, "nodes", "Locks of the per node states", lockFields},
+                    {RPCResult::Type::OBJ, "sessions", "Locks of the signing session shards", lockFields},
+                }},
+            }},
+        RPCExamples{
+                HelpExampleCli("quorum_verifystats", "")
+            + HelpExampleRpc("quorum_verifystats", "")
+        },
+    [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+{
+    if (!llmq::quorumSigningManager || !llmq::quorumSigSharesManager || !llmq::chainLocksHandler) {
+        throw JSONRPCError(RPC_INTERNAL_ERROR, "Quorum signing is not available");
+    }
+    UniValue ret(UniValue::VOBJ);
+    ret.pushKV("recsigs", llmq::quorumSigningManager->GetVerifyStats().ToJson());
+    ret.pushKV("sigshares", llmq::quorumSigSharesManager->GetVerifyStats().ToJson());
+    ret.pushKV("clsigs", llmq::chainLocksHandler->GetVerifyStats().ToJson());
+    UniValue locks(UniValue::VOBJ);
+    locks.pushKV("nodes", llmq::quorumSigSharesManager->GetNodeLockStats().ToJson());
+    locks.pushKV("sessions", llmq::quorumSigSharesManager->GetShardLockStats().ToJson());
+    ret.pushKV("sigshares_locks", locks);
+    return ret;
+},
+    };
+}
+
 void RegisterQuorumsRPCCommands(CRPCTable &t)
 {
 // clang-format off
@@ -614,6 +666,7 @@ static const CRPCCommand commands[] =
     { "evo",                &quorum_getrecsig,                   },
     { "evo",                &quorum_isconflicting,               },
     { "evo",                &quorum_sign,                        },
+    { "evo",                &quorum_verifystats,                 },
 };
 // clang-format on
     for (const auto& c : commands) {
@@ -13,12 +13,82 @@
 #include <messagesigner.h>
 #include <util/rbf.h>
 #include <undo.h>
+#include <crypto/common.h>
+#include <cuckoocache.h>
+#include <random.h>
+#include <script/sigcache.h>
+#include <shared_mutex>
 std::unique_ptr<CAssetDB> passetdb;
 std::unique_ptr<CEthereumTxRootsDB> pethereumtxrootsdb;
 std::unique_ptr<CEthereumMintedTxDB> pethereumtxmintdb;
 RecursiveMutex cs_setethstatus;
 extern std::string EncodeDestination(const CTxDestination& dest);
-bool CheckSyscoinMint(const bool &ibd, const CTransaction& tx, const uint256& txHash, TxValidationState& state, const bool &fJustCheck, const bool& bSanityCheck, const int& nHeight, const int64_t& nTime, const uint256& blockhash, EthereumMintTxMap &mapMintKeys, const CAssetsMap &mapAssetIn, const CAssetsMap &mapAssetOut) {
+// SPV proofs (tx and receipt trie) already verified for a mint, shared between mempool and block validation
+static CuckooCache::cache<uint256, SignatureCacheHasher> g_mintProofCache;
+static CSHA256 g_mintProofCacheHasher;
+static std::shared_mutex cs_mintproofcache;
+
+void InitMintProofCache() {
+    // Setup the salted hasher
+    uint256 nonce = GetRandHash();
+    // We want the nonce to be 64 bytes long to force the hasher to process
+    // this chunk, which makes later hash computations more efficient.
+    g_mintProofCacheHasher.Write(nonce.begin(), 32);
+    g_mintProofCacheHasher.Write(nonce.begin(), 32);
+    size_t nElems = g_mintProofCache.setup_bytes(MINT_PROOF_CACHE_SIZE);
+    LogPrintf("Using %zu KiB for mint proof cache, able to store %zu elements\n",
+            (nElems*sizeof(uint256)) >>10, nElems);
+}
+
+void ComputeMintProofCacheEntry(uint256& entry, const uint256& txHash, const uint32_t nBlockNumber, const std::vector<unsigned char> &vchTxRoot, const std::vector<unsigned char> &vchReceiptRoot) {
+    unsigned char vchBlockNumber[4];
+    WriteLE32(vchBlockNumber, nBlockNumber);
+    // each root is prefixed by its length, so bytes can't move from one root to the other for the same entry
+    unsigned char vchTxRootSize[4];
+    WriteLE32(vchTxRootSize, vchTxRoot.size());
+    unsigned char vchReceiptRootSize[4];
+    WriteLE32(vchReceiptRootSize, vchReceiptRoot.size());
+    CSHA256 hasher = g_mintProofCacheHasher;
+    hasher.Write(txHash.begin(), 32).Write(vchBlockNumber, 4).Write(vchTxRootSize, 4).Write(vchTxRoot.data(), vchTxRoot.size()).Write(vchReceiptRootSize, 4).Write(vchReceiptRoot.data(), vchReceiptRoot.size()).Finalize(entry.begin());
+}
+
+bool MintProofCacheContains(const uint256& entry, const bool erase) {
+    std::shared_lock<std::shared_mutex> lock(cs_mintproofcache);
+    return g_mintProofCache.contains(entry, erase);
+}
+
+void MintProofCacheInsert(const uint256& entry) {
+    std::unique_lock<std::shared_mutex> lock(cs_mintproofcache);
+    g_mintProofCache.insert(entry);
+}
+bool CheckSyscoinMintKeys(const CTransaction& tx, const uint256& txHash, TxValidationState& state, const bool& bSanityCheck, EthereumMintTxMap &mapMintKeys) {
+    CMintSyscoin mintSyscoin(tx);
+    if(mintSyscoin.IsNull()) {
+        return FormatSyscoinErrorMessage(state, "mint-unserialize", bSanityCheck);
+    }
+    const uint32_t &nBridgeTransferID = mintSyscoin.nBridgeTransferID;
+    // ensure eth tx not already spent in a previous block
+    if(pethereumtxmintdb->Exists(nBridgeTransferID)) {
+        return FormatSyscoinErrorMessage(state, "mint-exists", bSanityCheck);
+    } 
+    // sanity check is set in mempool during m_test_accept and when miner validates block
+    // we care to ensure unique bridge id's in the mempool, not to emplace on test_accept
+    if(bSanityCheck) {
+        if(mapMintKeys.find(nBridgeTransferID) != mapMintKeys.end()) {
+            return FormatSyscoinErrorMessage(state, "mint-duplicate-transfer", bSanityCheck);
+        }
+    }
+    else {
+        // ensure eth tx not already spent in current processing block or mempool(mapMintKeysMempool passed in)
+        auto itMap = mapMintKeys.try_emplace(nBridgeTransferID, txHash);
+        if(!itMap.second) {
+            return FormatSyscoinErrorMessage(state, "mint-duplicate-transfer", bSanityCheck);
+        }
+    }
+    return true;
+}
+
+bool CheckSyscoinMintProof(const CTransaction& tx, const uint256& txHash, TxValidationState& state, const bool &fJustCheck, const bool& bSanityCheck, const int& nHeight, const int64_t& nTime, const uint256& blockhash, const CAssetsMap &mapAssetIn, const CAssetsMap &mapAssetOut) {
     if (!bSanityCheck)
         LogPrint(BCLog::SYS,"*** ASSET MINT %d %s %s bSanityCheck=%d\n", nHeight,
             txHash.ToString().c_str(),
@@ -158,15 +228,16 @@ bool CheckSyscoinMint(const bool &ibd, const CTransaction& tx, const uint256& tx
     if(nBridgeTransferID != mintSyscoin.nBridgeTransferID) {
         return FormatSyscoinErrorMessage(state, "mint-mismatch-bridge-id", bSanityCheck);
     }
-    // check transaction spv proofs
+    // check transaction spv proofs, the roots and parent nodes are walked in place by VerifyProof() but still
+    // decoded strictly here so malformed encodings keep failing the same way they always have
     dev::RLP rlpTxRoot(&mintSyscoin.vchTxRoot);
     dev::RLP rlpReceiptRoot(&mintSyscoin.vchReceiptRoot);
 
-    if(!txRootDB.vchTxRoot.empty() && mintSyscoin.vchTxRoot != txRootDB.vchTxRoot){
+    if(!txRootDB.hashTxRoot.IsNull() && !EthereumRootMatches(txRootDB.hashTxRoot, mintSyscoin.vchTxRoot)){
         return FormatSyscoinErrorMessage(state, "mint-mismatching-txroot", bSanityCheck);
     }
 
-    if(!txRootDB.vchReceiptRoot.empty() && mintSyscoin.vchReceiptRoot != txRootDB.vchReceiptRoot){
+    if(!txRootDB.hashReceiptRoot.IsNull() && !EthereumRootMatches(txRootDB.hashReceiptRoot, mintSyscoin.vchReceiptRoot)){
         return FormatSyscoinErrorMessage(state, "mint-mismatching-receiptroot", bSanityCheck);
     }
     
@@ -175,33 +246,23 @@ bool CheckSyscoinMint(const bool &ibd, const CTransaction& tx, const uint256& tx
     dev::RLP rlpTxValue(&vchTxValue);
     const std::vector<unsigned char> &vchTxPath = mintSyscoin.vchTxPath;
     dev::RLP rlpTxPath(&vchTxPath);
-    // ensure eth tx not already spent in a previous block
-    if(pethereumtxmintdb->Exists(nBridgeTransferID)) {
-        return FormatSyscoinErrorMessage(state, "mint-exists", bSanityCheck);
-    } 
-    // sanity check is set in mempool during m_test_accept and when miner validates block
-    // we care to ensure unique bridge id's in the mempool, not to emplace on test_accept
-    if(bSanityCheck) {
-        if(mapMintKeys.find(nBridgeTransferID) != mapMintKeys.end()) {
-            return FormatSyscoinErrorMessage(state, "mint-duplicate-transfer", bSanityCheck);
-        }
-    }
-    else {
-        // ensure eth tx not already spent in current processing block or mempool(mapMintKeysMempool passed in)
-        auto itMap = mapMintKeys.try_emplace(nBridgeTransferID, txHash);
-        if(!itMap.second) {
-            return FormatSyscoinErrorMessage(state, "mint-duplicate-transfer", bSanityCheck);
+    // proofs verified when the mint was relayed don't need to be verified again when the block connects,
+    // keep them cached for mempool and miner checks and drop the entry once the block is connected for real
+    uint256 proofCacheEntry;
+    ComputeMintProofCacheEntry(proofCacheEntry, txHash, mintSyscoin.nBlockNumber, mintSyscoin.vchTxRoot, mintSyscoin.vchReceiptRoot);
+    if(!MintProofCacheContains(proofCacheEntry, !fJustCheck && !bSanityCheck)) {
+        // verify receipt proof
+        if(!VerifyProof(vchTxPath, vchReceiptValue, mintSyscoin.vchReceiptParentNodes, mintSyscoin.vchReceiptRoot)) {
+            return FormatSyscoinErrorMessage(state, "mint-verify-receipt-proof", bSanityCheck);
+        } 
+        // verify transaction proof
+        if(!VerifyProof(vchTxPath, vchTxValue, mintSyscoin.vchTxParentNodes, mintSyscoin.vchTxRoot)) {
+            return FormatSyscoinErrorMessage(state, "mint-verify-tx-proof", bSanityCheck);
+        } 
+        if(fJustCheck) {
+            MintProofCacheInsert(proofCacheEntry);
         }
     }
-     
-    // verify receipt proof
-    if(!VerifyProof(&vchTxPath, rlpReceiptValue, rlpReceiptParentNodes, rlpReceiptRoot)) {
-        return FormatSyscoinErrorMessage(state, "mint-verify-receipt-proof", bSanityCheck);
-    } 
-    // verify transaction proof
-    if(!VerifyProof(&vchTxPath, rlpTxValue, rlpTxParentNodes, rlpTxRoot)) {
-        return FormatSyscoinErrorMessage(state, "mint-verify-tx-proof", bSanityCheck);
-    } 
     if (!rlpTxValue.isList()) {
         return FormatSyscoinErrorMessage(state, "mint-tx-rlp-list", bSanityCheck);
     }
@@ -267,11 +328,21 @@ bool CheckSyscoinMint(const bool &ibd, const CTransaction& tx, const uint256& tx
     if (!MoneyRangeAsset(nTotal)) {
         return FormatSyscoinErrorMessage(state, "mint-value-outofrange", bSanityCheck);
     }
+    return true;
+}
+
+bool CheckSyscoinMint(const bool &ibd, const CTransaction& tx, const uint256& txHash, TxValidationState& state, const bool &fJustCheck, const bool& bSanityCheck, const int& nHeight, const int64_t& nTime, const uint256& blockhash, EthereumMintTxMap &mapMintKeys, const CAssetsMap &mapAssetIn, const CAssetsMap &mapAssetOut) {
+    if(!CheckSyscoinMintProof(tx, txHash, state, fJustCheck, bSanityCheck, nHeight, nTime, blockhash, mapAssetIn, mapAssetOut)) {
+        return false;
+    }
+    if(!CheckSyscoinMintKeys(tx, txHash, state, bSanityCheck, mapMintKeys)) {
+        return false;
+    }
     if(!fJustCheck) {
         if(!bSanityCheck && nHeight > 0) {   
             LogPrint(BCLog::SYS,"CONNECTED ASSET MINT: op=%s asset=%llu hash=%s height=%d fJustCheck=%s\n",
                 stringFromSyscoinTx(tx.nVersion).c_str(),
-                nAsset,
+                tx.voutAssets.front().key,
                 txHash.ToString().c_str(),
                 nHeight,
                 fJustCheck ? "JUSTCHECK" : "BLOCK");      
@@ -307,6 +378,22 @@ bool CheckSyscoinInputs(const bool &ibd, const CTransaction& tx, const uint256&
     return good;
 }
 
+bool CSyscoinCheck::operator()() {
+    assert(ptxTo != nullptr && pstate != nullptr);
+    const CTransaction &tx = *ptxTo;
+    try{
+        if(IsSyscoinMintTx(tx.nVersion)) {
+            return CheckSyscoinMintProof(tx, txHash, *pstate, fJustCheck, bSanityCheck, nHeight, nTime, blockHash, mapAssetIn, mapAssetOut);
+        }
+        else if (IsAssetAllocationTx(tx.nVersion)) {
+            return CheckAssetAllocationInputs(tx, txHash, *pstate, fJustCheck, nHeight, blockHash, bSanityCheck, mapAssetIn, mapAssetOut);
+        }
+    } catch (...) {
+        return FormatSyscoinErrorMessage(*pstate, "checksyscoininputs-exception", bSanityCheck);
+    }
+    return true;
+}
+
 bool DisconnectMintAsset(const CTransaction &tx, const uint256& txHash, EthereumMintTxMap &mapMintKeys){
     CMintSyscoin mintSyscoin(tx);
     if(mintSyscoin.IsNull()) {
@@ -985,32 +1072,358 @@ bool CheckAssetInputs(const CTransaction &tx, const uint256& txHash, TxValidatio
     return true;
 }
 
+static const uint8_t DB_TXROOT_BUCKET = 'b';
+
+bool EthereumRootMatches(const uint256& root, const std::vector<unsigned char> &vchRLPRoot) {
+    return vchRLPRoot.size() == 33 && vchRLPRoot[0] == 0xa0 && std::equal(root.begin(), root.end(), vchRLPRoot.begin() + 1);
+}
+
+namespace {
+/** Key of the record holding the roots of heights [nBucket * ETHEREUM_TX_ROOTS_BUCKET_SIZE, (nBucket + 1) * ETHEREUM_TX_ROOTS_BUCKET_SIZE) */
+struct EthereumTxRootKey {
+    uint32_t nBucket{0};
+
+    EthereumTxRootKey() {}
+    explicit EthereumTxRootKey(const uint32_t &nBucketIn) : nBucket(nBucketIn) {}
+
+    template <typename Stream>
+    void Serialize(Stream& s) const
+    {
+        ser_writedata8(s, DB_TXROOT_BUCKET);
+        // big endian so buckets are iterated in height order
+        ser_writedata32be(s, nBucket);
+    }
+
+    template <typename Stream>
+    void Unserialize(Stream& s)
+    {
+        if (ser_readdata8(s) != DB_TXROOT_BUCKET) {
+            throw std::ios_base::failure("Invalid format for ethereum tx roots DB key");
+        }
+        nBucket = ser_readdata32be(s);
+    }
+};
+
+/** Format of the roots before they were grouped in buckets, one record per height keyed by the height */
+class LegacyEthereumTxRoot {
+    public:
+    std::vector<unsigned char> vchBlockHash;
+    std::vector<unsigned char> vchPrevHash;
+    std::vector<unsigned char> vchTxRoot;
+    std::vector<unsigned char> vchReceiptRoot;
+    int64_t nTimestamp;
+
+    SERIALIZE_METHODS(LegacyEthereumTxRoot, obj)
+    {
+        READWRITE(obj.vchBlockHash, obj.vchPrevHash, obj.vchTxRoot, obj.vchReceiptRoot, obj.nTimestamp);
+    }
+};
+
+bool ParseLegacyRoot(const std::vector<unsigned char> &vchRoot, uint256 &root) {
+    // roots were stored with their RLP header, but only if the relayer didn't pass one starting with a0 already
+    if (vchRoot.size() == 33 && vchRoot[0] == 0xa0) {
+        std::copy(vchRoot.begin() + 1, vchRoot.end(), root.begin());
+        return true;
+    }
+    if (vchRoot.size() == 32) {
+        root = uint256(vchRoot);
+        return true;
+    }
+    return false;
+}
+} // namespace
+
+/** Roots of ETHEREUM_TX_ROOTS_BUCKET_SIZE consecutive heights, only the heights present are stored */
+class EthereumTxRootBucket {
+private:
+    static const size_t PRESENCE_WORDS = ETHEREUM_TX_ROOTS_BUCKET_SIZE / 64;
+    uint64_t vPresence[PRESENCE_WORDS]{};
+    // roots of the present heights in height order
+    std::vector<EthereumTxRoot> vRoots;
+
+    size_t Index(const uint32_t &nOffset) const {
+        size_t nIndex = 0;
+        for (size_t i = 0; i < nOffset / 64; i++) {
+            nIndex += __builtin_popcountll(vPresence[i]);
+        }
+        return nIndex + __builtin_popcountll(vPresence[nOffset / 64] & ((uint64_t{1} << (nOffset % 64)) - 1));
+    }
+public:
+    bool IsEmpty() const { return vRoots.empty(); }
+    bool Has(const uint32_t &nOffset) const { return (vPresence[nOffset / 64] >> (nOffset % 64)) & 1; }
+    const EthereumTxRoot* Get(const uint32_t &nOffset) const {
+        return Has(nOffset) ? &vRoots[Index(nOffset)] : nullptr;
+    }
+    void Set(const uint32_t &nOffset, const EthereumTxRoot &txRoot) {
+        const size_t nIndex = Index(nOffset);
+        if (Has(nOffset)) {
+            vRoots[nIndex] = txRoot;
+            return;
+        }
+        vRoots.insert(vRoots.begin() + nIndex, txRoot);
+        vPresence[nOffset / 64] |= uint64_t{1} << (nOffset % 64);
+    }
+    void Erase(const uint32_t &nOffset) {
+        if (!Has(nOffset))
+            return;
+        vRoots.erase(vRoots.begin() + Index(nOffset));
+        vPresence[nOffset / 64] &= ~(uint64_t{1} << (nOffset % 64));
+    }
+    // calls fn(nOffset, txRoot) for every present height in order
+    template <typename Fn>
+    void ForEach(Fn fn) const {
+        size_t nIndex = 0;
+        for (uint32_t nOffset = 0; nOffset < ETHEREUM_TX_ROOTS_BUCKET_SIZE; nOffset++) {
+            if (Has(nOffset))
+                fn(nOffset, vRoots[nIndex++]);
+        }
+    }
+
+    template <typename Stream>
+    void Serialize(Stream& s) const
+    {
+        for (const uint64_t &nWord : vPresence) {
+            ser_writedata64(s, nWord);
+        }
+        s << vRoots;
+    }
+
+    template <typename Stream>
+    void Unserialize(Stream& s)
+    {
+        size_t nPresent = 0;
+        for (uint64_t &nWord : vPresence) {
+            nWord = ser_readdata64(s);
+            nPresent += __builtin_popcountll(nWord);
+        }
+        s >> vRoots;
+        if (vRoots.size() != nPresent) {
+            throw std::ios_base::failure("Ethereum tx roots bucket size does not match its presence bitmap");
+        }
+    }
+};
+
+bool CEthereumTxRootsDB::IsPresent(const uint32_t &nHeight) const {
+    auto it = mapPresentRanges.upper_bound(nHeight);
+    if (it == mapPresentRanges.begin())
+        return false;
+    return std::prev(it)->second >= nHeight;
+}
+
+void CEthereumTxRootsDB::AddPresent(const uint32_t &nHeight) {
+    if (IsPresent(nHeight))
+        return;
+    auto itNext = mapPresentRanges.upper_bound(nHeight);
+    // extend the range ending right below, else start a new one
+    auto it = itNext;
+    if (it != mapPresentRanges.begin() && std::prev(it)->second + 1 == nHeight) {
+        it = std::prev(it);
+        it->second = nHeight;
+    } else {
+        it = mapPresentRanges.emplace_hint(itNext, nHeight, nHeight);
+    }
+    // merge with the range starting right above
+    if (itNext != mapPresentRanges.end() && itNext->first == nHeight + 1) {
+        it->second = itNext->second;
+        mapPresentRanges.erase(itNext);
+    }
+}
+
+void CEthereumTxRootsDB::RemovePresent(const uint32_t &nFirst, const uint32_t &nLast) {
+    auto it = mapPresentRanges.upper_bound(nFirst);
+    if (it != mapPresentRanges.begin() && std::prev(it)->second >= nFirst)
+        it = std::prev(it);
+    while (it != mapPresentRanges.end() && it->first <= nLast) {
+        const uint32_t nRangeFirst = it->first;
+        const uint32_t nRangeLast = it->second;
+        it = mapPresentRanges.erase(it);
+        // keep what is left on either side of the removed heights
+        if (nRangeFirst < nFirst)
+            mapPresentRanges.emplace(nRangeFirst, nFirst - 1);
+        if (nRangeLast > nLast)
+            it = mapPresentRanges.emplace(nLast + 1, nRangeLast).first;
+    }
+}
+
+EthereumTxRootBucket& CEthereumTxRootsDB::LoadBucket(std::map<uint32_t, EthereumTxRootBucket> &mapBuckets, const uint32_t &nHeight) {
+    const uint32_t nBucket = nHeight / ETHEREUM_TX_ROOTS_BUCKET_SIZE;
+    auto it = mapBuckets.find(nBucket);
+    if (it == mapBuckets.end()) {
+        it = mapBuckets.emplace(nBucket, EthereumTxRootBucket()).first;
+        // a missing record is an empty bucket
+        if (!Read(EthereumTxRootKey(nBucket), it->second))
+            it->second = EthereumTxRootBucket();
+    }
+    return it->second;
+}
+
+void CEthereumTxRootsDB::UpdateLink(std::map<uint32_t, EthereumTxRootBucket> &mapBuckets, const uint32_t &nHeight) {
+    // only heights continuing a present height are checked for a continuous hash chain
+    if (nHeight == 0 || !IsPresent(nHeight) || !IsPresent(nHeight - 1)) {
+        setBrokenLinks.erase(nHeight);
+        return;
+    }
+    const EthereumTxRoot* txRoot = LoadBucket(mapBuckets, nHeight).Get(nHeight % ETHEREUM_TX_ROOTS_BUCKET_SIZE);
+    const EthereumTxRoot* txRootPrev = LoadBucket(mapBuckets, nHeight - 1).Get((nHeight - 1) % ETHEREUM_TX_ROOTS_BUCKET_SIZE);
+    if (txRoot && txRootPrev && txRoot->hashPrevBlock != txRootPrev->hashBlock)
+        setBrokenLinks.insert(nHeight);
+    else
+        setBrokenLinks.erase(nHeight);
+}
+
+template <typename Buckets>
+void CEthereumTxRootsDB::UncacheBuckets(const Buckets &buckets) {
+    LOCK(cs_bucketcache);
+    nBucketCacheEpoch++;
+    for (const auto &bucket : buckets) {
+        if constexpr (std::is_same_v<typename Buckets::value_type, uint32_t>)
+            bucketCache.erase(bucket);
+        else
+            bucketCache.erase(bucket.first);
+    }
+}
+
+bool CEthereumTxRootsDB::ReadTxRoots(const uint32_t& nHeight, EthereumTxRoot& txRoot) {
+    // called from the check queue workers, only the presence lookup needs cs_setethstatus
+    if (!WITH_LOCK(cs_setethstatus, return IsPresent(nHeight)))
+        return false;
+    const uint32_t nBucket = nHeight / ETHEREUM_TX_ROOTS_BUCKET_SIZE;
+    std::shared_ptr<const EthereumTxRootBucket> bucket;
+    uint64_t nEpoch;
+    {
+        LOCK(cs_bucketcache);
+        bucketCache.get(nBucket, bucket);
+        nEpoch = nBucketCacheEpoch;
+    }
+    if (!bucket) {
+        auto bucketDB = std::make_shared<EthereumTxRootBucket>();
+        if (!Read(EthereumTxRootKey(nBucket), *bucketDB))
+            return false;
+        bucket = bucketDB;
+        LOCK(cs_bucketcache);
+        if (nEpoch == nBucketCacheEpoch)
+            bucketCache.insert(nBucket, bucket);
+    }
+    const EthereumTxRoot* txRootDB = bucket->Get(nHeight % ETHEREUM_TX_ROOTS_BUCKET_SIZE);
+    if (!txRootDB)
+        return false;
+    txRoot = *txRootDB;
+    return true;
+}
+
+bool CEthereumTxRootsDB::EraseRange(const uint32_t &nFirst, const uint32_t &nLast) {
+    if (nFirst > nLast)
+        return true;
+    CDBBatch batch(*this);
+    size_t nErased = 0;
+    // only buckets overlapping present ranges are visited, whole buckets are erased without reading them
+    std::set<uint32_t> setBuckets;
+    auto it = mapPresentRanges.upper_bound(nFirst);
+    if (it != mapPresentRanges.begin())
+        it = std::prev(it);
+    for (; it != mapPresentRanges.end() && it->first <= nLast; ++it) {
+        const uint32_t nFrom = std::max(it->first, nFirst);
+        const uint32_t nTo = std::min(it->second, nLast);
+        if (nFrom > nTo)
+            continue;
+        nErased += nTo - nFrom + 1;
+        for (uint32_t nBucket = nFrom / ETHEREUM_TX_ROOTS_BUCKET_SIZE; nBucket <= nTo / ETHEREUM_TX_ROOTS_BUCKET_SIZE; nBucket++) {
+            setBuckets.insert(nBucket);
+        }
+    }
+    if (setBuckets.empty())
+        return true;
+    for (const uint32_t &nBucket : setBuckets) {
+        const uint32_t nBucketFirst = nBucket * ETHEREUM_TX_ROOTS_BUCKET_SIZE;
+        const uint32_t nBucketLast = nBucketFirst + (ETHEREUM_TX_ROOTS_BUCKET_SIZE - 1);
+        if (nFirst <= nBucketFirst && nBucketLast <= nLast) {
+            batch.Erase(EthereumTxRootKey(nBucket));
+            continue;
+        }
+        EthereumTxRootBucket bucket;
+        if (!Read(EthereumTxRootKey(nBucket), bucket))
+            continue;
+        // iterate offsets so the last bucket doesn't overflow the height
+        for (uint32_t nOffset = std::max(nFirst, nBucketFirst) - nBucketFirst; nOffset <= std::min(nLast, nBucketLast) - nBucketFirst; nOffset++) {
+            bucket.Erase(nOffset);
+        }
+        if (bucket.IsEmpty())
+            batch.Erase(EthereumTxRootKey(nBucket));
+        else
+            batch.Write(EthereumTxRootKey(nBucket), bucket);
+    }
+    LogPrint(BCLog::SYS, "Flushing, erasing %d ethereum tx roots, block range (%d-%d)\n", nErased, nFirst, nLast);
+    if (!WriteBatch(batch))
+        return false;
+    UncacheBuckets(setBuckets);
+    RemovePresent(nFirst, nLast);
+    // the height above the range no longer continues a present height
+    setBrokenLinks.erase(setBrokenLinks.lower_bound(nFirst), nLast == std::numeric_limits<uint32_t>::max() ? setBrokenLinks.end() : setBrokenLinks.upper_bound(nLast + 1));
+    return true;
+}
+
 bool CEthereumTxRootsDB::PruneTxRoots(const uint32_t &fNewGethSyncHeight) {
     LOCK(cs_setethstatus);
     uint32_t fNewGethCurrentHeight = fGethCurrentHeight;
-    std::unique_ptr<CDBIterator> pcursor(NewIterator());
-    pcursor->SeekToFirst();
-    std::vector<uint32_t> vecHeightKeys;
-    uint32_t nKey = 0;
-    uint32_t cutoffHeight = 0;
     if(fNewGethSyncHeight > 0) {
-        // cutoff to keep blocks
-        cutoffHeight = fNewGethSyncHeight - MAX_ETHEREUM_TX_ROOTS;
         if(fNewGethSyncHeight < MAX_ETHEREUM_TX_ROOTS) {
             LogPrint(BCLog::SYS, "Nothing to prune fGethSyncHeight = %d\n", fNewGethSyncHeight);
             return true;
         }
+        // cutoff to keep blocks
+        const uint32_t cutoffHeight = fNewGethSyncHeight - MAX_ETHEREUM_TX_ROOTS;
+        // remove txroots before cutoff height or after tip height passed in (re-org)
+        if((cutoffHeight > 0 && !EraseRange(0, cutoffHeight - 1)) || !EraseRange(fNewGethSyncHeight + 1, std::numeric_limits<uint32_t>::max()))
+            return false;
     }
-    std::vector<unsigned char> txPos;
+    if(!mapPresentRanges.empty() && mapPresentRanges.rbegin()->second > fNewGethCurrentHeight)
+        fNewGethCurrentHeight = mapPresentRanges.rbegin()->second;
+
+    fGethSyncHeight = fNewGethSyncHeight;
+    fGethCurrentHeight = fNewGethCurrentHeight;
+    return true;
+}
+
+bool CEthereumTxRootsDB::MigrateLegacyRoots() {
+    std::unique_ptr<CDBIterator> pcursor(NewIterator());
+    pcursor->SeekToFirst();
+    EthereumTxRootKey bucketKey;
+    uint32_t nKey = 0;
+    EthereumTxRootMap mapTxRoots;
+    std::vector<uint32_t> vecLegacyKeys;
+    size_t nMigrated = 0;
+    size_t nDropped = 0;
+    auto flush = [&]() {
+        CDBBatch batch(*this);
+        for (const uint32_t &nLegacyKey : vecLegacyKeys) {
+            batch.Erase(nLegacyKey);
+        }
+        if (!WriteBatch(batch) || !FlushWrite(mapTxRoots))
+            return false;
+        nMigrated += mapTxRoots.size();
+        vecLegacyKeys.clear();
+        mapTxRoots.clear();
+        return true;
+    };
     while (pcursor->Valid()) {
         try {
-            if(pcursor->GetKey(nKey)) {
-                // if height is before cutoff height or after tip height passed in (re-org), remove the txroot from db
-                if (fNewGethSyncHeight > 0 && (nKey < cutoffHeight || nKey > fNewGethSyncHeight)) {
-                    vecHeightKeys.emplace_back(nKey);
+            if(!pcursor->GetKey(bucketKey) && pcursor->GetKey(nKey)) {
+                vecLegacyKeys.emplace_back(nKey);
+                LegacyEthereumTxRoot legacyRoot;
+                EthereumTxRoot txRoot;
+                // roots that can't be converted are left for the audit to fetch again
+                if(pcursor->GetValue(legacyRoot) && legacyRoot.vchBlockHash.size() == 32 && legacyRoot.vchPrevHash.size() == 32 &&
+                    ParseLegacyRoot(legacyRoot.vchTxRoot, txRoot.hashTxRoot) && ParseLegacyRoot(legacyRoot.vchReceiptRoot, txRoot.hashReceiptRoot)) {
+                    txRoot.hashBlock = uint256(legacyRoot.vchBlockHash);
+                    txRoot.hashPrevBlock = uint256(legacyRoot.vchPrevHash);
+                    txRoot.nTimestamp = legacyRoot.nTimestamp;
+                    mapTxRoots.try_emplace(nKey, txRoot);
+                } else {
+                    LogPrint(BCLog::SYS, "%s: dropping unreadable legacy ethereum tx root at height %d\n", __func__, nKey);
+                    nDropped++;
                 }
-                else if(nKey > fNewGethCurrentHeight)
-                    fNewGethCurrentHeight = nKey;
+                if(vecLegacyKeys.size() >= 10000 && !flush())
+                    return false;
             }
             pcursor->Next();
         }
@@ -1018,134 +1431,166 @@ bool CEthereumTxRootsDB::PruneTxRoots(const uint32_t &fNewGethSyncHeight) {
             return error("%s() : deserialize error", __PRETTY_FUNCTION__);
         }
     }
-
-    fGethSyncHeight = fNewGethSyncHeight;
-    fGethCurrentHeight = fNewGethCurrentHeight;   
-    return FlushErase(vecHeightKeys);
-}
-
-bool CEthereumTxRootsDB::Init() {
-    return PruneTxRoots(0);
+    if(!vecLegacyKeys.empty() && !flush())
+        return false;
+    if(nMigrated > 0)
+        LogPrintf("Migrated %d ethereum tx roots to the bucketed format\n", nMigrated);
+    if(nDropped > 0)
+        LogPrintf("Dropped %d legacy ethereum tx roots that could not be converted, they are fetched again by the audit\n", nDropped);
+    return true;
 }
 
-bool CEthereumTxRootsDB::Clear() {
-    LOCK(cs_setethstatus);
-    std::vector<uint32_t> vecHeightKeys;
-    uint32_t nKey = 0;
+bool CEthereumTxRootsDB::LoadPresentRanges() {
+    mapPresentRanges.clear();
+    setBrokenLinks.clear();
     std::unique_ptr<CDBIterator> pcursor(NewIterator());
-    pcursor->SeekToFirst();
+    pcursor->Seek(EthereumTxRootKey(0));
+    EthereumTxRootKey key;
+    EthereumTxRootBucket bucket;
+    bool fHavePrev = false;
+    uint32_t nPrevHeight = 0;
+    uint256 hashPrevBlock;
+    // buckets come in height order so ranges only ever grow at the end
     while (pcursor->Valid()) {
         try {
-            if(pcursor->GetKey(nKey)) {
-                vecHeightKeys.push_back(nKey);
-            }
+            if(!pcursor->GetKey(key))
+                break;
+            if(!pcursor->GetValue(bucket))
+                return error("%s() : failed to read ethereum tx roots bucket %d", __PRETTY_FUNCTION__, key.nBucket);
+            bucket.ForEach([&](const uint32_t &nOffset, const EthereumTxRoot &txRoot) {
+                const uint32_t nHeight = key.nBucket * ETHEREUM_TX_ROOTS_BUCKET_SIZE + nOffset;
+                if(fHavePrev && nPrevHeight + 1 == nHeight) {
+                    mapPresentRanges.rbegin()->second = nHeight;
+                    if(txRoot.hashPrevBlock != hashPrevBlock)
+                        setBrokenLinks.insert(nHeight);
+                } else {
+                    mapPresentRanges.emplace_hint(mapPresentRanges.end(), nHeight, nHeight);
+                }
+                fHavePrev = true;
+                nPrevHeight = nHeight;
+                hashPrevBlock = txRoot.hashBlock;
+            });
             pcursor->Next();
         }
         catch (std::exception &e) {
             return error("%s() : deserialize error", __PRETTY_FUNCTION__);
         }
     }
+    return true;
+}
+
+bool CEthereumTxRootsDB::Init() {
+    LOCK(cs_setethstatus);
+    if(!MigrateLegacyRoots() || !LoadPresentRanges())
+        return false;
+    return PruneTxRoots(0);
+}
+
+bool CEthereumTxRootsDB::Clear() {
+    LOCK(cs_setethstatus);
+    if(!EraseRange(0, std::numeric_limits<uint32_t>::max()))
+        return false;
     fGethSyncHeight = 0;
-    fGethCurrentHeight = 0;   
-    return FlushErase(vecHeightKeys);
+    fGethCurrentHeight = 0;
+    return true;
 }
 
 void CEthereumTxRootsDB::AuditTxRootDB(std::vector<std::pair<uint32_t, uint32_t> > &vecMissingBlockRanges){
     LOCK(cs_setethstatus);
-    std::unique_ptr<CDBIterator> pcursor(NewIterator());
-    pcursor->SeekToFirst();
-    std::vector<uint32_t> vecHeightKeys;
-    uint32_t nKey = 0;
-    uint32_t nKeyIndex = 0;
-    uint32_t nCurrentSyncHeight = 0;
-    nCurrentSyncHeight = fGethSyncHeight;
+    const uint32_t nCurrentSyncHeight = fGethSyncHeight;
 
     uint32_t nKeyCutoff = nCurrentSyncHeight - DOWNLOAD_ETHEREUM_TX_ROOTS;
     if(nCurrentSyncHeight < DOWNLOAD_ETHEREUM_TX_ROOTS)
         nKeyCutoff = 0;
-    std::vector<unsigned char> txPos;
-    std::map<uint32_t, EthereumTxRoot> mapTxRoots;
-    // sort keys numerically
-    while (pcursor->Valid()) {
-        try {
-            if(!pcursor->GetKey(nKey)) {
-                pcursor->Next();
-                continue;
-            }
-            EthereumTxRoot txRoot;
-            pcursor->GetValue(txRoot);
-            mapTxRoots.try_emplace(std::move(nKey), std::move(txRoot));        
-            pcursor->Next();
-        }
-        catch (std::exception &e) {
-            LogPrintf("AuditTxRootDB exception: %s\n", e.what()); 
-            return;
-        }
-    }
-    if(mapTxRoots.size() < 2) {
+    if(mapPresentRanges.empty() || (mapPresentRanges.size() == 1 && mapPresentRanges.begin()->first == mapPresentRanges.begin()->second)) {
         vecMissingBlockRanges.emplace_back(std::make_pair(nKeyCutoff, nCurrentSyncHeight));
         return;
     }
-    auto setIt = mapTxRoots.begin();
-    nKeyIndex = setIt->first;
-    setIt++;
+    const uint32_t nFirstKey = mapPresentRanges.begin()->first;
     // we should have at least DOWNLOAD_ETHEREUM_TX_ROOTS roots available from the tip for consensus checks
-    if(nCurrentSyncHeight >= DOWNLOAD_ETHEREUM_TX_ROOTS && nKeyIndex > nKeyCutoff) {
-        vecMissingBlockRanges.emplace_back(std::make_pair(nKeyCutoff, nKeyIndex-1));
+    if(nCurrentSyncHeight >= DOWNLOAD_ETHEREUM_TX_ROOTS && nFirstKey > nKeyCutoff) {
+        vecMissingBlockRanges.emplace_back(std::make_pair(nKeyCutoff, nFirstKey-1));
     }
-    std::vector<unsigned char> vchPrevHash;
     std::vector<uint32_t> vecRemoveKeys;
-    // find sequence gaps in sorted key set 
-    for (; setIt != mapTxRoots.end(); ++setIt) {
-            const uint32_t &key = setIt->first;
-            const uint32_t &nNextKeyIndex = nKeyIndex+1;
-            if (key != nNextKeyIndex && (key-1) >= nNextKeyIndex)
-                vecMissingBlockRanges.emplace_back(std::make_pair(nNextKeyIndex, key-1));
-            // if continuous index we want to ensure hash chain is also continuous
-            else {
-                // if prevhash of prev txroot != hash of this tx root then request inconsistent roots again
-                const EthereumTxRoot &txRoot = setIt->second;
-                auto prevRootPair = std::prev(setIt);
-                const EthereumTxRoot &txRootPrev = prevRootPair->second;
-                if(txRoot.vchPrevHash != txRootPrev.vchBlockHash){
-                    // get a range of -50 to +50 around effected tx root to minimize chance that you will be requesting 1 root at a time in a long range fork
-                    // this is fine because relayer fetches hundreds headers at a time anyway
-                    vecMissingBlockRanges.emplace_back(std::make_pair(std::max(0,(int32_t)key-50), std::min((int32_t)key+50, (int32_t)nCurrentSyncHeight)));
-                    vecRemoveKeys.push_back(key);
-                }
-            }
-            nKeyIndex = key;   
-    } 
+    auto itBroken = setBrokenLinks.begin();
+    // report in height order the inconsistent hash chains within each present range, then the gap that follows it
+    for (auto it = mapPresentRanges.begin(); it != mapPresentRanges.end(); ++it) {
+        for (; itBroken != setBrokenLinks.end() && *itBroken <= it->second; ++itBroken) {
+            const uint32_t &key = *itBroken;
+            // get a range of -50 to +50 around effected tx root to minimize chance that you will be requesting 1 root at a time in a long range fork
+            // this is fine because relayer fetches hundreds headers at a time anyway
+            vecMissingBlockRanges.emplace_back(std::make_pair(std::max(0,(int32_t)key-50), std::min((int32_t)key+50, (int32_t)nCurrentSyncHeight)));
+            vecRemoveKeys.push_back(key);
+        }
+        auto itNext = std::next(it);
+        if (itNext != mapPresentRanges.end())
+            vecMissingBlockRanges.emplace_back(std::make_pair(it->second+1, itNext->first-1));
+    }
     if(!vecRemoveKeys.empty()) {
         LogPrint(BCLog::SYS, "Detected an %d inconsistent hash chains in Ethereum headers, removing...\n", vecRemoveKeys.size());
-        pethereumtxrootsdb->FlushErase(vecRemoveKeys);
+        FlushErase(vecRemoveKeys);
     }
 }
+
 bool CEthereumTxRootsDB::FlushErase(const std::vector<uint32_t> &vecHeightKeys) {
     if(vecHeightKeys.empty())
         return true;
+    LOCK(cs_setethstatus);
     const uint32_t &nFirst = vecHeightKeys.front();
     const uint32_t &nLast = vecHeightKeys.back();
-    CDBBatch batch(*this);
+    std::map<uint32_t, EthereumTxRootBucket> mapBuckets;
     for (const auto &key : vecHeightKeys) {
-        batch.Erase(key);
+        LoadBucket(mapBuckets, key).Erase(key % ETHEREUM_TX_ROOTS_BUCKET_SIZE);
+    }
+    CDBBatch batch(*this);
+    for (const auto &[nBucket, bucket] : mapBuckets) {
+        if (bucket.IsEmpty())
+            batch.Erase(EthereumTxRootKey(nBucket));
+        else
+            batch.Write(EthereumTxRootKey(nBucket), bucket);
     }
     LogPrint(BCLog::SYS, "Flushing, erasing %d ethereum tx roots, block range (%d-%d)\n", vecHeightKeys.size(), nFirst, nLast);
-    return WriteBatch(batch);
+    if (!WriteBatch(batch))
+        return false;
+    UncacheBuckets(mapBuckets);
+    for (const auto &key : vecHeightKeys) {
+        RemovePresent(key, key);
+        setBrokenLinks.erase(key);
+        // the height above no longer continues a present height
+        setBrokenLinks.erase(key + 1);
+    }
+    return true;
 }
 
 bool CEthereumTxRootsDB::FlushWrite(const EthereumTxRootMap &mapTxRoots) {
     if(mapTxRoots.empty())
         return true;
+    LOCK(cs_setethstatus);
     const uint32_t &nFirst = mapTxRoots.begin()->first;
     uint32_t nLast = nFirst;
-    CDBBatch batch(*this);
+    std::map<uint32_t, EthereumTxRootBucket> mapBuckets;
     for (const auto &key : mapTxRoots) {
-        batch.Write(key.first, key.second);
+        LoadBucket(mapBuckets, key.first).Set(key.first % ETHEREUM_TX_ROOTS_BUCKET_SIZE, key.second);
         nLast = key.first;
     }
+    CDBBatch batch(*this);
+    for (const auto &[nBucket, bucket] : mapBuckets) {
+        batch.Write(EthereumTxRootKey(nBucket), bucket);
+    }
     LogPrint(BCLog::SYS, "Flushing, writing %d ethereum tx roots, block range (%d-%d)\n", mapTxRoots.size(), nFirst, nLast);
-    return WriteBatch(batch);
+    if (!WriteBatch(batch))
+        return false;
+    UncacheBuckets(mapBuckets);
+    for (const auto &key : mapTxRoots) {
+        AddPresent(key.first);
+    }
+    // a written root may fix or break the hash chain to the heights below and above it
+    for (const auto &key : mapTxRoots) {
+        UpdateLink(mapBuckets, key.first);
+        if (key.first < std::numeric_limits<uint32_t>::max())
+            UpdateLink(mapBuckets, key.first + 1);
+    }
+    return true;
 }
 
 // called on connect
@@ -1173,12 +1618,57 @@ bool CEthereumMintedTxDB::FlushErase(const EthereumMintTxMap &mapMintKeys) {
 }
 
 
+bool CAssetDB::EraseAsset(const uint32_t& nBaseAsset) {
+    LOCK(cs_assetcache);
+    assetCache.erase(nBaseAsset);
+    notaryKeyIDCache.erase(nBaseAsset);
+    return Erase(nBaseAsset);
+}
+
+bool CAssetDB::ReadAsset(const uint32_t& nBaseAsset, CAsset& asset) {
+    // hold the lock across the disk read so a concurrent Flush() cannot be overwritten by a stale entry
+    LOCK(cs_assetcache);
+    CDataStream ssValue(SER_DISK, CLIENT_VERSION);
+    if(!assetCache.get(nBaseAsset, ssValue)) {
+        if(!ReadDataStream(nBaseAsset, ssValue)) {
+            return false;
+        }
+        assetCache.insert(nBaseAsset, ssValue);
+    }
+    try {
+        ssValue >> asset;
+    } catch (const std::exception&) {
+        assetCache.erase(nBaseAsset);
+        return false;
+    }
+    return true;
+}
+
+bool CAssetDB::ReadAssetNotaryKeyID(const uint32_t& nBaseAsset, std::vector<unsigned char>& keyID) {
+    LOCK(cs_assetcache);
+    if(notaryKeyIDCache.get(nBaseAsset, keyID)) {
+        return !keyID.empty();
+    }
+    const auto& pair = std::make_pair(nBaseAsset, true);
+    if(!Exists(pair) || !Read(pair, keyID)) {
+        keyID.clear();
+        // only remember assets without a notary if the asset itself exists
+        if(Exists(nBaseAsset)) {
+            notaryKeyIDCache.insert(nBaseAsset, keyID);
+        }
+        return false;
+    }
+    notaryKeyIDCache.insert(nBaseAsset, keyID);
+    return true;
+}
+
 bool CAssetDB::Flush(const AssetMap &mapAssets) {
     if(mapAssets.empty()) {
         return true;
 	}
 	int write = 0;
 	int erase = 0;
+    LOCK(cs_assetcache);
     CDBBatch batch(*this);
     for (const auto &key : mapAssets) {
 		if (key.second.IsNull()) {
@@ -1200,17 +1690,39 @@ bool CAssetDB::Flush(const AssetMap &mapAssets) {
 		}
     }
     LogPrint(BCLog::SYS, "Flushing %d assets (erased %d, written %d)\n", mapAssets.size(), erase, write);
-    return WriteBatch(batch);
+    if(!WriteBatch(batch)) {
+        // disk state is unknown, make sure the next lookups go back to the db
+        for (const auto &key : mapAssets) {
+            assetCache.erase(key.first);
+            notaryKeyIDCache.erase(key.first);
+        }
+        return false;
+    }
+    // keep the in-memory view consistent with what was just written so the next block is served from memory
+    for (const auto &key : mapAssets) {
+        if (key.second.IsNull()) {
+            assetCache.erase(key.first);
+            notaryKeyIDCache.erase(key.first);
+        } else {
+            CDataStream ssValue(SER_DISK, CLIENT_VERSION);
+            ssValue << key.second;
+            assetCache.insert(key.first, ssValue);
+            notaryKeyIDCache.insert(key.first, key.second.vchNotaryKeyID);
+        }
+    }
+    return true;
 }
 
-CEthereumTxRootsDB::CEthereumTxRootsDB(size_t nCacheSize, bool fMemory, bool fWipe) : CDBWrapper(GetDataDir() / "ethereumtxroots", nCacheSize, fMemory, fWipe) {
+CEthereumTxRootsDB::CEthereumTxRootsDB(size_t nCacheSize, bool fMemory, bool fWipe) : CDBWrapper(GetDataDir() / "ethereumtxroots", nCacheSize, fMemory, fWipe),
+    bucketCache(ETHEREUM_TX_ROOTS_BUCKET_CACHE_SIZE) {
     Init();
 }
 
 CEthereumMintedTxDB::CEthereumMintedTxDB(size_t nCacheSize, bool fMemory, bool fWipe) : CDBWrapper(GetDataDir() / "ethereumminttx", nCacheSize, fMemory, fWipe) {
 }
 
-CAssetDB::CAssetDB(size_t nCacheSize, bool fMemory, bool fWipe) : CDBWrapper(GetDataDir() / "asset", nCacheSize, fMemory, fWipe) {
+CAssetDB::CAssetDB(size_t nCacheSize, bool fMemory, bool fWipe, size_t nAssetCacheSize) : CDBWrapper(GetDataDir() / "asset", nCacheSize, fMemory, fWipe),
+    assetCache(nAssetCacheSize), notaryKeyIDCache(nAssetCacheSize) {
 }
 
 CAssetOldDB::CAssetOldDB(size_t nCacheSize, bool fMemory, bool fWipe) : CDBWrapper(GetDataDir() / "assets", nCacheSize, fMemory, fWipe) {
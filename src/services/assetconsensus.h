@@ -6,29 +6,61 @@
 #define SYSCOIN_SERVICES_ASSETCONSENSUS_H
 #include <primitives/transaction.h>
 #include <dbwrapper.h>
+#include <sync.h>
+#include <unordered_lru_cache.h>
+#include <map>
+#include <memory>
+#include <set>
 class TxValidationState;
 class CCoinsViewCache;
 class CTxUndo;
 class EthereumTxRoot {
     public:
-    std::vector<unsigned char> vchBlockHash;
-    std::vector<unsigned char> vchPrevHash;
-    std::vector<unsigned char> vchTxRoot;
-    std::vector<unsigned char> vchReceiptRoot;
-    int64_t nTimestamp;
-    
+    uint256 hashBlock;
+    uint256 hashPrevBlock;
+    // roots are kept without the RLP string header (0xa0) mint proofs carry them with
+    uint256 hashTxRoot;
+    uint256 hashReceiptRoot;
+    int64_t nTimestamp{0};
+
     SERIALIZE_METHODS(EthereumTxRoot, obj)
     {
-        READWRITE(obj.vchBlockHash, obj.vchPrevHash, obj.vchTxRoot, obj.vchReceiptRoot, obj.nTimestamp);
+        READWRITE(obj.hashBlock, obj.hashPrevBlock, obj.hashTxRoot, obj.hashReceiptRoot, obj.nTimestamp);
     }
 };
+/** True if vchRLPRoot is root RLP encoded as in a mint proof (0xa0 followed by the 32 bytes of the root) */
+bool EthereumRootMatches(const uint256& root, const std::vector<unsigned char> &vchRLPRoot);
 typedef std::unordered_map<uint32_t, EthereumTxRoot> EthereumTxRootMap;
+// number of consecutive Ethereum heights stored in one record of the tx roots db
+static const uint32_t ETHEREUM_TX_ROOTS_BUCKET_SIZE = 1024;
+// number of decoded buckets ReadTxRoots keeps in memory, mint proofs of a block mostly reference recent heights
+static const size_t ETHEREUM_TX_ROOTS_BUCKET_CACHE_SIZE = 8;
+class EthereumTxRootBucket;
+extern RecursiveMutex cs_setethstatus;
 class CEthereumTxRootsDB : public CDBWrapper {
+private:
+    Mutex cs_bucketcache;
+    // buckets are immutable once cached, writers drop the buckets they change
+    unordered_lru_cache<uint32_t, std::shared_ptr<const EthereumTxRootBucket>, std::hash<uint32_t> > bucketCache GUARDED_BY(cs_bucketcache);
+    // bumped by every write so a bucket read from disk while a flush is in progress is not cached
+    uint64_t nBucketCacheEpoch GUARDED_BY(cs_bucketcache){0};
+    // heights present in the db as inclusive [first, last] ranges keyed by first, so gaps are found without reading the db
+    std::map<uint32_t, uint32_t> mapPresentRanges GUARDED_BY(cs_setethstatus);
+    // present heights whose previous block hash is not the block hash stored at the height below
+    std::set<uint32_t> setBrokenLinks GUARDED_BY(cs_setethstatus);
+    bool IsPresent(const uint32_t &nHeight) const EXCLUSIVE_LOCKS_REQUIRED(cs_setethstatus);
+    void AddPresent(const uint32_t &nHeight) EXCLUSIVE_LOCKS_REQUIRED(cs_setethstatus);
+    void RemovePresent(const uint32_t &nFirst, const uint32_t &nLast) EXCLUSIVE_LOCKS_REQUIRED(cs_setethstatus);
+    EthereumTxRootBucket& LoadBucket(std::map<uint32_t, EthereumTxRootBucket> &mapBuckets, const uint32_t &nHeight);
+    void UpdateLink(std::map<uint32_t, EthereumTxRootBucket> &mapBuckets, const uint32_t &nHeight) EXCLUSIVE_LOCKS_REQUIRED(cs_setethstatus);
+    template <typename Buckets>
+    void UncacheBuckets(const Buckets &buckets);
+    bool EraseRange(const uint32_t &nFirst, const uint32_t &nLast) EXCLUSIVE_LOCKS_REQUIRED(cs_setethstatus);
+    bool MigrateLegacyRoots();
+    bool LoadPresentRanges() EXCLUSIVE_LOCKS_REQUIRED(cs_setethstatus);
 public:
     explicit CEthereumTxRootsDB(size_t nCacheSize, bool fMemory = false, bool fWipe = false);
-    bool ReadTxRoots(const uint32_t& nHeight, EthereumTxRoot& txRoot) {
-        return Read(nHeight, txRoot);
-    } 
+    bool ReadTxRoots(const uint32_t& nHeight, EthereumTxRoot& txRoot);
     void AuditTxRootDB(std::vector<std::pair<uint32_t, uint32_t> > &vecMissingBlockRanges);
     bool Init();
     bool Clear();
@@ -44,19 +76,21 @@ public:
     bool FlushWrite(const EthereumMintTxMap &mapMintKeys);
 };
 
+// number of assets (and notary key ids) kept in memory in front of the asset db
+static const size_t DEFAULT_ASSET_CACHE_SIZE = 10000;
 class CAssetDB : public CDBWrapper {
+private:
+    Mutex cs_assetcache;
+    // hot assets are served from here in their on-disk serialization (CAsset is move-only),
+    // entries are kept in sync with disk on every Flush()
+    unordered_lru_cache<uint32_t, CDataStream, std::hash<uint32_t> > assetCache GUARDED_BY(cs_assetcache);
+    // empty keyID means the asset exists but has no notary, absence from db is not cached
+    unordered_lru_cache<uint32_t, std::vector<unsigned char>, std::hash<uint32_t> > notaryKeyIDCache GUARDED_BY(cs_assetcache);
 public:
-    explicit CAssetDB(size_t nCacheSize, bool fMemory = false, bool fWipe = false);
-    bool EraseAsset(const uint32_t& nBaseAsset) {
-        return Erase(nBaseAsset);
-    }   
-    bool ReadAsset(const uint32_t& nBaseAsset, CAsset& asset) {
-        return Read(nBaseAsset, asset);
-    } 
-    bool ReadAssetNotaryKeyID(const uint32_t& nBaseAsset, std::vector<unsigned char>& keyID) {
-        const auto& pair = std::make_pair(nBaseAsset, true);
-        return Exists(pair) && Read(pair, keyID);
-    }  
+    explicit CAssetDB(size_t nCacheSize, bool fMemory = false, bool fWipe = false, size_t nAssetCacheSize = DEFAULT_ASSET_CACHE_SIZE);
+    bool EraseAsset(const uint32_t& nBaseAsset);
+    bool ReadAsset(const uint32_t& nBaseAsset, CAsset& asset);
+    bool ReadAssetNotaryKeyID(const uint32_t& nBaseAsset, std::vector<unsigned char>& keyID);
     bool Flush(const AssetMap &mapAssets);
 };
 class CAssetOldDB : public CDBWrapper {
@@ -64,6 +98,14 @@ public:
     explicit CAssetOldDB(size_t nCacheSize, bool fMemory = false, bool fWipe = false);
     bool Empty();
 };
+// bytes reserved for the verified mint proof cache
+static const size_t MINT_PROOF_CACHE_SIZE = 1 << 20;
+/** Initializes the verified mint proof cache */
+void InitMintProofCache();
+/** The entry is bound to the mint tx, the Ethereum block and both roots the proofs were verified against */
+void ComputeMintProofCacheEntry(uint256& entry, const uint256& txHash, const uint32_t nBlockNumber, const std::vector<unsigned char> &vchTxRoot, const std::vector<unsigned char> &vchReceiptRoot);
+bool MintProofCacheContains(const uint256& entry, const bool erase);
+void MintProofCacheInsert(const uint256& entry);
 extern std::unique_ptr<CAssetDB> passetdb;
 extern std::unique_ptr<CEthereumTxRootsDB> pethereumtxrootsdb;
 extern std::unique_ptr<CEthereumMintedTxDB> pethereumtxmintdb;
@@ -72,10 +114,58 @@ bool DisconnectAssetSend(const CTransaction &tx, const uint256& txHash, const CT
 bool DisconnectAssetUpdate(const CTransaction &tx, const uint256& txHash, AssetMap &mapAssets);
 bool DisconnectMintAsset(const CTransaction &tx, const uint256& txHash, EthereumMintTxMap &mapMintKeys);
 bool DisconnectSyscoinTransaction(const CTransaction& tx, const uint256& txHash, const CTxUndo& txundo, CCoinsViewCache& view, AssetMap &mapAssets, EthereumMintTxMap &mapMintKeys);
-bool CheckSyscoinMint(const bool &ibd, const CTransaction& tx, const uint256& txHash, TxValidationState &tstate, const bool &fJustCheck, const bool& bSanityCheck, const int& nHeight, const int64_t& nTime, const uint256& blockhash, EthereumMintTxMap &mapMintKeys);
+bool CheckSyscoinMint(const bool &ibd, const CTransaction& tx, const uint256& txHash, TxValidationState &tstate, const bool &fJustCheck, const bool& bSanityCheck, const int& nHeight, const int64_t& nTime, const uint256& blockhash, EthereumMintTxMap &mapMintKeys, const CAssetsMap &mapAssetIn, const CAssetsMap &mapAssetOut);
+bool CheckSyscoinMintProof(const CTransaction& tx, const uint256& txHash, TxValidationState &tstate, const bool &fJustCheck, const bool& bSanityCheck, const int& nHeight, const int64_t& nTime, const uint256& blockhash, const CAssetsMap &mapAssetIn, const CAssetsMap &mapAssetOut);
+bool CheckSyscoinMintKeys(const CTransaction& tx, const uint256& txHash, TxValidationState &tstate, const bool& bSanityCheck, EthereumMintTxMap &mapMintKeys);
 bool CheckAssetInputs(const CTransaction &tx, const uint256& txHash, TxValidationState &tstate, const bool &fJustCheck, const int &nHeight, const uint256& blockhash, AssetMap &mapAssets, const bool &bSanityCheck, const CAssetsMap &mapAssetIn, const CAssetsMap &mapAssetOut);
 bool CheckSyscoinInputs(const CTransaction& tx, const uint256& txHash, TxValidationState &tstate, const int &nHeight, const int64_t& nTime, EthereumMintTxMap &mapMintKeys, const bool &bSanityCheck, const CAssetsMap& mapAssetIn, const CAssetsMap& mapAssetOut);
 bool CheckSyscoinInputs(const bool &ibd, const CTransaction& tx,  const uint256& txHash, TxValidationState &tstate, const bool &fJustCheck, const int &nHeight, const int64_t& nTime, const uint256 & blockHash, const bool &bSanityCheck, AssetMap &mapAssets, EthereumMintTxMap &mapMintKeys, const CAssetsMap& mapAssetIn, const CAssetsMap& mapAssetOut);
 bool CheckAssetAllocationInputs(const CTransaction &tx, const uint256& txHash, TxValidationState &tstate, const bool &fJustCheck, const int &nHeight, const uint256& blockhash, const bool &bSanityCheck, const CAssetsMap &mapAssetIn, const CAssetsMap &mapAssetOut);
 uint256 GetNotarySigHash(const CTransaction &tx, const CAssetOut &vecOut);
+/**
+ * Closure representing the stateless part of the Syscoin consensus checks of one transaction
+ * (mint SPV proofs, allocation notary signatures and burn amounts). Anything touching AssetMap or
+ * EthereumMintTxMap stays on the caller's thread, so these can run on a CCheckQueue alongside script checks.
+ */
+class CSyscoinCheck
+{
+private:
+    const CTransaction *ptxTo;
+    uint256 txHash;
+    int nHeight;
+    int64_t nTime;
+    uint256 blockHash;
+    bool fJustCheck;
+    bool bSanityCheck;
+    CAssetsMap mapAssetIn;
+    CAssetsMap mapAssetOut;
+    // owned by the caller, one slot per transaction so failures can be reported after the queue finished
+    TxValidationState *pstate;
+
+public:
+    CSyscoinCheck(): ptxTo(nullptr), nHeight(0), nTime(0), fJustCheck(false), bSanityCheck(false), pstate(nullptr) {}
+    CSyscoinCheck(const CTransaction& txToIn, const uint256& txHashIn, const int& nHeightIn, const int64_t& nTimeIn, const uint256& blockHashIn, const bool& fJustCheckIn, const bool& bSanityCheckIn,
+        CAssetsMap&& mapAssetInIn, CAssetsMap&& mapAssetOutIn, TxValidationState* pstateIn) :
+        ptxTo(&txToIn), txHash(txHashIn), nHeight(nHeightIn), nTime(nTimeIn), blockHash(blockHashIn), fJustCheck(fJustCheckIn), bSanityCheck(bSanityCheckIn),
+        mapAssetIn(std::move(mapAssetInIn)), mapAssetOut(std::move(mapAssetOutIn)), pstate(pstateIn) { }
+
+    bool operator()();
+
+    void swap(CSyscoinCheck &check) {
+        std::swap(ptxTo, check.ptxTo);
+        std::swap(txHash, check.txHash);
+        std::swap(nHeight, check.nHeight);
+        std::swap(nTime, check.nTime);
+        std::swap(blockHash, check.blockHash);
+        std::swap(fJustCheck, check.fJustCheck);
+        std::swap(bSanityCheck, check.bSanityCheck);
+        mapAssetIn.swap(check.mapAssetIn);
+        mapAssetOut.swap(check.mapAssetOut);
+        std::swap(pstate, check.pstate);
+    }
+};
+/** Whether the consensus checks of this transaction can be split into a CSyscoinCheck */
+inline bool IsSyscoinCheckParallelizable(const int &nVersion) {
+    return IsSyscoinMintTx(nVersion) || IsAssetAllocationTx(nVersion);
+}
 #endif // SYSCOIN_SERVICES_ASSETCONSENSUS_H
@@ -11,8 +11,11 @@
 #include <chainparams.h>
 #include <rpc/server.h>
 #include <thread>
+#include <algorithm>
 #include <policy/rbf.h>
 #include <policy/policy.h>
+#include <index/assetaddressindex.h>
+#include <index/assetindex.h>
 #include <index/txindex.h>
 #include <core_io.h>
 #include <util/system.h>
@@ -45,7 +48,110 @@ bool BuildAssetJson(const CAsset& asset, const uint32_t& nBaseAsset, UniValue& o
 	oAsset.__pushKV("precision", asset.nPrecision);
 	return true;
 }
+static std::vector<unsigned char> ParseContractFilter(const UniValue& value) {
+    std::string strContract = value.get_str();
+    if (strContract.substr(0, 2) == "0x") {
+        strContract = strContract.substr(2);
+    }
+    const std::vector<unsigned char> vchContract = ParseHex(strContract);
+    if (vchContract.size() != MAX_GUID_LENGTH || !IsHex(strContract)) {
+        throw JSONRPCError(RPC_INVALID_PARAMETER, "Invalid contract address");
+    }
+    return vchContract;
+}
+// parse a 32 byte Ethereum hash given in hex with an optional 0x prefix, roots may also carry their RLP header (a0)
+static uint256 ParseEthereumHash(const UniValue& value, bool fRoot) {
+    std::string strHash = value.get_str();
+    if (strHash.substr(0, 2) == "0x") {
+        strHash = strHash.substr(2);
+    }
+    if (fRoot && strHash.size() == 66 && strHash.substr(0, 2) == "a0") {
+        strHash = strHash.substr(2);
+    }
+    if (strHash.size() != 64 || !IsHex(strHash)) {
+        throw JSONRPCError(RPC_INVALID_PARAMS, "Invalid Ethereum block hash or root, should be 32 bytes in hex");
+    }
+    return uint256(ParseHex(strHash));
+}
+static std::vector<unsigned char> ParseNotaryFilter(const UniValue& value) {
+    const CTxDestination txDest = DecodeDestination(value.get_str());
+    const WitnessV0KeyHash* witness_id = std::get_if<WitnessV0KeyHash>(&txDest);
+    if (!witness_id) {
+        throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Invalid notary address: Please use P2WPKH address.");
+    }
+    const CKeyID keyID = ToKeyID(*witness_id);
+    return std::vector<unsigned char>(keyID.begin(), keyID.end());
+}
+// look up the guids matching the symbol, contract and notary_address filters in the asset index
+// returns false if none of these filters are set, otherwise vecGuids is the intersection of the matches in ascending order
+// the index filters cannot be combined with the asset_guid or txid filters of the full scan
+static bool LookupAssetIndex(const UniValue& oOptions, std::vector<uint32_t>& vecGuids) {
+    if (!oOptions.isObject()) {
+        return false;
+    }
+    const UniValue &symbolObj = find_value(oOptions, "symbol");
+    const UniValue &contractObj = find_value(oOptions, "contract");
+    const UniValue &notaryObj = find_value(oOptions, "notary_address");
+    if (!symbolObj.isStr() && !contractObj.isStr() && !notaryObj.isStr()) {
+        return false;
+    }
+    if (!find_value(oOptions, "asset_guid").isNull() || !find_value(oOptions, "txid").isNull()) {
+        throw JSONRPCError(RPC_INVALID_PARAMS, "asset_guid and txid cannot be combined with symbol, contract or notary_address");
+    }
+    if (!g_asset_index) {
+        throw JSONRPCError(RPC_MISC_ERROR, "Filtering by symbol, contract or notary_address requires -assetindex");
+    }
+    g_asset_index->BlockUntilSyncedToCurrentChain();
+    bool bFirst = true;
+    auto intersect = [&](const std::vector<uint32_t>& vecMatches) {
+        if (bFirst) {
+            vecGuids = vecMatches;
+            bFirst = false;
+            return;
+        }
+        std::vector<uint32_t> vecCommon;
+        std::set_intersection(vecGuids.begin(), vecGuids.end(), vecMatches.begin(), vecMatches.end(), std::back_inserter(vecCommon));
+        vecGuids = std::move(vecCommon);
+    };
+    std::vector<uint32_t> vecMatches;
+    if (symbolObj.isStr()) {
+        g_asset_index->FindAssetsBySymbol(symbolObj.get_str(), vecMatches);
+        intersect(vecMatches);
+    }
+    if (contractObj.isStr()) {
+        g_asset_index->FindAssetsByContract(ParseContractFilter(contractObj), vecMatches);
+        intersect(vecMatches);
+    }
+    if (notaryObj.isStr()) {
+        g_asset_index->FindAssetsByNotary(ParseNotaryFilter(notaryObj), vecMatches);
+        intersect(vecMatches);
+    }
+    return true;
+}
 bool ScanAssets(CAssetDB& passetdb, const uint32_t count, const uint32_t from, const UniValue& oOptions, UniValue& oRes) {
+    // served from the asset index without touching the rest of the asset database
+    std::vector<uint32_t> vecGuids;
+    if (LookupAssetIndex(oOptions, vecGuids)) {
+        uint32_t index = 0;
+        for (const uint32_t &nBaseAsset: vecGuids) {
+            CAsset txPos;
+            if (!passetdb.ReadAsset(nBaseAsset, txPos) || txPos.IsNull()) {
+                continue;
+            }
+            index += 1;
+            if (index <= from) {
+                continue;
+            }
+            UniValue oAsset(UniValue::VOBJ);
+            if (BuildAssetJson(txPos, nBaseAsset, oAsset)) {
+                oRes.push_back(oAsset);
+            }
+            if (index >= count + from) {
+                break;
+            }
+        }
+        return true;
+    }
 	std::string strTxid = "";
     uint32_t nBaseAsset = 0;
 	if (!oOptions.isNull()) {
@@ -271,41 +377,9 @@ static RPCHelpMan convertaddress()
 }
 
 int CheckActorsInTransactionGraph(const CTxMemPool& mempool, const uint256& lookForTxHash) {
-    LOCK(cs_main);
+    // the mempool keeps the zdag status of every entry and its ancestors up to date
     LOCK(mempool.cs);
-    {
-        CTxMemPool::setEntries setAncestors;
-        const CTransactionRef &txRef = mempool.get(lookForTxHash);
-        if (!txRef)
-            return ZDAG_NOT_FOUND;
-        if(!IsZdagTx(txRef->nVersion))
-            return ZDAG_WARNING_NOT_ZDAG_TX;
-        // the zdag tx should be under MTU of IP packet
-        if(txRef->GetTotalSize() > MAX_STANDARD_ZDAG_TX_SIZE)
-            return ZDAG_WARNING_SIZE_OVER_POLICY;
-        // check if any inputs are dbl spent, reject if so
-        if(mempool.existsConflicts(*txRef))
-            return ZDAG_MAJOR_CONFLICT;        
-
-        // check this transaction isn't RBF enabled
-        RBFTransactionState rbfState = IsRBFOptIn(*txRef, mempool, setAncestors);
-        if (rbfState == RBFTransactionState::UNKNOWN)
-            return ZDAG_NOT_FOUND;
-        else if (rbfState == RBFTransactionState::REPLACEABLE_BIP125)
-            return ZDAG_WARNING_RBF;
-        for (CTxMemPool::txiter it : setAncestors) {
-            const CTransactionRef& ancestorTxRef = it->GetSharedTx();
-            // should be under MTU of IP packet
-            if(ancestorTxRef->GetTotalSize() > MAX_STANDARD_ZDAG_TX_SIZE)
-                return ZDAG_WARNING_SIZE_OVER_POLICY;
-            // check if any ancestor inputs are dbl spent, reject if so
-            if(mempool.existsConflicts(*ancestorTxRef))
-                return ZDAG_MAJOR_CONFLICT;
-            if(!IsZdagTx(ancestorTxRef->nVersion))
-                return ZDAG_WARNING_NOT_ZDAG_TX;
-        }  
-    }
-    return ZDAG_STATUS_OK;
+    return mempool.GetZDAGStatus(lookForTxHash);
 }
 
 int VerifyTransactionGraph(const CTxMemPool& mempool, const uint256& lookForTxHash) {  
@@ -350,6 +424,53 @@ static RPCHelpMan assetallocationverifyzdag()
     };
 }
 
+static RPCHelpMan assetallocationverifyzdagmany()
+{
+    return RPCHelpMan{"assetallocationverifyzdagmany",
+        "\nShow the Z-DAG status of many transactions at once, see assetallocationverifyzdag for the meaning of the status levels.\n"
+        "All transactions are checked against the same mempool state.\n",
+        {
+            {"txids", RPCArg::Type::ARR, RPCArg::Optional::NO, "The transaction ids of the ZDAG transactions.",
+                {
+                    {"txid", RPCArg::Type::STR_HEX, RPCArg::Optional::OMITTED, "The transaction id"},
+                },
+            },
+        },
+        RPCResult{
+            RPCResult::Type::ARR, "", "",
+            {
+                {RPCResult::Type::OBJ, "", "",
+                {
+                    {RPCResult::Type::STR_HEX, "txid", "The transaction id"},
+                    {RPCResult::Type::NUM, "status", "The status level of the transaction"},
+                }},
+            }},
+        RPCExamples{
+            HelpExampleCli("assetallocationverifyzdagmany", "\"[\\\"txid\\\",...]\"")
+            + HelpExampleRpc("assetallocationverifyzdagmany", "[\"txid\",...]")
+        },
+    [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+{
+    const CTxMemPool& mempool = EnsureAnyMemPool(request.context);
+    const UniValue &txids = request.params[0].get_array();
+    std::vector<uint256> vecTxids;
+    vecTxids.reserve(txids.size());
+    for (size_t i = 0; i < txids.size(); i++) {
+        vecTxids.emplace_back(ParseHashV(txids[i], "txid"));
+    }
+    UniValue oRes(UniValue::VARR);
+    LOCK(mempool.cs);
+    for (const uint256 &txid : vecTxids) {
+        UniValue oAssetAllocationStatus(UniValue::VOBJ);
+        oAssetAllocationStatus.__pushKV("txid", txid.GetHex());
+        oAssetAllocationStatus.__pushKV("status", mempool.GetZDAGStatus(txid));
+        oRes.push_back(oAssetAllocationStatus);
+    }
+    return oRes;
+},
+    };
+}
+
 static RPCHelpMan syscoindecoderawtransaction()
 {
     return RPCHelpMan{"syscoindecoderawtransaction",
@@ -468,6 +589,9 @@ static RPCHelpMan listassets()
             {"options", RPCArg::Type::OBJ, RPCArg::Optional::OMITTED, "A json object with options to filter results.",
                 {
                     {"asset_guid", RPCArg::Type::STR, RPCArg::Optional::OMITTED, "Asset GUID to filter"},
+                    {"symbol", RPCArg::Type::STR, RPCArg::Optional::OMITTED, "Only assets created with this symbol (case-insensitive). Requires -assetindex"},
+                    {"contract", RPCArg::Type::STR_HEX, RPCArg::Optional::OMITTED, "Only assets bridged to this ethereum contract. Requires -assetindex"},
+                    {"notary_address", RPCArg::Type::STR, RPCArg::Optional::OMITTED, "Only assets notarized by this address. Requires -assetindex"},
                 }
                 }
             },
@@ -491,6 +615,7 @@ static RPCHelpMan listassets()
             HelpExampleCli("listassets", "0")
             + HelpExampleCli("listassets", "10 10")
             + HelpExampleCli("listassets", "0 0 '{\"asset_guid\":\"3473733\"}'")
+            + HelpExampleCli("listassets", "0 0 '{\"symbol\":\"TST\"}'")
             + HelpExampleRpc("listassets", "0, 0, '{\"asset_guid\":\"3473733\"}'")
             },
     [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
@@ -519,6 +644,189 @@ static RPCHelpMan listassets()
     };
 }
 
+static RPCHelpMan assetlookup()
+{
+    return RPCHelpMan{"assetlookup",
+        "\nLook up assets by symbol, ethereum contract or notary address using the asset index. Requires -assetindex.\n",
+        {
+            {"type", RPCArg::Type::STR, RPCArg::Optional::NO, "What to look up by: symbol, contract or notary_address"},
+            {"value", RPCArg::Type::STR, RPCArg::Optional::NO, "The symbol (case-insensitive), contract address or notary address"},
+        },
+        RPCResult{
+            RPCResult::Type::ARR, "", "",
+            {
+                {RPCResult::Type::OBJ, "", "",
+                {
+                    {RPCResult::Type::STR, "asset_guid", "The guid of the asset"},
+                    {RPCResult::Type::STR, "symbol", "The asset symbol"},
+                    {RPCResult::Type::STR, "public_value", "The public value attached to this asset"},
+                    {RPCResult::Type::STR_HEX, "contract", "The ethereum contract address"},
+                    {RPCResult::Type::STR, "notary_address", "The notary address, empty if not notarized"},
+                    {RPCResult::Type::OBJ, "notary_details", /* optional */ true, "The notary details, if set",
+                    {
+                        {RPCResult::Type::STR, "endpoint", "Notary API endpoint (if applicable)"},
+                        {RPCResult::Type::BOOL, "instant_transfers", "Enforced double-spend prevention on Notary for Instant Transfers"},
+                        {RPCResult::Type::BOOL, "hd_required", "If Notary requires HD Wallet approval"},
+                    }},
+                    {RPCResult::Type::OBJ, "auxfee", /* optional */ true, "The auxiliary fee structure, if set",
+                    {
+                        {RPCResult::Type::STR, "auxfee_address", "AuxFee address"},
+                        {RPCResult::Type::ARR, "fee_struct", "Auxiliary fee structure",
+                        {
+                            {RPCResult::Type::OBJ, "", "",
+                            {
+                                {RPCResult::Type::STR_AMOUNT, "bound", "Bound (in amount) for the fee level based on total transaction amount"},
+                                {RPCResult::Type::STR, "percentage", "The percentage to share with the operator"},
+                            }},
+                        }},
+                    }},
+                    {RPCResult::Type::STR_AMOUNT, "total_supply", "The total supply of this asset"},
+                    {RPCResult::Type::STR_AMOUNT, "max_supply", "The maximum supply of this asset"},
+                    {RPCResult::Type::NUM, "updatecapability_flags", "The capability flag in decimal"},
+                    {RPCResult::Type::NUM, "precision", "The precision of this asset"},
+                }},
+            }
+        },
+        RPCExamples{
+            HelpExampleCli("assetlookup", "symbol TST")
+            + HelpExampleCli("assetlookup", "contract 0x8d827...")
+            + HelpExampleRpc("assetlookup", "\"symbol\", \"TST\"")
+        },
+    [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+{
+    const std::string &strType = request.params[0].get_str();
+    if (strType != "symbol" && strType != "contract" && strType != "notary_address") {
+        throw JSONRPCError(RPC_INVALID_PARAMETER, "type must be one of symbol, contract or notary_address");
+    }
+    UniValue options(UniValue::VOBJ);
+    options.pushKV(strType, request.params[1].get_str());
+    std::vector<uint32_t> vecGuids;
+    LookupAssetIndex(options, vecGuids);
+    UniValue oRes(UniValue::VARR);
+    for (const uint32_t &nBaseAsset: vecGuids) {
+        CAsset txPos;
+        if (!GetAsset(nBaseAsset, txPos))
+            continue;
+        UniValue oAsset(UniValue::VOBJ);
+        if (BuildAssetJson(txPos, nBaseAsset, oAsset))
+            oRes.push_back(oAsset);
+    }
+    return oRes;
+},
+    };
+}
+
+static RPCHelpMan getaddressbalance()
+{
+    return RPCHelpMan{"getaddressbalance",
+        "\nShow the confirmed Syscoin and asset balances of addresses using the address index. Requires -assetaddressindex.\n",
+        {
+            {"addresses", RPCArg::Type::ARR, RPCArg::Optional::NO, "The syscoin addresses to sum the balances of",
+                {
+                    {"address", RPCArg::Type::STR, RPCArg::Optional::OMITTED, "syscoin address"},
+                },
+            },
+            {"asset_guid", RPCArg::Type::STR, RPCArg::Optional::OMITTED_NAMED_ARG, "Only show the balance of this asset"},
+        },
+        {
+            RPCResult{"if asset_guid is not set",
+                RPCResult::Type::OBJ, "", "",
+                {
+                    {RPCResult::Type::STR_AMOUNT, "amount", "the Syscoin balance of all unspent outputs in " + CURRENCY_UNIT},
+                    {RPCResult::Type::NUM, "count", "the number of unspent outputs"},
+                    {RPCResult::Type::ARR, "assets", "",
+                    {
+                        {RPCResult::Type::OBJ, "", "",
+                        {
+                            {RPCResult::Type::STR, "asset_guid", "The guid of the asset"},
+                            {RPCResult::Type::STR_AMOUNT, "amount", "the Syscoin balance of the asset outputs in " + CURRENCY_UNIT},
+                            {RPCResult::Type::STR_AMOUNT, "asset_amount", "the asset balance"},
+                            {RPCResult::Type::NUM, "count", "the number of unspent asset outputs"},
+                        }},
+                    }},
+                }
+            },
+            RPCResult{"if asset_guid is set",
+                RPCResult::Type::OBJ, "", "",
+                {
+                    {RPCResult::Type::STR_AMOUNT, "amount", "the Syscoin balance of the asset outputs in " + CURRENCY_UNIT},
+                    {RPCResult::Type::STR_AMOUNT, "asset_amount", "the asset balance"},
+                    {RPCResult::Type::NUM, "count", "the number of unspent asset outputs"},
+                }
+            },
+        },
+        RPCExamples{
+            HelpExampleCli("getaddressbalance", "\"[\\\"" + EXAMPLE_ADDRESS[0] + "\\\"]\"")
+            + HelpExampleCli("getaddressbalance", "\"[\\\"" + EXAMPLE_ADDRESS[0] + "\\\"]\" 552723762")
+            + HelpExampleRpc("getaddressbalance", "\"[\\\"" + EXAMPLE_ADDRESS[0] + "\\\"]\", \"552723762\"")
+        },
+    [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+{
+    if (!g_asset_address_index) {
+        throw JSONRPCError(RPC_MISC_ERROR, "Requires -assetaddressindex");
+    }
+    std::set<CScript> setScripts;
+    const UniValue &addresses = request.params[0].get_array();
+    for (size_t i = 0; i < addresses.size(); i++) {
+        const CTxDestination dest = DecodeDestination(addresses[i].get_str());
+        if (!IsValidDestination(dest)) {
+            throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, std::string("Invalid Syscoin address: ") + addresses[i].get_str());
+        }
+        if (!setScripts.insert(GetScriptForDestination(dest)).second) {
+            throw JSONRPCError(RPC_INVALID_PARAMETER, std::string("Invalid parameter, duplicated address: ") + addresses[i].get_str());
+        }
+    }
+    uint64_t nAsset = 0;
+    if (!request.params[1].isNull()) {
+        if(!ParseUInt64(request.params[1].get_str(), &nAsset) || nAsset == 0)
+            throw JSONRPCError(RPC_INVALID_PARAMS, "Could not parse asset_guid");
+    }
+    g_asset_address_index->BlockUntilSyncedToCurrentChain();
+
+    CAddressBalance total;
+    std::map<uint64_t, CAddressBalance> mapAssetTotals;
+    for (const CScript& scriptPubKey: setScripts) {
+        CAddressBalance balance;
+        if (!g_asset_address_index->GetBalance(scriptPubKey, nAsset, balance))
+            throw JSONRPCError(RPC_DATABASE_ERROR, "Failed to read from address index");
+        total.nValue += balance.nValue;
+        total.nAssetValue += balance.nAssetValue;
+        total.nCount += balance.nCount;
+        if (nAsset != 0)
+            continue;
+        std::map<uint64_t, CAddressBalance> mapBalances;
+        if (!g_asset_address_index->GetAssetBalances(scriptPubKey, mapBalances))
+            throw JSONRPCError(RPC_DATABASE_ERROR, "Failed to read from address index");
+        for (const auto& [nAssetKey, assetBalance]: mapBalances) {
+            CAddressBalance& assetTotal = mapAssetTotals[nAssetKey];
+            assetTotal.nValue += assetBalance.nValue;
+            assetTotal.nAssetValue += assetBalance.nAssetValue;
+            assetTotal.nCount += assetBalance.nCount;
+        }
+    }
+    UniValue res(UniValue::VOBJ);
+    res.__pushKV("amount", ValueFromAmount(total.nValue));
+    if (nAsset != 0) {
+        res.__pushKV("asset_amount", ValueFromAmount(total.nAssetValue, GetBaseAssetID(nAsset)));
+        res.__pushKV("count", total.nCount);
+        return res;
+    }
+    res.__pushKV("count", total.nCount);
+    UniValue assets(UniValue::VARR);
+    for (const auto& [nAssetKey, assetTotal]: mapAssetTotals) {
+        UniValue oAsset(UniValue::VOBJ);
+        oAsset.__pushKV("asset_guid", UniValue(nAssetKey).write());
+        oAsset.__pushKV("amount", ValueFromAmount(assetTotal.nValue));
+        oAsset.__pushKV("asset_amount", ValueFromAmount(assetTotal.nAssetValue, GetBaseAssetID(nAssetKey)));
+        oAsset.__pushKV("count", assetTotal.nCount);
+        assets.push_back(oAsset);
+    }
+    res.__pushKV("assets", assets);
+    return res;
+},
+    };
+}
+
 static RPCHelpMan syscoingetspvproof()
 {
     return RPCHelpMan{"syscoingetspvproof",
@@ -777,23 +1085,10 @@ static RPCHelpMan syscoinsetethheaders()
         if(tupleArray.size() != 6)
             throw JSONRPCError(RPC_INVALID_PARAMS, "Invalid size in a Ethereum header input, should be size of 6");
         const uint32_t &nHeight = tupleArray[0].get_uint();
-        std::string blockHash = tupleArray[1].get_str();
-        boost::erase_all(blockHash, "0x");  // strip 0x
-        txRoot.vchBlockHash = ParseHex(blockHash);
-        std::string prevHash = tupleArray[2].get_str();
-        boost::erase_all(prevHash, "0x");  // strip 0x
-        txRoot.vchPrevHash = ParseHex(prevHash);
-        std::string txRootStr = tupleArray[3].get_str();
-        boost::erase_all(txRootStr, "0x");  // strip 0x
-        // add RLP header in case it doesn't already have it
-        if(txRootStr.find("a0") != 0)
-            txRootStr = "a0" + txRootStr;
-        txRoot.vchTxRoot = ParseHex(txRootStr);
-        std::string txReceiptRoot = tupleArray[4].get_str();
-        boost::erase_all(txReceiptRoot, "0x");  // strip 0x
-        if(txReceiptRoot.find("a0") != 0)
-            txReceiptRoot = "a0" + txReceiptRoot;
-        txRoot.vchReceiptRoot = ParseHex(txReceiptRoot);
+        txRoot.hashBlock = ParseEthereumHash(tupleArray[1], false);
+        txRoot.hashPrevBlock = ParseEthereumHash(tupleArray[2], false);
+        txRoot.hashTxRoot = ParseEthereumHash(tupleArray[3], true);
+        txRoot.hashReceiptRoot = ParseEthereumHash(tupleArray[4], true);
         const int64_t &nTimestamp = tupleArray[5].get_int64();
         txRoot.nTimestamp = nTimestamp;
         txRootMap.try_emplace(nHeight, txRoot);
@@ -852,17 +1147,17 @@ static RPCHelpMan syscoingettxroots()
 {
     LOCK(cs_setethstatus);
     uint32_t nHeight = request.params[0].get_uint();
-    std::pair<std::vector<unsigned char>,std::vector<unsigned char>> vchTxRoots;
     EthereumTxRoot txRootDB;
     if(!pethereumtxrootsdb || !pethereumtxrootsdb->ReadTxRoots(nHeight, txRootDB)){
        throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Could not read transaction roots");
     }
       
     UniValue ret(UniValue::VOBJ);  
-    ret.pushKV("blockhash", HexStr(txRootDB.vchBlockHash));
-    ret.pushKV("prevhash", HexStr(txRootDB.vchPrevHash)); 
-    ret.pushKV("txroot", HexStr(txRootDB.vchTxRoot));
-    ret.pushKV("receiptroot", HexStr(txRootDB.vchReceiptRoot));
+    ret.pushKV("blockhash", HexStr(txRootDB.hashBlock));
+    ret.pushKV("prevhash", HexStr(txRootDB.hashPrevBlock));
+    // roots are reported RLP encoded as they appear in mint proofs
+    ret.pushKV("txroot", "a0" + HexStr(txRootDB.hashTxRoot));
+    ret.pushKV("receiptroot", "a0" + HexStr(txRootDB.hashReceiptRoot));
     ret.pushKV("timestamp", txRootDB.nTimestamp);
     
     return ret;
@@ -913,7 +1208,10 @@ static const CRPCCommand commands[] =
     { "syscoin",            &syscoindecoderawtransaction,   },
     { "syscoin",            &assetinfo,                     },
     { "syscoin",            &listassets,                    },
+    { "syscoin",            &assetlookup,                   },
+    { "syscoin",            &getaddressbalance,             },
     { "syscoin",            &assetallocationverifyzdag,     },
+    { "syscoin",            &assetallocationverifyzdagmany, },
     { "syscoin",            &syscoinsetethstatus,           },
     { "syscoin",            &syscoinsetethheaders,          },
     { "syscoin",            &syscoinclearethheaders,        },
@@ -2068,6 +2068,50 @@ static RPCHelpMan listunspentasset()
     };
 }
 
+// sum the coins listunspent would return for these filters, without building and re-parsing its JSON
+static void SumAvailableCoins(const CWallet& wallet, const UniValue& addresses, const int nMinDepth, const int nMaxDepth, const uint64_t nAsset, CAmount& nTotalAmount, CAmount& nAssetTotalAmount) {
+    std::set<CTxDestination> destinations;
+    if (!addresses.isNull()) {
+        const UniValue& inputs = addresses.get_array();
+        for (size_t idx = 0; idx < inputs.size(); idx++) {
+            const CTxDestination dest = DecodeDestination(inputs[idx].get_str());
+            if (!IsValidDestination(dest)) {
+                throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, std::string("Invalid Syscoin address: ") + inputs[idx].get_str());
+            }
+            if (!destinations.insert(dest).second) {
+                throw JSONRPCError(RPC_INVALID_PARAMETER, std::string("Invalid parameter, duplicated address: ") + inputs[idx].get_str());
+            }
+        }
+    }
+    // Make sure the results are valid at least up to the most recent block
+    // the user could have gotten from another RPC command prior to now
+    wallet.BlockUntilSyncedToCurrentChain();
+
+    nTotalAmount = 0;
+    nAssetTotalAmount = 0;
+    std::vector<COutput> vecOutputs;
+    LOCK(wallet.cs_wallet);
+    {
+        CCoinControl cctl;
+        cctl.m_avoid_address_reuse = false;
+        cctl.m_min_depth = nMinDepth;
+        cctl.m_max_depth = nMaxDepth;
+        wallet.AvailableCoins(vecOutputs, false, &cctl, 0, MAX_MONEY, MAX_MONEY, 0, MAX_ASSET, MAX_ASSET, 0, false, CAssetCoinInfo(nAsset, MAX_ASSET));
+    }
+    for (const COutput& out : vecOutputs) {
+        const CTxOut& txOut = out.tx->tx->vout[out.i];
+        if (!destinations.empty()) {
+            CTxDestination address;
+            if (!ExtractDestination(txOut.scriptPubKey, address) || !destinations.count(address))
+                continue;
+        }
+        nTotalAmount += txOut.nValue;
+        if (!txOut.assetInfo.IsNull()) {
+            nAssetTotalAmount += txOut.assetInfo.nValue;
+        }
+    }
+}
+
 static RPCHelpMan addressbalance() {
     return RPCHelpMan{"addressbalance",	
         "\nShow the Syscoin balance of an array of addresses in your wallet.\n",	
@@ -2091,30 +2135,19 @@ static RPCHelpMan addressbalance() {
         },
     [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
 {	
+    std::shared_ptr<CWallet> const pwallet = GetWalletForJSONRPCRequest(request);
+    if (!pwallet) return NullUniValue;
     int nMinDepth = 1;
     if (!request.params[1].isNull()) {
         nMinDepth = request.params[1].get_int();
     }
     int nMaxDepth = 9999999;
     if (!request.params[2].isNull()) {
-        nMaxDepth = request.params[1].get_int();
+        nMaxDepth = request.params[2].get_int();
     }
-    UniValue paramsFund(UniValue::VARR);
-    paramsFund.push_back(nMinDepth);
-    paramsFund.push_back(nMaxDepth);
-    paramsFund.push_back(request.params[0]);
-    JSONRPCRequest requestSpent;
-    requestSpent.context = request.context;
-    requestSpent.params = paramsFund;
-    requestSpent.URI = request.URI;
-    const UniValue &resUTXOs = listunspent().HandleRequest(requestSpent);
     CAmount nTotalAmount = 0;
-    const UniValue &resUTXOArr = resUTXOs.get_array();
-    if(!resUTXOArr.isNull()) {
-        for(size_t i =0;i<resUTXOArr.size();i++) {
-            nTotalAmount += AmountFromValue(find_value(resUTXOArr[i].get_obj(), "amount"));
-        }
-    }
+    CAmount nAssetTotalAmount = 0;
+    SumAvailableCoins(*pwallet, request.params[0], nMinDepth, nMaxDepth, 0, nTotalAmount, nAssetTotalAmount);
     UniValue res(UniValue::VOBJ);
     res.__pushKV("amount", ValueFromAmount(nTotalAmount));
     return res;
@@ -2167,6 +2200,8 @@ static RPCHelpMan assetallocationbalance() {
         },
     [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
 {	
+    std::shared_ptr<CWallet> const pwallet = GetWalletForJSONRPCRequest(request);
+    if (!pwallet) return NullUniValue;
     uint64_t nAsset;
     if(!ParseUInt64(request.params[0].get_str(), &nAsset))
         throw JSONRPCError(RPC_INVALID_PARAMS, "Could not parse asset_guid");
@@ -2192,36 +2227,9 @@ static RPCHelpMan assetallocationbalance() {
     if(fVerbose && !BuildAssetJson(theAsset, nBaseAsset, oAsset))
         throw JSONRPCError(RPC_DATABASE_ERROR, "Failed to create asset JSON");
 
-    bool include_unsafe = true;
-    UniValue paramsFund(UniValue::VARR);
-    UniValue includeSafe(UniValue::VBOOL);
-    includeSafe.setBool(include_unsafe);
-    paramsFund.push_back(nMinDepth);
-    paramsFund.push_back(nMaxDepth);
-    paramsFund.push_back(request.params[1]);
-    paramsFund.push_back(includeSafe);
-    
-    UniValue options(UniValue::VOBJ);
-    options.__pushKV("assetGuid", request.params[0]);
-    paramsFund.push_back(options);
-    JSONRPCRequest requestSpent;
-    requestSpent.context = request.context;
-    requestSpent.params = paramsFund;
-    requestSpent.URI = request.URI;
-    const UniValue &resUTXOs = listunspent().HandleRequest(requestSpent);  
     CAmount nTotalAmount = 0;
     CAmount nAssetTotalAmount = 0;
-    const UniValue &resUTXOArr = resUTXOs.get_array();
-    if(!resUTXOArr.isNull()) {
-        for(size_t i =0;i<resUTXOArr.size();i++) {
-            const UniValue &utxoObj = resUTXOArr[i].get_obj();
-            nTotalAmount += AmountFromValue(find_value(utxoObj, "amount"));
-            const UniValue &assetAmountVal = find_value(utxoObj, "asset_amount");
-            if(!assetAmountVal.isNull()) {
-                nAssetTotalAmount += AssetAmountFromValue(assetAmountVal, theAsset.nPrecision);
-            }
-        }
-    }
+    SumAvailableCoins(*pwallet, request.params[1], nMinDepth, nMaxDepth, nAsset, nTotalAmount, nAssetTotalAmount);
     oAsset.__pushKV("amount", ValueFromAmount(nTotalAmount));
     oAsset.__pushKV("asset_amount", ValueFromAssetAmount(nAssetTotalAmount, theAsset.nPrecision));
     return oAsset;
@@ -4,6 +4,7 @@
 
 #include <bls/bls.h>
 #include <bls/bls_batchverifier.h>
+#include <bls/bls_workerpool.h>
 #include <test/util/setup_common.h>
 
 #include <boost/test/unit_test.hpp>
@@ -154,4 +155,39 @@ BOOST_AUTO_TEST_CASE(batch_verifier_tests)
     Verify(msgs);
 }
 
+
+BOOST_AUTO_TEST_CASE(bls_workerpool_tests)
+{
+    CBLSWorkerPool pool;
+    pool.Start(4);
+
+    // tasks pushed from workers go to their own queues and must be stolen by the other workers
+    std::atomic<int> nDone{0};
+    std::vector<std::future<std::vector<std::future<void>>>> outer;
+    for (int i = 0; i < 16; i++) {
+        outer.emplace_back(pool.push([&](int) {
+            std::vector<std::future<void>> inner;
+            for (int j = 0; j < 64; j++) {
+                inner.emplace_back(pool.push([&](int) { nDone++; }));
+            }
+            return inner;
+        }));
+    }
+    for (auto& f : outer) {
+        for (auto& f2 : f.get()) {
+            f2.get();
+        }
+    }
+    BOOST_CHECK_EQUAL(nDone, 16 * 64);
+
+    int threadId = pool.push([](int threadId) { return threadId; }, CBLSWorkerPool::Priority::HIGH).get();
+    BOOST_CHECK(threadId >= 0 && threadId < 4);
+
+    // tasks pushed before the start run once the workers are started
+    CBLSWorkerPool pool2;
+    auto future = pool2.push([](int) { return 1; });
+    pool2.Start(2);
+    BOOST_CHECK_EQUAL(future.get(), 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -2,15 +2,18 @@
 #include <test/data/ethspv_valid.json.h>
 #include <test/data/ethspv_invalid.json.h>
 
+#include <arith_uint256.h>
 #include <uint256.h>
 #include <util/strencodings.h>
 #include <ethereum/ethereum.h>
 #include <ethereum/common.h>
 #include <ethereum/rlp.h>
+#include <ethereum/sha3.h>
 #include <script/interpreter.h>
 #include <script/standard.h>
 #include <policy/policy.h>
 #include <services/asset.h>
+#include <services/assetconsensus.h>
 #include <univalue.h>
 #include <key_io.h>
 #include <util/system.h>
@@ -35,6 +38,45 @@ BOOST_AUTO_TEST_CASE(ethereum_parseabidata)
 
 }
 
+static std::vector<unsigned char> KeccakTestInput(size_t len)
+{
+    std::vector<unsigned char> in(len);
+    for (size_t i = 0; i < len; i++) {
+        in[i] = i % 256;
+    }
+    return in;
+}
+
+BOOST_AUTO_TEST_CASE(ethereum_keccak256)
+{
+    BOOST_CHECK_EQUAL(dev::sha3(dev::bytesConstRef()).hex(), "c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470");
+    BOOST_CHECK_EQUAL(dev::sha3(std::string("abc")).hex(), "4e03657aea45a94fc7d47ba826c8d667c0d1e6e33a64a036ec44f58fa12d6c45");
+    BOOST_CHECK_EQUAL(dev::sha3(std::string("The quick brown fox jumps over the lazy dog")).hex(), "4d741b6f1eb29cb2a9b9911c82f56fa8d73b04959d3d9d222895df6c0b28aa15");
+    // around the 136 byte rate and a full branch node
+    BOOST_CHECK_EQUAL(dev::sha3(KeccakTestInput(135)).hex(), "cbdfd9dee5faad3818d6b06f95a219fd290b0e1706f6a82e5a595b9ce9faca62");
+    BOOST_CHECK_EQUAL(dev::sha3(KeccakTestInput(136)).hex(), "7ce759f1ab7f9ce437719970c26b0a66ff11fe3e38e17df89cf5d29c7d7f807e");
+    BOOST_CHECK_EQUAL(dev::sha3(KeccakTestInput(137)).hex(), "ac73d4fae68b8453f764007c1a20ce95994187861f0c3227a3a8e99a73a3b1db");
+    BOOST_CHECK_EQUAL(dev::sha3(KeccakTestInput(532)).hex(), "6cec40d944dc321c7811a4768339b0e3a6779b92a33b4b2598731fdb45fcd2a7");
+}
+
+BOOST_AUTO_TEST_CASE(ethereum_keccak256_batch)
+{
+    // batches of mixed lengths hashed together must match hashing them one by one
+    const std::vector<unsigned char> in = KeccakTestInput(1000);
+    for (size_t count = 0; count <= 9; count++) {
+        std::vector<dev::bytesConstRef> inputs;
+        for (size_t i = 0; i < count; i++) {
+            const size_t len = InsecureRandRange(in.size());
+            inputs.emplace_back(in.data() + InsecureRandRange(in.size() - len + 1), len);
+        }
+        std::vector<dev::h256> outputs(count);
+        dev::sha3(inputs.data(), inputs.size(), outputs.data());
+        for (size_t i = 0; i < count; i++) {
+            BOOST_CHECK(outputs[i] == dev::sha3(inputs[i]));
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(ethspv_valid)
 {
     tfm::format(std::cout,"Running ethspv_valid...\n");
@@ -70,6 +112,7 @@ BOOST_AUTO_TEST_CASE(ethspv_valid)
         dev::RLP rlpTxValue(&vchTxValue);
         const std::vector<unsigned char> &vchTxPath = ParseHex(spv_path);
         BOOST_CHECK(VerifyProof(&vchTxPath, rlpTxValue, rlpTxParentNodes, rlpTxRoot));
+        BOOST_CHECK(VerifyProof(vchTxPath, vchTxValue, vchTxParentNodes, vchTxRoot));
         }
     }
 }
@@ -108,7 +151,189 @@ BOOST_AUTO_TEST_CASE(ethspv_invalid)
             dev::RLP rlpTxValue(&vchTxValue);
             const std::vector<unsigned char> &vchTxPath = ParseHex(spv_path);
             BOOST_CHECK(!VerifyProof(&vchTxPath, rlpTxValue, rlpTxParentNodes, rlpTxRoot));
+            BOOST_CHECK(!VerifyProof(vchTxPath, vchTxValue, vchTxParentNodes, vchTxRoot));
         }
     }
 }
+static EthereumTxRoot TxRootAtHeight(uint32_t nHeight)
+{
+    EthereumTxRoot txRoot;
+    txRoot.hashBlock = ArithToUint256(arith_uint256(nHeight));
+    txRoot.hashPrevBlock = ArithToUint256(arith_uint256(nHeight - 1));
+    txRoot.hashTxRoot = txRoot.hashBlock;
+    txRoot.nTimestamp = nHeight;
+    return txRoot;
+}
+
+BOOST_AUTO_TEST_CASE(ethereum_txroots_db)
+{
+    tfm::format(std::cout,"Running ethereum_txroots_db...\n");
+    CEthereumTxRootsDB txRootsDB(1 << 20, true, true);
+    const uint32_t nSyncHeight = 300000;
+    EthereumTxRootMap mapTxRoots;
+    // below the prune cutoff, present ranges across bucket boundaries and above the sync height
+    for (const uint32_t nHeight : {uint32_t{50000}, nSyncHeight, nSyncHeight + 1}) {
+        mapTxRoots.emplace(nHeight, TxRootAtHeight(nHeight));
+    }
+    for (uint32_t nHeight = nSyncHeight - DOWNLOAD_ETHEREUM_TX_ROOTS; nHeight < 242000; nHeight++) {
+        if (nHeight != 241000)
+            mapTxRoots.emplace(nHeight, TxRootAtHeight(nHeight));
+    }
+    // fork within a range
+    mapTxRoots[241500].hashPrevBlock = ArithToUint256(arith_uint256(1));
+    BOOST_CHECK(txRootsDB.FlushWrite(mapTxRoots));
+    BOOST_CHECK(txRootsDB.PruneTxRoots(nSyncHeight));
+
+    EthereumTxRoot txRoot;
+    BOOST_CHECK(!txRootsDB.ReadTxRoots(50000, txRoot));
+    BOOST_CHECK(!txRootsDB.ReadTxRoots(nSyncHeight + 1, txRoot));
+    BOOST_CHECK(!txRootsDB.ReadTxRoots(241000, txRoot));
+    BOOST_CHECK(txRootsDB.ReadTxRoots(240640, txRoot));
+    BOOST_CHECK(txRoot.hashBlock == ArithToUint256(arith_uint256(240640)));
+    BOOST_CHECK_EQUAL(txRoot.nTimestamp, 240640);
+    BOOST_CHECK(EthereumRootMatches(txRoot.hashTxRoot, ParseHex("a0" + HexStr(txRoot.hashBlock))));
+    BOOST_CHECK(!EthereumRootMatches(txRoot.hashTxRoot, std::vector<unsigned char>(txRoot.hashBlock.begin(), txRoot.hashBlock.end())));
+
+    // cached by the read, the audit must drop it from the cache when it erases the fork
+    BOOST_CHECK(txRootsDB.ReadTxRoots(241500, txRoot));
+
+    std::vector<std::pair<uint32_t, uint32_t> > vecMissingBlockRanges;
+    txRootsDB.AuditTxRootDB(vecMissingBlockRanges);
+    const std::vector<std::pair<uint32_t, uint32_t> > vecExpected{{241000, 241000}, {241450, 241550}, {242000, nSyncHeight - 1}};
+    BOOST_CHECK(vecMissingBlockRanges == vecExpected);
+    // the fork is removed by the audit so it gets downloaded again
+    BOOST_CHECK(!txRootsDB.ReadTxRoots(241500, txRoot));
+    mapTxRoots.clear();
+    mapTxRoots.emplace(241000, TxRootAtHeight(241000));
+    mapTxRoots.emplace(241500, TxRootAtHeight(241500));
+    BOOST_CHECK(txRootsDB.FlushWrite(mapTxRoots));
+    vecMissingBlockRanges.clear();
+    txRootsDB.AuditTxRootDB(vecMissingBlockRanges);
+    BOOST_CHECK_EQUAL(vecMissingBlockRanges.size(), 1U);
+    BOOST_CHECK(vecMissingBlockRanges[0] == std::make_pair(uint32_t{242000}, nSyncHeight - 1));
+
+    BOOST_CHECK(txRootsDB.Clear());
+    BOOST_CHECK(!txRootsDB.ReadTxRoots(nSyncHeight, txRoot));
+}
+
+// roots as they were stored before the bucketed format, one record per height keyed by the height
+struct LegacyTxRoot {
+    std::vector<unsigned char> vchBlockHash;
+    std::vector<unsigned char> vchPrevHash;
+    std::vector<unsigned char> vchTxRoot;
+    std::vector<unsigned char> vchReceiptRoot;
+    int64_t nTimestamp;
+
+    SERIALIZE_METHODS(LegacyTxRoot, obj)
+    {
+        READWRITE(obj.vchBlockHash, obj.vchPrevHash, obj.vchTxRoot, obj.vchReceiptRoot, obj.nTimestamp);
+    }
+};
+
+BOOST_AUTO_TEST_CASE(ethereum_txroots_db_migrate)
+{
+    tfm::format(std::cout,"Running ethereum_txroots_db_migrate...\n");
+    CEthereumTxRootsDB txRootsDB(1 << 20, true, true);
+    auto legacyAtHeight = [](uint32_t nHeight, bool fRLPHeader) {
+        const EthereumTxRoot txRoot = TxRootAtHeight(nHeight);
+        LegacyTxRoot legacyRoot;
+        legacyRoot.vchBlockHash = std::vector<unsigned char>(txRoot.hashBlock.begin(), txRoot.hashBlock.end());
+        legacyRoot.vchPrevHash = std::vector<unsigned char>(txRoot.hashPrevBlock.begin(), txRoot.hashPrevBlock.end());
+        legacyRoot.vchTxRoot = legacyRoot.vchBlockHash;
+        if (fRLPHeader)
+            legacyRoot.vchTxRoot.insert(legacyRoot.vchTxRoot.begin(), 0xa0);
+        legacyRoot.vchReceiptRoot = legacyRoot.vchTxRoot;
+        legacyRoot.nTimestamp = nHeight;
+        return legacyRoot;
+    };
+    // both root encodings of the old format, across a bucket boundary
+    BOOST_CHECK(txRootsDB.Write(uint32_t{1023}, legacyAtHeight(1023, true)));
+    BOOST_CHECK(txRootsDB.Write(uint32_t{1024}, legacyAtHeight(1024, false)));
+    // can't be converted, dropped for the audit to fetch again
+    LegacyTxRoot badRoot = legacyAtHeight(1025, true);
+    badRoot.vchTxRoot.resize(20);
+    BOOST_CHECK(txRootsDB.Write(uint32_t{1025}, badRoot));
+    BOOST_CHECK(txRootsDB.Init());
+
+    for (const uint32_t nHeight : {uint32_t{1023}, uint32_t{1024}}) {
+        BOOST_CHECK(!txRootsDB.Exists(nHeight));
+        EthereumTxRoot txRoot;
+        BOOST_CHECK(txRootsDB.ReadTxRoots(nHeight, txRoot));
+        const EthereumTxRoot expected = TxRootAtHeight(nHeight);
+        BOOST_CHECK(txRoot.hashBlock == expected.hashBlock);
+        BOOST_CHECK(txRoot.hashPrevBlock == expected.hashPrevBlock);
+        BOOST_CHECK(txRoot.hashTxRoot == expected.hashBlock);
+        BOOST_CHECK(txRoot.hashReceiptRoot == expected.hashBlock);
+        BOOST_CHECK_EQUAL(txRoot.nTimestamp, nHeight);
+    }
+    EthereumTxRoot txRoot;
+    BOOST_CHECK(!txRootsDB.Exists(uint32_t{1025}));
+    BOOST_CHECK(!txRootsDB.ReadTxRoots(1025, txRoot));
+    // the migrated heights form one present range with a continuous hash chain
+    std::vector<std::pair<uint32_t, uint32_t> > vecMissingBlockRanges;
+    txRootsDB.AuditTxRootDB(vecMissingBlockRanges);
+    BOOST_CHECK(vecMissingBlockRanges.empty() || vecMissingBlockRanges[0].second < 1023);
+    // nothing left to migrate on the next start
+    BOOST_CHECK(txRootsDB.Init());
+    BOOST_CHECK(txRootsDB.ReadTxRoots(1024, txRoot));
+    BOOST_CHECK(txRootsDB.Clear());
+}
+BOOST_AUTO_TEST_CASE(ethereum_mint_proof_cache)
+{
+    tfm::format(std::cout,"Running ethereum_mint_proof_cache...\n");
+    const uint256 txHash = InsecureRand256();
+    const uint32_t nBlockNumber = 241000;
+    const std::vector<unsigned char> vchTxRoot = ParseHex("a0" + HexStr(InsecureRand256()));
+    const std::vector<unsigned char> vchReceiptRoot = ParseHex("a0" + HexStr(InsecureRand256()));
+    uint256 entry;
+    ComputeMintProofCacheEntry(entry, txHash, nBlockNumber, vchTxRoot, vchReceiptRoot);
+
+    // miss before the proof was verified, hit after
+    BOOST_CHECK(!MintProofCacheContains(entry, false));
+    MintProofCacheInsert(entry);
+    BOOST_CHECK(MintProofCacheContains(entry, false));
+
+    // a proof verified for one mint is never used for another tx, Ethereum block or root
+    std::vector<uint256> vecOtherEntries(5);
+    ComputeMintProofCacheEntry(vecOtherEntries[0], InsecureRand256(), nBlockNumber, vchTxRoot, vchReceiptRoot);
+    ComputeMintProofCacheEntry(vecOtherEntries[1], txHash, nBlockNumber + 1, vchTxRoot, vchReceiptRoot);
+    ComputeMintProofCacheEntry(vecOtherEntries[2], txHash, nBlockNumber, vchReceiptRoot, vchReceiptRoot);
+    ComputeMintProofCacheEntry(vecOtherEntries[3], txHash, nBlockNumber, vchTxRoot, vchTxRoot);
+    // moving bytes from one root to the other must not give the same entry
+    std::vector<unsigned char> vchTxRootLonger(vchTxRoot);
+    vchTxRootLonger.push_back(vchReceiptRoot.front());
+    ComputeMintProofCacheEntry(vecOtherEntries[4], txHash, nBlockNumber, vchTxRootLonger, std::vector<unsigned char>(vchReceiptRoot.begin() + 1, vchReceiptRoot.end()));
+    for (const auto& otherEntry : vecOtherEntries) {
+        BOOST_CHECK(otherEntry != entry);
+        BOOST_CHECK(!MintProofCacheContains(otherEntry, false));
+    }
+
+    // the same mint always maps to the same entry, the block connecting it consumes the entry
+    uint256 entry2;
+    ComputeMintProofCacheEntry(entry2, txHash, nBlockNumber, vchTxRoot, vchReceiptRoot);
+    BOOST_CHECK(entry2 == entry);
+    BOOST_CHECK(MintProofCacheContains(entry2, true));
+
+    // entries are evicted once the cache is full
+    std::vector<uint256> vecEntries;
+    for (int i = 0; i < 1000; i++) {
+        uint256 newEntry;
+        ComputeMintProofCacheEntry(newEntry, InsecureRand256(), nBlockNumber, vchTxRoot, vchReceiptRoot);
+        MintProofCacheInsert(newEntry);
+        vecEntries.emplace_back(newEntry);
+    }
+    for (const auto& newEntry : vecEntries) {
+        BOOST_CHECK(MintProofCacheContains(newEntry, false));
+    }
+    const size_t nCapacity = MINT_PROOF_CACHE_SIZE / sizeof(uint256);
+    for (size_t i = 0; i < 4 * nCapacity; i++) {
+        MintProofCacheInsert(InsecureRand256());
+    }
+    size_t nLeft = 0;
+    for (const auto& newEntry : vecEntries) {
+        nLeft += MintProofCacheContains(newEntry, false);
+    }
+    BOOST_CHECK(nLeft < vecEntries.size() / 2);
+    BOOST_CHECK(!MintProofCacheContains(entry, false));
+}
 BOOST_AUTO_TEST_SUITE_END()
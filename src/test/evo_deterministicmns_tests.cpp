@@ -17,6 +17,9 @@
 #include <evo/specialtx.h>
 #include <evo/providertx.h>
 #include <evo/deterministicmns.h>
+#include <evo/evodb.h>
+#include <clientversion.h>
+#include <streams.h>
 #include <boost/test/unit_test.hpp>
 typedef std::vector<std::pair<COutPoint, std::pair<int, CAmount>> > SimpleUTXOVec;
 
@@ -206,6 +209,20 @@ static CDeterministicMNCPtr FindPayoutDmn(const CBlock& block)
     return nullptr;
 }
 
+// a masternode that is only used in lists built by the tests, not registered on chain
+static CDeterministicMNCPtr MakeTestDmn(uint64_t nInternalId, int nRegisteredHeight, FastRandomContext& rng)
+{
+    auto dmn = std::make_shared<CDeterministicMN>(nInternalId);
+    dmn->proTxHash = rng.rand256();
+    dmn->collateralOutpoint = COutPoint(rng.rand256(), 0);
+    auto dmnState = std::make_shared<CDeterministicMNState>();
+    dmnState->nRegisteredHeight = nRegisteredHeight;
+    dmnState->keyIDOwner = CKeyID(uint160(rng.randbytes(20)));
+    dmnState->UpdateConfirmedHash(dmn->proTxHash, rng.rand256());
+    dmn->pdmnState = dmnState;
+    return dmn;
+}
+
 static bool CheckTransactionSignature(const CMutableTransaction& tx)
 {
     for (unsigned int i = 0; i < tx.vin.size(); i++) {
@@ -345,6 +362,20 @@ BOOST_FIXTURE_TEST_CASE(dip3_protx, TestChainDIP3Setup)
             deterministicMNManager->GetListAtChainTip(mnList);
         auto dmnExpectedPayee = mnList.GetMNPayee();
 
+        // the payee schedule moves forward with every block and must match the order of the list, it may hold
+        // fewer entries than were asked for
+        const CBlockIndex* pindexTip = WITH_LOCK(cs_main, return ::ChainActive().Tip());
+        const size_t nCount = mnList.GetValidMNsCount();
+        std::vector<CDeterministicMNCPtr> projectedPayees;
+        std::vector<CDeterministicMNCPtr> scheduledPayees;
+        mnList.GetProjectedMNPayees(nCount, projectedPayees);
+        deterministicMNManager->GetProjectedMNPayees(pindexTip, nCount, scheduledPayees);
+        BOOST_CHECK(!scheduledPayees.empty() && scheduledPayees.size() <= nCount);
+        for (size_t j = 0; j < std::min(nCount, scheduledPayees.size()); j++) {
+            BOOST_CHECK_EQUAL(scheduledPayees[j]->proTxHash.ToString(), projectedPayees[j]->proTxHash.ToString());
+        }
+        BOOST_CHECK_EQUAL(deterministicMNManager->GetMNPayee(pindexTip)->proTxHash.ToString(), dmnExpectedPayee->proTxHash.ToString());
+
         CBlock block = CreateAndProcessBlock({}, GetScriptForRawPubKey(coinbaseKey.GetPubKey()));
         {
             LOCK(cs_main);
@@ -511,4 +542,234 @@ BOOST_FIXTURE_TEST_CASE(dip3_protx, TestChainDIP3Setup)
 
     const_cast<Consensus::Params&>(Params().GetConsensus()).DIP0003EnforcementHeight = DIP0003EnforcementHeightBackup;
 }
+BOOST_FIXTURE_TEST_CASE(dip3_list_replay, TestChainDIP3Setup)
+{
+    // mine past the second daily snapshot after DIP3 activation
+    for (int i = 0; i < 611; i++) {
+        CreateAndProcessBlock({}, GetScriptForRawPubKey(coinbaseKey.GetPubKey()));
+    }
+    const CBlockIndex* pindexTip;
+    {
+        LOCK(cs_main);
+        pindexTip = ::ChainActive().Tip();
+        BOOST_CHECK_EQUAL(pindexTip->nHeight, 1160);
+        // drop the daily snapshots as if the blocks had been connected by an older version
+        for (const int nHeight : {576, 1152}) {
+            const auto key = std::make_pair(std::string("dmn_S"), ::ChainActive()[nHeight]->GetBlockHash());
+            BOOST_CHECK(evoDb->Exists(key));
+            evoDb->Erase(key);
+        }
+    }
+    const int nActivationHeight = Params().GetConsensus().DIP0003Height;
+
+    // a manager with empty caches has to replay every diff since activation
+    CDeterministicMNManager mnManager;
+    CDeterministicMNList mnList;
+    mnManager.GetListForBlock(pindexTip, mnList);
+    BOOST_CHECK(mnList.GetBlockHash() == pindexTip->GetBlockHash());
+    BOOST_CHECK_EQUAL(mnList.GetHeight(), 1160);
+    auto stats = mnManager.GetListStats();
+    BOOST_CHECK_EQUAL(stats.nMaxReplay, uint64_t(1160 - nActivationHeight));
+    // lookups are not on the block connect path, the missing snapshots are only queued
+    BOOST_CHECK_EQUAL(stats.nSnapshotsWritten, 0U);
+    {
+        LOCK(cs_main);
+        BOOST_CHECK(!evoDb->Exists(std::make_pair(std::string("dmn_S"), ::ChainActive()[1152]->GetBlockHash())));
+    }
+    // the next lookup starts from the queued snapshot
+    mnManager.GetListForBlock(pindexTip->pprev, mnList);
+    BOOST_CHECK(mnList.GetBlockHash() == pindexTip->pprev->GetBlockHash());
+    BOOST_CHECK_EQUAL(mnManager.GetListStats().nDiffsReplayed - stats.nDiffsReplayed, 1159U - 1152U);
+
+    {
+        LOCK(cs_main);
+        mnManager.WritePendingSnapshots();
+        BOOST_CHECK_EQUAL(mnManager.GetListStats().nSnapshotsWritten, 2U);
+        BOOST_CHECK(evoDb->Exists(std::make_pair(std::string("dmn_S"), ::ChainActive()[576]->GetBlockHash())));
+        BOOST_CHECK(evoDb->Exists(std::make_pair(std::string("dmn_S"), ::ChainActive()[1152]->GetBlockHash())));
+    }
+    // once written a fresh manager replays at most a day of diffs
+    CDeterministicMNManager mnManager2;
+    mnManager2.GetListForBlock(pindexTip, mnList);
+    BOOST_CHECK(mnList.GetBlockHash() == pindexTip->GetBlockHash());
+    BOOST_CHECK_EQUAL(mnManager2.GetListStats().nMaxReplay, 1160U - 1152U);
+}
+
+BOOST_AUTO_TEST_CASE(dip3_list_cache_trim)
+{
+    CDeterministicMNLRUCache<int> cache(25);
+    const uint256 hash1 = uint256S("01"), hash2 = uint256S("02"), hash3 = uint256S("03");
+    cache.Insert(hash1, 1, 10);
+    cache.Insert(hash2, 2, 10);
+    // inserting an existing entry keeps its value and usage
+    BOOST_CHECK_EQUAL(cache.Insert(hash1, 4, 10), 1);
+    BOOST_CHECK_EQUAL(cache.Usage(), 20U);
+    // inserting never evicts
+    cache.Insert(hash3, 3, 10);
+    BOOST_CHECK_EQUAL(cache.Size(), 3U);
+    BOOST_CHECK_EQUAL(cache.Usage(), 30U);
+    // hash1 was used after hash2, so hash2 is the least recently used one
+    cache.Trim();
+    BOOST_CHECK_EQUAL(cache.Size(), 2U);
+    BOOST_CHECK_EQUAL(cache.Usage(), 20U);
+    BOOST_CHECK(cache.Find(hash2) == nullptr);
+    BOOST_CHECK(cache.Find(hash1) != nullptr);
+    BOOST_CHECK(cache.Find(hash3) != nullptr);
+    // the most recently used entry is kept even if it is over the limit by itself
+    cache.Insert(hash2, 2, 100);
+    cache.Trim();
+    BOOST_CHECK_EQUAL(cache.Size(), 1U);
+    BOOST_CHECK_EQUAL(*cache.Find(hash2), 2);
+    BOOST_CHECK_EQUAL(cache.Usage(), 100U);
+    cache.Erase(hash2);
+    BOOST_CHECK_EQUAL(cache.Size(), 0U);
+    BOOST_CHECK_EQUAL(cache.Usage(), 0U);
+}
+BOOST_AUTO_TEST_CASE(dip3_payee_schedule)
+{
+    static const size_t SCHEDULE_SIZE = 5;
+    FastRandomContext rng(true);
+    CDeterministicMNList mnList(rng.rand256(), 1, 0);
+    uint64_t nNextInternalId = 0;
+    for (; nNextInternalId < 10; nNextInternalId++) {
+        mnList.AddMN(MakeTestDmn(nNextInternalId, 1, rng));
+    }
+    CDeterministicMNPayeeSchedule schedule;
+    schedule.Build(mnList.GetBlockHash(), mnList, SCHEDULE_SIZE);
+
+    std::vector<uint256> bannedMNs;
+    size_t nAdvanced = 0;
+    for (int nHeight = 2; nHeight < 100; nHeight++) {
+        CDeterministicMNList newList = mnList;
+        newList.SetBlockHash(rng.rand256());
+        newList.SetHeight(nHeight);
+
+        // every block pays the next masternode
+        const auto payee = mnList.GetMNPayee();
+        BOOST_REQUIRE(payee != nullptr);
+        auto payeeState = std::make_shared<CDeterministicMNState>(*payee->pdmnState);
+        payeeState->nLastPaidHeight = nHeight;
+        newList.UpdateMN(payee->proTxHash, payeeState);
+
+        // some blocks also change the order in other ways, always touching a masternode besides the payee
+        CDeterministicMNCPtr other;
+        newList.ForEachMN(true, [&](const CDeterministicMNCPtr& dmn) {
+            if (dmn->proTxHash != payee->proTxHash) {
+                other = dmn;
+            }
+        });
+        BOOST_REQUIRE(other != nullptr);
+        bool fReordered = true;
+        switch (nHeight % 8) {
+        case 1: {
+            newList.AddMN(MakeTestDmn(nNextInternalId++, nHeight, rng));
+            break;
+        }
+        case 3: {
+            auto state = std::make_shared<CDeterministicMNState>(*other->pdmnState);
+            state->BanIfNotBanned(nHeight);
+            newList.UpdateMN(other->proTxHash, state);
+            bannedMNs.emplace_back(other->proTxHash);
+            break;
+        }
+        case 5: {
+            auto state = std::make_shared<CDeterministicMNState>(*newList.GetMN(bannedMNs.back())->pdmnState);
+            state->Revive(nHeight);
+            newList.UpdateMN(bannedMNs.back(), state);
+            bannedMNs.pop_back();
+            break;
+        }
+        case 7: {
+            newList.RemoveMN(other->proTxHash);
+            break;
+        }
+        default:
+            fReordered = false;
+        }
+
+        CDeterministicMNListDiff diff;
+        mnList.BuildDiff(newList, diff);
+        const bool fAdvance = schedule.Advance(newList.GetBlockHash(), newList, diff);
+        if (fReordered) {
+            BOOST_CHECK(!fAdvance);
+        }
+        if (fAdvance) {
+            nAdvanced++;
+        } else {
+            schedule.Build(newList.GetBlockHash(), newList, SCHEDULE_SIZE);
+        }
+
+        // the schedule moved forward is the start of the one built from the list
+        CDeterministicMNPayeeSchedule builtSchedule;
+        builtSchedule.Build(newList.GetBlockHash(), newList, SCHEDULE_SIZE);
+        std::vector<CDeterministicMNCPtr> payees;
+        std::vector<CDeterministicMNCPtr> builtPayees;
+        schedule.GetPayees(newList, SCHEDULE_SIZE, payees);
+        builtSchedule.GetPayees(newList, SCHEDULE_SIZE, builtPayees);
+        BOOST_CHECK(schedule.GetBlockHash() == newList.GetBlockHash());
+        BOOST_REQUIRE(!payees.empty());
+        BOOST_CHECK(payees.size() <= builtPayees.size());
+        for (size_t i = 0; i < std::min(payees.size(), builtPayees.size()); i++) {
+            BOOST_CHECK_EQUAL(payees[i]->proTxHash.ToString(), builtPayees[i]->proTxHash.ToString());
+        }
+        BOOST_CHECK_EQUAL(schedule.GetPayee(newList)->proTxHash.ToString(), newList.GetMNPayee()->proTxHash.ToString());
+
+        mnList = newList;
+    }
+    // most blocks only paid the first masternode of the schedule
+    BOOST_CHECK(nAdvanced > 0);
+}
+BOOST_AUTO_TEST_CASE(dip3_intern_mns)
+{
+    FastRandomContext rng(true);
+    CDeterministicMNList base(uint256(), 1, 0);
+    for (uint64_t i = 0; i < 20; i++) {
+        base.AddMN(MakeTestDmn(i, 1, rng));
+    }
+    std::vector<uint256> proTxHashes;
+    base.ForEachMN(false, [&](const CDeterministicMNCPtr& dmn) { proTxHashes.emplace_back(dmn->proTxHash); });
+
+    // a list read from disk starts with a copy of every masternode
+    CDataStream ds(SER_DISK, CLIENT_VERSION);
+    ds << base;
+    CDeterministicMNList loaded;
+    ds >> loaded;
+    for (const auto& proTxHash : proTxHashes) {
+        BOOST_CHECK(loaded.GetMN(proTxHash) != base.GetMN(proTxHash));
+    }
+
+    // one masternode changed since, one was removed and one added
+    auto changedState = std::make_shared<CDeterministicMNState>(*loaded.GetMN(proTxHashes[0])->pdmnState);
+    changedState->nPoSePenalty++;
+    loaded.UpdateMN(proTxHashes[0], changedState);
+    loaded.RemoveMN(proTxHashes[1]);
+    const auto addedDmn = MakeTestDmn(20, 2, rng);
+    loaded.AddMN(addedDmn);
+
+    CDataStream dsBefore(SER_DISK, CLIENT_VERSION);
+    dsBefore << loaded;
+    const size_t nUsageBefore = loaded.DynamicMemoryUsage();
+    BOOST_CHECK_EQUAL(loaded.InternMNs(base), proTxHashes.size() - 2);
+    BOOST_CHECK(loaded.DynamicMemoryUsage() < nUsageBefore);
+    for (size_t i = 2; i < proTxHashes.size(); i++) {
+        BOOST_CHECK(loaded.GetMN(proTxHashes[i]) == base.GetMN(proTxHashes[i]));
+    }
+    // masternodes which differ from base are kept as they are
+    BOOST_CHECK(loaded.GetMN(proTxHashes[0]) != base.GetMN(proTxHashes[0]));
+    BOOST_CHECK_EQUAL(loaded.GetMN(proTxHashes[0])->pdmnState->nPoSePenalty, changedState->nPoSePenalty);
+    BOOST_CHECK(loaded.GetMN(proTxHashes[1]) == nullptr);
+    BOOST_CHECK(loaded.GetMN(addedDmn->proTxHash) == addedDmn);
+    BOOST_CHECK_EQUAL(loaded.GetAllMNsCount(), proTxHashes.size());
+
+    // interning again finds the shared masternodes and changes nothing
+    BOOST_CHECK_EQUAL(loaded.InternMNs(base), proTxHashes.size() - 2);
+    for (size_t i = 2; i < proTxHashes.size(); i++) {
+        BOOST_CHECK(loaded.GetMNByInternalId(base.GetMN(proTxHashes[i])->GetInternalId()) == base.GetMN(proTxHashes[i]));
+    }
+
+    // the content of the list is unchanged by interning
+    CDataStream dsAfter(SER_DISK, CLIENT_VERSION);
+    dsAfter << loaded;
+    BOOST_CHECK(dsBefore.str() == dsAfter.str());
+}
 BOOST_AUTO_TEST_SUITE_END()
@@ -5,8 +5,10 @@
 #include <test/util/setup_common.h>
 
 #include <bls/bls.h>
+#include <evo/deterministicmns.h>
 #include <evo/simplifiedmns.h>
 #include <netbase.h>
+#include <random.h>
 #include <tinyformat.h>
 #include <boost/test/unit_test.hpp>
 BOOST_FIXTURE_TEST_SUITE(evo_simplifiedmns_tests, BasicTestingSetup)
@@ -69,4 +71,99 @@ BOOST_AUTO_TEST_CASE(simplifiedmns_merkleroots)
 
     BOOST_CHECK(expectedMerkleRoot == calculatedMerkleRoot);
 }
+
+static CDeterministicMNCPtr MakeMN(FastRandomContext& rng, uint64_t nInternalId)
+{
+    auto dmn = std::make_shared<CDeterministicMN>(nInternalId);
+    dmn->proTxHash = rng.rand256();
+    dmn->collateralOutpoint = COutPoint(rng.rand256(), 0);
+    auto dmnState = std::make_shared<CDeterministicMNState>();
+    dmnState->nRegisteredHeight = 1;
+    dmnState->keyIDOwner = CKeyID(uint160(rng.randbytes(20)));
+    dmnState->UpdateConfirmedHash(dmn->proTxHash, rng.rand256());
+    dmn->pdmnState = dmnState;
+    return dmn;
+}
+
+BOOST_AUTO_TEST_CASE(simplifiedmns_merkletree)
+{
+    FastRandomContext rng(true);
+    CDeterministicMNList mnList(uint256(), 1, 0);
+    uint64_t nInternalId{0};
+    CSimplifiedMNListMerkleTree tree;
+    // moves the tree to another list with the diff from the list it holds
+    const auto updateTree = [&](const CDeterministicMNList& fromList, const CDeterministicMNList& toList) {
+        CDeterministicMNListDiff diff;
+        fromList.BuildDiff(toList, diff);
+        tree.Update(toList, diff);
+    };
+
+    tree.Update(mnList, CDeterministicMNListDiff());
+    BOOST_CHECK(tree.GetRoot().IsNull());
+
+    for (int i = 0; i < 200; i++) {
+        const CDeterministicMNList prevList = mnList;
+        // masternodes changed in this step, the diff built from them only must match the full one
+        std::set<uint256> setChanged;
+        // add, remove and change a few masternodes per step, sometimes none
+        const int nAdd = rng.randrange(i < 20 ? 8 : 3);
+        for (int j = 0; j < nAdd; j++) {
+            const auto dmn = MakeMN(rng, nInternalId++);
+            mnList.AddMN(dmn);
+            setChanged.emplace(dmn->proTxHash);
+        }
+        std::vector<CDeterministicMNCPtr> vMNs;
+        mnList.ForEachMN(false, [&](const CDeterministicMNCPtr& dmn) { vMNs.emplace_back(dmn); });
+        Shuffle(vMNs.begin(), vMNs.end(), rng);
+        const size_t nRemove = std::min<size_t>(rng.randrange(3), vMNs.size());
+        for (size_t j = 0; j < nRemove; j++) {
+            mnList.RemoveMN(vMNs[j]->proTxHash);
+            setChanged.emplace(vMNs[j]->proTxHash);
+        }
+        const size_t nUpdate = std::min<size_t>(rng.randrange(4), vMNs.size() - nRemove);
+        for (size_t j = nRemove; j < nRemove + nUpdate; j++) {
+            auto dmnState = std::make_shared<CDeterministicMNState>(*vMNs[j]->pdmnState);
+            if (rng.randbool()) {
+                dmnState->BanIfNotBanned(i);
+            } else {
+                dmnState->UpdateConfirmedHash(vMNs[j]->proTxHash, rng.rand256());
+            }
+            mnList.UpdateMN(vMNs[j]->proTxHash, dmnState);
+            setChanged.emplace(vMNs[j]->proTxHash);
+        }
+
+        CDeterministicMNListDiff diff, diffFull;
+        prevList.BuildDiff(mnList, setChanged, diff);
+        prevList.BuildDiff(mnList, diffFull);
+        BOOST_CHECK(diff.addedMNs == diffFull.addedMNs);
+        BOOST_CHECK(diff.removedMns == diffFull.removedMns);
+        BOOST_CHECK_EQUAL(diff.updatedMNs.size(), diffFull.updatedMNs.size());
+        for (const auto& p : diffFull.updatedMNs) {
+            BOOST_CHECK(diff.updatedMNs.count(p.first) && diff.updatedMNs.at(p.first).fields == p.second.fields);
+        }
+        tree.Update(mnList, diff);
+        bool fMutated = true;
+        BOOST_CHECK_EQUAL(tree.GetRoot(&fMutated), CSimplifiedMNList(mnList).CalcMerkleRoot());
+        BOOST_CHECK(!fMutated);
+        BOOST_CHECK_EQUAL(tree.GetLeafCount(), mnList.GetAllMNsCount());
+    }
+
+    // a rebuilt tree has the same root and can move back to an older list
+    const CDeterministicMNList oldList = mnList;
+    for (int j = 0; j < 5; j++) {
+        mnList.AddMN(MakeMN(rng, nInternalId++));
+    }
+    updateTree(oldList, mnList);
+    CSimplifiedMNListMerkleTree treeFull;
+    treeFull.Build(mnList);
+    BOOST_CHECK_EQUAL(tree.GetRoot(), treeFull.GetRoot());
+    updateTree(mnList, oldList);
+    BOOST_CHECK_EQUAL(tree.GetRoot(), CSimplifiedMNList(oldList).CalcMerkleRoot());
+
+    // removing every masternode empties the tree
+    updateTree(oldList, CDeterministicMNList(uint256(), 1, 0));
+    BOOST_CHECK(tree.GetRoot().IsNull());
+    BOOST_CHECK_EQUAL(tree.GetLeafCount(), 0U);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,108 @@
+// Copyright (c) 2021 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <ethereum/ethereum.h>
+#include <ethereum/rlp.h>
+#include <ethereum/rlpreader.h>
+#include <ethereum/sha3.h>
+#include <test/fuzz/FuzzedDataProvider.h>
+#include <test/fuzz/fuzz.h>
+#include <test/fuzz/util.h>
+
+#include <cassert>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace {
+Span<const unsigned char> ToSpan(dev::bytesConstRef ref)
+{
+    return Span<const unsigned char>(ref.data(), ref.size());
+}
+} // namespace
+
+FUZZ_TARGET(rlp)
+{
+    const std::vector<unsigned char> data(buffer.begin(), buffer.end());
+    std::optional<dev::RLP> rlp;
+    try {
+        rlp.emplace(&data);
+    } catch (...) {
+    }
+    dev::RLPItem item;
+    const bool fDecoded = dev::RLPDecodeExact(data, item);
+    assert(fDecoded == rlp.has_value());
+    if (!fDecoded) {
+        return;
+    }
+    assert(item.IsNull() == rlp->isNull());
+    assert(item.fList == rlp->isList());
+    assert(ToSpan(rlp->data()) == item.data);
+    if (!item.IsNull()) {
+        assert(ToSpan(rlp->payload()) == item.payload);
+    }
+
+    std::optional<size_t> count;
+    try {
+        count = rlp->itemCount();
+    } catch (...) {
+    }
+    size_t nCount;
+    assert(dev::RLPItemCount(item, nCount) == count.has_value());
+    if (!count) {
+        return;
+    }
+    assert(nCount == *count);
+    for (size_t i = 0; i < nCount; ++i) {
+        const dev::RLP child = (*rlp)[i];
+        dev::RLPItem childItem;
+        assert(dev::RLPListItem(item, i, childItem));
+        assert(ToSpan(child.data()) == childItem.data);
+        assert(ToSpan(child.payload()) == childItem.payload);
+        assert(child.isList() == childItem.fList);
+    }
+    dev::RLPItem outOfRange;
+    assert(!dev::RLPListItem(item, nCount, outOfRange));
+}
+
+FUZZ_TARGET(eth_verify_proof)
+{
+    FuzzedDataProvider fuzzed_data_provider(buffer.data(), buffer.size());
+    const std::vector<unsigned char> path = ConsumeRandomLengthByteVector(fuzzed_data_provider, 32);
+    const std::vector<unsigned char> value = ConsumeRandomLengthByteVector(fuzzed_data_provider);
+    std::vector<unsigned char> parentNodes;
+    std::vector<unsigned char> root;
+    if (fuzzed_data_provider.ConsumeBool()) {
+        // build a list out of fuzzed nodes and commit to the first one so the walk gets past the root
+        std::vector<std::vector<unsigned char>> nodes;
+        while (nodes.size() < 8 && fuzzed_data_provider.ConsumeBool()) {
+            nodes.push_back(ConsumeRandomLengthByteVector(fuzzed_data_provider));
+        }
+        try {
+            dev::RLPStream stream(nodes.size());
+            for (const auto& node : nodes) {
+                stream.appendRaw(node);
+            }
+            parentNodes = stream.out();
+            if (!nodes.empty()) {
+                root = dev::rlp(dev::sha3(nodes.front()));
+            }
+        } catch (...) {
+            return;
+        }
+    } else {
+        parentNodes = ConsumeRandomLengthByteVector(fuzzed_data_provider);
+        root = ConsumeRandomLengthByteVector(fuzzed_data_provider);
+    }
+
+    // only encodings the strict dev::RLP decoding accepts ever reach VerifyProof
+    try {
+        const dev::RLP rlpValue(&value);
+        const dev::RLP rlpParentNodes(&parentNodes);
+        const dev::RLP rlpRoot(&root);
+        const bool fValid = VerifyProof(&path, rlpValue, rlpParentNodes, rlpRoot);
+        assert(VerifyProof(path, value, parentNodes, root) == fValid);
+    } catch (...) {
+    }
+}
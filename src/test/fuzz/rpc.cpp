@@ -91,6 +91,7 @@ const std::vector<std::string> RPC_COMMANDS_SAFE_FOR_FUZZING{
     "masternode_winners",
     "masternode_payments",
     "masternode_count",
+    "masternode_liststats",
     "masternode_winner",
     "masternode_status",
     "masternode_current",
@@ -121,6 +122,7 @@ const std::vector<std::string> RPC_COMMANDS_SAFE_FOR_FUZZING{
     "quorum_verify",
     "quorum_isconflicting",
     "quorum_sign",
+    "quorum_verifystats",
     "gobject_getcurrentvotes",
     "gobject_submit",
     "createauxblock",
@@ -131,7 +133,10 @@ const std::vector<std::string> RPC_COMMANDS_SAFE_FOR_FUZZING{
     "syscoindecoderawtransaction",
     "assetinfo",
     "listassets",
+    "assetlookup",
+    "getaddressbalance",
     "assetallocationverifyzdag",
+    "assetallocationverifyzdagmany",
     "syscoinsetethstatus",
     "syscoinsetethheaders",
     "syscoinclearethheaders",
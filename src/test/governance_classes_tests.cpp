@@ -0,0 +1,194 @@
+// Copyright (c) 2021 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <test/util/setup_common.h>
+
+#include <evo/deterministicmns.h>
+#include <governance/governance.h>
+#include <governance/governanceclasses.h>
+#include <governance/governancedb.h>
+#include <governance/governanceobject.h>
+#include <governance/governancevote.h>
+#include <key.h>
+#include <key_io.h>
+#include <masternode/masternodesync.h>
+#include <timedata.h>
+#include <univalue.h>
+#include <util/strencodings.h>
+#include <validation.h>
+
+#include <memory>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+namespace governance_classes_tests
+{
+class CSuperblockCacheForTest
+{
+public:
+    // an entry which doesn't match the triggers, queries only return it while it is cached
+    static void SetStaleEntry(int nBlockHeight)
+    {
+        LOCK(governance.cs);
+        auto& entry = triggerman.mapSuperblockCache[nBlockHeight];
+        entry.fTriggered = true;
+        entry.pBestSuperblock = std::make_shared<CSuperblock>();
+        entry.vecPayments = {CTxOut(COIN, CScript() << OP_TRUE)};
+    }
+
+    static bool IsCached(int nBlockHeight)
+    {
+        LOCK(governance.cs);
+        return triggerman.mapSuperblockCache.count(nBlockHeight) != 0;
+    }
+
+    static bool AddTrigger(const uint256& nHash)
+    {
+        LOCK(governance.cs);
+        return triggerman.AddNewTrigger(nHash);
+    }
+
+    static bool ProcessVote(const CGovernanceVote& vote, VoteSigCheck sigCheck, const CDeterministicMNList& mnList, CConnman& connman)
+    {
+        CGovernanceException exception;
+        return governance.ProcessVote(nullptr, vote, exception, connman, sigCheck, &mnList);
+    }
+
+    static void Reset()
+    {
+        LOCK(governance.cs);
+        triggerman.mapTrigger.clear();
+        triggerman.InvalidateSuperblockCache();
+    }
+};
+
+struct SuperblockCacheSetup : public TestingSetup
+{
+    int nSuperblockHeight;
+
+    SuperblockCacheSetup()
+    {
+        governanceDb.reset(new CGovernanceDB(1 << 20, true));
+        masternodeSync.SwitchToNextAsset(*m_node.connman);
+        masternodeSync.SwitchToNextAsset(*m_node.connman);
+        int nLastSuperblock;
+        CSuperblock::GetNearestSuperblocksHeights(WITH_LOCK(cs_main, return ::ChainActive().Height()), nLastSuperblock, nSuperblockHeight);
+    }
+    ~SuperblockCacheSetup()
+    {
+        CSuperblockCacheForTest::Reset();
+        masternodeSync.Reset(true, false);
+        governance.Clear();
+        governanceDb.reset();
+    }
+
+    // a trigger paying nAmount at the next superblock, loaded into governance
+    uint256 LoadTrigger(const std::string& strAmount)
+    {
+        CKey key;
+        key.MakeNewKey(true);
+        UniValue obj(UniValue::VOBJ);
+        obj.pushKV("type", GOVERNANCE_OBJECT_TRIGGER);
+        obj.pushKV("event_block_height", nSuperblockHeight);
+        obj.pushKV("payment_addresses", EncodeDestination(PKHash(key.GetPubKey())));
+        obj.pushKV("payment_amounts", strAmount);
+        const std::string strData = obj.write();
+        CGovernanceObject govobj(uint256(), 1, GetAdjustedTime(), InsecureRand256(), HexStr(strData));
+        BOOST_REQUIRE_EQUAL(govobj.GetObjectType(), GOVERNANCE_OBJECT_TRIGGER);
+        governanceDb->WriteObject(govobj);
+        governance.LoadFromDB();
+        return govobj.GetHash();
+    }
+
+    // the stale entry is returned until the cache is invalidated, then the triggers are evaluated again
+    void CheckStaleEntry(bool fCached) const
+    {
+        std::vector<CTxOut> voutSuperblock;
+        BOOST_CHECK_EQUAL(CSuperblockCacheForTest::IsCached(nSuperblockHeight), fCached);
+        BOOST_CHECK_EQUAL(CSuperblockManager::IsSuperblockTriggered(nSuperblockHeight), fCached);
+        BOOST_CHECK_EQUAL(CSuperblockManager::GetSuperblockPayments(nSuperblockHeight, voutSuperblock), fCached);
+    }
+};
+} // namespace governance_classes_tests
+
+BOOST_FIXTURE_TEST_SUITE(governance_classes_tests, SuperblockCacheSetup)
+
+BOOST_AUTO_TEST_CASE(superblock_cache_trigger_added)
+{
+    const uint256 nHash = LoadTrigger("1.5");
+    CSuperblockCacheForTest::SetStaleEntry(nSuperblockHeight);
+    CheckStaleEntry(true);
+
+    BOOST_CHECK(CSuperblockCacheForTest::AddTrigger(nHash));
+    // the trigger has no funding votes, so there is no superblock for the height
+    CheckStaleEntry(false);
+
+    // adding a known trigger changes nothing
+    CSuperblockCacheForTest::SetStaleEntry(nSuperblockHeight);
+    BOOST_CHECK(!CSuperblockCacheForTest::AddTrigger(nHash));
+    CheckStaleEntry(true);
+}
+
+BOOST_AUTO_TEST_CASE(superblock_cache_trigger_vote)
+{
+    const uint256 nHash = LoadTrigger("1.5");
+    BOOST_REQUIRE(CSuperblockCacheForTest::AddTrigger(nHash));
+    CSuperblockCacheForTest::SetStaleEntry(nSuperblockHeight);
+
+    auto dmn = std::make_shared<CDeterministicMN>(0);
+    dmn->proTxHash = InsecureRand256();
+    dmn->collateralOutpoint = COutPoint(InsecureRand256(), 0);
+    dmn->pdmnState = std::make_shared<CDeterministicMNState>();
+    CDeterministicMNList mnList(InsecureRand256(), 1, 0);
+    mnList.AddMN(dmn);
+
+    auto makeVote = [&](int64_t nTime) {
+        CGovernanceVote vote(dmn->collateralOutpoint, nHash, VOTE_SIGNAL_FUNDING, VOTE_OUTCOME_YES);
+        vote.SetTime(nTime);
+        return vote;
+    };
+
+    // a rejected vote keeps the entry
+    const int64_t nNow = GetAdjustedTime();
+    BOOST_CHECK(!CSuperblockCacheForTest::ProcessVote(makeVote(nNow - 10), VoteSigCheck::INVALID, mnList, *m_node.connman));
+    BOOST_CHECK(CSuperblockCacheForTest::IsCached(nSuperblockHeight));
+
+    // the accepted funding vote makes the trigger the best one for the height
+    BOOST_CHECK(CSuperblockCacheForTest::ProcessVote(makeVote(nNow), VoteSigCheck::VALID, mnList, *m_node.connman));
+    BOOST_CHECK(!CSuperblockCacheForTest::IsCached(nSuperblockHeight));
+    std::vector<CTxOut> voutSuperblock;
+    BOOST_CHECK(CSuperblockManager::GetSuperblockPayments(nSuperblockHeight, voutSuperblock));
+    BOOST_REQUIRE_EQUAL(voutSuperblock.size(), 1U);
+    BOOST_CHECK_EQUAL(voutSuperblock[0].nValue, 3 * COIN / 2);
+}
+
+BOOST_AUTO_TEST_CASE(superblock_cache_update_caches_and_clean)
+{
+    CSuperblockCacheForTest::SetStaleEntry(nSuperblockHeight);
+    CheckStaleEntry(true);
+
+    governance.UpdateCachesAndClean();
+    CheckStaleEntry(false);
+}
+
+BOOST_AUTO_TEST_CASE(superblock_cache_tip_changed)
+{
+    CSuperblockCacheForTest::SetStaleEntry(nSuperblockHeight);
+    CheckStaleEntry(true);
+
+    governance.UpdatedBlockTip(WITH_LOCK(cs_main, return ::ChainActive().Tip()), *m_node.connman);
+    CheckStaleEntry(false);
+}
+
+BOOST_AUTO_TEST_CASE(superblock_cache_cleared)
+{
+    CSuperblockCacheForTest::SetStaleEntry(nSuperblockHeight);
+    CheckStaleEntry(true);
+
+    governance.Clear();
+    CheckStaleEntry(false);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,256 @@
+// Copyright (c) 2021 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <test/util/setup_common.h>
+
+#include <cachemap.h>
+#include <clientversion.h>
+#include <evo/deterministicmns.h>
+#include <fs.h>
+#include <governance/governance.h>
+#include <governance/governancedb.h>
+#include <governance/governanceobject.h>
+#include <governance/governancevote.h>
+#include <hash.h>
+#include <streams.h>
+#include <timedata.h>
+#include <version.h>
+
+#include <algorithm>
+#include <map>
+#include <set>
+
+#include <boost/test/unit_test.hpp>
+
+namespace {
+struct GovernanceDBSetup : public TestingSetup
+{
+    GovernanceDBSetup()
+    {
+        governanceDb.reset(new CGovernanceDB(1 << 20, true));
+    }
+    ~GovernanceDBSetup()
+    {
+        governance.Clear();
+        governanceDb.reset();
+    }
+
+    static CGovernanceObject MakeObject()
+    {
+        return CGovernanceObject(uint256(), 1, GetAdjustedTime(), InsecureRand256(), "");
+    }
+
+    static CGovernanceVote MakeVote(const COutPoint& mnOutpoint, const uint256& nParentHash, vote_outcome_enum_t eOutcome, int64_t nTime)
+    {
+        CGovernanceVote vote(mnOutpoint, nParentHash, VOTE_SIGNAL_FUNDING, eOutcome);
+        vote.SetTime(nTime);
+        return vote;
+    }
+};
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(governance_db_tests, GovernanceDBSetup)
+
+BOOST_AUTO_TEST_CASE(governance_db_load_votes)
+{
+    auto govobj = MakeObject();
+    const uint256 nHash = govobj.GetHash();
+    governanceDb->WriteObject(govobj);
+    BOOST_CHECK(!govobj.HasUnstoredFlags());
+
+    const COutPoint mn1(InsecureRand256(), 0);
+    const COutPoint mn2(InsecureRand256(), 0);
+    const auto oldVote = MakeVote(mn1, nHash, VOTE_OUTCOME_NO, 1000);
+    const auto newVote = MakeVote(mn1, nHash, VOTE_OUTCOME_YES, 2000);
+    const auto otherVote = MakeVote(mn2, nHash, VOTE_OUTCOME_ABSTAIN, 1500);
+    // as left behind by a crash before the replaced vote was erased, votes are read in key order and not by time
+    governanceDb->WriteVote(newVote, {});
+    governanceDb->WriteVote(otherVote, {});
+    governanceDb->WriteVote(oldVote, {});
+    BOOST_CHECK_EQUAL(governanceDb->ReadVotes(nHash).size(), 3U);
+
+    governance.LoadFromDB();
+    governance.InitOnLoad();
+    const CGovernanceObject* pObj = governance.FindGovernanceObject(nHash);
+    BOOST_REQUIRE(pObj);
+    BOOST_CHECK(!pObj->HasUnstoredFlags());
+
+    // the replaced vote is dropped from the object and the db
+    const auto vecVoteHashes = pObj->GetVoteHashes();
+    BOOST_CHECK_EQUAL(vecVoteHashes.size(), 2U);
+    BOOST_CHECK(std::count(vecVoteHashes.begin(), vecVoteHashes.end(), newVote.GetHash()));
+    BOOST_CHECK(std::count(vecVoteHashes.begin(), vecVoteHashes.end(), otherVote.GetHash()));
+    BOOST_CHECK(!std::count(vecVoteHashes.begin(), vecVoteHashes.end(), oldVote.GetHash()));
+    const auto vecStored = governanceDb->ReadVotes(nHash);
+    BOOST_CHECK_EQUAL(vecStored.size(), 2U);
+    BOOST_CHECK(vecStored.front().GetHash() < vecStored.back().GetHash());
+
+    // the per-masternode records are the same as ProcessVote leaves them
+    vote_rec_t voteRecord;
+    BOOST_REQUIRE(pObj->GetCurrentMNVotes(mn1, voteRecord));
+    BOOST_CHECK_EQUAL(voteRecord.mapInstances.size(), 1U);
+    BOOST_CHECK(voteRecord.mapInstances.at(VOTE_SIGNAL_FUNDING).eOutcome == VOTE_OUTCOME_YES);
+    BOOST_CHECK_EQUAL(voteRecord.mapInstances.at(VOTE_SIGNAL_FUNDING).nCreationTime, 2000);
+    BOOST_REQUIRE(pObj->GetCurrentMNVotes(mn2, voteRecord));
+    BOOST_CHECK(voteRecord.mapInstances.at(VOTE_SIGNAL_FUNDING).eOutcome == VOTE_OUTCOME_ABSTAIN);
+    BOOST_CHECK_EQUAL(pObj->CountMatchingVotes(VOTE_SIGNAL_FUNDING, VOTE_OUTCOME_YES), 1);
+    BOOST_CHECK_EQUAL(pObj->CountMatchingVotes(VOTE_SIGNAL_FUNDING, VOTE_OUTCOME_NO), 0);
+
+    // the rebuilt indexes know every loaded vote
+    BOOST_CHECK_EQUAL(governance.GetVoteCount(), 2);
+    BOOST_CHECK(governance.HaveVoteForHash(newVote.GetHash()));
+    BOOST_CHECK(governance.HaveVoteForHash(otherVote.GetHash()));
+    BOOST_CHECK(!governance.HaveVoteForHash(oldVote.GetHash()));
+
+    // votes are only kept on disk and served from there
+    CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
+    BOOST_CHECK(governance.SerializeVoteForHash(newVote.GetHash(), ss));
+    CGovernanceVote readVote;
+    ss >> readVote;
+    BOOST_CHECK(readVote.GetHash() == newVote.GetHash());
+    BOOST_CHECK(!governance.SerializeVoteForHash(oldVote.GetHash(), ss));
+}
+
+BOOST_AUTO_TEST_CASE(governance_db_clear_masternode_votes)
+{
+    auto govobj = MakeObject();
+    const uint256 nHash = govobj.GetHash();
+    governanceDb->WriteObject(govobj);
+    const auto vote1 = MakeVote(COutPoint(InsecureRand256(), 0), nHash, VOTE_OUTCOME_YES, 1000);
+    const auto vote2 = MakeVote(COutPoint(InsecureRand256(), 0), nHash, VOTE_OUTCOME_NO, 1000);
+    governanceDb->WriteVote(vote1, {});
+    governanceDb->WriteVote(vote2, {});
+    governance.LoadFromDB();
+
+    CGovernanceObject* pObj = governance.FindGovernanceObject(nHash);
+    BOOST_REQUIRE(pObj);
+    BOOST_CHECK_EQUAL(pObj->GetVoteHashes().size(), 2U);
+
+    // neither masternode is in the (empty) list at the tip, so their votes are dropped from memory and disk
+    pObj->ClearMasternodeVotes();
+    BOOST_CHECK(pObj->GetVoteHashes().empty());
+    BOOST_CHECK(governanceDb->ReadVotes(nHash).empty());
+    BOOST_CHECK(!governanceDb->HasVote(nHash, vote1.GetHash()));
+    BOOST_CHECK(!governanceDb->HasVote(nHash, vote2.GetHash()));
+}
+
+BOOST_AUTO_TEST_CASE(governance_db_remove_invalid_votes)
+{
+    auto govobj = MakeObject();
+    const uint256 nHash = govobj.GetHash();
+    governanceDb->WriteObject(govobj);
+    const COutPoint mn(InsecureRand256(), 0);
+    const auto fundingVote = MakeVote(mn, nHash, VOTE_OUTCOME_YES, 1000);
+    CGovernanceVote deleteVote(mn, nHash, VOTE_SIGNAL_DELETE, VOTE_OUTCOME_NO);
+    deleteVote.SetTime(1000);
+    governanceDb->WriteVote(fundingVote, {});
+    governanceDb->WriteVote(deleteVote, {});
+    governance.LoadFromDB();
+
+    CGovernanceObject* pObj = governance.FindGovernanceObject(nHash);
+    BOOST_REQUIRE(pObj);
+    BOOST_CHECK_EQUAL(pObj->GetVoteHashes().size(), 2U);
+
+    // without the db the signatures can't be checked, so nothing is removed
+    auto db = std::move(governanceDb);
+    BOOST_CHECK(pObj->RemoveInvalidVotes(mn).empty());
+    BOOST_CHECK_EQUAL(pObj->GetVoteHashes().size(), 2U);
+    governanceDb = std::move(db);
+
+    // a vote which can't be read is kept, one which was read and isn't valid is removed from memory and disk
+    governanceDb->EraseVotes(nHash, {fundingVote.GetHash()});
+    const auto removedVotes = pObj->RemoveInvalidVotes(mn);
+    BOOST_CHECK(removedVotes == std::set<uint256>{deleteVote.GetHash()});
+    const auto vecVoteHashes = pObj->GetVoteHashes();
+    BOOST_CHECK_EQUAL(vecVoteHashes.size(), 1U);
+    BOOST_CHECK(std::count(vecVoteHashes.begin(), vecVoteHashes.end(), fundingVote.GetHash()));
+    BOOST_CHECK(!governanceDb->HasVote(nHash, deleteVote.GetHash()));
+}
+
+BOOST_AUTO_TEST_CASE(governance_db_flush_changed_objects)
+{
+    auto govobj1 = MakeObject();
+    auto govobj2 = MakeObject();
+    const uint256 nHash1 = govobj1.GetHash();
+    const uint256 nHash2 = govobj2.GetHash();
+    governanceDb->WriteObject(govobj1);
+    governanceDb->WriteObject(govobj2);
+    governance.LoadFromDB();
+
+    // erase the second object behind the back of the manager to see if a flush writes it again
+    governanceDb->EraseObject(nHash2);
+    CGovernanceObject* pObj1 = governance.FindGovernanceObject(nHash1);
+    BOOST_REQUIRE(pObj1);
+    BOOST_CHECK(!pObj1->HasUnstoredFlags());
+    pObj1->PrepareDeletion(12345);
+    BOOST_CHECK(pObj1->HasUnstoredFlags());
+
+    governance.FlushToDB();
+    BOOST_CHECK(!pObj1->HasUnstoredFlags());
+
+    std::map<uint256, int64_t> mapStored;
+    governanceDb->ForEachObject([&](const uint256& nHash, CGovernanceObject& govobj) {
+        mapStored.emplace(nHash, govobj.GetDeletionTime());
+        return true;
+    });
+    BOOST_CHECK_EQUAL(mapStored.size(), 1U);
+    BOOST_CHECK_EQUAL(mapStored[nHash1], 12345);
+    BOOST_CHECK(!mapStored.count(nHash2));
+}
+
+BOOST_AUTO_TEST_CASE(governance_db_migrate_flat_file)
+{
+    auto govobj = MakeObject();
+    govobj.PrepareDeletion(12345);
+    const uint256 nHash = govobj.GetHash();
+    const COutPoint mn1(InsecureRand256(), 0);
+    const COutPoint mn2(InsecureRand256(), 0);
+    const auto vote1 = MakeVote(mn1, nHash, VOTE_OUTCOME_YES, 1000);
+    const auto vote2 = MakeVote(mn2, nHash, VOTE_OUTCOME_NO, 1000);
+    const uint256 nErasedHash = InsecureRand256();
+
+    // governance.dat as it was dumped before the governance db, every object was followed by all of its votes
+    CDataStream ssObj(SER_DISK, CLIENT_VERSION);
+    ssObj << std::string("magicGovernanceCache");
+    ssObj << Params().MessageStart();
+    ssObj << std::string("CGovernanceManager-Version-15");
+    ssObj << std::map<uint256, int64_t>{{nErasedHash, 5000}};
+    ssObj << CacheMap<uint256, CGovernanceVote>();
+    ssObj << CGovernanceManager::vote_cmm_t();
+    ssObj << COMPACTSIZE(1U) << nHash << govobj << CGovernanceObject::vote_m_t() << 2 << std::vector<CGovernanceVote>{vote1, vote2};
+    ssObj << CGovernanceManager::txout_m_t();
+    ssObj << CDeterministicMNList();
+    ssObj << Hash(ssObj);
+    const fs::path pathFlatFile = GetDataDir() / "governance.dat";
+    {
+        CAutoFile fileout(fsbridge::fopen(pathFlatFile, "wb"), SER_DISK, CLIENT_VERSION);
+        BOOST_REQUIRE(!fileout.IsNull());
+        fileout << ssObj;
+    }
+
+    governance.MigrateFlatFile();
+    BOOST_CHECK(!fs::exists(pathFlatFile));
+    BOOST_CHECK_EQUAL(governanceDb->ReadVotes(nHash).size(), 2U);
+
+    governance.LoadFromDB();
+    const CGovernanceObject* pObj = governance.FindGovernanceObject(nHash);
+    BOOST_REQUIRE(pObj);
+    BOOST_CHECK_EQUAL(pObj->GetDeletionTime(), 12345);
+    BOOST_CHECK_EQUAL(pObj->GetVoteHashes().size(), 2U);
+    BOOST_CHECK_EQUAL(pObj->CountMatchingVotes(VOTE_SIGNAL_FUNDING, VOTE_OUTCOME_YES), 1);
+    BOOST_CHECK_EQUAL(pObj->CountMatchingVotes(VOTE_SIGNAL_FUNDING, VOTE_OUTCOME_NO), 1);
+    // the remaining state was moved over too
+    BOOST_CHECK(governance.ToString().find("Erased: 1") != std::string::npos);
+
+    // a file which can't be read is dropped, governance is then synced again
+    {
+        CAutoFile fileout(fsbridge::fopen(pathFlatFile, "wb"), SER_DISK, CLIENT_VERSION);
+        BOOST_REQUIRE(!fileout.IsNull());
+        fileout << std::string("garbage");
+    }
+    governance.MigrateFlatFile();
+    BOOST_CHECK(!fs::exists(pathFlatFile));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,314 @@
+// Copyright (c) 2021 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <test/util/setup_common.h>
+
+#include <bloom.h>
+#include <governance/governance.h>
+#include <governance/governancedb.h>
+#include <governance/governanceobject.h>
+#include <governance/governancevote.h>
+#include <masternode/masternodesync.h>
+#include <net.h>
+#include <net_processing.h>
+#include <netfulfilledman.h>
+#include <protocol.h>
+#include <streams.h>
+#include <timedata.h>
+#include <version.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+namespace {
+struct GovernanceSyncSetup : public TestingSetup
+{
+    std::vector<std::unique_ptr<CNode>> nodes;
+
+    GovernanceSyncSetup()
+    {
+        governanceDb.reset(new CGovernanceDB(1 << 20, true));
+        masternodeSync.SwitchToNextAsset(*m_node.connman);
+        masternodeSync.SwitchToNextAsset(*m_node.connman);
+    }
+    ~GovernanceSyncSetup()
+    {
+        for (const auto& node : nodes) {
+            m_node.peerman->FinalizeNode(*node);
+        }
+        masternodeSync.Reset(true, false);
+        netfulfilledman.Clear();
+        governance.Clear();
+        governanceDb.reset();
+    }
+
+    CNode& AddNode()
+    {
+        struct in_addr s;
+        s.s_addr = 0xa0b0c001 + nodes.size();
+        const CAddress addr(CService(CNetAddr(s), Params().GetDefaultPort()), NODE_NONE);
+        nodes.emplace_back(std::make_unique<CNode>(nodes.size(), NODE_NETWORK, INVALID_SOCKET, addr, /* nKeyedNetGroupIn */ 0, /* nLocalHostNonceIn */ 0, CAddress(),
+                                                   /* pszDest */ "", ConnectionType::OUTBOUND_FULL_RELAY, /* inbound_onion */ false));
+        CNode& node = *nodes.back();
+        node.SetCommonVersion(PROTOCOL_VERSION);
+        m_node.peerman->InitializeNode(&node);
+        node.fSuccessfullyConnected = true;
+        return node;
+    }
+
+    void ProcessMessage(CNode& node, const std::string& strCommand, CDataStream& ds)
+    {
+        governance.ProcessMessage(&node, strCommand, ds, *m_node.connman, *m_node.peerman);
+    }
+
+    // the messages pushed to the node since the last call, the socket is invalid so they are never sent
+    static std::vector<std::pair<std::string, CDataStream>> TakeMessages(CNode& node)
+    {
+        std::vector<std::pair<std::string, CDataStream>> ret;
+        LOCK(node.cs_vSend);
+        for (auto it = node.vSendMsg.begin(); it != node.vSendMsg.end(); ++it) {
+            CMessageHeader hdr;
+            CDataStream(*it, SER_NETWORK, PROTOCOL_VERSION) >> hdr;
+            CDataStream ds(SER_NETWORK, PROTOCOL_VERSION);
+            if (hdr.nMessageSize != 0) {
+                ++it;
+                ds.write((const char*)it->data(), it->size());
+            }
+            ret.emplace_back(hdr.GetCommand(), std::move(ds));
+        }
+        node.vSendMsg.clear();
+        node.nSendSize = 0;
+        return ret;
+    }
+
+    static std::vector<uint256> TakeInventory(CNode& node, int nType)
+    {
+        std::vector<uint256> ret;
+        LOCK(node.m_tx_relay->cs_tx_inventory);
+        for (const auto& inv : node.m_tx_relay->setInventoryTxToSendOther) {
+            if (inv.type == nType) {
+                ret.emplace_back(inv.hash);
+            }
+        }
+        node.m_tx_relay->setInventoryTxToSendOther.clear();
+        return ret;
+    }
+
+    static CDataStream MakeSyncRequest(const uint256& nProp, const uint256* pCursor)
+    {
+        CDataStream ds(SER_NETWORK, PROTOCOL_VERSION);
+        ds << nProp << CBloomFilter();
+        if (pCursor) {
+            ds << *pCursor;
+        }
+        return ds;
+    }
+
+    static CDataStream MakeSyncStatusCount(int nItemID, int nCount, const uint256& nProp, const uint256& nCursor)
+    {
+        CDataStream ds(SER_NETWORK, PROTOCOL_VERSION);
+        ds << nItemID << nCount << nProp << nCursor;
+        return ds;
+    }
+
+    // checks that the only message is a SYNCSTATUSCOUNT and returns its payload behind the item id and count
+    static CDataStream CheckSyncStatusCount(CNode& node, int nItemID, int nCount)
+    {
+        auto vecMessages = TakeMessages(node);
+        BOOST_REQUIRE_EQUAL(vecMessages.size(), 1U);
+        BOOST_CHECK_EQUAL(vecMessages[0].first, NetMsgType::SYNCSTATUSCOUNT);
+        int nItemIDRet, nCountRet;
+        vecMessages[0].second >> nItemIDRet >> nCountRet;
+        BOOST_CHECK_EQUAL(nItemIDRet, nItemID);
+        BOOST_CHECK_EQUAL(nCountRet, nCount);
+        return std::move(vecMessages[0].second);
+    }
+
+    static void CheckPage(CDataStream ds, const uint256& nPropExpected, const uint256& nCursorExpected)
+    {
+        uint256 nProp, nCursor;
+        ds >> nProp >> nCursor;
+        BOOST_CHECK(nProp == nPropExpected);
+        BOOST_CHECK(nCursor == nCursorExpected);
+        BOOST_CHECK(ds.empty());
+    }
+
+    // checks that the only message is a MNGOVERNANCESYNC for the given page
+    static void CheckSyncRequest(CNode& node, const uint256& nPropExpected, const uint256& nCursorExpected)
+    {
+        auto vecMessages = TakeMessages(node);
+        BOOST_REQUIRE_EQUAL(vecMessages.size(), 1U);
+        BOOST_CHECK_EQUAL(vecMessages[0].first, NetMsgType::MNGOVERNANCESYNC);
+        uint256 nProp, nCursor;
+        CBloomFilter filter;
+        vecMessages[0].second >> nProp >> filter >> nCursor;
+        BOOST_CHECK(nProp == nPropExpected);
+        BOOST_CHECK(nCursor == nCursorExpected);
+    }
+
+    static uint256 MakeCursor(uint8_t n)
+    {
+        // uint256 compares bytewise starting with the first byte
+        uint256 ret;
+        *ret.begin() = n;
+        return ret;
+    }
+};
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(governance_sync_tests, GovernanceSyncSetup)
+
+BOOST_AUTO_TEST_CASE(governance_sync_objects_paged)
+{
+    const int PAGE = CGovernanceManager::SYNC_PAGE_SIZE;
+    std::vector<uint256> vecHashes;
+    for (int i = 0; i < PAGE + 10; i++) {
+        CGovernanceObject govobj(uint256(), 1, GetAdjustedTime(), InsecureRand256(), "");
+        governanceDb->WriteObject(govobj);
+        vecHashes.emplace_back(govobj.GetHash());
+    }
+    std::sort(vecHashes.begin(), vecHashes.end());
+    governance.LoadFromDB();
+    BOOST_REQUIRE(masternodeSync.IsSynced());
+
+    CNode& node = AddNode();
+    const uint256 nFirstPage;
+    auto ds = MakeSyncRequest(uint256(), &nFirstPage);
+    ProcessMessage(node, NetMsgType::MNGOVERNANCESYNC, ds);
+    BOOST_CHECK(TakeInventory(node, MSG_GOVERNANCE_OBJECT) == std::vector<uint256>(vecHashes.begin(), vecHashes.begin() + PAGE));
+    CheckPage(CheckSyncStatusCount(node, MASTERNODE_SYNC_GOVOBJ, PAGE), uint256(), vecHashes[PAGE - 1]);
+
+    // only the page offered last is sent
+    ds = MakeSyncRequest(uint256(), &vecHashes[5]);
+    ProcessMessage(node, NetMsgType::MNGOVERNANCESYNC, ds);
+    BOOST_CHECK(TakeInventory(node, MSG_GOVERNANCE_OBJECT).empty());
+    BOOST_CHECK(TakeMessages(node).empty());
+
+    ds = MakeSyncRequest(uint256(), &vecHashes[PAGE - 1]);
+    ProcessMessage(node, NetMsgType::MNGOVERNANCESYNC, ds);
+    BOOST_CHECK(TakeInventory(node, MSG_GOVERNANCE_OBJECT) == std::vector<uint256>(vecHashes.begin() + PAGE, vecHashes.end()));
+    CheckPage(CheckSyncStatusCount(node, MASTERNODE_SYNC_GOVOBJ, 10), uint256(), uint256());
+
+    // the last page doesn't offer another one
+    ds = MakeSyncRequest(uint256(), &vecHashes[PAGE - 1]);
+    ProcessMessage(node, NetMsgType::MNGOVERNANCESYNC, ds);
+    BOOST_CHECK(TakeInventory(node, MSG_GOVERNANCE_OBJECT).empty());
+    BOOST_CHECK(TakeMessages(node).empty());
+
+    // a peer which doesn't page gets the whole list and the status count without a cursor
+    CNode& nodeLegacy = AddNode();
+    ds = MakeSyncRequest(uint256(), nullptr);
+    ProcessMessage(nodeLegacy, NetMsgType::MNGOVERNANCESYNC, ds);
+    BOOST_CHECK(TakeInventory(nodeLegacy, MSG_GOVERNANCE_OBJECT) == vecHashes);
+    BOOST_CHECK(CheckSyncStatusCount(nodeLegacy, MASTERNODE_SYNC_GOVOBJ, PAGE + 10).empty());
+}
+
+BOOST_AUTO_TEST_CASE(governance_sync_votes_paged)
+{
+    const int PAGE = CGovernanceManager::SYNC_PAGE_SIZE;
+    CGovernanceObject govobj(uint256(), 1, GetAdjustedTime(), InsecureRand256(), "");
+    const uint256 nProp = govobj.GetHash();
+    governanceDb->WriteObject(govobj);
+    std::vector<CGovernanceVote> vecVotes;
+    std::vector<uint256> vecHashes;
+    for (int i = 0; i < PAGE + 10; i++) {
+        CGovernanceVote vote(COutPoint(InsecureRand256(), 0), nProp, VOTE_SIGNAL_FUNDING, VOTE_OUTCOME_YES);
+        vote.SetTime(GetAdjustedTime());
+        vecVotes.emplace_back(vote);
+        vecHashes.emplace_back(vote.GetHash());
+    }
+    std::sort(vecHashes.begin(), vecHashes.end());
+    governanceDb->WriteVotes(vecVotes);
+    governance.LoadFromDB();
+    BOOST_REQUIRE(masternodeSync.IsSynced());
+
+    // none of the masternodes is in the list at the tip, so no vote is sent, but the votes still fill the pages
+    CNode& node = AddNode();
+    const uint256 nFirstPage;
+    auto ds = MakeSyncRequest(nProp, &nFirstPage);
+    ProcessMessage(node, NetMsgType::MNGOVERNANCESYNC, ds);
+    BOOST_CHECK(TakeInventory(node, MSG_GOVERNANCE_OBJECT_VOTE).empty());
+    CheckPage(CheckSyncStatusCount(node, MASTERNODE_SYNC_GOVOBJ_VOTE, 0), nProp, vecHashes[PAGE - 1]);
+
+    // a page starts behind its cursor
+    ds = MakeSyncRequest(nProp, &vecHashes[8]);
+    ProcessMessage(node, NetMsgType::MNGOVERNANCESYNC, ds);
+    CheckPage(CheckSyncStatusCount(node, MASTERNODE_SYNC_GOVOBJ_VOTE, 0), nProp, vecHashes[PAGE + 8]);
+
+    // a page which ends with the last vote doesn't offer another one
+    ds = MakeSyncRequest(nProp, &vecHashes[9]);
+    ProcessMessage(node, NetMsgType::MNGOVERNANCESYNC, ds);
+    CheckPage(CheckSyncStatusCount(node, MASTERNODE_SYNC_GOVOBJ_VOTE, 0), nProp, uint256());
+
+    ds = MakeSyncRequest(nProp, &vecHashes[PAGE - 1]);
+    ProcessMessage(node, NetMsgType::MNGOVERNANCESYNC, ds);
+    CheckPage(CheckSyncStatusCount(node, MASTERNODE_SYNC_GOVOBJ_VOTE, 0), nProp, uint256());
+
+    // the cursor doesn't have to be the hash of a vote
+    uint256 nCursor = vecHashes[PAGE + 5];
+    *(nCursor.end() - 1) ^= 1;
+    ds = MakeSyncRequest(nProp, &nCursor);
+    ProcessMessage(node, NetMsgType::MNGOVERNANCESYNC, ds);
+    CheckPage(CheckSyncStatusCount(node, MASTERNODE_SYNC_GOVOBJ_VOTE, 0), nProp, uint256());
+
+    // a peer which doesn't page gets the status count without a cursor
+    ds = MakeSyncRequest(nProp, nullptr);
+    ProcessMessage(node, NetMsgType::MNGOVERNANCESYNC, ds);
+    BOOST_CHECK(CheckSyncStatusCount(node, MASTERNODE_SYNC_GOVOBJ_VOTE, 0).empty());
+}
+
+BOOST_AUTO_TEST_CASE(governance_sync_follow_requested_pages)
+{
+    CGovernanceObject govobj(uint256(), 1, GetAdjustedTime(), InsecureRand256(), "");
+    const uint256 nProp = govobj.GetHash();
+    governanceDb->WriteObject(govobj);
+    governance.LoadFromDB();
+    BOOST_REQUIRE(masternodeSync.IsSynced());
+
+    CNode& node = AddNode();
+
+    // pages we didn't ask for are not followed
+    auto ds = MakeSyncStatusCount(MASTERNODE_SYNC_GOVOBJ, 1, uint256(), MakeCursor(1));
+    ProcessMessage(node, NetMsgType::SYNCSTATUSCOUNT, ds);
+    ds = MakeSyncStatusCount(MASTERNODE_SYNC_GOVOBJ_VOTE, 1, nProp, MakeCursor(1));
+    ProcessMessage(node, NetMsgType::SYNCSTATUSCOUNT, ds);
+    BOOST_CHECK(TakeMessages(node).empty());
+
+    governance.RequestObjectList(&node, *m_node.connman);
+    CheckSyncRequest(node, uint256(), uint256());
+    ds = MakeSyncStatusCount(MASTERNODE_SYNC_GOVOBJ, 1, uint256(), MakeCursor(2));
+    ProcessMessage(node, NetMsgType::SYNCSTATUSCOUNT, ds);
+    CheckSyncRequest(node, uint256(), MakeCursor(2));
+
+    // neither the same page again nor one before it
+    ds = MakeSyncStatusCount(MASTERNODE_SYNC_GOVOBJ, 1, uint256(), MakeCursor(2));
+    ProcessMessage(node, NetMsgType::SYNCSTATUSCOUNT, ds);
+    ds = MakeSyncStatusCount(MASTERNODE_SYNC_GOVOBJ, 1, uint256(), MakeCursor(1));
+    ProcessMessage(node, NetMsgType::SYNCSTATUSCOUNT, ds);
+    BOOST_CHECK(TakeMessages(node).empty());
+
+    // nothing is followed after the last page
+    ds = MakeSyncStatusCount(MASTERNODE_SYNC_GOVOBJ, 1, uint256(), uint256());
+    ProcessMessage(node, NetMsgType::SYNCSTATUSCOUNT, ds);
+    ds = MakeSyncStatusCount(MASTERNODE_SYNC_GOVOBJ, 1, uint256(), MakeCursor(3));
+    ProcessMessage(node, NetMsgType::SYNCSTATUSCOUNT, ds);
+    BOOST_CHECK(TakeMessages(node).empty());
+
+    // the votes of an object are followed the same way, pages of other objects are not
+    BOOST_CHECK_EQUAL(governance.RequestGovernanceObjectVotes(&node, *m_node.connman, *m_node.peerman), 0);
+    CheckSyncRequest(node, nProp, uint256());
+    ds = MakeSyncStatusCount(MASTERNODE_SYNC_GOVOBJ_VOTE, 1, InsecureRand256(), MakeCursor(1));
+    ProcessMessage(node, NetMsgType::SYNCSTATUSCOUNT, ds);
+    BOOST_CHECK(TakeMessages(node).empty());
+    ds = MakeSyncStatusCount(MASTERNODE_SYNC_GOVOBJ_VOTE, 1, nProp, MakeCursor(1));
+    ProcessMessage(node, NetMsgType::SYNCSTATUSCOUNT, ds);
+    CheckSyncRequest(node, nProp, MakeCursor(1));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,247 @@
+// Copyright (c) 2021 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <test/util/setup_common.h>
+
+#include <banman.h>
+#include <bls/bls.h>
+#include <evo/deterministicmns.h>
+#include <governance/governance.h>
+#include <governance/governancedb.h>
+#include <governance/governanceobject.h>
+#include <governance/governancevote.h>
+#include <key.h>
+#include <masternode/masternodesync.h>
+#include <net.h>
+#include <net_processing.h>
+#include <protocol.h>
+#include <timedata.h>
+#include <util/time.h>
+
+#include <boost/test/unit_test.hpp>
+
+namespace {
+struct MasternodeKeys
+{
+    CBLSSecretKey operatorKey;
+    CKey votingKey;
+    CDeterministicMNCPtr dmn;
+};
+
+MasternodeKeys MakeMasternode(uint64_t nInternalId)
+{
+    MasternodeKeys mn;
+    mn.operatorKey.MakeNewKey();
+    mn.votingKey.MakeNewKey(true);
+    auto dmn = std::make_shared<CDeterministicMN>(nInternalId);
+    dmn->proTxHash = InsecureRand256();
+    dmn->collateralOutpoint = COutPoint(InsecureRand256(), 0);
+    auto state = std::make_shared<CDeterministicMNState>();
+    state->keyIDOwner = CKeyID(uint160(g_insecure_rand_ctx.randbytes(20)));
+    state->pubKeyOperator.Set(mn.operatorKey.GetPublicKey());
+    state->keyIDVoting = mn.votingKey.GetPubKey().GetID();
+    dmn->pdmnState = state;
+    mn.dmn = dmn;
+    return mn;
+}
+
+CGovernanceManager::PendingVote MakeOperatorVote(NodeId nodeId, const COutPoint& mnOutpoint, const CBLSSecretKey& key)
+{
+    CGovernanceVote vote(mnOutpoint, InsecureRand256(), VOTE_SIGNAL_DELETE, VOTE_OUTCOME_YES);
+    BOOST_REQUIRE(vote.Sign(key));
+    return CGovernanceManager::PendingVote{nodeId, vote, false, 0};
+}
+
+CGovernanceManager::PendingVote MakeFundingVote(NodeId nodeId, const COutPoint& mnOutpoint, const CKey& key)
+{
+    CGovernanceVote vote(mnOutpoint, InsecureRand256(), VOTE_SIGNAL_FUNDING, VOTE_OUTCOME_YES);
+    BOOST_REQUIRE(vote.Sign(key, key.GetPubKey().GetID()));
+    return CGovernanceManager::PendingVote{nodeId, vote, true, 0};
+}
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(governance_votes_tests, TestingSetup)
+
+BOOST_AUTO_TEST_CASE(governance_vote_batch_verify)
+{
+    std::vector<MasternodeKeys> mns;
+    CDeterministicMNList mnList(InsecureRand256(), 1, 0);
+    for (int i = 0; i < 4; i++) {
+        mns.emplace_back(MakeMasternode(i));
+        mnList.AddMN(mns.back().dmn);
+    }
+    CBLSSecretKey wrongOperatorKey;
+    wrongOperatorKey.MakeNewKey();
+    CKey wrongVotingKey;
+    wrongVotingKey.MakeNewKey(true);
+    const COutPoint unknownOutpoint(InsecureRand256(), 0);
+
+    std::vector<CGovernanceManager::PendingVote> vecVotes;
+    vecVotes.emplace_back(MakeOperatorVote(1, mns[0].dmn->collateralOutpoint, mns[0].operatorKey));
+    vecVotes.emplace_back(MakeOperatorVote(2, mns[1].dmn->collateralOutpoint, mns[1].operatorKey));
+    // a bad signature in a batch only fails the vote it belongs to, also for other votes of the same node
+    vecVotes.emplace_back(MakeOperatorVote(2, mns[2].dmn->collateralOutpoint, wrongOperatorKey));
+    vecVotes.emplace_back(MakeFundingVote(1, mns[3].dmn->collateralOutpoint, mns[3].votingKey));
+    vecVotes.emplace_back(MakeFundingVote(1, mns[3].dmn->collateralOutpoint, wrongVotingKey));
+    // a masternode which is not in the list can't be verified here and must not be reported as valid
+    vecVotes.emplace_back(MakeOperatorVote(3, unknownOutpoint, wrongOperatorKey));
+    vecVotes.emplace_back(MakeFundingVote(3, unknownOutpoint, wrongVotingKey));
+
+    const std::vector<VoteSigCheck> vecExpected{VoteSigCheck::VALID, VoteSigCheck::VALID, VoteSigCheck::INVALID,
+                                                VoteSigCheck::VALID, VoteSigCheck::INVALID,
+                                                VoteSigCheck::UNCHECKED, VoteSigCheck::UNCHECKED};
+    BOOST_CHECK(CGovernanceManager::VerifyVoteSignatures(vecVotes, 0, vecVotes.size(), mnList) == vecExpected);
+
+    // the verification pool checks the votes in ranges
+    auto vecRange = CGovernanceManager::VerifyVoteSignatures(vecVotes, 2, 3, mnList);
+    BOOST_CHECK(std::vector<VoteSigCheck>(vecExpected.begin() + 2, vecExpected.begin() + 5) == vecRange);
+}
+
+BOOST_AUTO_TEST_CASE(governance_vote_changed_keys)
+{
+    std::vector<MasternodeKeys> mns;
+    for (int i = 0; i < 4; i++) {
+        mns.emplace_back(MakeMasternode(i));
+    }
+    CDeterministicMNList mnList(InsecureRand256(), 1, 0);
+    CDeterministicMNList mnListTip(InsecureRand256(), 2, 0);
+    for (const auto& mn : mns) {
+        mnList.AddMN(mn.dmn);
+    }
+    // mns[0] was removed, mns[1] got a new operator key and mns[2] a new voting key, mns[3] is unchanged
+    for (size_t i = 1; i < mns.size(); i++) {
+        auto dmn = std::make_shared<CDeterministicMN>(*mns[i].dmn);
+        auto state = std::make_shared<CDeterministicMNState>(*dmn->pdmnState);
+        if (i == 1) {
+            CBLSSecretKey newOperatorKey;
+            newOperatorKey.MakeNewKey();
+            state->pubKeyOperator.Set(newOperatorKey.GetPublicKey());
+        } else if (i == 2) {
+            CKey newVotingKey;
+            newVotingKey.MakeNewKey(true);
+            state->keyIDVoting = newVotingKey.GetPubKey().GetID();
+        }
+        dmn->pdmnState = state;
+        mnListTip.AddMN(dmn);
+    }
+
+    std::vector<CGovernanceManager::PendingVote> vecVotes;
+    vecVotes.emplace_back(MakeOperatorVote(1, mns[0].dmn->collateralOutpoint, mns[0].operatorKey));
+    vecVotes.emplace_back(MakeOperatorVote(1, mns[1].dmn->collateralOutpoint, mns[1].operatorKey));
+    vecVotes.emplace_back(MakeFundingVote(1, mns[1].dmn->collateralOutpoint, mns[1].votingKey));
+    vecVotes.emplace_back(MakeOperatorVote(1, mns[2].dmn->collateralOutpoint, mns[2].operatorKey));
+    vecVotes.emplace_back(MakeFundingVote(1, mns[2].dmn->collateralOutpoint, mns[2].votingKey));
+    vecVotes.emplace_back(MakeOperatorVote(1, mns[3].dmn->collateralOutpoint, mns[3].operatorKey));
+    vecVotes.emplace_back(MakeOperatorVote(1, mns[3].dmn->collateralOutpoint, mns[0].operatorKey));
+
+    auto vecResults = CGovernanceManager::VerifyVoteSignatures(vecVotes, 0, vecVotes.size(), mnList);
+    const std::vector<VoteSigCheck> vecVerified{VoteSigCheck::VALID, VoteSigCheck::VALID, VoteSigCheck::VALID,
+                                                VoteSigCheck::VALID, VoteSigCheck::VALID, VoteSigCheck::VALID,
+                                                VoteSigCheck::INVALID};
+    BOOST_CHECK(vecResults == vecVerified);
+
+    // nothing changes when the tip is still the list the votes were verified against
+    auto vecSameList = vecResults;
+    CGovernanceManager::UncheckChangedVoteKeys(vecVotes, mnList, mnList, vecSameList);
+    BOOST_CHECK(vecSameList == vecVerified);
+
+    // only the votes verified with a key which isn't current anymore need a full check, invalid ones stay invalid
+    CGovernanceManager::UncheckChangedVoteKeys(vecVotes, mnList, mnListTip, vecResults);
+    const std::vector<VoteSigCheck> vecExpected{VoteSigCheck::UNCHECKED, VoteSigCheck::UNCHECKED, VoteSigCheck::VALID,
+                                                VoteSigCheck::VALID, VoteSigCheck::UNCHECKED, VoteSigCheck::VALID,
+                                                VoteSigCheck::INVALID};
+    BOOST_CHECK(vecResults == vecExpected);
+}
+
+BOOST_AUTO_TEST_CASE(governance_vote_batch_result)
+{
+    const auto mn1 = MakeMasternode(0);
+    const auto mn2 = MakeMasternode(1);
+    CDeterministicMNList mnList(InsecureRand256(), 1, 0);
+    mnList.AddMN(mn1.dmn);
+    mnList.AddMN(mn2.dmn);
+    CGovernanceObject govobj(uint256(), 1, GetAdjustedTime(), InsecureRand256(), "");
+    const int64_t nNow = GetAdjustedTime();
+    auto makeVote = [&](const MasternodeKeys& mn, int64_t nTime) {
+        CGovernanceVote vote(mn.dmn->collateralOutpoint, govobj.GetHash(), VOTE_SIGNAL_DELETE, VOTE_OUTCOME_YES);
+        vote.SetTime(nTime);
+        BOOST_CHECK(vote.Sign(mn.operatorKey));
+        return vote;
+    };
+
+    // the masternodes are only in the list the batch was checked against, which is used instead of the one at the tip
+    CGovernanceException exception;
+    BOOST_CHECK(!govobj.ProcessVote(nullptr, makeVote(mn1, nNow), exception, *m_node.connman));
+    BOOST_CHECK_EQUAL(exception.GetNodePenalty(), 20);
+    BOOST_CHECK(govobj.ProcessVote(nullptr, makeVote(mn1, nNow), exception, *m_node.connman, VoteSigCheck::VALID, &mnList));
+
+    // a vote which failed the batched signature check is rejected by the other checks first, an obsolete one isn't penalized
+    exception = CGovernanceException();
+    BOOST_CHECK(!govobj.ProcessVote(nullptr, makeVote(mn1, nNow - 10), exception, *m_node.connman, VoteSigCheck::INVALID, &mnList));
+    BOOST_CHECK_EQUAL(exception.GetNodePenalty(), 0);
+
+    // otherwise it is penalized like a signature failing the full check
+    BOOST_CHECK(!govobj.ProcessVote(nullptr, makeVote(mn2, nNow), exception, *m_node.connman, VoteSigCheck::INVALID, &mnList));
+    BOOST_CHECK_EQUAL(exception.GetNodePenalty(), 20);
+    BOOST_CHECK_EQUAL(govobj.GetVoteHashes().size(), 1U);
+
+    governance.Clear();
+}
+
+BOOST_AUTO_TEST_CASE(governance_vote_queue_penalty)
+{
+    governanceDb.reset(new CGovernanceDB(1 << 20, true));
+    CGovernanceObject govobj(uint256(), 1, GetAdjustedTime(), InsecureRand256(), "");
+    governanceDb->WriteObject(govobj);
+    governance.LoadFromDB();
+    masternodeSync.SwitchToNextAsset(*m_node.connman);
+    masternodeSync.SwitchToNextAsset(*m_node.connman);
+    BOOST_REQUIRE(masternodeSync.IsSynced());
+    governance.StartWorkerThread(*m_node.connman, *m_node.peerman);
+
+    struct in_addr s;
+    s.s_addr = 0xa0b0c001;
+    const CAddress addr(CService(CNetAddr(s), Params().GetDefaultPort()), NODE_NONE);
+    CNode node(0, NODE_NETWORK, INVALID_SOCKET, addr, /* nKeyedNetGroupIn */ 0, /* nLocalHostNonceIn */ 0, CAddress(),
+               /* pszDest */ "", ConnectionType::INBOUND, /* inbound_onion */ false);
+    node.SetCommonVersion(PROTOCOL_VERSION);
+    m_node.peerman->InitializeNode(&node);
+    node.fSuccessfullyConnected = true;
+
+    // votes of masternodes which are not in the list are queued and rejected by the full check after the batch, each
+    // one is penalized like an invalid signature
+    const uint64_t nVotesBefore = governance.GetVoteVerifyStats().nVotes;
+    const int nVotes = 5;
+    for (int i = 0; i < nVotes; i++) {
+        CBLSSecretKey key;
+        key.MakeNewKey();
+        CGovernanceVote vote(COutPoint(InsecureRand256(), 0), govobj.GetHash(), VOTE_SIGNAL_DELETE, VOTE_OUTCOME_YES);
+        BOOST_REQUIRE(vote.Sign(key));
+        BOOST_REQUIRE(governance.ConfirmInventoryRequest(GenTxid(false, vote.GetHash(), MSG_GOVERNANCE_OBJECT_VOTE)));
+        CDataStream ds(SER_NETWORK, PROTOCOL_VERSION);
+        ds << vote;
+        governance.ProcessMessage(&node, NetMsgType::MNGOVERNANCEOBJECTVOTE, ds, *m_node.connman, *m_node.peerman);
+    }
+    for (int i = 0; i < 1000 && governance.GetVoteVerifyStats().nVotes < nVotesBefore + nVotes; i++) {
+        UninterruptibleSleep(std::chrono::milliseconds{10});
+    }
+    BOOST_CHECK_EQUAL(governance.GetVoteVerifyStats().nVotes, nVotesBefore + nVotes);
+    BOOST_CHECK_EQUAL(governance.GetVoteCount(), 0);
+
+    {
+        LOCK(node.cs_sendProcessing);
+        BOOST_CHECK(m_node.peerman->SendMessages(&node));
+    }
+    BOOST_CHECK(m_node.banman->IsDiscouraged(addr));
+
+    governance.InterruptWorkerThread();
+    governance.StopWorkerThread();
+    m_node.peerman->FinalizeNode(node);
+    m_node.banman->ClearBanned();
+    masternodeSync.Reset(true, false);
+    governance.Clear();
+    governanceDb.reset();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
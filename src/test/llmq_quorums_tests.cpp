@@ -0,0 +1,196 @@
+// Copyright (c) 2021 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <test/util/setup_common.h>
+
+#include <arith_uint256.h>
+#include <bls/bls_worker.h>
+#include <chainparams.h>
+#include <evo/deterministicmns.h>
+#include <evo/evodb.h>
+#include <hash.h>
+#include <llmq/quorums.h>
+#include <llmq/quorums_commitment.h>
+#include <masternode/activemasternode.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace llmq;
+
+namespace {
+struct QuorumDataSetup : public TestingSetup
+{
+    CBLSWorker worker;
+    const Consensus::LLMQParams& params{Params().GetConsensus().llmqs.at(Consensus::LLMQ_TEST)};
+    const uint256 quorumHash{ArithToUint256(arith_uint256(1))};
+    std::vector<CDeterministicMNCPtr> members;
+    BLSVerificationVector vvec;
+    // the key share of the first member, which is this node
+    CBLSSecretKey skShare;
+    CBLSSecretKey operatorKey;
+
+    QuorumDataSetup() : TestingSetup(CBaseChainParams::REGTEST)
+    {
+        BLSIdVector ids;
+        for (int i = 0; i < params.size; i++) {
+            auto dmn = std::make_shared<CDeterministicMN>(i);
+            dmn->proTxHash = ArithToUint256(arith_uint256(i + 1));
+            members.emplace_back(dmn);
+            ids.emplace_back(CBLSId::FromHash(dmn->proTxHash));
+        }
+        BLSVerificationVectorPtr vvecPtr;
+        BLSSecretKeyVector skShares;
+        BOOST_REQUIRE(worker.GenerateContributions(params.threshold, ids, vvecPtr, skShares));
+        vvec = *vvecPtr;
+        skShare = skShares[0];
+        activeMasternodeInfo.proTxHash = members[0]->proTxHash;
+        operatorKey.MakeNewKey();
+        SetOperatorKey(operatorKey);
+    }
+    ~QuorumDataSetup()
+    {
+        activeMasternodeInfo.proTxHash.SetNull();
+        activeMasternodeInfo.blsKeyOperator.reset();
+        activeMasternodeInfo.blsPubKeyOperator.reset();
+    }
+
+    static void SetOperatorKey(const CBLSSecretKey& sk)
+    {
+        activeMasternodeInfo.blsKeyOperator = std::make_unique<CBLSSecretKey>(sk);
+        activeMasternodeInfo.blsPubKeyOperator = std::make_unique<CBLSPublicKey>(sk.GetPublicKey());
+    }
+
+    // a quorum as built by CQuorumManager before its contributions are known
+    std::shared_ptr<CQuorum> MakeQuorum()
+    {
+        auto qc = std::make_shared<CFinalCommitment>(params, quorumHash);
+        for (int i = 0; i < params.size; i++) {
+            qc->validMembers[i] = true;
+        }
+        auto quorum = std::make_shared<CQuorum>(params, worker);
+        quorum->Init(qc, nullptr, uint256(), members);
+        return quorum;
+    }
+
+    // same as the key CQuorum binds its stored data to
+    uint256 QuorumKey() const
+    {
+        CHashWriter hw(SER_NETWORK, 0);
+        hw << params.type;
+        hw << quorumHash;
+        for (const auto& dmn : members) {
+            hw << dmn->proTxHash;
+        }
+        return hw.GetHash();
+    }
+};
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(llmq_quorums_tests, QuorumDataSetup)
+
+BOOST_AUTO_TEST_CASE(quorum_data_roundtrip)
+{
+    auto quorum = MakeQuorum();
+    quorum->quorumVvec = std::make_shared<BLSVerificationVector>(vvec);
+    quorum->skShare = skShare;
+    quorum->WriteContributions();
+
+    // the stored skShare must survive serialization as a valid encrypted blob
+    CQuorumDataRecord record;
+    BOOST_CHECK(evoDb->GetRawDB().Read(std::make_tuple(std::string("q_Qdata"), params.type, quorumHash), record));
+    BOOST_CHECK(record.quorumKey == QuorumKey());
+    BOOST_CHECK(record.skShare.IsValid());
+    CDataStream ds(SER_DISK, PROTOCOL_VERSION);
+    ds << record;
+    CQuorumDataRecord record2;
+    ds >> record2;
+    BOOST_CHECK(record2.skShare.IsValid());
+
+    // as after a restart
+    auto quorum2 = MakeQuorum();
+    BOOST_CHECK(quorum2->ReadContributions());
+    BOOST_CHECK(quorum2->quorumVvec != nullptr && *quorum2->quorumVvec == vvec);
+    BOOST_CHECK(quorum2->skShare.IsValid());
+    BOOST_CHECK(quorum2->skShare == skShare);
+
+    // another operator key can't decrypt it, the quorum is still usable as a non-member
+    CBLSSecretKey otherKey;
+    otherKey.MakeNewKey();
+    SetOperatorKey(otherKey);
+    auto quorum3 = MakeQuorum();
+    BOOST_CHECK(quorum3->ReadContributions());
+    BOOST_CHECK(quorum3->quorumVvec != nullptr && *quorum3->quorumVvec == vvec);
+    BOOST_CHECK(!quorum3->skShare.IsValid());
+
+    // data stored for another member list is not used
+    members.pop_back();
+    BOOST_CHECK(!MakeQuorum()->ReadContributions());
+}
+
+BOOST_AUTO_TEST_CASE(quorum_data_legacy_migration)
+{
+    const uint256 dbKey = QuorumKey();
+    const auto vvecKey = std::make_pair(std::string("q_Qqvvec"), dbKey);
+    const auto skShareKey = std::make_pair(std::string("q_Qsk"), dbKey);
+    evoDb->GetRawDB().Write(vvecKey, vvec);
+    evoDb->GetRawDB().Write(skShareKey, skShare);
+
+    auto quorum = MakeQuorum();
+    BOOST_CHECK(quorum->ReadContributions());
+    BOOST_CHECK(quorum->quorumVvec != nullptr && *quorum->quorumVvec == vvec);
+    BOOST_CHECK(quorum->skShare == skShare);
+    // moved to an encrypted record, the plaintext entries are gone
+    BOOST_CHECK(!evoDb->GetRawDB().Exists(vvecKey));
+    BOOST_CHECK(!evoDb->GetRawDB().Exists(skShareKey));
+
+    auto quorum2 = MakeQuorum();
+    BOOST_CHECK(quorum2->ReadContributions());
+    BOOST_CHECK(quorum2->skShare == skShare);
+}
+
+BOOST_AUTO_TEST_CASE(quorum_data_legacy_migration_no_operator_key)
+{
+    const uint256 dbKey = QuorumKey();
+    const auto skShareKey = std::make_pair(std::string("q_Qsk"), dbKey);
+    evoDb->GetRawDB().Write(std::make_pair(std::string("q_Qqvvec"), dbKey), vvec);
+    evoDb->GetRawDB().Write(skShareKey, skShare);
+
+    // without an operator key the skShare can't be encrypted, the plaintext entry is kept to be migrated later
+    activeMasternodeInfo.blsKeyOperator.reset();
+    activeMasternodeInfo.blsPubKeyOperator.reset();
+    auto quorum = MakeQuorum();
+    BOOST_CHECK(quorum->ReadContributions());
+    BOOST_CHECK(quorum->skShare == skShare);
+    BOOST_CHECK(evoDb->GetRawDB().Exists(skShareKey));
+}
+
+BOOST_AUTO_TEST_CASE(quorum_data_legacy_migration_encrypt_fails)
+{
+    const uint256 dbKey = QuorumKey();
+    const auto vvecKey = std::make_pair(std::string("q_Qqvvec"), dbKey);
+    const auto skShareKey = std::make_pair(std::string("q_Qsk"), dbKey);
+    evoDb->GetRawDB().Write(vvecKey, vvec);
+    evoDb->GetRawDB().Write(skShareKey, skShare);
+
+    // an operator key is set but the skShare can't be encrypted to it, nothing is written and the legacy entries
+    // must be kept as they are the only copy of the skShare
+    activeMasternodeInfo.blsPubKeyOperator = std::make_unique<CBLSPublicKey>();
+    auto quorum = MakeQuorum();
+    BOOST_CHECK(quorum->ReadContributions());
+    BOOST_CHECK(quorum->skShare == skShare);
+    CQuorumDataRecord record;
+    BOOST_CHECK(!evoDb->GetRawDB().Read(std::make_tuple(std::string("q_Qdata"), params.type, quorumHash), record));
+    BOOST_CHECK(evoDb->GetRawDB().Exists(vvecKey));
+    BOOST_CHECK(evoDb->GetRawDB().Exists(skShareKey));
+
+    // migrated once it can be encrypted
+    SetOperatorKey(operatorKey);
+    auto quorum2 = MakeQuorum();
+    BOOST_CHECK(quorum2->ReadContributions());
+    BOOST_CHECK(quorum2->skShare == skShare);
+    BOOST_CHECK(!evoDb->GetRawDB().Exists(vvecKey));
+    BOOST_CHECK(!evoDb->GetRawDB().Exists(skShareKey));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,127 @@
+// Copyright (c) 2021 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <test/util/setup_common.h>
+
+#include <arith_uint256.h>
+#include <bls/bls_worker.h>
+#include <chainparams.h>
+#include <evo/deterministicmns.h>
+#include <llmq/quorums.h>
+#include <llmq/quorums_commitment.h>
+#include <llmq/quorums_signing.h>
+#include <llmq/quorums_signing_shares.h>
+#include <llmq/quorums_utils.h>
+#include <masternode/activemasternode.h>
+#include <util/time.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace llmq;
+
+namespace {
+struct SigSharesSetup : public TestingSetup
+{
+    CBLSWorker worker;
+    Consensus::LLMQParams params;
+    CBLSSecretKey quorumKey;
+    CQuorumCPtr quorum;
+
+    SigSharesSetup() : TestingSetup(CBaseChainParams::REGTEST)
+    {
+        // with a threshold of 1 every member holds the quorum key and our own share is enough to recover,
+        // so the whole signing session runs through the worker thread of this node
+        params = Params().GetConsensus().llmqs.at(Consensus::LLMQ_TEST);
+        params.threshold = 1;
+        quorumKey.MakeNewKey();
+
+        const uint256 quorumHash = ArithToUint256(arith_uint256(1));
+        std::vector<CDeterministicMNCPtr> members;
+        for (int i = 0; i < params.size; i++) {
+            auto dmn = std::make_shared<CDeterministicMN>(i);
+            dmn->proTxHash = ArithToUint256(arith_uint256(i + 1));
+            members.emplace_back(dmn);
+        }
+        auto qc = std::make_shared<CFinalCommitment>(params, quorumHash);
+        for (int i = 0; i < params.size; i++) {
+            qc->validMembers[i] = true;
+        }
+        qc->quorumPublicKey = quorumKey.GetPublicKey();
+        auto q = std::make_shared<CQuorum>(params, worker);
+        q->Init(qc, nullptr, uint256(), members);
+        q->quorumVvec = std::make_shared<BLSVerificationVector>(BLSVerificationVector{quorumKey.GetPublicKey()});
+        q->skShare = quorumKey;
+        quorum = q;
+
+        fMasternodeMode = true;
+        activeMasternodeInfo.proTxHash = members[0]->proTxHash;
+        quorumSigSharesManager->RegisterAsRecoveredSigsListener();
+        quorumSigSharesManager->StartWorkerThread();
+    }
+    ~SigSharesSetup()
+    {
+        quorumSigSharesManager->InterruptWorkerThread();
+        quorumSigSharesManager->StopWorkerThread();
+        quorumSigSharesManager->UnregisterAsRecoveredSigsListener();
+        activeMasternodeInfo.proTxHash.SetNull();
+        fMasternodeMode = false;
+    }
+};
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(llmq_signing_shares_tests, SigSharesSetup)
+
+BOOST_AUTO_TEST_CASE(sigshares_sign_and_recover)
+{
+    // enough sessions to touch every shard
+    std::vector<std::pair<uint256, uint256>> sessions;
+    for (size_t i = 0; i < 4 * CSigSharesManager::SHARD_COUNT; i++) {
+        sessions.emplace_back(InsecureRand256(), InsecureRand256());
+    }
+    const uint64_t nShardLocks = quorumSigSharesManager->GetShardLockStats().nLocks;
+    for (const auto& p : sessions) {
+        quorumSigSharesManager->AsyncSign(quorum, p.first, p.second);
+    }
+
+    auto allRecovered = [&]() {
+        for (const auto& p : sessions) {
+            if (!quorumSigningManager->HasRecoveredSigForId(params.type, p.first)) {
+                return false;
+            }
+        }
+        return true;
+    };
+    for (int i = 0; i < 3000 && !allRecovered(); i++) {
+        UninterruptibleSleep(std::chrono::milliseconds{10});
+    }
+    BOOST_REQUIRE(allRecovered());
+
+    for (const auto& p : sessions) {
+        CRecoveredSig recSig;
+        BOOST_CHECK(quorumSigningManager->GetRecoveredSigForId(params.type, p.first, recSig));
+        BOOST_CHECK(recSig.msgHash == p.second);
+        BOOST_CHECK(recSig.sig.Get().VerifyInsecure(quorumKey.GetPublicKey(), CLLMQUtils::BuildSignHash(recSig)));
+    }
+
+    // every session took its shard lock at least to add the share and to recover from it
+    const CSigSharesLockStats& stats = quorumSigSharesManager->GetShardLockStats();
+    BOOST_CHECK(stats.nLocks >= nShardLocks + 2 * sessions.size());
+    BOOST_CHECK(stats.nContended <= stats.nLocks);
+}
+
+BOOST_AUTO_TEST_CASE(sigshares_non_member)
+{
+    const uint256 id = InsecureRand256();
+    const uint256 msgHash = InsecureRand256();
+    BOOST_CHECK(quorumSigSharesManager->CreateSigShare(quorum, id, msgHash).sigShare.Get().IsValid());
+
+    // a node which is not part of the quorum doesn't create a share and nothing is recovered
+    activeMasternodeInfo.proTxHash = ArithToUint256(arith_uint256(params.size + 1));
+    BOOST_CHECK(!quorumSigSharesManager->CreateSigShare(quorum, id, msgHash).sigShare.Get().IsValid());
+    quorumSigSharesManager->AsyncSign(quorum, id, msgHash);
+    UninterruptibleSleep(std::chrono::milliseconds{300});
+    BOOST_CHECK(!quorumSigningManager->HasRecoveredSigForId(params.type, id));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
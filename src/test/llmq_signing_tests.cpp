@@ -0,0 +1,188 @@
+// Copyright (c) 2021 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <test/util/setup_common.h>
+
+#include <bls/bls.h>
+#include <dbwrapper.h>
+#include <llmq/quorums_signing.h>
+#include <util/time.h>
+
+#include <tuple>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace llmq;
+
+namespace llmq_signing_tests
+{
+class CRecoveredSigsDbForTest
+{
+public:
+    // the filter answers lookups as long as it hasn't forgotten any key
+    static bool IsFilterUsed(CRecoveredSigsDb& db)
+    {
+        LOCK(db.cs);
+        return db.knownKeysFilter && db.knownKeysFilterInserts < db.knownKeysFilterSize;
+    }
+
+    static unsigned int GetFilterInserts(CRecoveredSigsDb& db)
+    {
+        LOCK(db.cs);
+        return db.knownKeysFilterInserts;
+    }
+
+    static bool MaybeHasRecoveredSig(CRecoveredSigsDb& db, const CRecoveredSig& recSig)
+    {
+        LOCK(db.cs);
+        return db.MaybeHasKey(std::make_tuple(std::string("rs_r"), recSig.llmqType, recSig.id));
+    }
+
+    static bool BeginRebuild(CRecoveredSigsDb& db) { return db.BeginKnownKeysFilterRebuild(); }
+    static std::vector<uint256> ReadKnownKeys(CRecoveredSigsDb& db) { return db.ReadKnownKeys(); }
+    static void FinishRebuild(CRecoveredSigsDb& db, const std::vector<uint256>& keyHashes) { db.FinishKnownKeysFilterRebuild(keyHashes); }
+};
+} // namespace llmq_signing_tests
+
+static CRecoveredSig MakeRecoveredSig()
+{
+    CRecoveredSig recSig;
+    recSig.llmqType = Consensus::LLMQ_TEST;
+    recSig.quorumHash = InsecureRand256();
+    recSig.id = InsecureRand256();
+    recSig.msgHash = InsecureRand256();
+    CBLSSecretKey sk;
+    sk.MakeNewKey();
+    recSig.sig.Set(sk.Sign(recSig.msgHash));
+    recSig.UpdateHash();
+    return recSig;
+}
+
+static bool HasRecoveredSig(CRecoveredSigsDb& db, const CRecoveredSig& recSig)
+{
+    return db.HasRecoveredSigForId(recSig.llmqType, recSig.id) &&
+           db.HasRecoveredSig(recSig.llmqType, recSig.id, recSig.msgHash) &&
+           db.HasRecoveredSigForHash(recSig.GetHash());
+}
+
+BOOST_FIXTURE_TEST_SUITE(llmq_signing_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(recsigs_known_keys_filter)
+{
+    CDBWrapper dbw(m_args.GetDataDirPath() / "llmq_recsigs", 1 << 20, true);
+    CRecoveredSigsDb db(dbw, 1);
+
+    // unknown recovered sigs are filtered out, known ones are found after being written
+    auto recSig = MakeRecoveredSig();
+    BOOST_CHECK(!db.HasRecoveredSigForId(recSig.llmqType, recSig.id));
+    BOOST_CHECK(!db.HasRecoveredSigForHash(recSig.GetHash()));
+    db.WriteRecoveredSig(recSig);
+    BOOST_CHECK(HasRecoveredSig(db, recSig));
+    CRecoveredSig recSig2;
+    BOOST_CHECK(db.GetRecoveredSigById(recSig.llmqType, recSig.id, recSig2));
+    BOOST_CHECK(recSig2.GetHash() == recSig.GetHash());
+
+    // a filter rebuilt from the db (as on startup) knows the keys written before
+    CRecoveredSigsDb db2(dbw, 1);
+    BOOST_CHECK(HasRecoveredSig(db2, recSig));
+    BOOST_CHECK(!db2.HasRecoveredSigForId(recSig.llmqType, InsecureRand256()));
+}
+
+BOOST_AUTO_TEST_CASE(recsigs_known_keys_filter_cleanup)
+{
+    CDBWrapper dbw(m_args.GetDataDirPath() / "llmq_recsigs_cleanup", 1 << 20, true);
+    CRecoveredSigsDb db(dbw, 1);
+
+    const int64_t now = GetTime();
+    SetMockTime(now - 1000);
+    auto oldRecSig = MakeRecoveredSig();
+    db.WriteRecoveredSig(oldRecSig);
+    SetMockTime(now);
+    auto recSig = MakeRecoveredSig();
+    db.WriteRecoveredSig(recSig);
+
+    // removed keys stay in the filter, the db lookup behind it must still report them as gone
+    db.CleanupOldRecoveredSigs(500);
+    BOOST_CHECK(!db.HasRecoveredSigForId(oldRecSig.llmqType, oldRecSig.id));
+    BOOST_CHECK(!db.HasRecoveredSigForHash(oldRecSig.GetHash()));
+    BOOST_CHECK(HasRecoveredSig(db, recSig));
+
+    // and a rebuilt filter doesn't know about them anymore
+    CRecoveredSigsDb db2(dbw, 1);
+    BOOST_CHECK(!db2.HasRecoveredSigForId(oldRecSig.llmqType, oldRecSig.id));
+    BOOST_CHECK(HasRecoveredSig(db2, recSig));
+
+    // keys written after a rebuild are added to the new filter
+    auto newRecSig = MakeRecoveredSig();
+    db2.WriteRecoveredSig(newRecSig);
+    BOOST_CHECK(HasRecoveredSig(db2, newRecSig));
+    SetMockTime(0);
+}
+
+BOOST_AUTO_TEST_CASE(recsigs_known_keys_filter_cleanup_rebuild)
+{
+    CDBWrapper dbw(m_args.GetDataDirPath() / "llmq_recsigs_cleanup_rebuild", 1 << 20, true);
+    // every recovered sig adds 4 keys, so the filter is full after 4 of them
+    CRecoveredSigsDb db(dbw, 1, 16);
+
+    const int64_t now = GetTime();
+    SetMockTime(now - 1000);
+    auto oldRecSig = MakeRecoveredSig();
+    db.WriteRecoveredSig(oldRecSig);
+    SetMockTime(now);
+    std::vector<CRecoveredSig> recSigs;
+    for (int i = 0; i < 3; i++) {
+        recSigs.emplace_back(MakeRecoveredSig());
+        db.WriteRecoveredSig(recSigs.back());
+    }
+    BOOST_CHECK(!CRecoveredSigsDbForTest::IsFilterUsed(db));
+
+    // the cleanup rebuilds the full filter, sized for the keys in the db
+    db.CleanupOldRecoveredSigs(500);
+    BOOST_CHECK(CRecoveredSigsDbForTest::IsFilterUsed(db));
+    BOOST_CHECK_EQUAL(CRecoveredSigsDbForTest::GetFilterInserts(db), 16U);
+    BOOST_CHECK(!db.HasRecoveredSigForId(oldRecSig.llmqType, oldRecSig.id));
+    for (const auto& recSig : recSigs) {
+        BOOST_CHECK(CRecoveredSigsDbForTest::MaybeHasRecoveredSig(db, recSig));
+        BOOST_CHECK(HasRecoveredSig(db, recSig));
+    }
+    BOOST_CHECK(!CRecoveredSigsDbForTest::MaybeHasRecoveredSig(db, MakeRecoveredSig()));
+
+    // the filter was rebuilt before the old recovered sig was removed, the next rebuild forgets its keys
+    db.CleanupOldRecoveredSigs(500);
+    BOOST_CHECK_EQUAL(CRecoveredSigsDbForTest::GetFilterInserts(db), 12U);
+    BOOST_CHECK(!CRecoveredSigsDbForTest::MaybeHasRecoveredSig(db, oldRecSig));
+    BOOST_CHECK(HasRecoveredSig(db, recSigs.front()));
+    SetMockTime(0);
+}
+
+BOOST_AUTO_TEST_CASE(recsigs_known_keys_filter_write_while_rebuilding)
+{
+    CDBWrapper dbw(m_args.GetDataDirPath() / "llmq_recsigs_rebuilding", 1 << 20, true);
+    CRecoveredSigsDb db(dbw, 1, 16);
+    auto recSig = MakeRecoveredSig();
+    db.WriteRecoveredSig(recSig);
+
+    // a recovered sig written after the db was scanned is still added to the new filter
+    BOOST_REQUIRE(CRecoveredSigsDbForTest::BeginRebuild(db));
+    BOOST_CHECK(!CRecoveredSigsDbForTest::BeginRebuild(db));
+    const auto keyHashes = CRecoveredSigsDbForTest::ReadKnownKeys(db);
+    BOOST_CHECK_EQUAL(keyHashes.size(), 4U);
+    auto recSig2 = MakeRecoveredSig();
+    db.WriteRecoveredSig(recSig2);
+    CRecoveredSigsDbForTest::FinishRebuild(db, keyHashes);
+
+    BOOST_CHECK_EQUAL(CRecoveredSigsDbForTest::GetFilterInserts(db), 8U);
+    BOOST_CHECK(CRecoveredSigsDbForTest::MaybeHasRecoveredSig(db, recSig));
+    BOOST_CHECK(CRecoveredSigsDbForTest::MaybeHasRecoveredSig(db, recSig2));
+    BOOST_CHECK(HasRecoveredSig(db, recSig2));
+
+    // keys written after the rebuild aren't collected anymore
+    BOOST_REQUIRE(CRecoveredSigsDbForTest::BeginRebuild(db));
+    CRecoveredSigsDbForTest::FinishRebuild(db, CRecoveredSigsDbForTest::ReadKnownKeys(db));
+    BOOST_CHECK_EQUAL(CRecoveredSigsDbForTest::GetFilterInserts(db), 8U);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -43,6 +43,15 @@ CTxMemPoolEntry::CTxMemPoolEntry(const CTransactionRef& _tx, const CAmount& _nFe
     nSizeWithAncestors = GetTxSize();
     nModFeesWithAncestors = nFee;
     nSigOpCostWithAncestors = sigOpCost;
+    // SYSCOIN
+    // the conflict flag depends on mapAssetAllocationConflicts and is set when the entry is added
+    if (!IsZdagTx(tx->nVersion))
+        nZDAGFlags |= ZDAG_FLAG_NOT_ZDAG;
+    // the zdag tx should be under MTU of IP packet
+    if (tx->GetTotalSize() > MAX_STANDARD_ZDAG_TX_SIZE)
+        nZDAGFlags |= ZDAG_FLAG_SIZE;
+    if (SignalsOptInRBF(*tx))
+        nZDAGFlags |= ZDAG_FLAG_RBF;
 }
 
 void CTxMemPoolEntry::UpdateFeeDelta(int64_t newFeeDelta)
@@ -102,6 +111,9 @@ void CTxMemPool::UpdateForDescendants(txiter updateIt, cacheMap &cachedDescendan
             cachedDescendants[updateIt].insert(mapTx.iterator_to(descendant));
             // Update ancestor state for each descendant
             mapTx.modify(mapTx.iterator_to(descendant), update_ancestor_state(updateIt->GetTxSize(), updateIt->GetModifiedFee(), 1, updateIt->GetSigOpCost()));
+            // SYSCOIN
+            descendant.UpdateZDAGAncestorState(updateIt->nZDAGFlags, 1);
+            NotifyZDAGStatus(mapTx.iterator_to(descendant));
         }
     }
     mapTx.modify(updateIt, update_descendant_state(modifySize, modifyFee, modifyCount));
@@ -246,6 +258,8 @@ void CTxMemPool::UpdateEntryForAncestors(txiter it, const setEntries &setAncesto
         updateSize += ancestorIt->GetTxSize();
         updateFee += ancestorIt->GetModifiedFee();
         updateSigOpsCost += ancestorIt->GetSigOpCost();
+        // SYSCOIN
+        it->UpdateZDAGAncestorState(ancestorIt->nZDAGFlags, 1);
     }
     mapTx.modify(it, update_ancestor_state(updateSize, updateFee, updateCount, updateSigOpsCost));
 }
@@ -264,6 +278,8 @@ void CTxMemPool::UpdateForRemoveFromMempool(const setEntries &entriesToRemove, b
     // transaction
     const uint64_t nNoLimit = std::numeric_limits<uint64_t>::max();
     if (updateDescendants) {
+        // SYSCOIN
+        setEntries setZDAGUpdated;
         // updateDescendants should be true whenever we're not recursively
         // removing a tx and all its descendants, eg when a transaction is
         // confirmed in a block.
@@ -279,8 +295,17 @@ void CTxMemPool::UpdateForRemoveFromMempool(const setEntries &entriesToRemove, b
             int modifySigOps = -removeIt->GetSigOpCost();
             for (txiter dit : setDescendants) {
                 mapTx.modify(dit, update_ancestor_state(modifySize, modifyFee, -1, modifySigOps));
+                // SYSCOIN
+                dit->UpdateZDAGAncestorState(removeIt->nZDAGFlags, -1);
+                setZDAGUpdated.insert(dit);
             }
         }
+        // SYSCOIN
+        // descendants staying in the mempool may have lost their last risky ancestor
+        for (txiter dit : setZDAGUpdated) {
+            if (!entriesToRemove.count(dit))
+                NotifyZDAGStatus(dit);
+        }
     }
     for (txiter removeIt : entriesToRemove) {
         setEntries setAncestors;
@@ -337,6 +362,48 @@ void CTxMemPoolEntry::UpdateAncestorState(int64_t modifySize, CAmount modifyFee,
     nSigOpCostWithAncestors += modifySigOps;
     assert(int(nSigOpCostWithAncestors) >= 0);
 }
+// SYSCOIN
+void CTxMemPoolEntry::UpdateZDAGAncestorState(uint8_t nFlags, int64_t modifyCount) const
+{
+    for (size_t i = 0; i < ZDAG_FLAG_COUNT; i++) {
+        if (nFlags & (1U << i)) {
+            nZDAGAncestorCounts[i] += modifyCount;
+            assert(nZDAGAncestorCounts[i] >= 0);
+        }
+    }
+}
+
+uint8_t CTxMemPoolEntry::GetZDAGAncestorFlags() const
+{
+    uint8_t nFlags = 0;
+    for (size_t i = 0; i < ZDAG_FLAG_COUNT; i++) {
+        if (nZDAGAncestorCounts[i] > 0)
+            nFlags |= (1U << i);
+    }
+    return nFlags;
+}
+
+int CTxMemPoolEntry::GetZDAGStatus() const
+{
+    if (nZDAGFlags & ZDAG_FLAG_NOT_ZDAG)
+        return ZDAG_WARNING_NOT_ZDAG_TX;
+    if (nZDAGFlags & ZDAG_FLAG_SIZE)
+        return ZDAG_WARNING_SIZE_OVER_POLICY;
+    // check if any inputs are dbl spent
+    if (nZDAGFlags & ZDAG_FLAG_CONFLICT)
+        return ZDAG_MAJOR_CONFLICT;
+    // replaceable if this transaction or any unconfirmed ancestor signals RBF
+    const uint8_t nAncestorFlags = GetZDAGAncestorFlags();
+    if ((nZDAGFlags | nAncestorFlags) & ZDAG_FLAG_RBF)
+        return ZDAG_WARNING_RBF;
+    if (nAncestorFlags & ZDAG_FLAG_SIZE)
+        return ZDAG_WARNING_SIZE_OVER_POLICY;
+    if (nAncestorFlags & ZDAG_FLAG_CONFLICT)
+        return ZDAG_MAJOR_CONFLICT;
+    if (nAncestorFlags & ZDAG_FLAG_NOT_ZDAG)
+        return ZDAG_WARNING_NOT_ZDAG_TX;
+    return ZDAG_STATUS_OK;
+}
 
 CTxMemPool::CTxMemPool(CBlockPolicyEstimator* estimator, int check_ratio)
     : m_check_ratio(check_ratio), minerPolicyEstimator(estimator)
@@ -399,6 +466,10 @@ void CTxMemPool::addUnchecked(const CTxMemPoolEntry &entry, setEntries &setAnces
     }
     UpdateAncestorsOf(true, newit, setAncestors);
     UpdateEntryForAncestors(newit, setAncestors);
+    // SYSCOIN
+    if (existsConflicts(tx))
+        newit->nZDAGFlags |= ZDAG_FLAG_CONFLICT;
+    NotifyZDAGStatus(newit);
 
     nTransactionsUpdated++;
     totalTxSize += entry.GetTxSize();
@@ -704,6 +775,53 @@ void CTxMemPool::removeZDAGConflicts(const CTransaction &tx)
     }
 }
 
+void CTxMemPool::UpdateZDAGConflict(const CTransaction &tx)
+{
+    AssertLockHeld(cs_main);
+    AssertLockHeld(cs);
+    txiter it = mapTx.find(tx.GetHash());
+    if (it == mapTx.end())
+        return;
+    const bool fConflict = existsConflicts(tx);
+    if (fConflict == ((it->nZDAGFlags & ZDAG_FLAG_CONFLICT) != 0))
+        return;
+    if (fConflict)
+        it->nZDAGFlags |= ZDAG_FLAG_CONFLICT;
+    else
+        it->nZDAGFlags &= ~ZDAG_FLAG_CONFLICT;
+    // every descendant now has one more (or one less) ancestor in conflict
+    setEntries setDescendants;
+    CalculateDescendants(it, setDescendants);
+    setDescendants.erase(it);
+    for (txiter dit : setDescendants) {
+        dit->UpdateZDAGAncestorState(ZDAG_FLAG_CONFLICT, fConflict ? 1 : -1);
+        NotifyZDAGStatus(dit);
+    }
+    NotifyZDAGStatus(it);
+}
+
+int CTxMemPool::GetZDAGStatus(const uint256 &txid) const
+{
+    AssertLockHeld(cs);
+    const auto it = mapTx.find(txid);
+    if (it == mapTx.end())
+        return ZDAG_NOT_FOUND;
+    return it->GetZDAGStatus();
+}
+
+void CTxMemPool::NotifyZDAGStatus(txiter it) const
+{
+    AssertLockHeld(cs);
+    // only asset allocations are tracked by merchants, anything else is always flagged as not zdag
+    if (it->nZDAGFlags & ZDAG_FLAG_NOT_ZDAG)
+        return;
+    const int nStatus = it->GetZDAGStatus();
+    if (nStatus == it->nNotifiedZDAGStatus)
+        return;
+    it->nNotifiedZDAGStatus = nStatus;
+    GetMainSignals().NotifyZDAGStatus(it->GetTx().GetHash(), nStatus);
+}
+
 // true if other tx (conflicting) was first in mempool and it was involved in asset double spend
 bool CTxMemPool::isSyscoinConflictIsFirstSeen(const CTransaction &tx) const {
     AssertLockHeld(cs_main);
@@ -1065,12 +1183,20 @@ void CTxMemPool::check(CChainState& active_chainstate) const
         uint64_t nSizeCheck = it->GetTxSize();
         CAmount nFeesCheck = it->GetModifiedFee();
         int64_t nSigOpCheck = it->GetSigOpCost();
+        // SYSCOIN
+        std::array<int64_t, ZDAG_FLAG_COUNT> nZDAGCountsCheck{};
 
         for (txiter ancestorIt : setAncestors) {
             nSizeCheck += ancestorIt->GetTxSize();
             nFeesCheck += ancestorIt->GetModifiedFee();
             nSigOpCheck += ancestorIt->GetSigOpCost();
+            for (size_t i = 0; i < ZDAG_FLAG_COUNT; i++) {
+                if (ancestorIt->nZDAGFlags & (1U << i))
+                    nZDAGCountsCheck[i]++;
+            }
         }
+        assert(it->nZDAGAncestorCounts == nZDAGCountsCheck);
+        assert(((it->nZDAGFlags & ZDAG_FLAG_CONFLICT) != 0) == existsConflicts(it->GetTx()));
 
         assert(it->GetCountWithAncestors() == nCountCheck);
         assert(it->GetSizeWithAncestors() == nSizeCheck);
@@ -6,6 +6,7 @@
 #ifndef SYSCOIN_TXMEMPOOL_H
 #define SYSCOIN_TXMEMPOOL_H
 
+#include <array>
 #include <atomic>
 #include <map>
 #include <optional>
@@ -70,6 +71,16 @@ struct CompareIteratorByHash {
     }
 };
 
+// SYSCOIN
+/** Z-DAG checks a mempool transaction can fail, see CTxMemPool::GetZDAGStatus() */
+enum ZDAGFlags : uint8_t {
+    ZDAG_FLAG_NOT_ZDAG = (1U << 0), //!< not an asset allocation transaction
+    ZDAG_FLAG_SIZE = (1U << 1),     //!< larger than MAX_STANDARD_ZDAG_TX_SIZE
+    ZDAG_FLAG_RBF = (1U << 2),      //!< signals BIP125 replaceability
+    ZDAG_FLAG_CONFLICT = (1U << 3), //!< spends an input involved in an asset allocation double spend
+};
+static constexpr size_t ZDAG_FLAG_COUNT{4};
+
 /** \class CTxMemPoolEntry
  *
  * CTxMemPoolEntry stores data about the corresponding transaction, as well
@@ -167,6 +178,18 @@ public:
     // If this is a proTx, this will be the hash of the key for which this ProTx was valid
     mutable uint256 validForProTxKey;
     mutable bool isKeyChangeProTx{false};
+    // Z-DAG checks failed by this transaction and the number of in-mempool ancestors failing each of them,
+    // kept up to date as the mempool and mapAssetAllocationConflicts change so no ancestor walk is needed
+    mutable uint8_t nZDAGFlags{0};
+    mutable std::array<int64_t, ZDAG_FLAG_COUNT> nZDAGAncestorCounts{};
+    // Adds modifyCount to the ancestor count of every flag set in nFlags
+    void UpdateZDAGAncestorState(uint8_t nFlags, int64_t modifyCount) const;
+    // Flags failed by at least one in-mempool ancestor
+    uint8_t GetZDAGAncestorFlags() const;
+    // Z-DAG status (ZDAG_* from primitives/transaction.h) derived from the flags above
+    int GetZDAGStatus() const;
+    // Last Z-DAG status announced through CValidationInterface::NotifyZDAGStatus()
+    mutable int nNotifiedZDAGStatus{ZDAG_NOT_FOUND};
 };
 
 // Helpers for modifying CTxMemPool::mapTx, which is a boost multi_index.
@@ -655,6 +678,12 @@ public:
     void removeConflicts(const CTransaction& tx) EXCLUSIVE_LOCKS_REQUIRED(cs, cs_main);
     // SYSCOIN
     void removeZDAGConflicts(const CTransaction& tx) EXCLUSIVE_LOCKS_REQUIRED(cs, cs_main);
+    /** Refresh the cached conflict flag of tx and its descendants after mapAssetAllocationConflicts changed for one of its inputs */
+    void UpdateZDAGConflict(const CTransaction& tx) EXCLUSIVE_LOCKS_REQUIRED(cs, cs_main);
+    /** Z-DAG status (ZDAG_* from primitives/transaction.h) of a mempool transaction, ZDAG_NOT_FOUND if it is not in the mempool */
+    int GetZDAGStatus(const uint256& txid) const EXCLUSIVE_LOCKS_REQUIRED(cs);
+    /** Announce the Z-DAG status of an asset allocation entry if it changed since it was last announced */
+    void NotifyZDAGStatus(txiter it) const EXCLUSIVE_LOCKS_REQUIRED(cs);
     // SYSCOIN
     void removeForBlock(const std::vector<CTransactionRef>& vtx, unsigned int nBlockHeight) EXCLUSIVE_LOCKS_REQUIRED(cs, cs_main);
     void clear();
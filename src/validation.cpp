@@ -707,6 +707,9 @@ bool MemPoolAccept::PreChecks(ATMPArgs& args, Workspace& ws)
                             // if just testing, and this is the first conflict for this prevout then let it go through but just don't add it to the global mapAssetAllocationConflicts
                             if(args.m_test_accept) {
                                 mapAssetAllocationConflicts.erase(txin.prevout);
+                            } else {
+                                // the tx already in mempool (and its descendants) is now in conflict
+                                m_pool.UpdateZDAGConflict(*ptxConflicting);
                             }
                             setConflictsAsset.insert(ptxConflicting->GetHash());
                             break;
@@ -1210,7 +1213,16 @@ static MempoolAcceptResult AcceptToMemoryPoolWithTime(const CChainParams& chainp
         for (const COutPoint& hashTx : coins_to_uncache) {
             active_chainstate.CoinsTip().Uncache(hashTx);
             // SYSCOIN
-            mapAssetAllocationConflicts.erase(hashTx);
+            auto itConflict = mapAssetAllocationConflicts.find(hashTx);
+            if (itConflict != mapAssetAllocationConflicts.end()) {
+                const auto conflictTxs = itConflict->second;
+                mapAssetAllocationConflicts.erase(itConflict);
+                LOCK(pool.cs);
+                if (conflictTxs.first)
+                    pool.UpdateZDAGConflict(*conflictTxs.first);
+                if (conflictTxs.second)
+                    pool.UpdateZDAGConflict(*conflictTxs.second);
+            }
         }
         // remove bridge transfer id from mempool structure
         if(IsSyscoinMintTx(tx->nVersion)) {
@@ -1788,15 +1800,21 @@ DisconnectResult CChainState::DisconnectBlock(const CBlock& block, const CBlockI
 }
 
 static CCheckQueue<CScriptCheck> scriptcheckqueue(128);
+// SYSCOIN mint proofs and notary signatures are far heavier than a single script check, keep batches small
+static CCheckQueue<CSyscoinCheck> syscoincheckqueue(8);
 
 void StartScriptCheckWorkerThreads(int threads_num)
 {
     scriptcheckqueue.StartWorkerThreads(threads_num);
+    // SYSCOIN
+    syscoincheckqueue.StartWorkerThreads(threads_num);
 }
 
 void StopScriptCheckWorkerThreads()
 {
     scriptcheckqueue.StopWorkerThreads();
+    // SYSCOIN
+    syscoincheckqueue.StopWorkerThreads();
 }
 
 VersionBitsCache versionbitscache GUARDED_BY(cs_main);
@@ -2063,6 +2081,9 @@ bool CChainState::ConnectBlock(const CBlock& block, BlockValidationState& state,
     // for as long as `control`.
     CCheckQueueControl<CScriptCheck> control(fScriptChecks && g_parallel_script_checks ? &scriptcheckqueue : nullptr);
     std::vector<PrecomputedTransactionData> txsdata(block.vtx.size());
+    // SYSCOIN stateless asset checks are queued like script checks, per-tx states must outlive syscoinControl
+    std::vector<TxValidationState> vSyscoinStates(block.vtx.size());
+    CCheckQueueControl<CSyscoinCheck> syscoinControl(g_parallel_script_checks ? &syscoincheckqueue : nullptr);
 
     std::vector<int> prevheights;
     CAmount nFees = 0;
@@ -2102,7 +2123,26 @@ bool CChainState::ConnectBlock(const CBlock& block, BlockValidationState& state,
                 return error("%s: Consensus::CheckTxInputs: %s, %s", __func__, tx.GetHash().ToString(), state.ToString());
             }
             // SYSCOIN
-            if(hasAssets){
+            if(hasAssets && IsSyscoinCheckParallelizable(tx.nVersion)){
+                TxValidationState &tx_statesys = vSyscoinStates[i];
+                // only the bridge transfer id bookkeeping is stateful, do it here in block order
+                if (IsSyscoinMintTx(tx.nVersion) && !CheckSyscoinMintKeys(tx, txHash, tx_statesys, fJustCheck, mapMintKeys)){
+                    state.Invalid(BlockValidationResult::BLOCK_CONSENSUS,
+                                tx_statesys.GetRejectReason(), tx_statesys.GetDebugMessage());
+                    return error("%s: Consensus::CheckSyscoinMintKeys: %s, %s", __func__, tx.GetHash().ToString(), state.ToString());
+                }
+                CSyscoinCheck check(tx, txHash, pindex->nHeight, ::ChainActive().Tip()->GetMedianTimePast(), blockHash, false, fJustCheck, std::move(mapAssetIn), std::move(mapAssetOut), &tx_statesys);
+                if (g_parallel_script_checks) {
+                    std::vector<CSyscoinCheck> vSyscoinChecks(1);
+                    check.swap(vSyscoinChecks.back());
+                    syscoinControl.Add(vSyscoinChecks);
+                } else if (!check()) {
+                    state.Invalid(BlockValidationResult::BLOCK_CONSENSUS,
+                                tx_statesys.GetRejectReason(), tx_statesys.GetDebugMessage());
+                    return error("%s: Consensus::CheckSyscoinInputs: %s, %s", __func__, tx.GetHash().ToString(), state.ToString());
+                }
+            }
+            else if(hasAssets){
                 TxValidationState tx_statesys;
                 // just temp var not used in !fJustCheck mode
                 if (!CheckSyscoinInputs(ibd, tx, txHash, tx_statesys, false, pindex->nHeight, ::ChainActive().Tip()->GetMedianTimePast(), blockHash, fJustCheck, mapAssets, mapMintKeys, mapAssetIn, mapAssetOut)){
@@ -2171,6 +2211,20 @@ bool CChainState::ConnectBlock(const CBlock& block, BlockValidationState& state,
         LogPrintf("ERROR: %s: CheckQueue failed\n", __func__);
         return state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, "block-validation-failed");
     }
+    // SYSCOIN
+    if (!syscoinControl.Wait()){
+        // report the first failing transaction that was evaluated, workers stop early once one check fails
+        for (unsigned int i = 0; i < vSyscoinStates.size(); i++) {
+            const TxValidationState &tx_statesys = vSyscoinStates[i];
+            if (tx_statesys.IsInvalid()) {
+                state.Invalid(BlockValidationResult::BLOCK_CONSENSUS,
+                            tx_statesys.GetRejectReason(), tx_statesys.GetDebugMessage());
+                return error("%s: Consensus::CheckSyscoinInputs: %s, %s", __func__, block.vtx[i]->GetHash().ToString(), state.ToString());
+            }
+        }
+        LogPrintf("ERROR: %s: Syscoin CheckQueue failed\n", __func__);
+        return state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, "block-validation-failed");
+    }
 
     // SYSCOIN : MODIFIED TO CHECK MASTERNODE PAYMENTS AND SUPERBLOCKS
     const CAmount &blockReward = GetBlockSubsidy(pindex->nHeight, chainparams);
@@ -3777,10 +3831,10 @@ static bool ContextualCheckBlock(const CBlock& block, BlockValidationState& stat
                         return state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, "mint-insufficient-confirmations", "You must wait at least 1 hour to mint");
                     }
                     // ensure block height provided points to the right block
-                    if(mintSyscoin.vchTxRoot != txRootDB.vchTxRoot) {
+                    if(!EthereumRootMatches(txRootDB.hashTxRoot, mintSyscoin.vchTxRoot)) {
                         return state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, "mint-mismatching-txroot");
                     }
-                    if(mintSyscoin.vchReceiptRoot != txRootDB.vchReceiptRoot) {
+                    if(!EthereumRootMatches(txRootDB.hashReceiptRoot, mintSyscoin.vchReceiptRoot)) {
                         return state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, "mint-mismatching-receiptroot");
                     }
                 } 
@@ -272,4 +272,12 @@ void CMainSignals::NotifyGovernanceObject(const std::shared_ptr<const CGovernanc
 }
 void CMainSignals::NotifyMasternodeListChanged(bool undo, const CDeterministicMNList& oldMNList, const CDeterministicMNListDiff& diff) {
     m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.NotifyMasternodeListChanged(undo, oldMNList, diff); });
+}
+void CMainSignals::NotifyZDAGStatus(const uint256& txid, int status) {
+    auto event = [txid, status, this] {
+        m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.NotifyZDAGStatus(txid, status); });
+    };
+    ENQUEUE_AND_LOG_EVENT(event, "%s: txid=%s status=%d", __func__,
+                          txid.ToString(),
+                          status);
 }
\ No newline at end of file
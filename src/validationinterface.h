@@ -187,6 +187,14 @@ protected:
     virtual void NotifyGovernanceVote(const std::shared_ptr<const CGovernanceVote>& vote) {}
     virtual void NotifyGovernanceObject(const std::shared_ptr<const CGovernanceObject> &object) {}
     virtual void NotifyMasternodeListChanged(bool undo, const CDeterministicMNList& oldMNList, const CDeterministicMNListDiff& diff) {}
+    /**
+     * Notifies listeners that the Z-DAG status (ZDAG_* from primitives/transaction.h) of an
+     * asset allocation in the mempool changed, including its first status when it is added.
+     *
+     * Called on a background thread. Leaving the mempool is reported through
+     * TransactionRemovedFromMempool() and BlockConnected() as for any other transaction.
+     */
+    virtual void NotifyZDAGStatus(const uint256& txid, int status) {}
 };
 
 struct MainSignalsInstance;
@@ -225,6 +233,7 @@ public:
     void NotifyGovernanceVote(const std::shared_ptr<const CGovernanceVote>& vote);
     void NotifyGovernanceObject(const std::shared_ptr<const CGovernanceObject>& object);
     void NotifyMasternodeListChanged(bool undo, const CDeterministicMNList& oldMNList, const CDeterministicMNListDiff& diff);
+    void NotifyZDAGStatus(const uint256& txid, int status);
 };
 
 CMainSignals& GetMainSignals();
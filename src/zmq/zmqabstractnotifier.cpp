@@ -25,6 +25,14 @@ bool CZMQAbstractNotifier::NotifyTransactionMempool(const CTransaction &/*transa
 {
     return true;
 }
+bool CZMQAbstractNotifier::NotifyZDAGStatus(const uint256 &/*txid*/, int /*status*/)
+{
+    return true;
+}
+bool CZMQAbstractNotifier::NotifyZDAGRemoval(const CTransaction &/*transaction*/, bool /*fConfirmed*/)
+{
+    return true;
+}
 bool CZMQAbstractNotifier::NotifyBlock(const CBlockIndex * /*CBlockIndex*/)
 {
     return true;
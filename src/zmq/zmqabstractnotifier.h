@@ -15,6 +15,7 @@ class CZMQAbstractNotifier;
 // SYSCOIN
 class CGovernanceObject;
 class CGovernanceVote;
+class uint256;
 using CZMQNotifierFactory = std::unique_ptr<CZMQAbstractNotifier> (*)();
 
 class CZMQAbstractNotifier
@@ -61,6 +62,10 @@ public:
     virtual bool NotifyTransactionMempool(const CTransaction &transaction);
     virtual bool NotifyGovernanceVote(const std::shared_ptr<const CGovernanceVote>& vote);
     virtual bool NotifyGovernanceObject(const std::shared_ptr<const CGovernanceObject>& object);
+    // Notifies of Z-DAG status changes of asset allocations in the mempool
+    virtual bool NotifyZDAGStatus(const uint256 &txid, int status);
+    // Notifies of asset allocations leaving the mempool, confirmed in a block or not
+    virtual bool NotifyZDAGRemoval(const CTransaction &transaction, bool fConfirmed);
 
 protected:
     void *psocket;
@@ -45,6 +45,7 @@ CZMQNotificationInterface* CZMQNotificationInterface::Create()
     factories["pubhashgovernanceobject"] = CZMQAbstractNotifier::Create<CZMQPublishHashGovernanceObjectNotifier>;
     factories["pubrawgovernancevote"] = CZMQAbstractNotifier::Create<CZMQPublishRawGovernanceVoteNotifier>;
     factories["pubrawgovernanceobject"] = CZMQAbstractNotifier::Create<CZMQPublishRawGovernanceObjectNotifier>;
+    factories["pubzdagstatus"] = CZMQAbstractNotifier::Create<CZMQPublishZDAGStatusNotifier>;
     factories["pubsequence"] = CZMQAbstractNotifier::Create<CZMQPublishSequenceNotifier>;
 
     std::list<std::unique_ptr<CZMQAbstractNotifier>> notifiers;
@@ -161,8 +162,10 @@ void CZMQNotificationInterface::TransactionRemovedFromMempool(const CTransaction
     // Called for all non-block inclusion reasons
     const CTransaction& tx = *ptx;
 
-    TryForEachAndRemoveFailed(notifiers, [&tx, mempool_sequence](CZMQAbstractNotifier* notifier) {
-        return notifier->NotifyTransactionRemoval(tx, mempool_sequence);
+    // SYSCOIN
+    const bool fZdag = IsZdagTx(tx.nVersion);
+    TryForEachAndRemoveFailed(notifiers, [&tx, mempool_sequence, fZdag](CZMQAbstractNotifier* notifier) {
+        return notifier->NotifyTransactionRemoval(tx, mempool_sequence) && (!fZdag || notifier->NotifyZDAGRemoval(tx, false));
     });
 }
 
@@ -170,8 +173,10 @@ void CZMQNotificationInterface::BlockConnected(const std::shared_ptr<const CBloc
 {
     for (const CTransactionRef& ptx : pblock->vtx) {
         const CTransaction& tx = *ptx;
-        TryForEachAndRemoveFailed(notifiers, [&tx](CZMQAbstractNotifier* notifier) {
-            return notifier->NotifyTransaction(tx);
+        // SYSCOIN
+        const bool fZdag = IsZdagTx(tx.nVersion);
+        TryForEachAndRemoveFailed(notifiers, [&tx, fZdag](CZMQAbstractNotifier* notifier) {
+            return notifier->NotifyTransaction(tx) && (!fZdag || notifier->NotifyZDAGRemoval(tx, true));
         });
     }
 
@@ -209,4 +214,11 @@ void CZMQNotificationInterface::NotifyGovernanceObject(const std::shared_ptr<con
         return notifier->NotifyGovernanceObject(object);
     });
 }
+
+void CZMQNotificationInterface::NotifyZDAGStatus(const uint256& txid, int status)
+{
+    TryForEachAndRemoveFailed(notifiers, [&txid, status](CZMQAbstractNotifier* notifier) {
+        return notifier->NotifyZDAGStatus(txid, status);
+    });
+}
 CZMQNotificationInterface* g_zmq_notification_interface = nullptr;
@@ -34,6 +34,7 @@ protected:
     // SYSCOIN
     void NotifyGovernanceVote(const std::shared_ptr<const CGovernanceVote>& vote) override;
     void NotifyGovernanceObject(const std::shared_ptr<const CGovernanceObject>& object) override;
+    void NotifyZDAGStatus(const uint256& txid, int status) override;
 private:
     CZMQNotificationInterface();
 
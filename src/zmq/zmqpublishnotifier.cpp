@@ -37,6 +37,7 @@ static const char *MSG_HASHGVOTE     = "hashgovernancevote";
 static const char *MSG_HASHGOBJ      = "hashgovernanceobject";
 static const char *MSG_RAWGVOTE      = "rawgovernancevote";
 static const char *MSG_RAWGOBJ       = "rawgovernanceobject";
+static const char *MSG_ZDAGSTATUS    = "zdagstatus";
 static const char *MSG_SEQUENCE  = "sequence";
 
 // Internal function to send multipart message
@@ -282,6 +283,33 @@ bool CZMQPublishRawMempoolTransactionNotifier::NotifyTransactionMempool(const CT
     return SendZmqMessage(MSG_RAWMEMPOOLTX, &(*ss.begin()), ss.size());
 }
 
+// SYSCOIN
+// Helper function to send a 'zdagstatus' topic message with the following structure:
+//    <32-byte txid> | <1-byte label> | <4-byte LE status> (only for the (S)tatus label)
+static bool SendZDAGStatusMsg(CZMQAbstractPublishNotifier& notifier, const uint256& hash, char label, std::optional<int32_t> status = {})
+{
+    unsigned char data[sizeof(hash) + sizeof(label) + sizeof(int32_t)];
+    for (unsigned int i = 0; i < sizeof(hash); ++i) {
+        data[sizeof(hash) - 1 - i] = hash.begin()[i];
+    }
+    data[sizeof(hash)] = label;
+    if (status) WriteLE32(data + sizeof(hash) + sizeof(label), static_cast<uint32_t>(*status));
+    return notifier.SendZmqMessage(MSG_ZDAGSTATUS, data, status ? sizeof(data) : sizeof(hash) + sizeof(label));
+}
+
+bool CZMQPublishZDAGStatusNotifier::NotifyZDAGStatus(const uint256 &txid, int status)
+{
+    LogPrint(BCLog::ZMQ, "zmq: Publish zdagstatus %s status %d to %s\n", txid.GetHex(), status, this->address);
+    return SendZDAGStatusMsg(*this, txid, /* (S)tatus */ 'S', status);
+}
+
+bool CZMQPublishZDAGStatusNotifier::NotifyZDAGRemoval(const CTransaction &transaction, bool fConfirmed)
+{
+    uint256 hash = transaction.GetHash();
+    LogPrint(BCLog::ZMQ, "zmq: Publish zdagstatus %s %s to %s\n", hash.GetHex(), fConfirmed ? "confirmed" : "removal", this->address);
+    return SendZDAGStatusMsg(*this, hash, fConfirmed ? /* (C)onfirmed */ 'C' : /* Mempool (R)emoval */ 'R');
+}
+
 // Helper function to send a 'sequence' topic message with the following structure:
 //    <32-byte hash> | <1-byte label> | <8-byte LE sequence> (optional)
 static bool SendSequenceMsg(CZMQAbstractPublishNotifier& notifier, uint256 hash, char label, std::optional<uint64_t> sequence = {})
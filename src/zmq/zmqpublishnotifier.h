@@ -79,6 +79,12 @@ class CZMQPublishRawGovernanceObjectNotifier : public CZMQAbstractPublishNotifie
 public:
     bool NotifyGovernanceObject(const std::shared_ptr<const CGovernanceObject>& object) override;
 };
+class CZMQPublishZDAGStatusNotifier : public CZMQAbstractPublishNotifier
+{
+public:
+    bool NotifyZDAGStatus(const uint256 &txid, int status) override;
+    bool NotifyZDAGRemoval(const CTransaction &transaction, bool fConfirmed) override;
+};
 class CZMQPublishSequenceNotifier : public CZMQAbstractPublishNotifier
 {
 public:
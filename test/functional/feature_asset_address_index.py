@@ -0,0 +1,68 @@
+#!/usr/bin/env python3
+# Copyright (c) 2021 The Syscoin Core developers
+# Distributed under the MIT software license, see the accompanying
+# file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+from decimal import Decimal
+from test_framework.test_framework import SyscoinTestFramework
+from test_framework.util import assert_equal, assert_raises_rpc_error
+
+class AssetAddressIndexTest(SyscoinTestFramework):
+    def set_test_params(self):
+        self.setup_clean_chain = True
+        self.num_nodes = 2
+        self.extra_args = [['-assetindex=1', '-assetaddressindex=1'], ['-assetindex=1']]
+
+    def skip_test_if_missing_module(self):
+        self.skip_if_no_wallet()
+
+    def check_balance(self, address):
+        # the index must agree with the wallet view of the same address
+        node = self.nodes[0]
+        indexed = node.getaddressbalance([address], self.asset)
+        wallet = node.assetallocationbalance(self.asset, [address])
+        assert_equal(indexed['amount'], wallet['amount'])
+        assert_equal(indexed['asset_amount'], wallet['asset_amount'])
+        assert_equal(node.getaddressbalance([address])['amount'], node.addressbalance([address])['amount'])
+        return indexed
+
+    def run_test(self):
+        node = self.nodes[0]
+        node.generate(200)
+        self.sync_blocks()
+        self.asset = node.assetnew('1', 'TST', 'asset description', '0x', 8, 10000, 127, '', {}, {})['asset_guid']
+        node.generate(1)
+        address = node.getnewaddress()
+        node.assetsend(self.asset, address, 10)
+        node.generate(1)
+        self.sync_blocks()
+
+        self.log.info("Balances follow sends and spends")
+        balance = self.check_balance(address)
+        assert_equal(balance['asset_amount'], Decimal('10'))
+        assert_equal(balance['count'], 1)
+        all_assets = node.getaddressbalance([address])
+        assert_equal(all_assets['assets'][0]['asset_guid'], self.asset)
+        assert_equal(all_assets['assets'][0]['asset_amount'], Decimal('10'))
+        address1 = node.getnewaddress()
+        node.assetallocationsend(self.asset, address1, 4)
+        node.generate(1)
+        blockhash = node.getbestblockhash()
+        assert_equal(self.check_balance(address1)['asset_amount'], Decimal('4'))
+        total = node.getaddressbalance([address, address1], self.asset)
+        assert_equal(total['asset_amount'], node.assetallocationbalance(self.asset, [address, address1])['asset_amount'])
+
+        self.log.info("Disconnecting blocks restores previous balances")
+        node.invalidateblock(blockhash)
+        assert_equal(node.getaddressbalance([address1], self.asset)['asset_amount'], Decimal('0'))
+        assert_equal(node.getaddressbalance([address], self.asset)['asset_amount'], Decimal('10'))
+        node.reconsiderblock(blockhash)
+        assert_equal(self.check_balance(address1)['asset_amount'], Decimal('4'))
+
+        self.log.info("Errors")
+        assert_raises_rpc_error(-1, 'Requires -assetaddressindex', self.nodes[1].getaddressbalance, [address])
+        assert_raises_rpc_error(-8, 'duplicated address', node.getaddressbalance, [address, address])
+        assert_raises_rpc_error(-5, 'Invalid Syscoin address', node.getaddressbalance, ['notanaddress'])
+
+if __name__ == '__main__':
+    AssetAddressIndexTest().main()
@@ -0,0 +1,72 @@
+#!/usr/bin/env python3
+# Copyright (c) 2021 The Syscoin Core developers
+# Distributed under the MIT software license, see the accompanying
+# file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+from test_framework.test_framework import SyscoinTestFramework
+from test_framework.util import assert_equal, assert_raises_rpc_error
+
+CONTRACT = '0x9f90b5093f35aeac5fbaeb591f9c9de8e2844a46'
+CONTRACT1 = '0xb0ea8c9ee8aa87efd28a12de8c034f947c144053'
+
+class AssetIndexTest(SyscoinTestFramework):
+    def set_test_params(self):
+        self.setup_clean_chain = True
+        self.num_nodes = 2
+        self.extra_args = [['-assetindex=1'], []]
+
+    def skip_test_if_missing_module(self):
+        self.skip_if_no_wallet()
+
+    def guids(self, assets):
+        return sorted(asset['asset_guid'] for asset in assets)
+
+    def run_test(self):
+        self.nodes[0].generate(200)
+        self.sync_blocks()
+        notary_address = self.nodes[0].getnewaddress()
+        asset0 = self.nodes[0].assetnew('1', 'TST', 'asset description', CONTRACT, 8, 10000, 127, notary_address, {}, {})['asset_guid']
+        asset1 = self.nodes[0].assetnew('1', 'tst', 'asset description', '0x', 8, 10000, 127, '', {}, {})['asset_guid']
+        asset2 = self.nodes[0].assetnew('1', 'OTHER', 'asset description', '0x', 8, 10000, 127, '', {}, {})['asset_guid']
+        self.nodes[0].generate(1)
+        self.sync_blocks()
+        assert_equal(self.nodes[0].getindexinfo('assetindex')['assetindex']['synced'], True)
+
+        self.log.info("Look up assets by symbol, contract and notary")
+        assert_equal(self.guids(self.nodes[0].assetlookup('symbol', 'TST')), sorted([asset0, asset1]))
+        assert_equal(self.guids(self.nodes[0].assetlookup('symbol', 'other')), [asset2])
+        assert_equal(self.nodes[0].assetlookup('symbol', 'NONE'), [])
+        assert_equal(self.guids(self.nodes[0].assetlookup('contract', CONTRACT)), [asset0])
+        assert_equal(self.guids(self.nodes[0].assetlookup('notary_address', notary_address)), [asset0])
+        assert_equal(self.guids(self.nodes[0].listassets(10, 0, {'symbol': 'TST'})), sorted([asset0, asset1]))
+        assert_equal(self.guids(self.nodes[0].listassets(10, 0, {'symbol': 'TST', 'contract': CONTRACT})), [asset0])
+        assert_equal(len(self.nodes[0].listassets(1, 1, {'symbol': 'TST'})), 1)
+        assert_raises_rpc_error(-8, 'Invalid contract address', self.nodes[0].assetlookup, 'contract', '0x1234')
+        assert_raises_rpc_error(-8, 'type must be one of', self.nodes[0].assetlookup, 'guid', asset0)
+        assert_raises_rpc_error(-1, 'requires -assetindex', self.nodes[1].assetlookup, 'symbol', 'TST')
+        assert_raises_rpc_error(-8, 'cannot be combined', self.nodes[0].listassets, 10, 0, {'symbol': 'TST', 'asset_guid': asset0})
+
+        self.log.info("Updates move the contract and notary entries")
+        self.nodes[0].assetupdate(asset0, '', CONTRACT1, 127, '', {}, {})
+        self.nodes[0].generate(1)
+        blockhash = self.nodes[0].getbestblockhash()
+        assert_equal(self.nodes[0].assetlookup('contract', CONTRACT), [])
+        assert_equal(self.guids(self.nodes[0].assetlookup('contract', CONTRACT1)), [asset0])
+        assert_equal(self.nodes[0].assetlookup('notary_address', notary_address), [])
+
+        self.log.info("Disconnecting blocks restores previous entries")
+        self.nodes[0].invalidateblock(blockhash)
+        assert_equal(self.guids(self.nodes[0].assetlookup('contract', CONTRACT)), [asset0])
+        assert_equal(self.nodes[0].assetlookup('contract', CONTRACT1), [])
+        assert_equal(self.guids(self.nodes[0].assetlookup('notary_address', notary_address)), [asset0])
+        self.nodes[0].reconsiderblock(blockhash)
+        assert_equal(self.guids(self.nodes[0].assetlookup('contract', CONTRACT1)), [asset0])
+
+        self.log.info("The index survives a restart")
+        self.restart_node(0)
+        self.wait_until(lambda: self.nodes[0].getindexinfo('assetindex')['assetindex']['synced'])
+        assert_equal(self.guids(self.nodes[0].assetlookup('symbol', 'TST')), sorted([asset0, asset1]))
+        assert_equal(self.guids(self.nodes[0].assetlookup('contract', CONTRACT1)), [asset0])
+
+if __name__ == '__main__':
+    AssetIndexTest().main()
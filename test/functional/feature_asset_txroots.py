@@ -4,7 +4,13 @@
 # file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 from test_framework.test_framework import SyscoinTestFramework
-from test_framework.util import assert_equal
+from test_framework.util import assert_equal, assert_raises_rpc_error
+
+ROOT = 'a0' + '11' * 32
+
+def blockhash(height):
+    # stand-in 32 byte block hash unique to the height
+    return '0x%064x' % height
 
 
 class AssetTxRootsTest(SyscoinTestFramework):
@@ -17,9 +23,10 @@ class AssetTxRootsTest(SyscoinTestFramework):
     def run_test(self):
         self.basic_audittxroot()
         self.basic_audittxroot1()
+        self.invalid_headers()
 
     def basic_audittxroot(self):
-        self.nodes[0].syscoinsetethheaders([[709780,'709780','709779','a','a',0],[707780,'707780','707779','a','a',0],[707772,'707772','707771','a','a',0],[707776,'707776','707775','a','a',0],[707770,'707770','707769','a','a',0],[707778,'707778','707777','a','a',0],[707774,'707774','707773','a','a',0]])
+        self.nodes[0].syscoinsetethheaders([[709780,blockhash(709780),blockhash(709779),ROOT,ROOT,0],[707780,blockhash(707780),blockhash(707779),ROOT,ROOT,0],[707772,blockhash(707772),blockhash(707771),ROOT,ROOT,0],[707776,blockhash(707776),blockhash(707775),ROOT,ROOT,0],[707770,blockhash(707770),blockhash(707769),ROOT,ROOT,0],[707778,blockhash(707778),blockhash(707777),ROOT,ROOT,0],[707774,blockhash(707774),blockhash(707773),ROOT,ROOT,0]])
         r = self.nodes[0].syscoinsetethstatus("synced", 709780)
         missing_blocks = r["missing_blocks"]
         # the - MAX_ETHEREUM_TX_ROOTS check to ensure you have at least that many roots stored from the tip
@@ -38,7 +45,7 @@ class AssetTxRootsTest(SyscoinTestFramework):
         assert_equal(missing_blocks[5]["to"] , 707779)
         assert_equal(missing_blocks[6]["from"] , 707781)
         assert_equal(missing_blocks[6]["to"] , 709779)
-        self.nodes[0].syscoinsetethheaders([[707773,'707773','707772','a','a',0],[707775,'707775','707774','a','a',0],[707771,'707771','707770','a','a',0],[707777,'707777','707776','a','a',0],[707779,'707779','707778','a','a',0],[707781,'707781','707780','a','a',0]])
+        self.nodes[0].syscoinsetethheaders([[707773,blockhash(707773),blockhash(707772),ROOT,ROOT,0],[707775,blockhash(707775),blockhash(707774),ROOT,ROOT,0],[707771,blockhash(707771),blockhash(707770),ROOT,ROOT,0],[707777,blockhash(707777),blockhash(707776),ROOT,ROOT,0],[707779,blockhash(707779),blockhash(707778),ROOT,ROOT,0],[707781,blockhash(707781),blockhash(707780),ROOT,ROOT,0]])
         r = self.nodes[0].syscoinsetethstatus("synced", 709780)
         missing_blocks = r["missing_blocks"]
         assert_equal(missing_blocks[0]["from"] , 649780)
@@ -47,7 +54,7 @@ class AssetTxRootsTest(SyscoinTestFramework):
         assert_equal(missing_blocks[1]["to"] , 709779)
         # now fork and check it revalidates chain
         # 707771 (should be 707772) -> 707773 and 707773 (should be 707774) -> 707775
-        self.nodes[0].syscoinsetethheaders([[707773,'707773','707771','a','a',0],[707775,'707775','707773','a','a',0]])
+        self.nodes[0].syscoinsetethheaders([[707773,blockhash(707773),blockhash(707771),ROOT,ROOT,0],[707775,blockhash(707775),blockhash(707773),ROOT,ROOT,0]])
         r = self.nodes[0].syscoinsetethstatus("synced", 709780)
         missing_blocks = r["missing_blocks"]
         # we should still have the missing ranges prior to the forks
@@ -72,7 +79,7 @@ class AssetTxRootsTest(SyscoinTestFramework):
             i = nStartHeight + index
             if i == nMissingRange1 or i == nMissingRange2 or i == nMissingRange3:
                 continue
-            roots.append([i,str(i),str(i-1),'a','a',0])
+            roots.append([i,blockhash(i),blockhash(i-1),ROOT,ROOT,0])
             if (index % 400) == 0:
                 self.nodes[0].syscoinsetethheaders(roots)
                 roots = []
@@ -89,11 +96,20 @@ class AssetTxRootsTest(SyscoinTestFramework):
         assert_equal(missing_blocks[1]["to"] , 800022)
         assert_equal(missing_blocks[2]["from"] , 814011)
         assert_equal(missing_blocks[2]["to"] , 814011)
-        self.nodes[0].syscoinsetethheaders([[814011,'814011','814010','a','a',0],[700059,'700059','700058','a','a',0],[800022,'800022','800021','a','a',0]])
+        self.nodes[0].syscoinsetethheaders([[814011,blockhash(814011),blockhash(814010),ROOT,ROOT,0],[700059,blockhash(700059),blockhash(700058),ROOT,ROOT,0],[800022,blockhash(800022),blockhash(800021),ROOT,ROOT,0]])
         r = self.nodes[0].syscoinsetethstatus("synced", 820000)
         missing_blocks = r["missing_blocks"]
         assert_equal(missing_blocks, [])
 
+    def invalid_headers(self):
+        root = self.nodes[0].syscoingettxroots(814011)
+        assert_equal(root['blockhash'], blockhash(814011)[2:])
+        assert_equal(root['prevhash'], blockhash(814010)[2:])
+        assert_equal(root['txroot'], ROOT)
+        assert_equal(root['receiptroot'], ROOT)
+        assert_raises_rpc_error(-32602, 'should be 32 bytes in hex', self.nodes[0].syscoinsetethheaders, [[707770,'707770',blockhash(707769),ROOT,ROOT,0]])
+        assert_raises_rpc_error(-32602, 'should be 32 bytes in hex', self.nodes[0].syscoinsetethheaders, [[707770,blockhash(707770),blockhash(707769),'a0',ROOT,0]])
+
 
 if __name__ == '__main__':
     AssetTxRootsTest().main()
@@ -68,6 +68,10 @@ class AssetVerifyZDAGTest(SyscoinTestFramework):
             # this one uses output from tx2 so its not involved in the conflict chain
             assert_equal(self.nodes[i].assetallocationverifyzdag(tx5)['status'], ZDAG_STATUS_OK)
             assert_equal(self.nodes[i].assetallocationverifyzdag(tx6)['status'], ZDAG_MAJOR_CONFLICT)
+            # the batch call reports the same statuses in request order
+            statuses = self.nodes[i].assetallocationverifyzdagmany([tx1, tx4a, tx5, tx6])
+            assert_equal([s['txid'] for s in statuses], [tx1, tx4a, tx5, tx6])
+            assert_equal([s['status'] for s in statuses], [ZDAG_STATUS_OK, ZDAG_MAJOR_CONFLICT, ZDAG_STATUS_OK, ZDAG_MAJOR_CONFLICT])
 
         self.nodes[0].generate(1)
         self.sync_blocks()
@@ -78,6 +82,7 @@ class AssetVerifyZDAGTest(SyscoinTestFramework):
             assert_equal(self.nodes[i].assetallocationverifyzdag(tx4a)['status'], ZDAG_NOT_FOUND)
             assert_equal(self.nodes[i].assetallocationverifyzdag(tx4)['status'], ZDAG_NOT_FOUND)
             assert_equal(self.nodes[i].assetallocationverifyzdag(tx5)['status'], ZDAG_NOT_FOUND)
+            assert_equal([s['status'] for s in self.nodes[i].assetallocationverifyzdagmany([tx1, tx6])], [ZDAG_NOT_FOUND, ZDAG_NOT_FOUND])
 
     # verify zdag will flag any descendents of non-zdag tx but not ancestors
     def burn_zdag_ancestor_nonzdag(self):
@@ -52,9 +52,20 @@ class LLMQCoinbaseCommitmentsTest(DashTestFramework):
 
         # Check if a diff with the genesis block as base returns all MNs
         expectedUpdated = [mn.proTxHash for mn in self.mninfo]
+        stats_before = self.nodes[0].masternode_liststats()
         mnList = self.test_getmnlistdiff(null_hash, self.nodes[0].getbestblockhash(), {}, [], expectedUpdated)
         expectedUpdated2 = expectedUpdated + []
 
+        # Lookups never replay more diffs than the snapshot period and the caches account for their lists
+        stats = self.nodes[0].masternode_liststats()
+        assert stats['lookups'] > 0
+        assert stats['max_replay'] <= 576
+        assert stats['lists_cached'] > 0 and stats['lists_usage'] > 0
+        # protx_diff asks for the same diff as the P2P request before it
+        assert_equal(stats['mnlistdiff_requests'], stats_before['mnlistdiff_requests'] + 2)
+        assert_equal(stats['mnlistdiff_cache_hits'], stats_before['mnlistdiff_cache_hits'] + 1)
+        assert stats['mnlistdiffs_cached'] > 0 and stats['mnlistdiffs_usage'] > 0
+
         # Register one more MN, but don't start it (that would fail as DashTestFramework doesn't support this atm)
         baseBlockHash = self.nodes[0].getbestblockhash()
         self.prepare_masternode(self.mn_count)
@@ -63,8 +74,11 @@ class LLMQCoinbaseCommitmentsTest(DashTestFramework):
         # Now test if that MN appears in a diff when the base block is the one just before MN registration
         expectedDeleted = []
         expectedUpdated = [new_mn.proTxHash]
+        composed_before = self.nodes[0].masternode_liststats()['mnlistdiff_composed']
         mnList = self.test_getmnlistdiff(baseBlockHash, self.nodes[0].getbestblockhash(), mnList, expectedDeleted, expectedUpdated)
         assert(mnList[new_mn.proTxHash].confirmedHash == 0)
+        # a diff over a few blocks is built from the diffs of these blocks
+        assert_equal(self.nodes[0].masternode_liststats()['mnlistdiff_composed'], composed_before + 1)
         # Now let the MN get enough confirmations and verify that the MNLISTDIFF now has confirmedHash != 0
         self.confirm_mns()
         mnList = self.test_getmnlistdiff(baseBlockHash, self.nodes[0].getbestblockhash(), mnList, expectedDeleted, expectedUpdated)
@@ -7,7 +7,7 @@ import time
 import struct
 from test_framework.test_framework import DashTestFramework
 from test_framework.messages import CInv, hash256, msg_clsig, msg_inv, ser_string, uint256_from_str
-from test_framework.util import hex_str_to_bytes
+from test_framework.util import assert_equal, hex_str_to_bytes
 from test_framework.p2p import (
   P2PInterface,
 )
@@ -79,6 +79,14 @@ class LLMQChainLocksTest(DashTestFramework):
             block = self.nodes[0].getblock(self.nodes[0].getblockhash(h))
             assert(block['chainlock'])
 
+        self.log.info("Assert that signatures of other nodes were verified in valid batches")
+        stats = [node.quorum_verifystats() for node in self.nodes]
+        assert sum(s['sigshares']['batches'] for s in stats) > 0
+        for s in stats:
+            for kind in ('recsigs', 'sigshares', 'clsigs'):
+                assert_equal(s[kind]['failed_batches'], 0)
+                assert s[kind]['sigs'] >= s[kind]['batches']
+
         self.log.info("Isolate node, mine on another, and reconnect")
         self.isolate_node(self.nodes[0])
         node0_mining_addr = self.nodes[0].getnewaddress()
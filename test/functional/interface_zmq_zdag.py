@@ -0,0 +1,96 @@
+#!/usr/bin/env python3
+# Copyright (c) 2021 The Syscoin Core developers
+# Distributed under the MIT software license, see the accompanying
+# file COPYING or http://www.opensource.org/licenses/mit-license.php.
+"""Test the zdagstatus ZMQ notifications of asset allocations."""
+import struct
+
+from test_framework.test_framework import SyscoinTestFramework
+from test_framework.util import assert_equal
+
+try:
+    import zmq
+except ImportError:
+    pass
+
+ZDAG_STATUS_OK = 0
+ZDAG_WARNING_RBF = 1
+
+class ZMQZDAGTest(SyscoinTestFramework):
+    def set_test_params(self):
+        self.setup_clean_chain = True
+        self.num_nodes = 1
+        self.extra_args = [['-assetindex=1']]
+
+    def skip_test_if_missing_module(self):
+        self.skip_if_no_py3_zmq()
+        self.skip_if_no_syscoind_zmq()
+        self.skip_if_no_wallet()
+
+    def receive(self, topic):
+        # skip messages of other topics published on the same address
+        while True:
+            msg_topic, body, _ = self.socket.recv_multipart()
+            if msg_topic == topic:
+                return body
+
+    def receive_zdag(self):
+        body = self.receive(b'zdagstatus')
+        txid = body[:32].hex()
+        label = chr(body[32])
+        if label == 'S':
+            assert_equal(len(body), 32 + 1 + 4)
+            return (txid, label, struct.unpack('<i', body[33:])[0])
+        assert label in ('C', 'R')
+        assert_equal(len(body), 32 + 1)
+        return (txid, label, None)
+
+    def run_test(self):
+        self.ctx = zmq.Context()
+        try:
+            self.test_zdag_status()
+        finally:
+            self.ctx.destroy(linger=None)
+
+    def test_zdag_status(self):
+        node = self.nodes[0]
+        address = 'tcp://127.0.0.1:28334'
+        self.socket = self.ctx.socket(zmq.SUB)
+        self.socket.set(zmq.RCVTIMEO, 60000)
+        self.socket.setsockopt(zmq.SUBSCRIBE, b'hashblock')
+        self.socket.setsockopt(zmq.SUBSCRIBE, b'zdagstatus')
+        self.restart_node(0, self.extra_args[0] + ['-zmqpubhashblock=%s' % address, '-zmqpubzdagstatus=%s' % address])
+        self.socket.connect(address)
+        # wait for the subscription to be active before relying on notifications
+        self.socket.set(zmq.RCVTIMEO, 1000)
+        while True:
+            blockhash = node.generate(1)[0]
+            try:
+                if self.receive(b'hashblock').hex() == blockhash:
+                    break
+            except zmq.error.Again:
+                continue
+        self.socket.set(zmq.RCVTIMEO, 60000)
+        node.generate(200)
+        asset = node.assetnew('1', 'TST', 'asset description', '0x', 8, 10000, 127, '', {}, {})['asset_guid']
+        node.generate(1)
+        useraddress = node.getnewaddress()
+        node.assetsend(asset, useraddress, 1.5)
+        node.generate(1)
+
+        self.log.info("A new asset allocation publishes its status")
+        tx1 = node.assetallocationsend(asset, node.getnewaddress(), 0.1, 0, False)['txid']
+        assert_equal(self.receive_zdag(), (tx1, 'S', ZDAG_STATUS_OK))
+        assert_equal(node.assetallocationverifyzdag(tx1)['status'], ZDAG_STATUS_OK)
+
+        self.log.info("Replaceable asset allocations are published as a warning")
+        tx2 = node.assetallocationsend(asset, node.getnewaddress(), 0.1, 0, True)['txid']
+        assert_equal(self.receive_zdag(), (tx2, 'S', ZDAG_WARNING_RBF))
+
+        self.log.info("Confirmation is published")
+        node.generate(1)
+        confirmed = sorted([self.receive_zdag(), self.receive_zdag()])
+        assert_equal(confirmed, sorted([(tx1, 'C', None), (tx2, 'C', None)]))
+
+if __name__ == '__main__':
+    ZMQZDAGTest().main()
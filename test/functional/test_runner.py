@@ -149,6 +149,7 @@ BASE_SCRIPTS = [
     'wallet_keypool_topup.py --descriptors',
     'feature_fee_estimation.py',
     'interface_zmq.py',
+    'interface_zmq_zdag.py',
     'rpc_invalid_address_message.py',
     'interface_syscoin_cli.py',
     'mempool_resurrect.py',
@@ -311,6 +312,8 @@ BASE_SCRIPTS = [
     'feature_multikeysporks.py',
     'feature_asset_auxfees.py',
     'feature_asset_reorg.py',
+    'feature_asset_index.py',
+    'feature_asset_address_index.py',
     'feature_asset_mint.py',
     'feature_asset_txroots.py',
     'feature_asset_burn.py',